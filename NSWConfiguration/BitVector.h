@@ -0,0 +1,188 @@
+#ifndef NSWCONFIGURATION_BITVECTOR_H
+#define NSWCONFIGURATION_BITVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nsw {
+  /**
+   * \brief Packed sequence of bits
+   *
+   * Replaces strings of '0' and '1' as representation of configuration bitstreams. Bit 0 is the
+   * first bit of the bitstream and is stored in the most significant bit of the first byte, so
+   * the packed bytes are exactly what is sent to the hardware. Bit fields are read and written
+   * MSB first, i.e. the bit at the given position is the most significant bit of the value.
+   */
+  class BitVector
+  {
+  public:
+    /// Maximum width of a bit field read or written at once
+    static constexpr std::size_t MAX_FIELD_WIDTH{64};
+
+    BitVector() = default;
+
+    /**
+     * \brief Construct a bit vector of a given size with all bits cleared
+     *
+     * \param numBits Number of bits
+     */
+    explicit BitVector(std::size_t numBits);
+
+    /**
+     * \brief Construct from a string of '0' and '1'
+     *
+     * \param bits Bit string, first character is bit 0
+     * \return BitVector Packed bits
+     * \throws std::invalid_argument String contains other characters
+     */
+    [[nodiscard]] static BitVector fromString(std::string_view bits);
+
+    /**
+     * \brief Construct from bytes
+     *
+     * \param bytes Bytes, MSB of the first byte is bit 0
+     * \return BitVector Packed bits (8 bits per byte)
+     */
+    [[nodiscard]] static BitVector fromBytes(std::span<const std::uint8_t> bytes);
+
+    /**
+     * \brief Reverse the order of the lowest bits of a value
+     *
+     * \param value Value
+     * \param width Number of bits to be reversed
+     * \return std::uint64_t Value with reversed bits, e.g. (0b00011, 5) -> 0b11000
+     */
+    [[nodiscard]] static std::uint64_t reverseBits(std::uint64_t value, std::size_t width);
+
+    /**
+     * \brief Get the number of bits
+     */
+    [[nodiscard]] std::size_t size() const { return m_size; }
+
+    /**
+     * \brief Check if the bit vector holds no bits
+     */
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /**
+     * \brief Reserve memory for a number of bits
+     *
+     * \param numBits Number of bits
+     */
+    void reserve(std::size_t numBits);
+
+    /**
+     * \brief Read a bit
+     *
+     * \param pos Position of the bit
+     * \return bool Value of the bit
+     * \throws std::out_of_range pos is out of range
+     */
+    [[nodiscard]] bool test(std::size_t pos) const;
+
+    /**
+     * \brief Write a bit
+     *
+     * \param pos Position of the bit
+     * \param value Value of the bit
+     * \throws std::out_of_range pos is out of range
+     */
+    void set(std::size_t pos, bool value);
+
+    /**
+     * \brief Read a bit field
+     *
+     * \param pos Position of the most significant bit of the field
+     * \param width Width of the field (at most \ref MAX_FIELD_WIDTH)
+     * \return std::uint64_t Value of the field
+     * \throws std::out_of_range field does not fit
+     */
+    [[nodiscard]] std::uint64_t extract(std::size_t pos, std::size_t width) const;
+
+    /**
+     * \brief Write a bit field
+     *
+     * Bits of value above width are ignored.
+     *
+     * \param pos Position of the most significant bit of the field
+     * \param width Width of the field (at most \ref MAX_FIELD_WIDTH)
+     * \param value Value of the field
+     * \throws std::out_of_range field does not fit
+     */
+    void insert(std::size_t pos, std::size_t width, std::uint64_t value);
+
+    /**
+     * \brief Interpret all bits as one unsigned number
+     *
+     * \return std::uint64_t Value of the bits, bit 0 is the most significant bit
+     * \throws std::out_of_range More than \ref MAX_FIELD_WIDTH bits
+     */
+    [[nodiscard]] std::uint64_t toInteger() const { return extract(0, m_size); }
+
+    /**
+     * \brief Append a bit field to the end
+     *
+     * \param value Value of the field
+     * \param width Width of the field (at most \ref MAX_FIELD_WIDTH)
+     */
+    void append(std::uint64_t value, std::size_t width);
+
+    /**
+     * \brief Append all bits of another bit vector to the end
+     *
+     * \param other Bits to be appended
+     */
+    void append(const BitVector& other);
+
+    /**
+     * \brief View of the packed bytes
+     *
+     * Unused bits of the last byte are 0.
+     *
+     * \return std::span<const std::uint8_t> Bytes, valid until the bit vector is modified
+     */
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const { return m_bytes; }
+
+    /**
+     * \brief Copy of the packed bytes
+     *
+     * \return std::vector<std::uint8_t> Bytes
+     */
+    [[nodiscard]] std::vector<std::uint8_t> toByteVector() const { return m_bytes; }
+
+    /**
+     * \brief Convert into a string of '0' and '1'
+     *
+     * \return std::string Bit string, first character is bit 0
+     */
+    [[nodiscard]] std::string toString() const;
+
+    /**
+     * \brief Convert into a hex string of the packed bytes
+     *
+     * \return std::string Hex string
+     */
+    [[nodiscard]] std::string toHexString() const;
+
+    bool operator==(const BitVector& other) const = default;
+
+  private:
+    /**
+     * \brief Throw if a field does not fit into the bit vector
+     *
+     * \param pos Position of the field
+     * \param width Width of the field
+     * \throws std::out_of_range field does not fit
+     */
+    void checkRange(std::size_t pos, std::size_t width) const;
+
+    std::vector<std::uint8_t> m_bytes{};  //!< Packed bits, unused bits of the last byte are 0
+    std::size_t m_size{0};                //!< Number of bits
+  };
+}  // namespace nsw
+
+#endif
@@ -18,6 +18,7 @@ namespace nsw::commands {
   constexpr static std::string_view RECOVER_OPC{"recoverOpc"};
   constexpr static std::string_view RECOVER_OPC_MESSAGE{"recoverOpcAndMessage"};
   constexpr static std::string_view MON_IS_SERVER_NAME{"monitoringIsServerName"};
+  constexpr static std::string_view DUMP_HISTORY{"dumpMonitoringHistory"};
 }  // namespace nsw::commands
 
 #endif
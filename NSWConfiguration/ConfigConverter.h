@@ -2,10 +2,13 @@
 #define NSWCONFIGURATION_CONFIGCONVERTER_H
 
 #include <map>
-#include <numeric>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 #include "NSWConfiguration/I2cRegisterMappings.h"
 #include "boost/property_tree/ptree.hpp"
@@ -89,6 +92,177 @@ namespace nsw {
   template<ConfigConversionType DEVICE>
   using translationMapIntType_t = typename translationMapTypeSelector<DEVICE>::intType;
 
+  /**
+   * \brief Translation map compiled into flat arrays
+   *
+   * Values, registers and sub-registers of the translation map of a device type are numbered
+   * once. Every value and every register know their translation units as a contiguous range, so
+   * that conversions work on arrays of register contents indexed by register number instead of
+   * ptrees and linear searches through the translation map. The index is built on first use and
+   * is immutable afterwards.
+   *
+   * \tparam DeviceType Device type
+   */
+  template<ConfigConversionType DeviceType>
+  class ConfigTranslationIndex
+  {
+  public:
+    using IntType = translationMapIntType_t<DeviceType>;
+
+    /**
+     * \brief Part of a value stored in a sub-register
+     */
+    struct Unit {
+      std::size_t m_value{};     ///< Index of the value
+      std::size_t m_register{};  ///< Index of the register
+      IntType m_maskRegister{};  ///< Bits of the register belonging to the sub-register
+      IntType m_maskValue{};     ///< Bits of the value stored in the sub-register
+      int m_shiftRegister{};     ///< Number of trailing zeros of m_maskRegister
+      int m_shiftValue{};        ///< Number of trailing zeros of m_maskValue
+    };
+
+    /**
+     * \brief Get the index of this device type
+     */
+    static const ConfigTranslationIndex& getInstance();
+
+    [[nodiscard]] std::size_t getNumValues() const { return m_valueNames.size(); }
+    [[nodiscard]] std::size_t getNumRegisters() const { return m_registerNames.size(); }
+    [[nodiscard]] const std::string& getValueName(const std::size_t value) const { return m_valueNames.at(value); }
+    [[nodiscard]] const std::string& getRegisterName(const std::size_t reg) const { return m_registerNames.at(reg); }
+    [[nodiscard]] const std::string& getSubRegisterName(const std::size_t unit) const { return m_subRegisterNames.at(unit); }
+    [[nodiscard]] const Unit& getUnit(const std::size_t unit) const { return m_units.at(unit); }
+
+    /**
+     * \brief Get the size of a register in bits
+     *
+     * \param reg Index of the register
+     * \return std::size_t Size, 0 if the register is not in the register mapping of the device
+     */
+    [[nodiscard]] std::size_t getRegisterSize(const std::size_t reg) const { return m_registerSizes.at(reg); }
+
+    /**
+     * \brief Find a value, register or sub-register (\<register\>.\<subregister\>) by name
+     *
+     * \param name Name
+     * \return std::optional<std::size_t> Index of the value, register or translation unit, empty if not found
+     */
+    [[nodiscard]] std::optional<std::size_t> findValue(const std::string& name) const;
+    [[nodiscard]] std::optional<std::size_t> findRegister(const std::string& name) const;     //!< \copydoc findValue
+    [[nodiscard]] std::optional<std::size_t> findSubRegister(const std::string& name) const;  //!< \copydoc findValue
+
+    /**
+     * \brief Get the index of a value
+     *
+     * \param name Name of the value
+     * \return std::size_t Index of the value
+     * \throws std::out_of_range Value is not in the translation map
+     */
+    [[nodiscard]] std::size_t getValue(const std::string& name) const;
+
+    /**
+     * \brief Get the translation units of a value
+     *
+     * \param value Index of the value
+     * \return std::span<const Unit> Units
+     */
+    [[nodiscard]] std::span<const Unit> getUnitsOfValue(std::size_t value) const;
+
+    /**
+     * \brief Get the names of the sub-registers of a value
+     *
+     * \param value Index of the value
+     * \return std::span<const std::string> Names in the order of \ref getUnitsOfValue
+     */
+    [[nodiscard]] std::span<const std::string> getSubRegisterNamesOfValue(std::size_t value) const;
+
+    /**
+     * \brief Get the indices of the translation units of a register
+     *
+     * \param reg Index of the register
+     * \return std::span<const std::size_t> Indices of the units (see \ref getUnit)
+     */
+    [[nodiscard]] std::span<const std::size_t> getUnitsOfRegister(std::size_t reg) const;
+
+    /**
+     * \brief Get the registers needed to decode values
+     *
+     * \param values Indices of the values
+     * \return std::vector<std::size_t> Sorted indices of the registers
+     */
+    [[nodiscard]] std::vector<std::size_t> getRegistersOfValues(std::span<const std::size_t> values) const;
+
+    /**
+     * \brief Assemble a value from the contents of its registers
+     *
+     * \param value Index of the value
+     * \param registers Contents of all registers indexed by register number (only the ones
+     *        returned by \ref getRegistersOfValues need to be set)
+     * \return IntType Value
+     */
+    [[nodiscard]] IntType decodeValue(std::size_t value, std::span<const IntType> registers) const;
+
+    /**
+     * \brief Distribute a value over its registers
+     *
+     * \param value Index of the value
+     * \param data Value
+     * \param registers Contents of all registers indexed by register number, the bits of the value are added
+     * \param masks Bits set per register, the bits of the value are added
+     */
+    void encodeValue(std::size_t value, IntType data, std::span<IntType> registers, std::span<IntType> masks) const;
+
+    /**
+     * \brief Read values
+     *
+     * \tparam Func Callable taking the indices of the needed registers
+     *         (std::span<const std::size_t>) and returning their contents in the same order
+     * \param names Names of the values
+     * \param readRegisters Reads the registers
+     * \return std::map<std::string, unsigned int> Map of value names to values
+     * \throws std::out_of_range A value is not in the translation map
+     */
+    template<typename Func>
+    [[nodiscard]] std::map<std::string, unsigned int> readValues(std::span<const std::string> names,
+                                                                 Func&& readRegisters) const
+    {
+      std::vector<std::size_t> values{};
+      values.reserve(names.size());
+      for (const auto& name : names) {
+        values.push_back(getValue(name));
+      }
+      const auto regs = getRegistersOfValues(values);
+      const std::vector<IntType> contents = std::forward<Func>(readRegisters)(std::span<const std::size_t>{regs});
+      if (contents.size() != regs.size()) {
+        throw std::logic_error("Number of read registers does not match the number of requested registers");
+      }
+      std::vector<IntType> registers(getNumRegisters());
+      for (std::size_t i = 0; i < regs.size(); ++i) {
+        registers[regs[i]] = contents[i];
+      }
+      std::map<std::string, unsigned int> result{};
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        result.emplace(names[i], static_cast<unsigned int>(decodeValue(values[i], registers)));
+      }
+      return result;
+    }
+
+  private:
+    ConfigTranslationIndex();
+
+    std::vector<std::string> m_valueNames{};
+    std::vector<std::string> m_registerNames{};
+    std::vector<std::string> m_subRegisterNames{};  ///< Indexed by unit, grouped by value
+    std::vector<std::size_t> m_registerSizes{};
+    std::vector<Unit> m_units{};                    ///< Grouped by value
+    std::vector<std::size_t> m_valueOffsets{};      ///< Units of value i are [m_valueOffsets[i], m_valueOffsets[i + 1])
+    std::vector<std::size_t> m_registerUnits{};     ///< Unit indices grouped by register
+    std::vector<std::size_t> m_registerOffsets{};   ///< Units of register i are [m_registerOffsets[i], m_registerOffsets[i + 1])
+    std::unordered_map<std::string, std::size_t> m_valueLookup{};
+    std::unordered_map<std::string, std::size_t> m_registerLookup{};
+    std::unordered_map<std::string, std::size_t> m_subRegisterLookup{};
+  };
+
   /**
    * \brief Converts between register-based and value-based configurations
    *
@@ -97,16 +271,18 @@ namespace nsw {
   template<ConfigConversionType DeviceType>
   class ConfigConverter
   {
+    using Index = ConfigTranslationIndex<DeviceType>;
+
     /**
-     * \brief Struct holding ptree and mask
+     * \brief Register contents and masks
      *
-     * Conversion without sub-registers needs to save both the new ptree as well as
-     * keeping track of the parts (sub-registers) which were set.
+     * Conversion without sub-registers needs to save both the register contents as well as
+     * keeping track of the parts (sub-registers) which were set. Both are indexed by the
+     * register number of the \ref ConfigTranslationIndex.
      */
     struct TranslatedConfig {
-      boost::property_tree::ptree m_ptree;  ///< translated ptree
-      std::map<std::string, translationMapIntType_t<DeviceType>>
-        m_mask;  ///< map holding mask of values set in ptree
+      std::vector<translationMapIntType_t<DeviceType>> m_registers;  ///< translated register contents
+      std::vector<translationMapIntType_t<DeviceType>> m_mask;       ///< mask of values set per register
     };
 
   public:
@@ -196,7 +372,7 @@ namespace nsw {
      * The conversion in this direction is slower as it should not be used while configuring
      * 1. Get all paths from ptree
      * 2. Iterate through paths of ptree and
-     *    a) Find the correct entry in TRANSLATION_MAP
+     *    a) Find the correct translation unit in the \ref ConfigTranslationIndex
      *       (key is now TranslationUnit.m_RegisterName)
      *    b) Calculate value: Shift value in old ptree by number of trailing zeros in maskValue
      *       to the left.
@@ -236,12 +412,11 @@ namespace nsw {
      * 2. Validate that all paths are in TRANSLATION_MAP
      * 3. a) Iterate through paths of input ptree and caluclate for each translation unit
      *       value & translationUnit.m_maskValue. This value needs to be shifted to the right by
-     * the number of trailing zeros of the mask. b) Check if register
-     * (TranslationUnit.m_RegisterName) already exists in new ptree: yes: Add it to the existing
-     * value no:  Put this value into TranslationUnit.m_RegisterName into the new ptree c) Keep
-     * track of the total mask applied per register \param t_config value-based configuration
+     * the number of trailing zeros of the mask. b) Add it to the contents of the register
+     * (TranslationUnit.m_RegisterName) c) Keep track of the total mask applied per register
      *
-     * \return register-based configuration without sub-registers and total mask per register
+     * \param t_config value-based configuration
+     * \return register contents and total mask per register, indexed by register number
      */
     [[nodiscard]] TranslatedConfig convertValueToFlatRegister(
       const boost::property_tree::ptree& t_config) const;
@@ -280,18 +455,21 @@ namespace nsw {
       // FIXME: return type of Func
       static_assert(std::is_invocable_r<uint8_t, Func, std::string>::value,
                     "Uh oh! the function is not invokable as we want it");
+      const auto& index = Index::getInstance();
       const TranslatedConfig tmp = convertValueToFlatRegister(m_valueTree);
-      auto config = tmp.m_ptree;
-      const auto& masks = tmp.m_mask;
 
-      for (const auto& [registerName, mask] : masks) {
+      boost::property_tree::ptree config;
+      for (std::size_t reg = 0; reg < index.getNumRegisters(); ++reg) {
+        const auto mask = tmp.m_mask[reg];
+        if (mask == 0) {
+          continue;
+        }
+        const auto& registerName = index.getRegisterName(reg);
         const auto numberBitsSet = popcount(mask);
-
-        const auto registerSize = std::accumulate(
-          std::begin(REGISTER_MAPPINGS.at(DeviceType).at(registerName)),
-          std::end(REGISTER_MAPPINGS.at(DeviceType).at(registerName)),
-          0,
-          [](const size_t sum, const i2c::RegisterSizePair& p) { return sum + p.second; });
+        const auto registerSize = index.getRegisterSize(reg);
+        if (registerSize == 0) {
+          throw std::out_of_range("Register " + registerName + " is not in the register mapping");
+        }
 
         if (static_cast<int>(registerSize) == numberBitsSet) {
           if (ctz(~mask) != static_cast<int>(registerSize)) {
@@ -299,12 +477,11 @@ namespace nsw {
                                      "consecutive for register " +
                                      registerName);
           }
+          config.put(registerName, tmp.m_registers[reg]);
           continue;
         }
 
-        config.put(registerName,
-                   config.template get<translationMapIntType_t<DeviceType>>(registerName) |
-                     (t_func(registerName) & (~mask)));
+        config.put(registerName, tmp.m_registers[reg] | (t_func(registerName) & (~mask)));
       }
 
       return config;
@@ -332,27 +509,15 @@ namespace nsw {
     static int popcount(translationMapIntType_t<DeviceType> t_val);
 
     /**
-     * \brief Converts a binary string into an int
+     * \brief Converts a bitstream into an int
      *
-     * \param t_string string of zeros and ones
+     * \param t_bits bitstream
      * \return translationMapIntType_t<DeviceType> integer
      */
-    static translationMapIntType_t<DeviceType> binaryStringToInt(const std::string& t_string);
+    static translationMapIntType_t<DeviceType> bitVectorToInt(const nsw::BitVector& t_bits);
 
-    /**
-     * \brief Get the translation map for each \ref DeviceType
-     *
-     * \return translationMapType_t<DeviceType> translation map
-     */
-    static const translationMapType_t<DeviceType>& getTranslationMap();
-
-    translationMapType_t<DeviceType>
-      m_translationMap;  ///< map used for translation (analog, digital, tds, ...)
     boost::property_tree::ptree m_registerTree;  ///< register-based ptree
     boost::property_tree::ptree m_valueTree;     ///< value-based ptree
-
-    static const std::unordered_map<ConfigConversionType, i2c::AddressRegisterMap>
-      REGISTER_MAPPINGS;
   };
 
 }  // namespace nsw
@@ -0,0 +1,352 @@
+#ifndef NSWCONFIGURATION_CONFIGIMAGECACHE_H
+#define NSWCONFIGURATION_CONFIGIMAGECACHE_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <ers/Issue.h>
+
+#include "NSWConfiguration/BitVector.h"
+#include "NSWConfiguration/ConfigOverlay.h"
+#include "NSWConfiguration/Types.h"
+
+ERS_DECLARE_ISSUE(nsw,
+                  ConfigImageCacheIssue,
+                  "Configuration image file " << filename << ": " << message,
+                  ((std::string) filename)
+                  ((std::string) message)
+                  )
+
+namespace nsw {
+  /// Version of the files written by \ref saveConfigImageCaches, files of other versions are ignored
+  constexpr std::uint32_t CONFIG_IMAGE_FILE_VERSION{1};
+
+  /**
+   * \brief Build the key under which the image of a configuration is cached
+   *
+   * The key is the domain followed by a 128 bit hash of a canonical serialization of the ptree:
+   * children are ordered by name (children with the same name, e.g. array elements, keep their
+   * order), so that trees which only differ in the order of their registers map to the same key.
+   * The serialization itself is never stored.
+   *
+   * \param domain Identifies the encoding (e.g. the register layout), images of different domains never match
+   * \param config Configuration ptree
+   * \return std::string Key ("<domain>:<32 hexadecimal digits>")
+   */
+  [[nodiscard]] std::string buildConfigImageKey(std::string_view domain, const boost::property_tree::ptree& config);
+
+  /**
+   * \brief Build the key under which the image of a layered configuration is cached
+   *
+   * If the common layer is shared (see \ref makeSharedConfigLayer), only its fingerprint and the
+   * overrides are hashed, so that the cost scales with the number of overrides.
+   *
+   * \param domain Identifies the encoding (e.g. the register layout), images of different domains never match
+   * \param config Layered configuration
+   * \return std::string Key
+   */
+  [[nodiscard]] std::string buildConfigImageKey(std::string_view domain, const ConfigOverlay& config);
+
+  /**
+   * \brief Build a short hash of the canonical content of a configuration
+   *
+   * \param config Configuration ptree
+   * \return std::string Hexadecimal 128 bit FNV-1a hash of the canonical serialization (see \ref buildConfigImageKey)
+   */
+  [[nodiscard]] std::string buildConfigFingerprint(const boost::property_tree::ptree& config);
+
+  /**
+   * \brief Counters of a \ref ConfigImageCache
+   */
+  struct ConfigImageCacheStatistics {
+    std::size_t m_hits{0};       //!< Images found in the cache
+    std::size_t m_misses{0};     //!< Images which had to be built
+    std::size_t m_entries{0};    //!< Distinct images in the cache
+    std::size_t m_rejected{0};   //!< Images read from a file which did not match the layout
+    std::size_t m_evictions{0};  //!< Least recently used images removed to respect the size limit
+  };
+
+  /**
+   * \brief Content-addressed cache of configuration images
+   *
+   * Most front ends of a sector share their common configuration and differ only in a few
+   * registers. The cache maps the canonical content of a configuration ptree (see
+   * \ref buildConfigImageKey) to the encoded image, so that identical images are built once and
+   * shared (read only) between all configuration objects. Entries are kept across configurations,
+   * so that a reconfiguration only builds the images which changed. The number of entries is
+   * limited (see \ref setMaxEntries), the least recently used ones are evicted first.
+   * Configuration objects keep their images when they are evicted. Thread safe.
+   *
+   * \tparam Image Type of the encoded image
+   */
+  template<typename Image>
+  class ConfigImageCache
+  {
+  public:
+    using ImagePtr = std::shared_ptr<const Image>;
+
+    constexpr static std::size_t DEFAULT_MAX_ENTRIES{16384};  //!< Default limit of the number of entries
+
+    /**
+     * \brief Get the process wide cache of this image type
+     */
+    static ConfigImageCache& getInstance()
+    {
+      static ConfigImageCache cache;
+      return cache;
+    }
+
+    /**
+     * \brief Get the image of a configuration, build it if it is not cached
+     *
+     * The builder is called without holding the lock. If two threads build the same image at the
+     * same time, the first one which finishes is kept.
+     *
+     * \param domain Identifies the encoding (see \ref buildConfigImageKey)
+     * \param config Configuration ptree
+     * \param build Callable building the image from the configuration
+     * \return ImagePtr Shared image
+     */
+    template<std::invocable<const boost::property_tree::ptree&> Builder>
+    ImagePtr get(const std::string_view domain, const boost::property_tree::ptree& config, Builder&& build)
+    {
+      return getByKey(buildConfigImageKey(domain, config),
+                      [&config, &build]() { return std::forward<Builder>(build)(config); });
+    }
+
+    /**
+     * \brief Get the image stored under a key, build it if it is not cached
+     *
+     * \param key Key of the image (see \ref buildConfigImageKey)
+     * \param build Callable building the image
+     * \return ImagePtr Shared image
+     */
+    template<std::invocable Builder>
+    ImagePtr getByKey(std::string key, Builder&& build)
+    {
+      return getByKey(std::move(key), std::forward<Builder>(build), [](const Image&) { return true; });
+    }
+
+    /**
+     * \brief Get the image stored under a key, build it if it is not cached
+     *
+     * An image read from a file (see \ref preload) is only used if it passes the check of the
+     * caller, which knows the layout of the image. Otherwise it is dropped and rebuilt.
+     *
+     * \param key Key of the image (see \ref buildConfigImageKey)
+     * \param build Callable building the image
+     * \param isValid Callable checking an image read from a file
+     * \return ImagePtr Shared image
+     */
+    template<std::invocable Builder, std::predicate<const Image&> Validator>
+    ImagePtr getByKey(std::string key, Builder&& build, Validator&& isValid)
+    {
+      {
+        std::scoped_lock lock(m_mutex);
+        if (const auto it = m_images.find(key); it != std::end(m_images)) {
+          ++m_hits;
+          m_order.splice(std::begin(m_order), m_order, it->second.m_position);
+          return it->second.m_image;
+        }
+        if (auto loaded = m_loaded.extract(key); not loaded.empty()) {
+          if (std::forward<Validator>(isValid)(*loaded.mapped())) {
+            ++m_hits;
+            return store(std::move(key), std::move(loaded.mapped()));
+          }
+          ++m_rejected;
+        }
+      }
+      auto image = std::make_shared<const Image>(std::forward<Builder>(build)());
+      std::scoped_lock lock(m_mutex);
+      ++m_misses;
+      return store(std::move(key), std::move(image));
+    }
+
+    /**
+     * \brief Add an image read from a file under a key (see \ref buildConfigImageKey)
+     *
+     * The image is checked when it is used for the first time (see \ref getByKey)
+     *
+     * \param key Key of the image
+     * \param image Image
+     * \return true if the image was added, false if the key is known or the cache is full
+     */
+    bool preload(std::string key, ImagePtr image)
+    {
+      std::scoped_lock lock(m_mutex);
+      if (m_images.contains(key) or std::size(m_images) + std::size(m_loaded) >= m_maxEntries) {
+        return false;
+      }
+      return m_loaded.try_emplace(std::move(key), std::move(image)).second;
+    }
+
+    /**
+     * \brief Get copies of all entries, the most recently used first
+     *
+     * Images read from a file which were not used yet are not included.
+     *
+     * \return std::vector<std::pair<std::string, ImagePtr>> Pairs of key and image
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, ImagePtr>> getEntries() const
+    {
+      std::scoped_lock lock(m_mutex);
+      std::vector<std::pair<std::string, ImagePtr>> entries;
+      entries.reserve(std::size(m_order));
+      for (const auto& key : m_order) {
+        entries.emplace_back(key, m_images.at(key).m_image);
+      }
+      return entries;
+    }
+
+    /**
+     * \brief Remove all entries and reset the counters
+     *
+     * Configuration objects keep their images.
+     */
+    void clear()
+    {
+      std::scoped_lock lock(m_mutex);
+      m_images.clear();
+      m_order.clear();
+      m_loaded.clear();
+      resetCounters();
+    }
+
+    /**
+     * \brief Reset the counters, e.g. before a new configuration
+     */
+    void resetStatistics()
+    {
+      std::scoped_lock lock(m_mutex);
+      resetCounters();
+    }
+
+    /**
+     * \brief Limit the number of entries, evicts the least recently used ones if needed
+     *
+     * \param maxEntries Maximum number of entries (at least 1)
+     */
+    void setMaxEntries(const std::size_t maxEntries)
+    {
+      std::scoped_lock lock(m_mutex);
+      m_maxEntries = std::max(maxEntries, std::size_t{1});
+      evict();
+    }
+
+    /**
+     * \brief Get the maximum number of entries
+     */
+    [[nodiscard]] std::size_t getMaxEntries() const
+    {
+      std::scoped_lock lock(m_mutex);
+      return m_maxEntries;
+    }
+
+    /**
+     * \brief Get the counters of the cache
+     */
+    [[nodiscard]] ConfigImageCacheStatistics getStatistics() const
+    {
+      std::scoped_lock lock(m_mutex);
+      return {m_hits, m_misses, m_images.size(), m_rejected, m_evictions};
+    }
+
+  private:
+    /**
+     * \brief Entry of the cache with its position in the usage order
+     */
+    struct Entry {
+      ImagePtr m_image;
+      std::list<std::string>::iterator m_position;
+    };
+
+    /**
+     * \brief Add an image as most recently used one and evict if needed (locked by caller)
+     *
+     * \return ImagePtr The cached image, an existing one if the key was already present
+     */
+    ImagePtr store(std::string key, ImagePtr image)
+    {
+      if (const auto it = m_images.find(key); it != std::end(m_images)) {
+        m_order.splice(std::begin(m_order), m_order, it->second.m_position);
+        return it->second.m_image;
+      }
+      m_order.push_front(key);
+      auto stored = m_images.try_emplace(std::move(key), Entry{std::move(image), std::begin(m_order)}).first->second.m_image;
+      evict();
+      return stored;
+    }
+
+    /**
+     * \brief Remove the least recently used entries above the limit (locked by caller)
+     */
+    void evict()
+    {
+      while (std::size(m_images) > m_maxEntries) {
+        m_images.erase(m_order.back());
+        m_order.pop_back();
+        ++m_evictions;
+      }
+    }
+
+    /**
+     * \brief Reset the counters (locked by caller)
+     */
+    void resetCounters()
+    {
+      m_hits = 0;
+      m_misses = 0;
+      m_rejected = 0;
+      m_evictions = 0;
+    }
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_images{};
+    std::list<std::string> m_order{};                    //!< Keys of m_images, most recently used first
+    std::unordered_map<std::string, ImagePtr> m_loaded{};  //!< Images read from a file, checked on first use
+    std::size_t m_maxEntries{DEFAULT_MAX_ENTRIES};
+    std::size_t m_hits{0};
+    std::size_t m_misses{0};
+    std::size_t m_rejected{0};
+    std::size_t m_evictions{0};
+  };
+
+  using VmmImageCache = ConfigImageCache<nsw::BitVector>;           //!< Cache of VMM SPI images
+  using I2cImageCache = ConfigImageCache<i2c::AddressBitstreamMap>;  //!< Cache of I2C master images
+
+  /**
+   * \brief Write the VMM and I2C image caches to a JSON file
+   *
+   * The file starts with its format version (\ref CONFIG_IMAGE_FILE_VERSION).
+   *
+   * \param filename Path of the file
+   * \throws boost::property_tree::json_parser_error File cannot be written
+   */
+  void saveConfigImageCaches(const std::string& filename);
+
+  /**
+   * \brief Add the images of a file written by \ref saveConfigImageCaches to the caches
+   *
+   * A file which cannot be parsed or has another format version is ignored with a warning, the
+   * caches stay as they are. Malformed entries are skipped with a warning. The images are checked
+   * against the layout of their configuration on first use (see \ref ConfigImageCache::getByKey).
+   *
+   * \param filename Path of the file
+   * \return std::size_t Number of loaded images
+   */
+  std::size_t loadConfigImageCaches(const std::string& filename);
+}  // namespace nsw
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef NSWCONFIGURATION_CONFIGOVERLAY_H
+#define NSWCONFIGURATION_CONFIGOVERLAY_H
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace nsw {
+  /**
+   * \brief Read-only view of a configuration made of a common layer and a sparse override layer
+   *
+   * Values are looked up in the override layer first and then in the common layer, which gives
+   * the same result as merging the overrides into a copy of the common tree (see
+   * \ref materialize) without copying it. The view does not own the trees.
+   */
+  class ConfigLayers
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param common Fully populated tree
+     * \param overrides Partially populated tree, may be nullptr
+     */
+    explicit ConfigLayers(const boost::property_tree::ptree& common,
+                          const boost::property_tree::ptree* overrides = nullptr) :
+      m_common{&common}, m_overrides{overrides}
+    {}
+
+    /**
+     * \brief Get a value
+     *
+     * \tparam T Type of the value
+     * \param path Path of the value
+     * \return T Value of the override layer if it exists, otherwise of the common layer
+     * \throws boost::property_tree::ptree_bad_path Value exists in none of the layers
+     * \throws boost::property_tree::ptree_bad_data Value cannot be converted
+     */
+    template<typename T>
+    [[nodiscard]] T get(const std::string& path) const
+    {
+      if (m_overrides != nullptr) {
+        if (const auto node = m_overrides->get_child_optional(path)) {
+          return node->get_value<T>();
+        }
+      }
+      return m_common->get<T>(path);
+    }
+
+    /**
+     * \brief Get the layered view of a child
+     *
+     * \param path Path of the child
+     * \return std::optional<ConfigLayers> View of the child in both layers, empty if it exists in none
+     */
+    [[nodiscard]] std::optional<ConfigLayers> getChildOptional(const std::string& path) const;
+
+    /**
+     * \brief Get a node of the topmost layer which contains it
+     *
+     * An overridden node replaces the common one as a whole, e.g. an array of channel values or
+     * a single value for all channels.
+     *
+     * \param path Path of the node
+     * \return const boost::property_tree::ptree& Node
+     * \throws boost::property_tree::ptree_bad_path Node exists in none of the layers
+     */
+    [[nodiscard]] const boost::property_tree::ptree& getNode(const std::string& path) const;
+
+    /**
+     * \brief Merge the overrides into a copy of the common layer
+     *
+     * Nodes with named children are merged recursively, values and arrays are replaced.
+     *
+     * \return boost::property_tree::ptree Merged tree
+     */
+    [[nodiscard]] boost::property_tree::ptree materialize() const;
+
+    [[nodiscard]] const boost::property_tree::ptree& getCommon() const { return *m_common; }
+    [[nodiscard]] const boost::property_tree::ptree* getOverrides() const { return m_overrides; }
+
+  private:
+    const boost::property_tree::ptree* m_common;
+    const boost::property_tree::ptree* m_overrides;
+  };
+
+  /**
+   * \brief Common configuration shared by many devices
+   */
+  struct ConfigLayer {
+    boost::property_tree::ptree m_tree{};  //!< Fully populated configuration
+    std::string m_fingerprint{};           //!< Hash of the content, empty if the layer belongs to a single device
+  };
+
+  /**
+   * \brief Create a common layer to be shared between devices
+   *
+   * \param tree Fully populated configuration
+   * \return std::shared_ptr<const ConfigLayer> Layer with the fingerprint of its content
+   */
+  [[nodiscard]] std::shared_ptr<const ConfigLayer> makeSharedConfigLayer(boost::property_tree::ptree tree);
+
+  /**
+   * \brief Configuration of a device made of a shared common layer and its own overrides
+   *
+   * Memory scales with the number of overrides instead of the number of registers.
+   */
+  class ConfigOverlay
+  {
+  public:
+    /**
+     * \brief Construct from a fully populated configuration without overrides
+     *
+     * \param config Configuration of a single device
+     */
+    explicit ConfigOverlay(boost::property_tree::ptree config);
+
+    /**
+     * \brief Construct from a shared common layer and overrides
+     *
+     * \param common Common layer (see \ref makeSharedConfigLayer)
+     * \param overrides Partially populated configuration of the device
+     */
+    ConfigOverlay(std::shared_ptr<const ConfigLayer> common, boost::property_tree::ptree overrides);
+
+    /**
+     * \brief Get the read-only view of both layers
+     */
+    [[nodiscard]] ConfigLayers getLayers() const { return ConfigLayers{m_common->m_tree, &m_overrides}; }
+
+    /**
+     * \brief Get a value (see \ref ConfigLayers::get)
+     */
+    template<typename T>
+    [[nodiscard]] T get(const std::string& path) const
+    {
+      return getLayers().get<T>(path);
+    }
+
+    /**
+     * \brief Merge the overrides into a copy of the common layer (see \ref ConfigLayers::materialize)
+     */
+    [[nodiscard]] boost::property_tree::ptree materialize() const { return getLayers().materialize(); }
+
+    [[nodiscard]] const ConfigLayer& getCommon() const { return *m_common; }
+    [[nodiscard]] const boost::property_tree::ptree& getOverrides() const { return m_overrides; }
+    [[nodiscard]] boost::property_tree::ptree& getOverrides() { return m_overrides; }  //!< \overload
+
+  private:
+    std::shared_ptr<const ConfigLayer> m_common;
+    boost::property_tree::ptree m_overrides{};
+  };
+}  // namespace nsw
+
+#endif
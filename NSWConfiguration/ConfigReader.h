@@ -39,6 +39,11 @@ class ConfigReader {
     return m_api->read(element_name);
   }
 
+  //! Read front end board configuration sharing the common configurations (see ConfigReaderApi::readFEBConfig)
+  nsw::FEBConfig readFEBConfig(const std::string& element_name) const {
+    return m_api->readFEBConfig(element_name);
+  }
+
   //! Get names of all Front end elements in the config database
   std::set<std::string> getAllElementNames() const {
     return m_api->getAllElementNames();
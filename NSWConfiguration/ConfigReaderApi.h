@@ -13,6 +13,7 @@
 #include <boost/property_tree/ptree.hpp>
 
 #include "NSWConfiguration/Constants.h"
+#include "NSWConfiguration/FEBConfig.h"
 #include "NSWConfiguration/Types.h"
 
 #include "ers/Issue.h"
@@ -31,6 +32,12 @@ class ConfigReaderApi {
   /// Read configuration of a single front end element into a ptree
   boost::property_tree::ptree read(const std::string& element);
 
+  /// Read configuration of a single front end board (MMFE8, PFEB, SFEB)
+  /// Unlike \ref read the common ROC, VMM and TDS configurations are not merged into the
+  /// configuration of each board but shared between all of them
+  /// \throws std::runtime_error Element is not a front end board
+  nsw::FEBConfig readFEBConfig(const std::string& element) const;
+
   /// Get names of all Front end elements in the configuration
   /// The base class method iterates through config ptree and finds all
   /// elements that start with MMFE8, PFEB, SFEB, ADDC, PadTrigger, Router in the name.
@@ -78,6 +85,14 @@ class ConfigReaderApi {
   virtual const boost::property_tree::ptree& getConfig() const = 0;
 
 protected:
+  /// Read configuration of front end, specifying number of vmm and tds in the FE
+  /// The base class method merges the full configuration, implementations may share the common
+  /// configurations between front ends instead
+  virtual nsw::FEBConfig readFEBLayered(const std::string& element, size_t nvmm, size_t ntds,
+                                        size_t vmm_start, size_t tds_start) const {
+    return nsw::FEBConfig{readFEB(element, nvmm, ntds, vmm_start, tds_start)};
+  }
+
   /**
    * \brief Adjust the ROC config for disabled sub-devices (sROC/VMM)
    *
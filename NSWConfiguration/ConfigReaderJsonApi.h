@@ -4,11 +4,13 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <set>
 
 #include <boost/property_tree/ptree.hpp>
 #include <utility>
 
+#include "NSWConfiguration/ConfigOverlay.h"
 #include "NSWConfiguration/ConfigReaderApi.h"
 #include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/Types.h"
@@ -43,6 +45,14 @@ ERS_DECLARE_ISSUE(nsw,
 
 class JsonApi: public ConfigReaderApi {
  private:
+  /// Checks that all elements of the specific tree exist in the common tree
+  /// \throws nsw::ConfigBadNode An element does not exist in the common tree
+  void checkI2cMasterTree(const boost::property_tree::ptree& specific, const boost::property_tree::ptree& common) const;
+
+  /// Checks that all registers of the specific tree exist in the common tree
+  /// \throws nsw::ConfigBadNode A register does not exist in the common tree
+  void checkVMMTree(const boost::property_tree::ptree& specific, const boost::property_tree::ptree& common) const;
+
   /// Merges 2 trees, overwrites elements in common tree, using the ones from specific
   /// \param common ptree that is fully populated with all fields required by I2cMasterConfig
   /// \param specific ptree that is partially populated.
@@ -55,6 +65,16 @@ class JsonApi: public ConfigReaderApi {
 
   boost::property_tree::ptree read();
 
+  /// Read configuration of front end
+  /// \param merge Merge the common configurations into the ROC, VMM and TDS nodes. Otherwise
+  ///        these nodes only hold the registers set for this front end
+  boost::property_tree::ptree readFEBTree(
+      const std::string& element, size_t nvmm, size_t ntds,
+      size_t vmm_start, size_t tds_start, bool merge) const;
+
+  /// Get the common ROC, VMM and TDS configurations as layers shared by all front ends
+  const nsw::FEBCommonConfig& getFEBCommonConfig() const;
+
   /**
    * @brief Validate that all devices in the map are contained in the JSON
    *
@@ -87,6 +107,11 @@ class JsonApi: public ConfigReaderApi {
       const std::string& element, size_t nvmm, size_t ntds,
       size_t vmm_start = 0, size_t tds_start = 0) const override;
 
+  /// Read configuration of front end without merging the common configurations into it
+  nsw::FEBConfig readFEBLayered(
+      const std::string& element, size_t nvmm, size_t ntds,
+      size_t vmm_start, size_t tds_start) const override;
+
   std::set<std::string> getAllElementNames() const override;
 
   boost::property_tree::ptree& getConfig() override;
@@ -97,6 +122,8 @@ class JsonApi: public ConfigReaderApi {
   std::string m_file_path;
   nsw::DeviceMap m_devices{};
   boost::property_tree::ptree m_config;  /// Ptree that holds all configuration
+  mutable std::once_flag m_febCommonOnce;  /// Guards the construction of m_febCommon
+  mutable nsw::FEBCommonConfig m_febCommon{};  /// Common front end configurations, built on first use
 };
 
 #endif  // NSWCONFIGURATION_CONFIGREADERJSONAPI_H
@@ -257,6 +257,13 @@ class ConfigSender {
     // Read SCA Online Status
     bool readSCAOnline(FEBConfig& feb);
 
+    /// Read online status, ID and address of many front ends with one request per OPC server
+    /// \param febs Front end configurations
+    /// \param chunkSize Maximum number of SCAs per read request
+    /// \return status in the order of febs
+    std::vector<nsw::ScaStatusInfo> readSCAStatus(const std::vector<FEBConfig>& febs,
+                                                  std::size_t chunkSize = OpcClient::DEFAULT_READ_CHUNK_SIZE);
+
     /// Program FPGA from bitfile
     /// \param bitfile_path relative or absolute path of the binary file that contains the configuration
     void sendFPGA(const std::string& opcserver_ipport, const std::string& node, const std::string& bitfile_path);
@@ -3,16 +3,26 @@
 #ifndef NSWCONFIGURATION_FEBCONFIG_H_
 #define NSWCONFIGURATION_FEBCONFIG_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "NSWConfiguration/Utility.h"
+#include "NSWConfiguration/ConfigOverlay.h"
 #include "NSWConfiguration/SCAConfig.h"
 #include "NSWConfiguration/VMMConfig.h"
 #include "NSWConfiguration/I2cMasterConfig.h"
 
 namespace nsw {
 
+//! Common configurations shared by the ROC, VMMs and TDSs of all front end boards
+struct FEBCommonConfig {
+    std::shared_ptr<const ConfigLayer> m_rocAnalog;   //!< Common rocPllCoreAnalog configuration
+    std::shared_ptr<const ConfigLayer> m_rocDigital;  //!< Common rocCoreDigital configuration
+    std::shared_ptr<const ConfigLayer> m_vmm;         //!< Common VMM configuration
+    std::shared_ptr<const ConfigLayer> m_tds;         //!< Common TDS configuration
+};
+
 //! Base class or configuration for any front end board that has
 //! - SCA
 //! - ROC and VMM(multiple)
@@ -30,6 +40,9 @@ class FEBConfig: public SCAConfig {
     std::size_t m_firstVmm{nsw::MAX_NUMBER_OF_VMM};  //!< Hold the board ID of the first VMM to correctly access by index of container
     std::size_t m_firstTds{nsw::MAX_NUMBER_OF_TDS};  //!< Hold the board ID of the first TDS to correctly access by index of container
 
+    //! Common implementation of the constructors, common is nullptr if config is fully populated
+    FEBConfig(const boost::property_tree::ptree& config, const FEBCommonConfig* common);
+
  public:
     //! Constructor.
     //! The ptree in the argument should contain
@@ -38,6 +51,13 @@ class FEBConfig: public SCAConfig {
     //! - Multiple vmm instances named vmm0 to vmmN
     //! - Multiple tds instances named tds0 to tdsN (optional)
     explicit FEBConfig(const boost::property_tree::ptree& config);
+
+    //! Constructor from common configurations and the values which differ for this board.
+    //! The ptree in the argument has the same structure, but rocPllCoreAnalog, rocCoreDigital,
+    //! vmmN and tdsN only hold the registers which differ from the common configuration
+    //! (possibly none). Memory scales with the number of these registers. getConfig() then only
+    //! holds these values, the ROC, VMM and TDS configurations are read from their objects.
+    FEBConfig(const boost::property_tree::ptree& config, const FEBCommonConfig& common);
     ~FEBConfig() = default;
 
     void dump() const;
@@ -1,11 +1,16 @@
 #ifndef NSWCONFIGURATION_I2CMASTERCONFIG_H_
 #define NSWCONFIGURATION_I2CMASTERCONFIG_H_
 
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "boost/property_tree/ptree.hpp"
 
+#include "NSWConfiguration/ConfigOverlay.h"
+#include "NSWConfiguration/RegisterLayout.h"
 #include "NSWConfiguration/Types.h"
 
 #include "ers/Issue.h"
@@ -61,6 +66,17 @@ class I2cMasterCodec {
     explicit I2cMasterCodec(const i2c::AddressRegisterMap & ar_map);
     ~I2cMasterCodec() = default;
 
+    /** \brief Get the shared codec of a register map
+     *  Codecs are immutable and only depend on the register map. One instance per register map
+     *  is created on first use and lives until the end of the process. Thread safe.
+     *  \param ar_map Register address map (e.g. ROC_ANALOG_REGISTERS). Must outlive the process
+     *  \return Codec of the register map
+     */
+    static const I2cMasterCodec& getInstance(const i2c::AddressRegisterMap& ar_map);
+
+    /// Increment when the encoding changes but the register maps do not
+    static constexpr unsigned ENCODER_VERSION = 1;
+
     /** \brief Method that creates bitstreams from config tree
      *  Iterates through m_addr_reg and creates a bitstream. Throws if the ptree does
      *  not contain all registers.
@@ -69,6 +85,12 @@ class I2cMasterCodec {
      */
     i2c::AddressBitstreamMap buildConfig(const boost::property_tree::ptree& config) const;
 
+    /** \brief Method that creates bitstreams from a layered config without merging the layers
+     *  \param config Configuration layers
+     *  \return Bitstream map register name : bitstream
+     */
+    i2c::AddressBitstreamMap buildConfig(const nsw::ConfigLayers& config) const;
+
     /** \brief Method to create a bitstream from a partial config tree
      *  Iterates through the ptree and creates a bitstream. Throws if it contains
      *  unknown registers.
@@ -77,6 +99,12 @@ class I2cMasterCodec {
      */
     i2c::AddressBitstreamMap buildPartialConfig(const boost::property_tree::ptree& config) const;
 
+    /** \brief Check that an image (e.g. read from a file) matches the layout of the codec
+     *  \param image Bitstream map as created by buildConfig
+     *  \return true if it contains exactly the configurable addresses, each with their total size
+     */
+    bool isValidImage(const i2c::AddressBitstreamMap& image) const;
+
     /// Map of i2c addresses, to a map of registers to positions in the bitstream
     i2c::AddressRegisterSizeMap m_addr_reg_pos;
 
@@ -89,6 +117,9 @@ class I2cMasterCodec {
     /// Return addresses of slaves the I2c master
     std::vector<std::string> getAddresses() const;
 
+    /// Return a short identifier of the register layout and ENCODER_VERSION, equal for codecs of identical register maps
+    const std::string& getLayoutKey() const { return m_layout_key; }
+
  protected:
     /// Map of i2c addresses and internal mapping of registers
     const i2c::AddressRegisterMap& m_addr_reg;
@@ -96,7 +127,17 @@ class I2cMasterCodec {
     /// Map of i2c addresses and total sizes
     i2c::AddressSizeMap m_addr_size;
 
-    // Fills m_addr_size
+    /// Map of i2c addresses to the offsets and widths of their registers in bitstream order
+    std::map<std::string, std::vector<FieldLayout>> m_addr_layout;
+
+    /// Hash of the addresses, register names and sizes
+    std::string m_layout_key;
+
+    /// Fills m_addr_size, m_addr_reg_pos, m_addr_reg_size, m_addr_layout and m_layout_key
+    ///
+    /// Runs once per register map when the shared codec is created. The I2C register maps are
+    /// runtime std::map tables, so unlike the VMM layouts these tables are not built at compile
+    /// time. Registers are looked up in the std::map tables, not in a hash table.
     void calculateSizesAndPositions();
 };
 
@@ -108,10 +149,10 @@ class I2cMasterCodec {
 class I2cMasterConfig {
  protected:
     // derived classes should have their own Codec types derived from I2cMasterCodec
-    boost::property_tree::ptree m_config;
+    nsw::ConfigOverlay m_config;  // Common configuration and the values set for this I2cMaster
     std::string m_name;  // Name of I2cMaster, used in Opc Address
-    I2cMasterCodec m_codec;
-    i2c::AddressBitstreamMap m_address_bitstream;  /// Map of I2c addresses(string) and bitstreams(string)
+    const I2cMasterCodec* m_codec;  // Shared between all configs of the same register map
+    std::shared_ptr<const i2c::AddressBitstreamMap> m_address_bitstream;  /// Map of I2c addresses(string) and bitstreams, shared with identical configs (copied on write)
 
  public:
     /** \brief Constructor
@@ -122,16 +163,31 @@ class I2cMasterConfig {
      *  \param partial Switch if the config argument is a full configuration or a partial transaction
      */
     explicit I2cMasterConfig(const boost::property_tree::ptree& config, const std::string& name, const i2c::AddressRegisterMap & reg, const bool partial=false):
-        m_config(config), m_name(name), m_codec(reg), m_address_bitstream(buildConfig(config, partial)) {
+        m_config(config), m_name(name), m_codec(&I2cMasterCodec::getInstance(reg)), m_address_bitstream(buildConfig(partial)) {
+        }
+
+    /** \brief Constructor from a layered configuration
+     *  Constructs I2cMasterConfig object from a shared common configuration and the values which
+     *  differ for this I2cMaster, and builds the bitstream
+     *  \param config Configuration layers
+     *  \param name Register address space name (e.g. rocPllCoreAnalog). See I2cRegisterMappings.h
+     *  \param reg Register address map (e.g. ROC_ANALOG_REGISTERS). See I2cRegisterMappings.h
+     */
+    explicit I2cMasterConfig(nsw::ConfigOverlay config, const std::string& name, const i2c::AddressRegisterMap & reg):
+        m_config(std::move(config)), m_name(name), m_codec(&I2cMasterCodec::getInstance(reg)), m_address_bitstream(buildConfig(false)) {
         }
 
     std::string getName() const { return m_name;}
 
-    const boost::property_tree::ptree & getConfig() const {return m_config;}
+    /// Return the layered view of the configuration, valid as long as this object
+    nsw::ConfigLayers getConfigLayers() const {return m_config.getLayers();}
+
+    /// Return the configuration ptree, the layers are merged into a copy (see getConfigLayers)
+    boost::property_tree::ptree getConfig() const {return m_config.materialize();}
 
     void setName(const std::string& name) { m_name = name;}
 
-    i2c::AddressBitstreamMap getBitstreamMap() const { return m_address_bitstream;}
+    const i2c::AddressBitstreamMap& getBitstreamMap() const { return *m_address_bitstream;}
 
     /// Set value of register by changing the corresponding bits in in m_address_bitstream
     void setRegisterValue(const std::string& address, const std::string& register_name, uint32_t value);
@@ -143,40 +199,28 @@ class I2cMasterConfig {
     void decodeVector(const std::string& address, const std::vector<uint8_t>& vec) const;
 
     /// Return addresses of slaves the I2c master
-    std::vector<std::string> getAddresses() const { return m_codec.getAddresses(); }
+    std::vector<std::string> getAddresses() const { return m_codec->getAddresses(); }
 
     /// Return address positions of the I2c master
-    const i2c::AddressRegisterSizeMap& getAddressPositions() const { return m_codec.m_addr_reg_pos; }
+    const i2c::AddressRegisterSizeMap& getAddressPositions() const { return m_codec->m_addr_reg_pos; }
 
     /// Return address sizes of the I2c master
-    const i2c::AddressRegisterSizeMap& getAddressSizes() const { return m_codec.m_addr_reg_size; }
+    const i2c::AddressRegisterSizeMap& getAddressSizes() const { return m_codec->m_addr_reg_size; }
 
     /// Return total size of registers in an i2c address
-    size_t getTotalSize(const std::string& address) const { return m_codec.getTotalSize(address); }
-
-    // Following may be needed if codec is declared as unique_ptr
-    // I2cMasterConfig(const I2cMasterConfig&) = delete;
+    size_t getTotalSize(const std::string& address) const { return m_codec->getTotalSize(address); }
 
     void dump() const;
 
 protected:
     /** \brief Build the bitstream map
-     *  Calls the corresponding buildConfig function of the codec.
-     *  \param config configuration ptree
-     *  \param partialConfig Switch if the ptree represents a full configuration object ("old buildConfig")
+     *  Calls the corresponding buildConfig function of the codec. Full configurations are looked
+     *  up in the I2cImageCache (see ConfigImageCache.h) so that identical configurations share one map.
+     *  \param partialConfig Switch if m_config represents a full configuration object ("old buildConfig")
      *                       or a partial transaction
      *  \return map of register name to bitstream
      */
-    i2c::AddressBitstreamMap buildConfig(const boost::property_tree::ptree& config, const bool partialConfig) {
-      if (not partialConfig)
-      {
-        return m_codec.buildConfig(config);
-      }
-      else
-      {
-        return m_codec.buildPartialConfig(config);
-      }
-    }
+    std::shared_ptr<const i2c::AddressBitstreamMap> buildConfig(const bool partialConfig);
 };
 }  // namespace nsw
 
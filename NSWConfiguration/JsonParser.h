@@ -0,0 +1,40 @@
+#ifndef NSWCONFIGURATION_JSONPARSER_H
+#define NSWCONFIGURATION_JSONPARSER_H
+
+#include <string>
+#include <string_view>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace nsw::json {
+  /**
+   * \brief Parse a JSON document into a property tree
+   *
+   * Single pass parser building the tree directly. The resulting tree is identical to the one of
+   * boost::property_tree::read_json: all values are stored as strings (numbers as written in the
+   * document, literals as "true", "false" and "null") and array elements have empty keys. In
+   * addition to strict JSON, the configuration files may contain
+   *  - comments starting with "//" or "#" and extending to the end of the line
+   *  - trailing commas before '}' and ']'
+   *
+   * \param text JSON document
+   * \param source Name of the document used in error messages
+   * \return boost::property_tree::ptree Tree of the document
+   * \throws boost::property_tree::json_parser::json_parser_error Document is malformed
+   */
+  [[nodiscard]] boost::property_tree::ptree parse(std::string_view text,
+                                                  const std::string& source = "<unspecified file>");
+
+  /**
+   * \brief Parse a JSON file into a property tree
+   *
+   * The file is memory mapped and parsed with \ref parse.
+   *
+   * \param path Path of the file
+   * \return boost::property_tree::ptree Tree of the document
+   * \throws boost::property_tree::json_parser::json_parser_error File cannot be read or is malformed
+   */
+  [[nodiscard]] boost::property_tree::ptree readFile(const std::string& path);
+}  // namespace nsw::json
+
+#endif
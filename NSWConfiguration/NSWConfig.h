@@ -1,8 +1,10 @@
 #ifndef NSWCONFIGURATION_NSWCONFIG_H_
 #define NSWCONFIGURATION_NSWCONFIG_H_
 
+#include <chrono>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <map>
@@ -11,8 +13,12 @@
 #include "NSWConfiguration/ConfigSender.h"
 #include "NSWConfiguration/ConfigReader.h"
 #include "NSWConfiguration/OKSDeviceHierarchy.h"
+#include "NSWConfiguration/OpcRetryPolicy.h"
 #include "NSWConfiguration/Types.h"
 #include "NSWConfiguration/hw/DeviceManager.h"
+#include "NSWConfiguration/monitoring/Config.h"
+#include "NSWConfiguration/monitoring/History.h"
+#include "NSWConfiguration/monitoring/IsPublisher.h"
 #include "NSWConfiguration/monitoring/RocConfigurationRegisters.h"
 #include "NSWConfiguration/monitoring/RocStatusRegisters.h"
 #include "NSWConfiguration/monitoring/MmtpInRunStatusRegisters.h"
@@ -56,7 +62,17 @@ class NSWConfig {
         m_dbcon = nswApp->get_dbConnection();
         m_resetvmm = nswApp->get_resetVMM();
         m_resettds = nswApp->get_resetTDS();
+        m_writeChangedOnly = nswApp->get_writeChangedOnly();
         m_max_threads = nswApp->get_maxThreads();
+        m_max_threads_per_opc_server = nswApp->get_maxThreadsPerOpcServer();
+        m_opc_sessions_per_server = nswApp->get_opcSessionsPerServer();
+        m_opc_session_selection = nswApp->get_opcSessionSelection();
+        m_history.reset(nswApp->get_monitoringHistorySize());
+        nsw::OpcRetryPolicy::getDefault().setParameters(
+          {.m_maxAttempts = nswApp->get_opcMaxAttempts(),
+           .m_scaFailureThreshold = nswApp->get_opcScaFailureThreshold(),
+           .m_serverFailureThreshold = nswApp->get_opcServerFailureThreshold(),
+           .m_breakerCooldown = std::chrono::milliseconds{nswApp->get_opcBreakerCooldown()}});
         ERS_INFO("Read device hierarchy");
         auto conf = Configuration("");
         const auto jsonConfiguration = m_dbcon.find(".json") != std::string::npos;
@@ -73,7 +89,16 @@ class NSWConfig {
         ERS_INFO("DB Configuration: " << m_dbcon);
         ERS_INFO("Reset VMM: "   << m_resetvmm);
         ERS_INFO("Reset TDS: "   << m_resettds);
+        ERS_INFO("Write changed registers only: " << m_writeChangedOnly);
         ERS_INFO("max threads: " << m_max_threads);
+        ERS_INFO("max threads per OPC server: " << m_max_threads_per_opc_server);
+        ERS_INFO("OPC sessions per server: " << m_opc_sessions_per_server << " (" << m_opc_session_selection << ")");
+        ERS_INFO("Monitoring history size: " << nswApp->get_monitoringHistorySize());
+        ERS_INFO("OPC retries: " << nswApp->get_opcMaxAttempts() << " attempts, circuit breakers open after "
+                 << nswApp->get_opcScaFailureThreshold() << " (SCA) and " << nswApp->get_opcServerFailureThreshold()
+                 << " (server) failed operations for " << nswApp->get_opcBreakerCooldown() << " ms");
+        m_deviceManager.setOpcSessionPoolParameters(
+          m_opc_sessions_per_server, nsw::OpcManager::parseSessionSelection(m_opc_session_selection));
       } catch(std::exception& ex) {
           std::stringstream ss;
           ss << "Problem reading OKS configuration of NSWConfig: " << ex.what();
@@ -81,6 +106,8 @@ class NSWConfig {
           ers::fatal(issue);
       }
 
+      m_deviceManager.setConcurrency(m_max_threads, m_max_threads_per_opc_server);
+
       m_reader  = std::make_unique<nsw::ConfigReader>(m_dbcon, deviceHierarchy);
       m_sender  = std::make_unique<nsw::ConfigSender>();
       m_threads = std::make_unique<std::vector<std::future<void> > >();
@@ -139,10 +166,14 @@ class NSWConfig {
      * \brief Monitor a given group
      *
      * \param name Name of the monitoring group
-     * \param isDict IS dictionary
+     * \param publisher IS publisher
      * \param serverName Name of the IS server
+     * \param shard Part of the devices to be monitored (default: all)
      */
-    void monitor(const std::string& name, ISInfoDictionary* isDict, std::string_view serverName);
+    void monitor(const std::string& name,
+                 mon::ISPublisher& publisher,
+                 std::string_view serverName,
+                 mon::Shard shard = {});
 
     /**
      * \brief Get the fraction of devices that failed to configure
@@ -151,9 +182,19 @@ class NSWConfig {
      */
     double getFractionFailed() const { return m_deviceManager.getFractionFailed(); }
 
+    /**
+     * \brief Get the local history of the monitored values
+     *
+     * \return const mon::History& history
+     */
+    const mon::History& getHistory() const { return m_history; }
+
     hw::DeviceManager& getDeviceManager() { return m_deviceManager; }
     const hw::DeviceManager& getDeviceManager() const { return m_deviceManager; }
 private:
+    //! Environment variable holding the file in which configuration images are persisted (optional)
+    constexpr static std::string_view IMAGE_CACHE_ENV{"NSW_CONFIG_IMAGE_CACHE"};
+
     //! Count how many threads are running
     size_t active_threads();
     bool too_many_threads();
@@ -178,6 +219,7 @@ private:
     std::map<std::string, L1DDCConfig>         m_l1ddcs;      //!
 
     hw::DeviceManager m_deviceManager;
+    mon::History m_history;  //!< Local history of monitored values, outlives the monitoring groups
 
     using MonitoringVariant = std::variant<
       nsw::mon::RocStatusRegisters, nsw::mon::RocConfigurationRegisters, 
@@ -194,9 +236,16 @@ private:
     bool m_resetvmm;
     // reset the tds SER, logic, ePLL after configuration
     bool m_resettds;
+    // only write the FEB registers which changed since the last configuration
+    bool m_writeChangedOnly{false};
 
     // thread management
     size_t m_max_threads;
+    size_t m_max_threads_per_opc_server;
+
+    // OPC session pools
+    size_t m_opc_sessions_per_server;
+    std::string m_opc_session_selection;
     std::unique_ptr<std::vector<std::future<void> > > m_threads;
 
     // Run the program in simulation mode, don't send any configuration
@@ -3,10 +3,11 @@
 
 #include <memory>
 #include <string_view>
-#include <thread>
 
 #include "NSWConfiguration/CommandSender.h"
 #include "NSWConfiguration/monitoring/Config.h"
+#include "NSWConfiguration/monitoring/IsPublisher.h"
+#include "NSWConfiguration/monitoring/Scheduler.h"
 #include "NSWConfigurationDal/NSWMonitoringControllerApplication.h"
 
 #include <ipc/partition.h>
@@ -54,18 +55,19 @@ namespace nsw {
     IPCPartition m_ipcpartition;
     const nsw::dal::NSWMonitoringControllerApplication* m_app{};
     std::unique_ptr<ISInfoDictionary> m_isDictionary;
+    std::unique_ptr<nsw::mon::ISPublisher> m_isPublisher;
     std::string m_partitionName;
     std::string m_monitoringIsServerName;
     std::vector<nsw::mon::Config> m_configs;
-    std::map<std::string, std::jthread> m_threads;
+    std::unique_ptr<nsw::mon::Scheduler> m_scheduler;
 
     /**
-     * \brief Start moniotring threads for all groups
+     * \brief Start monitoring of all groups
      */
     void startMonitoringAll();
 
     /**
-     * \brief Stop moniotring threads for all groups
+     * \brief Stop monitoring of all groups
      */
     void stopMonitoringAll();
   };
@@ -3,7 +3,6 @@
 
 #include <memory>
 #include <string_view>
-#include <thread>
 
 #include <ipc/partition.h>
 #include <is/infodictionary.h>
@@ -13,6 +12,8 @@
 
 #include "NSWConfiguration/NSWConfig.h"
 #include "NSWConfiguration/monitoring/Config.h"
+#include "NSWConfiguration/monitoring/IsPublisher.h"
+#include "NSWConfiguration/monitoring/Scheduler.h"
 
 namespace daq::rc {
   class SubTransitionCmd;
@@ -57,10 +58,11 @@ namespace nsw {
     std::unique_ptr<NSWConfig> m_NSWConfig{};
     const nsw::dal::NSWOutOfRunMonitoringApplication* m_app{};
     std::unique_ptr<ISInfoDictionary> m_isDictionary{nullptr};
+    std::unique_ptr<nsw::mon::ISPublisher> m_isPublisher{nullptr};
     std::string m_partitionName;
     std::string m_monitoringIsServerName;
     std::vector<nsw::mon::Config> m_configs;
-    std::map<std::string, std::jthread> m_threads;
+    std::unique_ptr<nsw::mon::Scheduler> m_scheduler;
   };
 }  // namespace nsw
 #endif  // NSWCONFIGURATION_NSWCONFIGRC_H_
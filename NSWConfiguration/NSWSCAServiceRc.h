@@ -2,6 +2,11 @@
 #define NSWCONFIGURATION_NSWSCASERVICERC_H
 
 #include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
 
 #include <ipc/partition.h>
 #include <is/infodictionary.h>
@@ -10,6 +15,8 @@
 
 #include "NSWConfiguration/CommandSender.h"
 #include "NSWConfiguration/NSWConfig.h"
+#include "NSWConfiguration/hw/Executor.h"
+#include "NSWConfiguration/monitoring/IsPublisher.h"
 
 namespace daq::rc {
   class SubTransitionCmd;
@@ -23,6 +30,12 @@ namespace nsw {
    *
    * Recieves commands from configuration, monitoring, and sector controller. Reports OPC issues to
    * sector controller. Holds all HWIs.
+   *
+   * Transitions and user commands which change the devices are executed exclusively. MONITOR
+   * commands only read from the devices: the requests of different monitoring groups run
+   * concurrently on a bounded executor and only wait for (and block) the exclusive commands.
+   * Groups which share devices wait for each other per device (see
+   * \ref nsw::mon::internal::DeviceLocks).
    */
   class NSWSCAServiceRc : public daq::rc::Controllable
   {
@@ -53,6 +66,50 @@ namespace nsw {
     bool simulationFromIS();
 
   private:
+    /**
+     * \brief Monitor the group given in a MONITOR command
+     *
+     * A request for a group whose previous cycle is still running is dropped, the running cycle
+     * publishes the data.
+     *
+     * \param cmd MONITOR command
+     */
+    void monitor(const daq::rc::UserCmd& cmd);
+
+    /**
+     * \brief Write the local monitoring history to a binary file
+     *
+     * Arguments: file name, monitoring group, device name (empty or missing: all), window in
+     * seconds (missing: all samples). See \ref nsw::mon::History::write for the format.
+     *
+     * \param cmd DUMP_HISTORY command
+     */
+    void dumpHistory(const daq::rc::UserCmd& cmd);
+
+    /**
+     * \brief Publish that the SCA is unavailable, inform the sector controller if requested
+     *
+     * \param commandName Name of the command which detected the issue
+     */
+    void notifyScaUnavailable(std::string_view commandName);
+
+    /**
+     * \brief Lock for commands which change the devices
+     *
+     * New monitoring cycles are held back while waiting, so that transitions are not starved by
+     * overlapping monitoring cycles.
+     *
+     * \return std::unique_lock<std::shared_mutex> Exclusive lock
+     */
+    [[nodiscard]] std::unique_lock<std::shared_mutex> lockExclusive() const;
+
+    /**
+     * \brief Lock for commands which only read from the devices
+     *
+     * \return std::shared_lock<std::shared_mutex> Shared lock
+     */
+    [[nodiscard]] std::shared_lock<std::shared_mutex> lockShared() const;
+
     std::unique_ptr<NSWConfig> m_NSWConfig{};
     CommandSender m_sectorControllerSender{};
     std::string m_monitoringIsServerName{};
@@ -64,8 +121,13 @@ namespace nsw {
 
     IPCPartition m_ipcpartition;
     std::unique_ptr<ISInfoDictionary> m_isDictionary;
+    std::unique_ptr<mon::ISPublisher> m_isPublisher{};  //<! Publishes the monitoring data of m_NSWConfig
 
-    mutable std::mutex m_mutex{};  //<! Mutex for synchronization
+    mutable std::shared_mutex m_mutex{};  //<! Exclusive for transitions, shared for monitoring
+    mutable std::mutex m_turnstile{};     //<! Held by exclusive commands while waiting for m_mutex
+    std::mutex m_monitoringMutex{};       //<! Protects m_monitoringInFlight
+    std::set<std::string> m_monitoringInFlight{};  //<! Monitoring groups with a running cycle
+    std::unique_ptr<hw::Executor> m_monitoringExecutor{};  //<! Runs the monitoring cycles, destroyed first
   };
 }  // namespace nsw
 
@@ -6,13 +6,26 @@
 #include <unistd.h>
 #include <ctime>
 
+#include <array>
+#include <concepts>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <ers/ers.h>
 
+#include "NSWConfiguration/OpcRequestQueue.h"
+#include "NSWConfiguration/OpcRetryPolicy.h"
+#include "NSWConfiguration/OpcTransaction.h"
+
 // From UaoForQuasar (UaoClientForOpcUaSca/include)
 #include <ClientSessionFactory.h>
 #include <QuasarFreeVariable.h>
@@ -41,6 +54,10 @@ ERS_DECLARE_ISSUE(nsw,
                   ((std::string) message)  // Describe the problem or forward the message that comes from downstream
                   )
 
+namespace UaoClientForOpcUaSca {
+  class IoBatch;
+}
+
 namespace nsw::gpio::roc {
   enum class ROCGPIOPins {
   };
@@ -48,12 +65,30 @@ namespace nsw::gpio::roc {
 
 namespace nsw {
 
+/// Read of an I2C slave which first needs the register address to be written
+struct I2cAddressedRead {
+    std::vector<uint8_t> address;  //!< Address written to the slave without data
+    std::size_t numberOfBytes;     //!< Number of bytes read afterwards
+};
+
+/// Status variables of one SCA read by \ref OpcClient::readScaStatus
+///
+/// Values which could not be read are empty
+struct ScaStatusInfo {
+    std::optional<bool> online{};
+    std::optional<std::uint32_t> id{};
+    std::optional<std::string> address{};
+};
+
 class OpcClient {
  private:
     std::string m_server_ipport;
 
     std::unique_ptr<UaClientSdk::UaSession> m_session;
 
+    /// Executes the asynchronous requests of this session, drained before the session is closed
+    std::unique_ptr<OpcRequestQueue> m_requests;
+
     UaClientSdk::SessionSecurityInfo m_security;
     UaClientSdk::SessionConnectInfo m_sessionConnectInfo;
 
@@ -66,6 +101,95 @@ class OpcClient {
     /// Used when looping over bytes
     static constexpr std::size_t ROC_REGISTER_SIZE = 8;
 
+    /// Append the bit-banged I2C sequence reading one ROC register to an IoBatch
+    ///
+    /// The sequence samples SDA ROC_REGISTER_SIZE + 2 times, first the two acknowledge bits,
+    /// then the register bits (MSB first)
+    static void addRocRead(UaoClientForOpcUaSca::IoBatch& ioBatch, unsigned int scl, unsigned int sda,
+                           std::uint8_t registerAddress, unsigned int i2cDelay);
+
+    /// Write several GPIOs with one Write service request
+    ///
+    /// The server applies the nodes in no specified order, only independent writes are batched
+    void writeGPIOs(std::span<const OpcTransaction::Operation> operations) const;
+
+    /// Write several I2C slaves with one Call service request (one writeSlave call per operation)
+    ///
+    /// The server executes the calls of a request in order. A single write uses \ref writeI2cRaw.
+    void writeI2cs(std::span<const OpcTransaction::Operation> operations) const;
+
+    /// Read variables of many SCAs with one Read service request per chunk of SCAs
+    ///
+    /// The requests are executed as \ref probe, they are not retried.
+    ///
+    /// \param nodes SCA node IDs
+    /// \param variables Names of the variables of each SCA (e.g. "online")
+    /// \param chunkSize Maximum number of SCAs per read request
+    /// \param store Called with the index of the node, the index of the variable and the value.
+    ///        Not called for values with a bad status.
+    /// \throws OpcReadWriteIssue a read request failed or did not return one value per variable
+    void readScaVariables(std::span<const std::string> nodes,
+                          std::span<const std::string_view> variables,
+                          std::size_t chunkSize,
+                          const std::function<void(std::size_t, std::size_t, const UaVariant&)>& store) const;
+
+    /// Execute an operation with the retry policy shared by all clients
+    ///
+    /// \param node Node ID used in the error message
+    /// \param sca Name of the SCA whose circuit breaker is used, empty for operations on several SCAs
+    /// \param operation Name of the operation used in messages
+    /// \param func Operation, reports failures by throwing
+    /// \param maxAttempts Number of attempts, 0 for the default of the policy
+    /// \return Result of func
+    /// \throws OpcReadWriteIssue The last attempt failed or a circuit breaker is open
+    template<std::invocable Func>
+    std::invoke_result_t<Func> retry(const std::string& node, std::string_view sca, std::string_view operation,
+                                     Func&& func, std::size_t maxAttempts = 0) const {
+        try {
+            return OpcRetryPolicy::getDefault().execute(m_server_ipport, sca, operation,
+                                                        std::forward<Func>(func), maxAttempts);
+        } catch (const nsw::OpcReadWriteIssue& issue) {
+            ers::warning(issue);
+            throw;
+        } catch (const std::exception& ex) {
+            nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node,
+                                         std::string{operation} + " failed: " + ex.what());
+            ers::warning(issue);
+            throw issue;
+        }
+    }
+
+    /// Execute an operation on one SCA with the retry policy shared by all clients
+    ///
+    /// See \ref retry, the circuit breaker is the one of the SCA of the node
+    template<std::invocable Func>
+    std::invoke_result_t<Func> retry(const std::string& node, std::string_view operation,
+                                     Func&& func, std::size_t maxAttempts = 0) const {
+        return retry(node, OpcRetryPolicy::getScaName(node), operation, std::forward<Func>(func), maxAttempts);
+    }
+
+    /// Execute a probe of the state of SCAs (e.g. a ping) once, outside of the retry policy
+    ///
+    /// A probe has to report the current state. It is not retried, not rejected by open circuit
+    /// breakers and its failures are not counted by them.
+    ///
+    /// \param node Node ID used in the error message
+    /// \param operation Name of the operation used in messages
+    /// \param func Operation, reports failures by throwing
+    /// \return Result of func
+    /// \throws OpcReadWriteIssue The operation failed
+    template<std::invocable Func>
+    std::invoke_result_t<Func> probe(const std::string& node, std::string_view operation, Func&& func) const {
+        try {
+            return std::invoke(std::forward<Func>(func));
+        } catch (const nsw::OpcReadWriteIssue&) {
+            throw;
+        } catch (const std::exception& ex) {
+            throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node,
+                                         std::string{operation} + " failed: " + ex.what());
+        }
+    }
+
 public:
     /// Initialize Opc Platform Layer and creates a UaSession
     explicit OpcClient(const std::string& server_ip_port);
@@ -73,7 +197,11 @@ public:
 
     OpcClient(const OpcClient&) = delete;
 
-    static constexpr std::size_t MAX_RETRY  = 5;
+    /// Maximum number of asynchronous requests queued or running per session
+    static constexpr std::size_t MAX_IN_FLIGHT = 256;
+
+    /// Maximum number of SCAs served concurrently by the asynchronous requests of a session
+    static constexpr std::size_t MAX_CONCURRENT_SCAS = 8;
 
     // vector may not be the best option...
 
@@ -97,10 +225,78 @@ public:
     [[nodiscard]]
     bool readGPIO(const std::string& node) const;
 
+    /// Send all operations of a transaction
+    ///
+    /// The operations are sent with one service request per \ref OpcTransaction::getRequests
+    /// entry. Every request is retried as a whole according to the \ref OpcRetryPolicy. The
+    /// first request which still fails aborts the transaction.
+    ///
+    /// \param transaction Operations to be executed
+    /// \throws OpcReadWriteIssue An operation failed
+    void dispatch(const OpcTransaction& transaction) const;
+
+    /// Send all operations of a transaction in the background
+    ///
+    /// Same as \ref dispatch, executed by the request queue of this session like the other
+    /// asynchronous operations. The transaction is ordered with the requests to the SCA of its
+    /// first operation (all operations of a transaction address the same SCA).
+    ///
+    /// \param transaction Operations to be executed
+    /// \return future which rethrows the OpcReadWriteIssue of \ref dispatch
+    [[nodiscard]]
+    std::future<void> dispatchAsync(OpcTransaction transaction) const;
+
+    /// \name Asynchronous operations
+    ///
+    /// Same as the blocking operations, but executed by the request queue of this session. One
+    /// thread can keep many SCAs busy this way. Requests to the same SCA are executed in the order
+    /// they were submitted, requests to different SCAs by up to \ref MAX_CONCURRENT_SCAS workers.
+    /// Whether their service calls overlap on the wire depends on the session implementation,
+    /// the waiting between retries of a failing SCA does not delay the others in any case.
+    /// Submitting blocks while \ref MAX_IN_FLIGHT requests are pending. Exceptions are rethrown by
+    /// the futures. Pending requests are executed before the client is destroyed.
+    /// @{
+    [[nodiscard]]
+    std::future<void> writeI2cRawAsync(std::string node, std::vector<uint8_t> data) const;
+
+    [[nodiscard]]
+    std::future<std::vector<uint8_t>> readI2cAsync(std::string node, size_t number_of_bytes = 1) const;
+
+    [[nodiscard]]
+    std::future<void> writeSpiSlaveRawAsync(std::string node, std::vector<uint8_t> data) const;
+
+    [[nodiscard]]
+    std::future<std::vector<uint8_t>> readSpiSlaveAsync(std::string node, size_t number_of_chunks) const;
+
+    [[nodiscard]]
+    std::future<void> writeGPIOAsync(std::string node, bool value) const;
+
+    [[nodiscard]]
+    std::future<bool> readGPIOAsync(std::string node) const;
+
+    [[nodiscard]]
+    std::future<std::uint8_t> readRocRawAsync(std::string node, unsigned int scl, unsigned int sda,
+                                              std::uint8_t registerAddress, unsigned int i2cDelay) const;
+    /// @}
+
     /// Read back the I2c
     [[nodiscard]]
     std::vector<uint8_t> readI2c(const std::string& node, size_t number_of_bytes = 1) const;
 
+    /// Write addresses to an I2C slave and read back the data after each of them
+    ///
+    /// All address writes and reads are sent as method calls of one Call service request, i.e.
+    /// one round trip instead of two per read. Each read directly follows its address write, so
+    /// the server has to execute the calls of a request in order. The request is retried as a whole.
+    ///
+    /// \param node Node ID of the I2C slave
+    /// \param reads Addresses and number of bytes to be read
+    /// \return data of each read in the order of reads
+    /// \throws OpcReadWriteIssue A call failed
+    [[nodiscard]]
+    std::vector<std::vector<uint8_t>> readI2cAtAddresses(const std::string& node,
+                                                         std::span<const I2cAddressedRead> reads) const;
+
     //! Read current value of an analog output
     [[nodiscard]]
     float readAnalogInput(const std::string& node) const;
@@ -117,10 +313,50 @@ public:
     [[nodiscard]]
     std::string readScaAddress(const std::string& node) const;
 
-    // Read SCA Online Status
+    // Read SCA Online Status (executed as probe, not retried)
     [[nodiscard]]
     bool readScaOnline(const std::string& node) const;
 
+    /// Maximum number of SCAs read with one request by default
+    static constexpr std::size_t DEFAULT_READ_CHUNK_SIZE = 256;
+
+    /// Read the online status of many SCAs with one read request per chunk of SCAs
+    /// \param nodes SCA node IDs
+    /// \param chunkSize Maximum number of SCAs per read request
+    /// \return online status in the order of nodes, empty if the node could not be read
+    /// \throws OpcReadWriteIssue a read request failed
+    [[nodiscard]]
+    std::vector<std::optional<bool>> readScaOnlineMulti(std::span<const std::string> nodes,
+                                                        std::size_t chunkSize = DEFAULT_READ_CHUNK_SIZE) const;
+
+    /// Read online status, ID and address of many SCAs with one read request per chunk of SCAs
+    /// \param nodes SCA node IDs
+    /// \param chunkSize Maximum number of SCAs per read request
+    /// \return status in the order of nodes
+    /// \throws OpcReadWriteIssue a read request failed
+    [[nodiscard]]
+    std::vector<ScaStatusInfo> readScaStatus(std::span<const std::string> nodes,
+                                             std::size_t chunkSize = DEFAULT_READ_CHUNK_SIZE) const;
+
+    /// Variables of an SCA read by \ref readScaStatus, index into \ref SCA_STATUS_VARIABLES
+    enum class ScaStatusVariable : std::size_t { ONLINE, ID, ADDRESS };
+
+    /// Names of the variables read by \ref readScaStatus
+    static constexpr std::array<std::string_view, 3> SCA_STATUS_VARIABLES{"online", "id", "address"};
+
+    /// Split nodes into the chunks read with one request each
+    /// \param numNodes Number of nodes
+    /// \param chunkSize Maximum number of nodes per chunk (0 is treated as 1)
+    /// \return index of the first node and number of nodes of every chunk
+    [[nodiscard]]
+    static std::vector<std::pair<std::size_t, std::size_t>> getReadChunks(std::size_t numNodes, std::size_t chunkSize);
+
+    /// Store a variable read by \ref readScaStatus, values of the wrong type are ignored
+    /// \param info Status of the SCA
+    /// \param variable Variable which was read
+    /// \param value Value which was read
+    static void storeScaStatus(ScaStatusInfo& info, ScaStatusVariable variable, const UaVariant& value);
+
     /// Read back ROC
     /// \param node node ID in the OPC space, something such as "SCA Name.gpio.bitBanger"
     /// \param scl scl lines to use
@@ -131,19 +367,46 @@ public:
     [[nodiscard]]
     std::uint8_t readRocRaw(const std::string& node, unsigned int scl, unsigned int sda, std::uint8_t registerAddress, unsigned int i2cDelay) const;
 
+    /// Read back several ROC registers with a single IoBatch dispatch
+    /// \param node node ID in the OPC space, something such as "SCA Name.gpio.bitBanger"
+    /// \param scl scl lines to use
+    /// \param sda sda lines to use
+    /// \param registerAddresses ROC register addresses (all on the I2C bus given by scl and sda)
+    /// \param i2cDelay I2c delay value, 2 corresponds to 100kHz
+    /// \return register values in the order of registerAddresses
+    [[nodiscard]]
+    std::vector<std::uint8_t> readRocRawMulti(const std::string& node, unsigned int scl, unsigned int sda,
+                                              std::span<const std::uint8_t> registerAddresses,
+                                              unsigned int i2cDelay) const;
+
+    /// Decode the SDA samples of the reads of \ref readRocRawMulti
+    ///
+    /// Each read samples the two acknowledge bits followed by the register bits (MSB first)
+    /// \param sdaBits SDA samples of all reads
+    /// \param numRegisters Number of registers read
+    /// \return register values in the order of the reads
+    /// \throws std::out_of_range Too few samples
+    [[nodiscard]]
+    static std::vector<std::uint8_t> decodeRocReads(const std::vector<bool>& sdaBits, std::size_t numRegisters);
+
     /// Program FPGA
     /// \param bitfile_path relative or absolute path of the binary file that contains the configuration
     void writeXilinxFpga(const std::string& node, const std::string& bitfile_path) const;
 
     // Read anytype SCA OPC UA's FreeVariable
+    // Throws OpcReadWriteIssue if the read fails
     template <typename T>
     inline T readFreeVariable(const std::string& node) const {
         try {
             UaoClientForOpcUaSca::QuasarFreeVariable<T> fvnode(m_session.get(), UaNodeId(node.c_str(), 2));
-            return fvnode.read();
-        } catch (const std::exception& e) {
-            nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, e.what());
+            return retry(node, "readFreeVariable", [&fvnode]() { return fvnode.read(); });
+        } catch (const nsw::OpcReadWriteIssue&) {
+            // Already reported by retry, there is no value to return
+            throw;
+        } catch (const std::exception& ex) {
+            nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, ex.what());
             ers::warning(issue);
+            throw issue;
         }
     }
 
@@ -152,17 +415,20 @@ public:
     inline void writeFreeVariable(const std::string& node, T value) const {
         try {
             UaoClientForOpcUaSca::QuasarFreeVariable<T> fvnode(m_session.get(), UaNodeId(node.c_str(), 2));
-            fvnode.write(value);
+            retry(node, "writeFreeVariable", [&fvnode, &value]() { fvnode.write(value); });
             ERS_DEBUG(2, "Write FreeVariable: " << node.c_str() << " to " << value);
-        } catch (const std::exception& e) {
-            nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, e.what());
+        } catch (const nsw::OpcReadWriteIssue&) {
+            // Already reported by retry
+        } catch (const std::exception& ex) {
+            nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, ex.what());
             ers::warning(issue);
         }
     }
 
 };
 
-using OpcClientPtr = const OpcClient*;
+/// Keeps the client alive while it is used
+using OpcClientPtr = std::shared_ptr<const OpcClient>;
 
 }  // namespace nsw
 
@@ -0,0 +1,112 @@
+#ifndef NSWCONFIGURATION_OPCREQUESTQUEUE_H
+#define NSWCONFIGURATION_OPCREQUESTQUEUE_H
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace nsw {
+  /**
+   * \brief Bounded queue of requests executed on behalf of one OPC session
+   *
+   * Every request carries a key (the SCA it talks to). Requests with the same key are executed
+   * one after the other in the order they were submitted, requests with different keys are
+   * executed concurrently by up to \ref getMaxWorkers worker threads. Workers are started when
+   * requests of more keys are pending than workers exist. The number of requests queued or
+   * running is limited, \ref submit blocks until a slot is free. This throttles callers which
+   * submit faster than the session can serve.
+   */
+  class OpcRequestQueue
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param maxInFlight Maximum number of requests queued or running (at least 1)
+     * \param maxWorkers Maximum number of keys served concurrently (at least 1)
+     */
+    OpcRequestQueue(std::size_t maxInFlight, std::size_t maxWorkers);
+
+    /**
+     * \brief Destructor
+     *
+     * Executes all requests that were already submitted and stops the workers
+     */
+    ~OpcRequestQueue();
+    OpcRequestQueue(const OpcRequestQueue&) = delete;
+    OpcRequestQueue(OpcRequestQueue&&) = delete;
+    OpcRequestQueue& operator=(const OpcRequestQueue&) = delete;
+    OpcRequestQueue& operator=(OpcRequestQueue&&) = delete;
+
+    /**
+     * \brief Submit a request
+     *
+     * Blocks while the maximum number of requests is in flight. Exceptions thrown by the request
+     * are transported through the returned future.
+     *
+     * \param key Requests with the same key are executed in submission order, never concurrently
+     * \param func Request to be executed
+     * \return std::future holding the result of func
+     */
+    template<std::invocable Func>
+    [[nodiscard]] std::future<std::invoke_result_t<Func>> submit(std::string_view key, Func&& func)
+    {
+      using Result = std::invoke_result_t<Func>;
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+      auto future = task->get_future();
+      post(key, [task = std::move(task)]() { (*task)(); });
+      return future;
+    }
+
+    /**
+     * \brief Get the maximum number of requests in flight
+     */
+    [[nodiscard]] std::size_t getMaxInFlight() const { return m_maxInFlight; }
+
+    /**
+     * \brief Get the maximum number of keys served concurrently
+     */
+    [[nodiscard]] std::size_t getMaxWorkers() const { return m_maxWorkers; }
+
+  private:
+    using Request = std::function<void()>;
+
+    /**
+     * \brief Wait for a free slot, queue the request and start a worker if needed
+     *
+     * \param key Key of the request
+     * \param request Request to be executed
+     */
+    void post(std::string_view key, Request request);
+
+    /**
+     * \brief Main loop of a worker thread
+     *
+     * \param stopToken Token to request to stop the worker once no requests are left
+     */
+    void run(std::stop_token stopToken);
+
+    std::size_t m_maxInFlight;                  //!< Maximum number of requests queued or running
+    std::size_t m_maxWorkers;                   //!< Maximum number of worker threads
+    std::mutex m_mutex{};                       //!< Protects the members below
+    std::condition_variable_any m_condition{};  //!< Signals new requests and free slots
+    std::map<std::string, std::deque<Request>, std::less<>> m_requests{};  //!< Pending requests per key
+    std::deque<std::string> m_ready{};          //!< Keys with pending requests which are not being served
+    std::size_t m_numInFlight{0};               //!< Requests queued or running
+    std::vector<std::jthread> m_workers{};      //!< Worker threads, started on demand
+  };
+}  // namespace nsw
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef NSWCONFIGURATION_OPCRETRYPOLICY_H
+#define NSWCONFIGURATION_OPCRETRYPOLICY_H
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <ers/Issue.h>
+
+ERS_DECLARE_ISSUE(nsw,
+                  OpcCircuitOpenIssue,
+                  "Circuit breaker of " << target << " is open after " << failures
+                  << " consecutive failures, request rejected",
+                  ((std::string) target)
+                  ((std::size_t) failures)
+                  )
+
+namespace nsw {
+  /**
+   * \brief Parameters of the \ref OpcRetryPolicy
+   */
+  struct OpcRetryParameters {
+    std::size_t m_maxAttempts{5};                         //!< Attempts per operation (including the first)
+    std::chrono::milliseconds m_initialBackoff{20};       //!< Wait before the first retry
+    std::chrono::milliseconds m_maxBackoff{1000};         //!< Upper limit of the wait between two attempts
+    double m_backoffMultiplier{2.};                       //!< Growth of the wait per attempt
+    double m_jitter{0.5};                                 //!< Fraction of the wait which is randomized
+    std::size_t m_scaFailureThreshold{10};                //!< Consecutive failed operations opening the breaker of an SCA
+    std::size_t m_serverFailureThreshold{50};             //!< Consecutive failed operations opening the breaker of a server
+    std::chrono::milliseconds m_breakerCooldown{5000};    //!< Time an open breaker rejects requests
+  };
+
+  /**
+   * \brief Counters of the operations executed by an \ref OpcRetryPolicy
+   */
+  struct OpcRetryStatistics {
+    std::uint64_t m_operations{0};                   //!< Operations executed
+    std::uint64_t m_retries{0};                      //!< Attempts after the first one
+    std::uint64_t m_failures{0};                     //!< Operations failing after all attempts
+    std::uint64_t m_rejections{0};                   //!< Attempts rejected by an open circuit breaker
+    std::chrono::microseconds m_totalLatency{0};     //!< Sum of the latencies of all operations
+    std::chrono::microseconds m_maxLatency{0};       //!< Largest latency of a single operation
+
+    /**
+     * \brief Human readable representation
+     *
+     * \return std::string e.g. "1000 operations, 12 retries, 1 failures, 0 rejections, mean latency 2.1 ms, max latency 1520.3 ms"
+     */
+    [[nodiscard]] std::string toString() const;
+  };
+
+  /**
+   * \brief Retry, backoff and circuit breaker policy shared by all OPC operations
+   *
+   * A failed operation is retried with an exponential backoff with jitter, so that the SCAs of a
+   * server which failed at the same time do not retry in lockstep. A circuit breaker per SCA and
+   * per server counts consecutive operations which failed after all their attempts. Once the
+   * threshold is reached, the breaker opens and requests are rejected immediately for a cooldown
+   * period instead of stalling the caller with retries. After the cooldown a single trial request
+   * is let through without retries, its outcome closes or reopens the breaker. An optional deadline (see \ref ScopedDeadline) limits the time spent in
+   * retries during a state transition: after the deadline failed operations are not retried
+   * anymore, but new operations are still attempted once.
+   *
+   * All members except \ref setParameters are thread safe. All OPC clients of a process share
+   * \ref getDefault so that the breakers see the failures of all sessions to a server.
+   */
+  class OpcRetryPolicy
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * \brief Constructor
+     *
+     * \param parameters Parameters of the policy
+     */
+    explicit OpcRetryPolicy(OpcRetryParameters parameters = {});
+
+    /**
+     * \brief Get the policy used by all OpcClients
+     */
+    [[nodiscard]] static OpcRetryPolicy& getDefault();
+
+    /**
+     * \brief Get the name of the SCA of a node ("SCA.i2c.register" -> "SCA")
+     */
+    [[nodiscard]] static std::string_view getScaName(std::string_view node);
+
+    /**
+     * \brief Execute an operation and retry it according to the policy
+     *
+     * \param server OPC server ("ip:port"), key of the server breaker
+     * \param sca Name of the SCA, key of the SCA breaker together with the server (empty if the
+     *            operation targets several SCAs)
+     * \param operation Name of the operation used in log messages
+     * \param func Operation, failures are reported by throwing an exception
+     * \param maxAttempts Number of attempts, 0 to use the default of the policy
+     * \return Result of func
+     * \throws OpcCircuitOpenIssue The breaker of the SCA or the server is open
+     * \throws The exception of the last attempt
+     */
+    template<std::invocable Func>
+    std::invoke_result_t<Func> execute(const std::string& server,
+                                       std::string_view sca,
+                                       std::string_view operation,
+                                       Func&& func,
+                                       std::size_t maxAttempts = 0);
+
+    /**
+     * \brief Set the time after which failed operations are not retried anymore
+     *
+     * \param deadline Deadline, empty to retry without time limit
+     */
+    void setDeadline(std::optional<Clock::time_point> deadline);
+
+    /**
+     * \brief Get the current deadline
+     */
+    [[nodiscard]] std::optional<Clock::time_point> getDeadline() const;
+
+    /**
+     * \brief Get the wait before an attempt
+     *
+     * \param attempt Number of the failed attempt (starting at 1)
+     * \return Clock::duration Backoff including jitter
+     */
+    [[nodiscard]] Clock::duration getBackoff(std::size_t attempt) const;
+
+    /**
+     * \brief Get the counters accumulated since the last reset
+     */
+    [[nodiscard]] OpcRetryStatistics getStatistics() const;
+
+    /**
+     * \brief Reset the counters
+     */
+    void resetStatistics();
+
+    /**
+     * \brief Close all circuit breakers
+     */
+    void resetBreakers();
+
+    /**
+     * \brief Change the parameters of the policy and close all circuit breakers
+     *
+     * Must not be called while operations are executed.
+     *
+     * \param parameters Parameters of the policy
+     */
+    void setParameters(OpcRetryParameters parameters);
+
+    /**
+     * \brief Get the parameters of the policy
+     */
+    [[nodiscard]] const OpcRetryParameters& getParameters() const { return m_parameters; }
+
+    /**
+     * \brief Limits the retries of a policy for the lifetime of the object
+     *
+     * Used to give a state transition a time budget. The previous deadline is restored on
+     * destruction.
+     */
+    class ScopedDeadline
+    {
+    public:
+      /**
+       * \brief Constructor
+       *
+       * \param policy Policy whose retries are limited
+       * \param budget Time from now after which failed operations are not retried
+       */
+      ScopedDeadline(OpcRetryPolicy& policy, Clock::duration budget);
+      ~ScopedDeadline();
+      ScopedDeadline(const ScopedDeadline&) = delete;
+      ScopedDeadline(ScopedDeadline&&) = delete;
+      ScopedDeadline& operator=(const ScopedDeadline&) = delete;
+      ScopedDeadline& operator=(ScopedDeadline&&) = delete;
+
+    private:
+      OpcRetryPolicy& m_policy;
+      std::optional<Clock::time_point> m_previous;
+    };
+
+  private:
+    /**
+     * \brief Consecutive failures of one SCA or server
+     */
+    struct Breaker {
+      std::size_t m_consecutiveFailures{0};
+      bool m_open{false};
+      Clock::time_point m_openUntil{};  //!< End of the cooldown (or of the trial request) of an open breaker
+    };
+
+    /**
+     * \brief Check the breakers of the SCA and the server
+     *
+     * An open breaker whose cooldown is over lets one trial request through. A rejected request
+     * counts as failed operation.
+     *
+     * \throws OpcCircuitOpenIssue A breaker is open
+     */
+    void checkBreakers(const std::string& server, std::string_view sca, Clock::time_point start);
+
+    /**
+     * \brief Close the breakers and record the latency of a successful operation
+     */
+    void onSuccess(const std::string& server, std::string_view sca, std::size_t attempt, Clock::time_point start);
+
+    /**
+     * \brief Decide if a failed attempt is retried and wait for the next one
+     *
+     * Only an operation which is not retried anymore counts as failure of the breakers.
+     *
+     * \return true if the operation should be retried
+     */
+    bool onFailure(const std::string& server,
+                   std::string_view sca,
+                   std::string_view operation,
+                   std::size_t attempt,
+                   std::size_t maxAttempts,
+                   Clock::time_point start,
+                   const std::exception& exception);
+
+    /**
+     * \brief Check if the breaker of the SCA or the server is open (the request is a trial)
+     */
+    [[nodiscard]] bool isTrial(const std::string& server, std::string_view sca) const;
+
+    /**
+     * \brief Get the breaker of an SCA, created if needed
+     *
+     * SCA names are only unique per server. Must be called with \ref m_mutex locked.
+     */
+    [[nodiscard]] Breaker& getScaBreaker(const std::string& server, std::string_view sca);
+
+    /**
+     * \brief Count a failed operation in the breakers of the SCA and the server
+     */
+    void recordFailedOperation(const std::string& server, std::string_view sca, Clock::time_point now);
+
+    /**
+     * \brief Count a failure, opens the breaker at the threshold
+     */
+    void recordFailure(Breaker& breaker, std::size_t threshold, std::string_view target, Clock::time_point now) const;
+
+    /**
+     * \brief Count a finished operation and record its latency
+     */
+    void recordLatency(Clock::time_point start);
+
+    OpcRetryParameters m_parameters;
+    mutable std::mutex m_mutex{};                        //!< Protects the breakers
+    std::map<std::string, std::map<std::string, Breaker, std::less<>>, std::less<>> m_scaBreakers{};  //!< Per server and SCA
+    std::map<std::string, Breaker, std::less<>> m_serverBreakers{};
+    std::atomic<Clock::rep> m_deadline{0};               //!< Ticks since the epoch of the clock, 0 if unset
+    std::atomic<std::uint64_t> m_operations{0};
+    std::atomic<std::uint64_t> m_retries{0};
+    std::atomic<std::uint64_t> m_failures{0};
+    std::atomic<std::uint64_t> m_rejections{0};
+    std::atomic<std::int64_t> m_totalLatency{0};         //!< Microseconds
+    std::atomic<std::int64_t> m_maxLatency{0};           //!< Microseconds
+  };
+}  // namespace nsw
+
+template<std::invocable Func>
+std::invoke_result_t<Func> nsw::OpcRetryPolicy::execute(const std::string& server,
+                                                        const std::string_view sca,
+                                                        const std::string_view operation,
+                                                        Func&& func,
+                                                        const std::size_t maxAttempts)
+{
+  const auto start = Clock::now();
+  const auto attempts = maxAttempts == 0 ? m_parameters.m_maxAttempts : maxAttempts;
+  for (std::size_t attempt = 1;; ++attempt) {
+    checkBreakers(server, sca, start);
+    try {
+      if constexpr (std::is_void_v<std::invoke_result_t<Func>>) {
+        func();
+        onSuccess(server, sca, attempt, start);
+        return;
+      } else {
+        auto result = func();
+        onSuccess(server, sca, attempt, start);
+        return result;
+      }
+    } catch (const std::exception& ex) {
+      if (not onFailure(server, sca, operation, attempt, attempts, start, ex)) {
+        throw;
+      }
+    }
+  }
+}
+
+#endif
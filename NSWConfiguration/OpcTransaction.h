@@ -0,0 +1,81 @@
+#ifndef NSWCONFIGURATION_OPCTRANSACTION_H_
+#define NSWCONFIGURATION_OPCTRANSACTION_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nsw {
+
+/// Queue of writes to the nodes of one SCA which are sent together by \ref OpcClient::dispatch
+///
+/// Operations are executed in the order they were added. Consecutive I2C writes are merged into
+/// one Call service request. The server applies the nodes of a Write service request in no
+/// specified order, so GPIO writes are sent one by one unless they were added as independent
+/// (see \ref getRequests).
+class OpcTransaction {
+ public:
+    enum class Type { I2C, SPI, GPIO };
+
+    /// Single write operation
+    struct Operation {
+        Type type;
+        std::string node;
+        std::vector<uint8_t> data{};  //!< Payload of I2C and SPI writes
+        bool value{false};            //!< Value of GPIO writes
+        bool independent{false};      //!< GPIO write which may be applied in any order with its neighbours
+    };
+
+    /// Queue a write to an I2C slave
+    OpcTransaction& addI2cWrite(std::string node, std::vector<uint8_t> data) {
+        m_operations.push_back({Type::I2C, std::move(node), std::move(data)});
+        return *this;
+    }
+
+    /// Queue a write to an SPI slave
+    OpcTransaction& addSpiWrite(std::string node, std::vector<uint8_t> data) {
+        m_operations.push_back({Type::SPI, std::move(node), std::move(data)});
+        return *this;
+    }
+
+    /// Queue a write to a GPIO which is sent after all previous operations
+    OpcTransaction& addGpioWrite(std::string node, bool value) {
+        m_operations.push_back({Type::GPIO, std::move(node), {}, value});
+        return *this;
+    }
+
+    /// Queue a write to a GPIO whose order relative to neighbouring independent GPIO writes does
+    /// not matter, it may be sent in the same Write service request as them
+    OpcTransaction& addIndependentGpioWrite(std::string node, bool value) {
+        m_operations.push_back({Type::GPIO, std::move(node), {}, value, true});
+        return *this;
+    }
+
+    [[nodiscard]]
+    const std::vector<Operation>& getOperations() const { return m_operations; }
+
+    [[nodiscard]]
+    bool empty() const { return m_operations.empty(); }
+
+    [[nodiscard]]
+    std::size_t size() const { return m_operations.size(); }
+
+    /// Split the operations into the service requests sent by \ref OpcClient::dispatch
+    ///
+    /// A request holds either a single GPIO write, or consecutive independent writes to different
+    /// GPIOs (a GPIO written twice starts a new request to keep the order of the two writes), or
+    /// consecutive I2C writes, or a single SPI write.
+    ///
+    /// \return operations of each request in the order of the operations
+    [[nodiscard]]
+    std::vector<std::span<const Operation>> getRequests() const;
+
+ private:
+    std::vector<Operation> m_operations;
+};
+
+}  // namespace nsw
+
+#endif  // NSWCONFIGURATION_OPCTRANSACTION_H_
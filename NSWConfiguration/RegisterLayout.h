@@ -0,0 +1,145 @@
+#ifndef NSWCONFIGURATION_REGISTERLAYOUT_H
+#define NSWCONFIGURATION_REGISTERLAYOUT_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "NSWConfiguration/Constants.h"
+
+namespace nsw {
+  /**
+   * \brief Position of a register (field) in a bitstream
+   */
+  struct FieldLayout {
+    std::string_view m_name{};  //!< Name of the register
+    std::size_t m_offset{};     //!< Position of the first bit in the bitstream
+    std::size_t m_width{};      //!< Number of bits
+    bool m_reversed{false};     //!< Bits are stored LSB first
+  };
+
+  /**
+   * \brief FNV-1a hash of a register name
+   *
+   * \param name Name of the register
+   * \return std::uint32_t Hash
+   */
+  constexpr std::uint32_t hashRegisterName(const std::string_view name)
+  {
+    constexpr std::uint32_t OFFSET_BASIS{2166136261U};
+    constexpr std::uint32_t PRIME{16777619U};
+    auto hash = OFFSET_BASIS;
+    for (const auto character : name) {
+      hash = (hash ^ static_cast<std::uint8_t>(character)) * PRIME;
+    }
+    return hash;
+  }
+
+  /**
+   * \brief Compile-time layout of the registers of a bitstream
+   *
+   * Built from an ordered list of {register name, size in bits}. Offsets, widths and reversal
+   * flags are computed when the layout is constructed at compile time. Lookup by name uses an
+   * ordinary hash table with linear probing (not a perfect hash), at most half full, so a lookup
+   * probes only a few slots on average. Fields called \ref NOT_USED occupy bits
+   * but cannot be looked up.
+   *
+   * \tparam N Number of fields
+   */
+  template<std::size_t N>
+  class RegisterLayout
+  {
+  public:
+    using NameSize = std::pair<std::string_view, std::size_t>;
+
+    /**
+     * \brief Constructor
+     *
+     * Fails to compile if a register name appears twice
+     *
+     * \param fields Registers in the order they appear in the bitstream
+     * \param reversed Names of the registers whose bits are reversed in the bitstream
+     */
+    consteval RegisterLayout(const std::array<NameSize, N>& fields,
+                             std::span<const std::string_view> reversed = {})
+    {
+      std::size_t offset{0};
+      for (std::size_t index = 0; index < N; ++index) {
+        const auto& [name, width] = fields[index];
+        const auto isReversed = std::find(std::begin(reversed), std::end(reversed), name) != std::end(reversed);
+        m_fields[index] = FieldLayout{name, offset, width, isReversed};
+        offset += width;
+      }
+      m_totalWidth = offset;
+
+      m_slots.fill(EMPTY);
+      for (std::size_t index = 0; index < N; ++index) {
+        const auto name = m_fields[index].m_name;
+        if (name == NOT_USED) {
+          continue;
+        }
+        auto slot = hashRegisterName(name) & (TABLE_SIZE - 1);
+        while (m_slots[slot] != EMPTY) {
+          if (m_fields[m_slots[slot]].m_name == name) {
+            throw "Duplicated register name in register layout";
+          }
+          slot = (slot + 1) & (TABLE_SIZE - 1);
+        }
+        m_slots[slot] = index;
+      }
+    }
+
+    /**
+     * \brief Find a register by name
+     *
+     * \param name Name of the register
+     * \return const FieldLayout* Layout of the register, nullptr if it does not exist
+     */
+    [[nodiscard]] constexpr const FieldLayout* find(const std::string_view name) const
+    {
+      // The table is never full, so the probing ends at an empty slot
+      for (auto slot = hashRegisterName(name) & (TABLE_SIZE - 1); m_slots[slot] != EMPTY;
+           slot = (slot + 1) & (TABLE_SIZE - 1)) {
+        if (m_fields[m_slots[slot]].m_name == name) {
+          return &m_fields[m_slots[slot]];
+        }
+      }
+      return nullptr;
+    }
+
+    /**
+     * \brief Check if a register exists
+     *
+     * \param name Name of the register
+     */
+    [[nodiscard]] constexpr bool contains(const std::string_view name) const
+    {
+      return find(name) != nullptr;
+    }
+
+    /**
+     * \brief Get the total number of bits of all fields
+     */
+    [[nodiscard]] constexpr std::size_t getTotalWidth() const { return m_totalWidth; }
+
+    /**
+     * \brief Get all fields in bitstream order
+     */
+    [[nodiscard]] constexpr const std::array<FieldLayout, N>& getFields() const { return m_fields; }
+
+  private:
+    static constexpr std::size_t TABLE_SIZE{std::bit_ceil(2 * N)};
+    static constexpr std::size_t EMPTY{N};
+
+    std::array<FieldLayout, N> m_fields{};          //!< Fields in bitstream order
+    std::array<std::size_t, TABLE_SIZE> m_slots{};  //!< Index of the field per hash slot
+    std::size_t m_totalWidth{0};                    //!< Sum of all widths
+  };
+}  // namespace nsw
+
+#endif
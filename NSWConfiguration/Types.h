@@ -15,6 +15,9 @@
 #include <utility>
 
 #include <boost/property_tree/ptree.hpp>
+
+#include "NSWConfiguration/BitVector.h"
+
 namespace i2c {
     using RegisterSizePair = std::pair<std::string_view, std::size_t>;
 
@@ -26,7 +29,7 @@ namespace i2c {
 
     using AddressRegisterSizeMap = std::map<std::string, AddressSizeMap>;
 
-    using AddressBitstreamMap = std::map<std::string, std::string>;
+    using AddressBitstreamMap = std::map<std::string, nsw::BitVector>;
 }  // namespace i2c
 
 namespace gbtx {
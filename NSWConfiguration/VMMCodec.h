@@ -10,7 +10,10 @@
 #include <string>
 #include <utility>
 
+#include "NSWConfiguration/BitVector.h"
+#include "NSWConfiguration/ConfigOverlay.h"
 #include "NSWConfiguration/Constants.h"
+#include "NSWConfiguration/RegisterLayout.h"
 
 #include <boost/property_tree/ptree_fwd.hpp>
 
@@ -39,21 +42,33 @@ class VMMCodec {
     static constexpr size_t NBITS_GLOBAL = 32 * 3;  /// Size of globals registers
     static constexpr size_t NBITS_CHANNEL = 24 * NCHANNELS;  /// Size of channel registers
     static constexpr size_t NBITS_TOTAL = NBITS_CHANNEL + 2*NBITS_GLOBAL;  /// total number of bits
+    static constexpr unsigned ENCODER_VERSION = 1;  /// Increment when the encoding changes but the layouts do not
 
-    static std::string buildConfig(const boost::property_tree::ptree& config);
+    static nsw::BitVector buildConfig(const boost::property_tree::ptree& config);
+
+    /// Encode a layered configuration without merging the layers
+    static nsw::BitVector buildConfig(const nsw::ConfigLayers& config);
+
+    /// Return a short identifier of the register layout and ENCODER_VERSION, changes whenever the encoding changes
+    static const std::string& getLayoutKey();
 
     static bool globalRegisterExists(std::string_view register_name);
     static bool channelRegisterExists(std::string_view register_name);
 
     /// Creates a vector for each channel register, such that element ["channel_sd"][4] is sd value for 4th channel
-    static std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> buildChannelRegisterMap(boost::property_tree::ptree config);
+    static std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> buildChannelRegisterMap(const boost::property_tree::ptree& config);
+
+    /// \overload An overridden channel register replaces the common one for all channels
+    static std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> buildChannelRegisterMap(const nsw::ConfigLayers& config);
 
  private:
-    static std::string buildGlobalConfig(const boost::property_tree::ptree& config, GlobalRegisters type);
+    /// Write the global registers of one type into the bitstream starting at start
+    static void encodeGlobalConfig(const nsw::ConfigLayers& config, GlobalRegisters type,
+                                   nsw::BitVector& bits, std::size_t start);
 
-    static std::string buildGlobalConfig0(const boost::property_tree::ptree& config);
-    static std::string buildGlobalConfig1(const boost::property_tree::ptree& config);
-    static std::string buildChannelConfig(const boost::property_tree::ptree& config);
+    /// Write the channel registers of all channels into the bitstream starting at start
+    static void encodeChannelConfig(const nsw::ConfigLayers& config,
+                                    nsw::BitVector& bits, std::size_t start);
 
     // void checkOverflow(size_t register_size, unsigned value, const std::string& register_name);
 
@@ -131,6 +146,18 @@ class VMMCodec {
     /// it will be put in bitstream as 11000 (instead of 00011)
     constexpr static std::array<std::string_view, NUM_REVERSED_REGS>
       m_bitreversed_registers{"sm", "st", "sg", "sdt_dac", "sdp_dac"};
+
+    /// Layouts with precomputed offsets, widths and reversal flags, and O(1) lookup by name
+    constexpr static RegisterLayout<NUM_GLOBAL_REGS_SIZE0> m_global_layout0{m_global_name_size0, m_bitreversed_registers};
+    constexpr static RegisterLayout<NUM_GLOBAL_REGS_SIZE1> m_global_layout1{m_global_name_size1, m_bitreversed_registers};
+    constexpr static RegisterLayout<NUM_CHANNEL_REGS> m_channel_layout{m_channel_name_size};
+
+    /// Size of the registers of one channel
+    constexpr static std::size_t NBITS_PER_CHANNEL = NBITS_CHANNEL / NCHANNELS;
+
+    static_assert(m_global_layout0.getTotalWidth() == NBITS_GLOBAL);
+    static_assert(m_global_layout1.getTotalWidth() == NBITS_GLOBAL);
+    static_assert(m_channel_layout.getTotalWidth() == NBITS_PER_CHANNEL);
 };
 }  // namespace nsw
 
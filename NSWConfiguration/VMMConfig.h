@@ -3,9 +3,11 @@
 #ifndef NSWCONFIGURATION_VMMCONFIG_H_
 #define NSWCONFIGURATION_VMMCONFIG_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "NSWConfiguration/ConfigOverlay.h"
 #include "NSWConfiguration/Constants.h"
 #include <boost/property_tree/ptree.hpp>
 
@@ -35,17 +37,22 @@ namespace nsw {
 
 class VMMConfig {
  private:
-    std::string m_bitstring;  // Config information as a string of 0/1s
+    std::shared_ptr<const nsw::BitVector> m_bitstream;  // Config information as packed bits, shared with identical configs
     std::string name;         // Name of the element (vmm0,vmm1,vmm2 ...)
-    boost::property_tree::ptree m_config;
+    nsw::ConfigOverlay m_config;  // Common configuration and the registers set for this VMM
 
  public:
     explicit VMMConfig(const boost::property_tree::ptree& vmmconfig);
+
+    /// Construct from a shared common configuration and the registers which differ for this VMM
+    explicit VMMConfig(nsw::ConfigOverlay vmmconfig);
     ~VMMConfig() = default;
 
     std::vector<uint8_t> getByteVector() const;  /// Create a vector of bytes
 
-    std::string getBitString() const {return m_bitstring;}  /// return the string of bits
+    const nsw::BitVector& getBitVector() const {return *m_bitstream;}  /// return the packed bits
+
+    std::string getBitString() const {return m_bitstream->toString();}  /// return the string of bits
 
     void setName(std::string str) {name = std::move(str);}
     std::string getName() const {return name;}
@@ -64,6 +71,10 @@ class VMMConfig {
     void setMonitorOutput   (std::uint32_t channel_id, std::uint32_t param);
     void setChannelTrimmer  (std::uint32_t channel_id, std::uint32_t param);
     void setChannelMOMode   (std::uint32_t channel_id, std::uint32_t param);
+
+ private:
+    /// Rebuild the bitstream after a register changed. Tweaked images are not added to the VmmImageCache
+    void rebuildBitstream();
 };
 
 namespace vmm {
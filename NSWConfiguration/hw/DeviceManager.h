@@ -1,15 +1,25 @@
 #ifndef NSWCONFIGURATION_HW_DEVICEMANAGER
 #define NSWCONFIGURATION_HW_DEVICEMANAGER
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <concepts>
 #include <span>
 
+#include "NSWConfiguration/ADDCConfig.h"
 #include "NSWConfiguration/Concepts.h"
 #include "NSWConfiguration/Issues.h"
+#include "NSWConfiguration/hw/Executor.h"
 #include "NSWConfiguration/hw/OpcManager.h"
 #include "NSWConfiguration/hw/FEB.h"
 #include "NSWConfiguration/hw/ADDC.h"
@@ -35,6 +45,9 @@ namespace nsw::hw {
      */
     explicit DeviceManager(bool multithreaded = true);
 
+    constexpr static std::size_t DEFAULT_MAX_CONCURRENT_PER_OPC_SERVER{32};  //!< Default jobs per OPC server
+    constexpr static std::chrono::seconds CONFIGURE_RETRY_BUDGET{120};       //!< Time in which failed OPC operations are retried during configure
+
     /**
      * \brief Options for configuring devices
      *
@@ -42,11 +55,15 @@ namespace nsw::hw {
     enum class Options {
       RESET_VMM,
       RESET_TDS,
-      DISABLE_VMM_CAPTURE_INPUTS
+      DISABLE_VMM_CAPTURE_INPUTS,
+      WRITE_CHANGED_ONLY  //!< Only write the registers of FEBs which changed since their last configuration
     };
     /**
      * \brief Add a config to the manager
      *
+     * The config of a FEB which was already added replaces the previous one (see
+     * \ref FEB::setConfiguration).
+     *
      * \param config config ptree
      */
     void add(const boost::property_tree::ptree& config)
@@ -60,11 +77,11 @@ namespace nsw::hw {
         }
       }();
       const auto type = nsw::getElementType(config.get<std::string>(std::string{OPC_NODE_ID_KEY}));
-      if (type == "MMFE8" or type == "SFEB6" or type == "SFEB8" or type == "PFEB" or type == "SFEB") {
+      if (isFebType(type)) {
         addFeb(FEBConfig{config});
       }
       else if (type == "ADDC") {
-        addAddc(config);
+        addAddc(ADDCConfig{config});
       }
       else if (type == "MMTP") {
         addMMTp(config);
@@ -86,6 +103,31 @@ namespace nsw::hw {
       }
     }
 
+    /**
+     * \brief Check if an element type (see \ref nsw::getElementType) is a front end board
+     *
+     * \param type element type
+     * \return true if the element is added as \ref FEB
+     */
+    [[nodiscard]] static bool isFebType(const std::string_view type)
+    {
+      return type == "MMFE8" or type == "SFEB6" or type == "SFEB8" or type == "PFEB" or type == "SFEB";
+    }
+
+    /**
+     * \brief Add a FEB whose configuration was already parsed
+     *
+     * \param config config object
+     */
+    void add(const nsw::FEBConfig& config) { addFeb(config); }
+
+    /**
+     * \brief Add an ADDC whose configuration was already parsed
+     *
+     * \param config config object
+     */
+    void add(const nsw::ADDCConfig& config) { addAddc(config); }
+
     /**
      * \brief Add a span of configs of one type to the manager
      *
@@ -106,6 +148,10 @@ namespace nsw::hw {
     /**
      * \brief Configure all devices
      *
+     * Device types are configured concurrently unless one depends on the other (see
+     * \ref TaskGraph). The critical path is reported at the end. Failed OPC operations are
+     * retried for at most \ref CONFIGURE_RETRY_BUDGET, the retry statistics are reported at the end.
+     *
      * \param options A set of options to be applied
      */
     void configure(std::span<const Options> options = {});
@@ -132,11 +178,15 @@ namespace nsw::hw {
 
     /**
      * \brief Enable VMM capture inputs of all ROCs
+     *
+     * The writes of all ROCs are queued on the OPC sessions at once (see \ref applyFuncAsync)
      */
     void enableVmmCaptureInputs();
 
     /**
      * \brief Disable VMM capture inputs of all ROCs
+     *
+     * The writes of all ROCs are queued on the OPC sessions at once (see \ref applyFuncAsync)
      */
     void disableVmmCaptureInputs();
 
@@ -212,15 +262,28 @@ namespace nsw::hw {
     const std::vector<FEB>& getFebs() const { return m_febs; }  //!< overload
 
     /**
-     * \brief Clear all managed devices and OPC connections
+     * \brief Clear all managed devices and close the OPC connections
+     *
+     * Used at unconfigure. The FEBs are kept aside with the images written to them: a FEB which
+     * is added again by the next configuration reuses them, so that \ref Options::WRITE_CHANGED_ONLY
+     * only writes what changed. FEBs which are not added again are dropped by the next clear.
+     * Closing the connections does not invalidate the images (see \ref OpcManager::close), a
+     * power cycle of a FEB in between is not detected.
      */
     void clear();
 
     /**
      * \brief Clear all OPC connections
+     *
+     * Used to recover from failing connections, the images written to the devices are forgotten
      */
     void clearOpc();
 
+    /**
+     * \brief Get the number of FEBs kept by \ref clear which were not added again yet
+     */
+    [[nodiscard]] std::size_t getNumKeptFebs() const { return std::size(m_keptFebs); }
+
     /**
      * \brief Set the command sender to the RC application
      *
@@ -228,6 +291,43 @@ namespace nsw::hw {
      */
     void setCommandSender(nsw::CommandSender&& sender) { m_opcManager.setCommandSender(std::move(sender)); }
 
+    /**
+     * \brief Set the size of the thread pool and the number of devices per OPC server handled in parallel
+     *
+     * The thread pool is created on first use and replaced if it exists with a different size.
+     * If the size is not set (or set to 0), it is derived from the devices, see
+     * \ref getNumThreads. The limit per OPC server holds for all device types together. Must not
+     * be called while devices are being configured. Has no effect if the manager is not
+     * multithreaded.
+     *
+     * \param numThreads Number of threads shared by all OPC servers (0: derived from the devices)
+     * \param maxConcurrentPerOpcServer Maximum number of devices of one OPC server handled at the same time
+     */
+    void setConcurrency(std::size_t numThreads, std::size_t maxConcurrentPerOpcServer);
+
+    /**
+     * \brief Get the size of the thread pool
+     *
+     * The threads mostly wait for OPC replies, and at most \ref DEFAULT_MAX_CONCURRENT_PER_OPC_SERVER
+     * (or the value set by \ref setConcurrency) devices per OPC server are handled at the same
+     * time. Unless set explicitly, the pool therefore has this number of threads for every OPC
+     * server of the managed devices: more threads could only wait for a free slot of their server.
+     *
+     * \return std::size_t Number of threads
+     */
+    [[nodiscard]] std::size_t getNumThreads() const;
+
+    /**
+     * \brief Configure the pools of OPC sessions shared by the devices of one server
+     *
+     * \see nsw::OpcManager::setSessionPoolParameters
+     */
+    void setOpcSessionPoolParameters(const std::size_t sessionsPerServer,
+                                     const nsw::OpcManager::SessionSelection selection)
+    {
+      m_opcManager.setSessionPoolParameters(sessionsPerServer, selection);
+    }
+
     /**
      * \brief Get the fraction of devices that failed to configure
      *
@@ -242,8 +342,13 @@ namespace nsw::hw {
 
   private:
     bool m_multithreaded{};
+    KeyedSemaphore m_opcServerSlots{DEFAULT_MAX_CONCURRENT_PER_OPC_SERVER};  //!< Devices handled per OPC server
+    std::size_t m_numThreads{0};  //!< Size of the thread pool (0: derived from the devices)
+    mutable std::mutex m_executorMutex{};  //!< Protects the lazy creation of m_executor and m_numThreads
+    std::unique_ptr<Executor> m_executor{};
     nsw::OpcManager m_opcManager{};
     std::vector<FEB> m_febs{};
+    std::vector<FEB> m_keptFebs{};  //!< FEBs of the previous configuration, see \ref clear
     std::vector<ADDC> m_addcs{};
     std::vector<MMTP> m_mmtps{};
     std::vector<STGCTP> m_stgctps{};
@@ -253,6 +358,16 @@ namespace nsw::hw {
     std::atomic<int> m_configurationErrorCounter{};
     std::atomic<int> m_configurationTotalCounter{};
 
+    /**
+     * \brief Get the thread pool, created on first use
+     *
+     * Replaced if the devices changed such that the derived size changed. Devices must not be
+     * added while they are being handled anyway.
+     *
+     * \return Executor& thread pool with \ref getNumThreads threads
+     */
+    Executor& getExecutor();
+
     /**
      * \brief Add ROC, TDSs, and VMMs from FEBConfig object
      *
@@ -265,7 +380,7 @@ namespace nsw::hw {
      *
      * \param config config object
      */
-    void addAddc(const boost::property_tree::ptree& config);
+    void addAddc(const nsw::ADDCConfig& config);
 
     /**
      * \brief Add MMTP from ptree object
@@ -319,9 +434,57 @@ namespace nsw::hw {
       return true;
     }
 
+    /**
+     * \brief Start an asynchronous operation on a range of devices and handle exceptions
+     *
+     * The operations of all devices are queued from the calling thread on the OPC sessions of the
+     * devices, which serve different SCAs concurrently (see \ref OpcClient::dispatchAsync). No
+     * executor job is needed per device. In single-threaded mode every operation is waited for
+     * before the next one is started. Errors are handled as in \ref applyFunc.
+     *
+     * \param devices Range of devices
+     * \param func Function starting the operation, returns a std::future<void>
+     * \param exceptionHandler Function to handle exceptions
+     */
+    template<std::ranges::range Range>
+    void applyFuncAsync(const Range& devices,
+                        const std::regular_invocable<typename Range::value_type> auto& func,
+                        const std::regular_invocable<std::exception> auto& exceptionHandler)
+    {
+      m_configurationTotalCounter += static_cast<int>(std::size(devices));
+      std::vector<std::future<void>> results{};
+      results.reserve(std::size(devices));
+      const auto wait = [&results](const std::size_t index) { results.at(index).get(); };
+      for (const auto& device : devices) {
+        // A device whose operation could not be started keeps an invalid future
+        results.emplace_back();
+        const auto started = checkSuccess(
+          device, [&results, &func](const auto& dev) { results.back() = func(dev); }, exceptionHandler);
+        if (not started) {
+          ++m_configurationErrorCounter;
+        } else if (not m_multithreaded and not checkSuccess(std::size(results) - 1, wait, exceptionHandler)) {
+          ++m_configurationErrorCounter;
+        }
+      }
+      if (not m_multithreaded) {
+        return;
+      }
+      for (std::size_t index = 0; index < std::size(results); ++index) {
+        if (results.at(index).valid() and not checkSuccess(index, wait, exceptionHandler)) {
+          ++m_configurationErrorCounter;
+        }
+      }
+    }
+
     /**
      * \brief Apply a function to a range of devices and handle exceptions
      *
+     * In multithreaded mode the devices are grouped by OPC server. For every server at most
+     * as many jobs as the server has slots in \ref m_opcServerSlots are submitted. Each job keeps
+     * taking the next device of its server until all devices of the server are done. A device is
+     * only handled while holding a slot of its server. The slots are shared by all calls, so
+     * device types handled concurrently (see \ref configure) respect the limit together.
+     *
      * \param devices Range of devices
      * \param func Function to be applied
      * \param exceptionHandler Function to handle exceptions
@@ -333,22 +496,39 @@ namespace nsw::hw {
     {
       m_configurationTotalCounter += static_cast<int>(std::size(devices));
       if (m_multithreaded) {
-        std::vector<std::future<bool>> threads{};
-        threads.reserve(devices.size());
+        struct ServerQueue {
+          std::vector<const typename Range::value_type*> m_devices{};
+          std::atomic<std::size_t> m_next{0};
+        };
+        std::map<std::string, ServerQueue> queues{};
         for (const auto& device : devices) {
-          threads.push_back(std::async(
-            std::launch::async,
-            [&func, &exceptionHandler](const auto& deviceLocal) {
-              return checkSuccess(deviceLocal, func, exceptionHandler);
-            },
-            device));
+          queues[device.getOpcServerIp()].m_devices.push_back(&device);
         }
-        for (auto& thread : threads) {
-          const auto success = thread.get();
-          if (not success) {
-            ++m_configurationErrorCounter;
+        std::vector<std::future<void>> jobs{};
+        auto& executor = getExecutor();
+        for (auto& entry : queues) {
+          auto& queue = entry.second;
+          const auto numJobs = std::min(m_opcServerSlots.getMaxPerKey(), std::size(queue.m_devices));
+          for (std::size_t counter = 0; counter < numJobs; ++counter) {
+            jobs.push_back(executor.submit([this, &server = entry.first, &queue, &func, &exceptionHandler]() {
+              for (auto index = queue.m_next++; index < std::size(queue.m_devices);
+                   index = queue.m_next++) {
+                const auto slot = m_opcServerSlots.acquire(server);
+                const auto success = checkSuccess(*queue.m_devices[index], func, exceptionHandler);
+                if (not success) {
+                  ++m_configurationErrorCounter;
+                }
+              }
+            }));
           }
         }
+        // All jobs reference the queues, wait for all of them before anything can throw
+        for (const auto& job : jobs) {
+          job.wait();
+        }
+        for (auto& job : jobs) {
+          job.get();
+        }
       } else {
         for (const auto& device : devices) {
           const auto success = checkSuccess(device, func, exceptionHandler);
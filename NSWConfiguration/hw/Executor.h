@@ -0,0 +1,240 @@
+#ifndef NSWCONFIGURATION_HW_EXECUTOR_H
+#define NSWCONFIGURATION_HW_EXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nsw::hw {
+  /**
+   * \brief Persistent, bounded thread pool with work stealing
+   *
+   * Every worker owns a queue. Jobs submitted from outside the pool are distributed round-robin
+   * over the queues, jobs submitted from a worker go to its own queue. A worker first takes the
+   * newest job of its own queue and steals the oldest job of another queue when its own queue is
+   * empty. The number of threads is fixed at construction, so the cost of creating threads is paid
+   * once and not per job.
+   */
+  class Executor
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * Starts the worker threads
+     *
+     * \param numThreads Number of worker threads (at least one thread is started)
+     */
+    explicit Executor(std::size_t numThreads);
+
+    /**
+     * \brief Destructor
+     *
+     * Stops the workers after they finished all jobs that were already submitted
+     */
+    ~Executor();
+    Executor(const Executor&) = delete;
+    Executor(Executor&&) = delete;
+    Executor& operator=(const Executor&) = delete;
+    Executor& operator=(Executor&&) = delete;
+
+    /**
+     * \brief Submit a job to the pool
+     *
+     * Exceptions thrown by the job are transported through the returned future.
+     *
+     * \param func Function to be executed
+     * \return std::future holding the result of func
+     */
+    template<std::invocable Func>
+    [[nodiscard]] std::future<std::invoke_result_t<Func>> submit(Func&& func)
+    {
+      using Result = std::invoke_result_t<Func>;
+      auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+      auto future = task->get_future();
+      post([task = std::move(task)]() { (*task)(); });
+      return future;
+    }
+
+    /**
+     * \brief Get the number of worker threads
+     *
+     * \return std::size_t number of threads
+     */
+    [[nodiscard]] std::size_t getNumThreads() const { return std::size(m_workers); }
+
+  private:
+    using Job = std::function<void()>;
+
+    /**
+     * \brief Queue of jobs owned by one worker
+     */
+    struct WorkQueue {
+      std::mutex m_mutex{};
+      std::deque<Job> m_jobs{};
+    };
+
+    /**
+     * \brief Put a job into a queue and wake up a worker
+     *
+     * \param job Job to be executed
+     */
+    void post(Job job);
+
+    /**
+     * \brief Main loop of a worker thread
+     *
+     * \param stopToken Token to request to stop the worker
+     * \param index Index of the queue owned by the worker
+     */
+    void run(std::stop_token stopToken, std::size_t index);
+
+    /**
+     * \brief Take a job from the own queue or steal one from another queue
+     *
+     * \param index Index of the queue owned by the worker
+     * \return std::optional<Job> Job if one was found
+     */
+    std::optional<Job> tryPop(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues{};  //!< One queue per worker
+    std::atomic<std::size_t> m_nextQueue{0};             //!< Round-robin counter for external jobs
+    std::mutex m_mutex{};                                //!< Protects m_numPending
+    std::condition_variable_any m_condition{};           //!< Signals new jobs to idle workers
+    std::size_t m_numPending{0};                         //!< Jobs that are queued but not yet taken
+    std::vector<std::jthread> m_workers{};               //!< Worker threads
+  };
+
+  /**
+   * \brief Limits the number of jobs running at the same time per key (e.g. per OPC server)
+   *
+   * The limit holds for all callers sharing the object, also if they submit their jobs
+   * independently of each other (e.g. device types configured concurrently).
+   */
+  class KeyedSemaphore
+  {
+  public:
+    /**
+     * \brief Permission to run one job, released on destruction
+     */
+    class Slot
+    {
+    public:
+      Slot(KeyedSemaphore& semaphore, std::size_t& numAcquired) :
+        m_semaphore{&semaphore}, m_numAcquired{&numAcquired}
+      {}
+      ~Slot();
+      Slot(const Slot&) = delete;
+      Slot(Slot&& other) noexcept :
+        m_semaphore{std::exchange(other.m_semaphore, nullptr)}, m_numAcquired{other.m_numAcquired}
+      {}
+      Slot& operator=(const Slot&) = delete;
+      Slot& operator=(Slot&&) = delete;
+
+    private:
+      KeyedSemaphore* m_semaphore;
+      std::size_t* m_numAcquired;
+    };
+
+    /**
+     * \brief Constructor
+     *
+     * \param maxPerKey Maximum number of slots acquired at the same time per key (at least 1)
+     */
+    explicit KeyedSemaphore(std::size_t maxPerKey) : m_maxPerKey{std::max(maxPerKey, std::size_t{1})} {}
+
+    /**
+     * \brief Acquire a slot of a key, waits until one is free
+     *
+     * \param key Key (e.g. OPC server)
+     * \return Slot Released on destruction
+     */
+    [[nodiscard]] Slot acquire(std::string_view key);
+
+    /**
+     * \brief Change the maximum number of slots acquired at the same time per key
+     *
+     * Slots already acquired are kept
+     *
+     * \param maxPerKey Maximum number of slots per key (at least 1)
+     */
+    void setMaxPerKey(std::size_t maxPerKey);
+
+    /**
+     * \brief Get the maximum number of slots acquired at the same time per key
+     */
+    [[nodiscard]] std::size_t getMaxPerKey() const;
+
+  private:
+    /**
+     * \brief Return a slot
+     *
+     * \param numAcquired Counter of the key of the slot
+     */
+    void release(std::size_t& numAcquired);
+
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::size_t m_maxPerKey;
+    std::map<std::string, std::size_t, std::less<>> m_numAcquired{};  //!< Slots acquired per key
+  };
+
+  /**
+   * \brief Process inputs in parallel and consume the results in the order of the inputs
+   *
+   * Runs func for every input on the executor. The results are consumed on the calling thread in
+   * the order of the inputs, so that the outcome and the order of the error reports do not depend
+   * on the scheduling.
+   *
+   * \param executor Executor running func
+   * \param inputs Inputs (random access range)
+   * \param func Function computing the result of one input
+   * \param consume Called with an input and its result
+   * \param onError Called with an input and the exception thrown by func or consume
+   */
+  template<typename Inputs, typename Func, typename Consume, typename OnError>
+  void transformInOrder(Executor& executor, const Inputs& inputs, Func func, Consume consume, OnError onError)
+  {
+    using Result = std::invoke_result_t<Func&, decltype(inputs[0])>;
+    std::vector<std::future<Result>> results{};
+    results.reserve(std::size(inputs));
+    for (const auto& input : inputs) {
+      results.push_back(executor.submit([&func, &input]() { return func(input); }));
+    }
+    try {
+      for (std::size_t index = 0; index < std::size(inputs); ++index) {
+        try {
+          consume(inputs[index], results[index].get());
+        } catch (const std::exception& ex) {
+          onError(inputs[index], ex);
+        }
+      }
+    } catch (...) {
+      // The remaining jobs still refer to the inputs and to func
+      for (auto& result : results) {
+        if (result.valid()) {
+          result.wait();
+        }
+      }
+      throw;
+    }
+  }
+}  // namespace nsw::hw
+
+#endif
@@ -33,6 +33,13 @@ namespace nsw::hw {
     [[nodiscard]] ROC& getRoc() { return m_roc; }
     [[nodiscard]] const ROC& getRoc() const { return m_roc; }  //!< \overload
 
+    /**
+     * \brief Get the IP of the OPC server the FEB is connected to
+     *
+     * \return std::string IP address of OPC server
+     */
+    [[nodiscard]] std::string getOpcServerIp() const { return m_roc.getOpcServerIp(); }
+
     /**
      * \brief Get the \ref VMM object specified by `id`
      *
@@ -92,14 +99,41 @@ namespace nsw::hw {
      */
     [[nodiscard]] bool isSFEB6() const { return getNumVmms() == nsw::NUM_VMM_PER_SFEB - nsw::SFEB6_FIRST_VMM; }
 
+    /**
+     * \brief Replace the configuration of all devices of the FEB
+     *
+     * The images written by previous configurations are kept, so that the next
+     * \ref writeConfiguration only sends the difference.
+     *
+     * \param config New configuration of the same FEB
+     * \throws std::invalid_argument The configuration belongs to another FEB or has a different number of VMMs or TDSs
+     */
+    void setConfiguration(const nsw::FEBConfig& config);
+
+    /**
+     * \brief Check if the images of a previous configuration of all devices are known
+     *
+     * \return true if \ref writeConfiguration can send only the changed registers
+     */
+    [[nodiscard]] bool hasWrittenConfiguration() const;
+
     /**
      * \brief Configure a FEB
      *
+     * By default the full configuration is written. If requested, the FEB was configured before
+     * (with the current OPC connections) and no reset is requested, only the ROC and TDS
+     * registers and the VMMs whose configuration changed since are written (see
+     * \ref ROC::writeChangedConfiguration).
+     *
      * \param resetVmm Reset VMMs
      * \param resetTds Reset TDSs
      * \param disableVmmCaptureInputs Disable VMM capture inputs after configuring ROC (THEY STAY DISABLED) 
+     * \param writeChangedOnly Only write what changed since the last configuration if possible
      */
-    void writeConfiguration(bool resetVmm = false, bool resetTds = false, bool disableVmmCaptureInputs = false) const;
+    void writeConfiguration(bool resetVmm = false,
+                            bool resetTds = false,
+                            bool disableVmmCaptureInputs = false,
+                            bool writeChangedOnly = false) const;
   private:
     ROC m_roc;                //!< ROC assiociated to this FEB
     std::vector<VMM> m_vmms;  //!< VMMs assiociated to this FEB
@@ -0,0 +1,103 @@
+#ifndef NSWCONFIGURATION_HW_I2CREADPLAN_H
+#define NSWCONFIGURATION_HW_I2CREADPLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nsw::hw {
+  /**
+   * \brief One 32 bit register to be read through an addressed I2C slave
+   */
+  struct RegisterRead {
+    std::uint32_t m_address;            //!< Register address
+    std::uint32_t m_mask{0xffffffff};   //!< Mask applied to the value
+  };
+
+  /**
+   * \brief Layout of the registers of an I2C slave which is read by writing the register address
+   *        followed by reading the data (e.g. SCAX and pad trigger FPGA)
+   */
+  struct I2cRegisterLayout {
+    std::size_t m_addressSize;        //!< Number of bytes of the register address
+    bool m_littleEndian;              //!< Byte order of address and data
+    std::size_t m_maxBurstRegisters;  //!< Registers read with one address write, 1 if the firmware does not auto-increment
+  };
+
+  /**
+   * \brief Compiled list of register reads of one device
+   *
+   * Registers which are requested several times (e.g. with different masks) are read once.
+   * If the firmware auto-increments the register address, consecutive registers are read with
+   * one address write followed by one read of all of their bytes (a burst), limited to
+   * \ref MAX_BURST_BYTES per read. The plan is independent of the device and can be compiled
+   * once per monitoring group.
+   */
+  class I2cReadPlan
+  {
+  public:
+    constexpr static std::size_t REGISTER_SIZE{4};     //!< Bytes per register
+    constexpr static std::size_t MAX_BURST_BYTES{16};  //!< Maximum length of a multi-byte I2C read of the SCA
+
+    /**
+     * \brief Address write and data read
+     */
+    struct Burst {
+      std::uint32_t m_firstAddress;      //!< Address of the first register
+      std::size_t m_numRegisters;        //!< Number of consecutive registers
+      std::vector<std::uint8_t> m_address{};  //!< Encoded address written to the slave
+    };
+
+    /**
+     * \brief Compile the reads
+     *
+     * \param registers Registers in the order the values are returned by \ref decode
+     * \param layout Register layout of the slave
+     */
+    I2cReadPlan(std::span<const RegisterRead> registers, const I2cRegisterLayout& layout);
+
+    /**
+     * \brief Get the address writes and data reads to be executed
+     */
+    [[nodiscard]] const std::vector<Burst>& getBursts() const { return m_bursts; }
+
+    /**
+     * \brief Get the number of bytes to be read for a burst
+     *
+     * \param burst Burst of this plan
+     * \return std::size_t Number of bytes
+     */
+    [[nodiscard]] static std::size_t getNumBytes(const Burst& burst) { return burst.m_numRegisters * REGISTER_SIZE; }
+
+    /**
+     * \brief Decode the data of all bursts
+     *
+     * \param replies Data read for each burst (in the order of \ref getBursts)
+     * \return std::vector<std::uint32_t> Masked value of each requested register (in the order of the constructor)
+     * \throws std::invalid_argument Number or size of the replies does not match the plan
+     */
+    [[nodiscard]] std::vector<std::uint32_t> decode(std::span<const std::vector<std::uint8_t>> replies) const;
+
+    /**
+     * \brief Get the requested registers
+     */
+    [[nodiscard]] const std::vector<RegisterRead>& getRegisters() const { return m_registers; }
+
+  private:
+    /**
+     * \brief Position of a requested register in the replies
+     */
+    struct Location {
+      std::size_t m_burst;
+      std::size_t m_offset;  //!< Index of the register in the burst
+    };
+
+    std::vector<RegisterRead> m_registers;
+    bool m_littleEndian;
+    std::vector<Burst> m_bursts{};
+    std::vector<Location> m_locations{};
+  };
+}  // namespace nsw::hw
+
+#endif
@@ -11,6 +11,7 @@
 #include <ers/Issue.h>
 
 #include "NSWConfiguration/TPConstants.h"
+#include "NSWConfiguration/hw/I2cReadPlan.h"
 #include "NSWConfiguration/hw/ScaAddressBase.h"
 #include "NSWConfiguration/hw/OpcConnectionBase.h"
 #include "NSWConfiguration/hw/OpcManager.h"
@@ -87,6 +88,15 @@ namespace nsw::hw {
     [[nodiscard]]
     std::uint32_t readRegister(std::uint32_t regAddress) const;
 
+    /**
+     * \brief Read several MMTP registers with one request
+     *
+     * \param plan compiled register reads (see \ref SCAX::REGISTER_LAYOUT)
+     * \return values in the order of the registers of the plan
+     */
+    [[nodiscard]]
+    std::vector<std::uint32_t> readRegisters(const I2cReadPlan& plan) const;
+
     /**
      * \brief Write a value to a MMTP register address, and read it back
      *
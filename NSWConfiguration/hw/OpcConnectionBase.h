@@ -1,6 +1,11 @@
 #ifndef NSWCONFIGURATION_HW_OPCCONNECTIONBASE_H
 #define NSWCONFIGURATION_HW_OPCCONNECTIONBASE_H
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
 #include "NSWConfiguration/OpcClient.h"
 #include "NSWConfiguration/hw/OpcManager.h"
 #include "NSWConfiguration/hw/ScaStatus.h"
@@ -21,6 +26,13 @@ namespace nsw::hw {
      */
     OpcConnectionBase(nsw::OpcManager& manager, std::string opcServerIp, std::string scaAddress);
 
+    /// The cached connection is shared with the copy
+    OpcConnectionBase(const OpcConnectionBase& other);
+    OpcConnectionBase(OpcConnectionBase&& other) noexcept;
+    OpcConnectionBase& operator=(const OpcConnectionBase& other);
+    OpcConnectionBase& operator=(OpcConnectionBase&& other) noexcept;
+    ~OpcConnectionBase() = default;
+
     /**
      * \brief Try to ping the device
      *
@@ -35,7 +47,6 @@ namespace nsw::hw {
      */
     [[nodiscard]] bool reachable() const;
 
-  protected:
     /**
      * \brief Get the Opc Server IP
      *
@@ -43,20 +54,43 @@ namespace nsw::hw {
      */
     [[nodiscard]] std::string getOpcServerIp() const { return m_opcServerIp; }
 
+  protected:
     /**
      * \brief Get a connection to the OPC server
      *
+     * The connection is resolved by the OpcManager once and cached. Later calls only compare the
+     * generation of the cached handle with the one of the manager and do not lock the manager.
+     * The returned pointer shares the ownership of the handle, so the session stays open while it
+     * is used even if the manager drops its connections meanwhile.
+     *
+     * Loading the cached handle is not lock-free: libstdc++ implements
+     * std::atomic<std::shared_ptr> with a lock owned by the atomic (is_lock_free() is false). The
+     * lock is per device and only held to copy the pointer. Uncontended, a load takes about as
+     * long as copying a shared_ptr under a std::mutex (~40 ns). What is saved is the manager-wide
+     * mutex and its map lookups, which all devices contended for.
+     *
      * \return OpcClientPtr Pointer to connection
      */
-    [[nodiscard]] OpcClientPtr getConnection() const
-    {
-      return m_opcManager.get().getConnection(m_opcServerIp, m_scaAddress);
-    }
+    [[nodiscard]] OpcClientPtr getConnection() const;
+
+    /**
+     * \brief Get the generation of the state of the devices of the OpcManager
+     *
+     * Changes whenever the devices may have lost their state (connections dropped for recovery,
+     * restart after a lost server), but not when the connections are closed at unconfigure.
+     * Anything cached about the state of the hardware cannot be trusted across a change.
+     *
+     * \return std::uint64_t Generation
+     */
+    [[nodiscard]] std::uint64_t getOpcGeneration() const { return m_opcManager.get().getDeviceGeneration(); }
 
   private:
+    using ConnectionHandlePtr = std::shared_ptr<const nsw::OpcManager::ConnectionHandle>;
+
     std::string m_scaAddress;                                      //!< SCA address
     std::string m_opcServerIp;                                     //!< OPC server IP address
     mutable std::reference_wrapper<nsw::OpcManager> m_opcManager;  //!< Pointer to OpcManager
+    mutable std::atomic<ConnectionHandlePtr> m_connection{};       //!< Cached connection (not lock-free)
   };
 }  // namespace nsw::hw
 
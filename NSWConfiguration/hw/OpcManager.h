@@ -1,17 +1,24 @@
 #ifndef NSWCONFIGURATION_HW_OPCMANAGER_H
 #define NSWCONFIGURATION_HW_OPCMANAGER_H
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <future>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include <ers/ers.h>
 
 #include "NSWConfiguration/OpcClient.h"
 #include "NSWConfiguration/CommandSender.h"
 #include "NSWConfiguration/hw/ScaStatus.h"
+#include "NSWConfiguration/hw/SessionLeases.h"
 
 ERS_DECLARE_ISSUE(nsw,
                   OpcManagerPingFrequency,
@@ -30,25 +37,187 @@ namespace nsw {
       std::string port{};
       std::string name{};
     };
-    using ConnectionMap = std::map<std::string, std::map<std::string, std::unique_ptr<OpcClient>>>;
+
+  public:
     using PingStatusMap = std::map<std::string, hw::ScaStatus::ScaStatus>;
 
+    /**
+     * \brief Session leased by a device and latest ping result of the device
+     *
+     * The status is written by the ping thread and read without holding the mutex.
+     */
+    struct Lease {
+      std::size_t session{};                                                //!< Index of the session
+      std::atomic<hw::ScaStatus::ScaStatus> status{hw::ScaStatus::REACHABLE};  //!< Latest ping result
+    };
+
+    /**
+     * \brief Device to be pinged (copied from the connection table)
+     */
+    struct PingTarget {
+      std::string name{};
+      std::shared_ptr<const OpcClient> session{};
+      std::shared_ptr<Lease> lease{};
+    };
+
+    /**
+     * \brief Function pinging devices sharing one session (signature of \ref testConnections)
+     */
+    using PingFunction = std::function<PingStatusMap(const std::vector<std::string>&, const OpcClient*)>;
+
+  private:
+    /**
+     * \brief Pool of OPC sessions to one server shared by all devices of that server
+     *
+     * Sessions and leases are reference counted such that a ping sweep working on a snapshot keeps
+     * them alive if the pool is reset in the meantime.
+     */
+    struct SessionPool {
+      std::vector<std::shared_ptr<OpcClient>> sessions{};       //!< Open sessions
+      hw::SessionLeases sessionLeases{};                        //!< Number of devices using each session
+      std::map<std::string, std::shared_ptr<Lease>> leases{};   //!< Lease of each device
+    };
+
+    using ConnectionMap = std::map<std::string, SessionPool>;
+
   public:
+    /**
+     * \brief Resolved connection of a device
+     *
+     * Keeps the session and the lease of the device alive. Stamped with the generation of the
+     * connection table it was resolved from. Once the generation of the manager changes (clear or
+     * restart of an OPC server) the handle is stale and has to be resolved again.
+     */
+    class ConnectionHandle
+    {
+    public:
+      /**
+       * \brief Get the OPC client
+       */
+      [[nodiscard]] OpcClientPtr get() const { return m_session; }
+
+      /**
+       * \brief Get the generation of the connection table the handle was resolved from
+       */
+      [[nodiscard]] std::uint64_t getGeneration() const { return m_generation; }
+
+    private:
+      friend class OpcManager;
+      ConnectionHandle(Identifier identifier,
+                       std::shared_ptr<const OpcClient> session,
+                       std::shared_ptr<const Lease> lease,
+                       std::uint64_t generation);
+
+      Identifier m_identifier;                      //!< Server and device name
+      std::shared_ptr<const OpcClient> m_session;   //!< Leased session
+      std::shared_ptr<const Lease> m_lease;         //!< Lease holding the ping status
+      std::uint64_t m_generation;                   //!< Generation of the connection table
+    };
+
+    using SessionSelection = hw::SessionSelection;
+
+    constexpr static std::size_t DEFAULT_SESSIONS_PER_SERVER{8};  //!< Default size of a session pool
+
+    /**
+     * \brief Parse the name of a session selection strategy
+     *
+     * \param name "RoundRobin" or "LeastLoaded"
+     * \return SessionSelection strategy
+     * \throws std::invalid_argument unknown name
+     */
+    static SessionSelection parseSessionSelection(std::string_view name);
+
+    /**
+     * \brief Opens a session to an OPC server
+     */
+    using SessionFactory = std::function<std::shared_ptr<OpcClient>(const std::string& ipPort)>;
+
     /**
      * @brief Constructor
      *
      * Start the background thread for pinging
+     *
+     * \param openSession Opens the sessions of the pools (replaced by tests)
      */
-    OpcManager();
+    explicit OpcManager(SessionFactory openSession = openOpcSession);
 
     /**
      * \brief Get a pointer containing the OPC client
      *
+     * The first request of a device leases a session from the pool of the server. The device keeps
+     * this session until the connections are cleared. New sessions are opened until the pool holds
+     * \ref m_sessionsPerServer sessions, afterwards existing sessions are shared.
+     *
+     * \param ipPort IP and port of the OPC server
      * \param deviceName Name of the device
-     * \return OpcClientPtr Object containing a pointer to the OPC client
+     * \return OpcClientPtr Pointer keeping the OPC client alive
      */
     OpcClientPtr getConnection(const std::string& ipPort, const std::string& deviceName);
 
+    /**
+     * \brief Resolve the connection of a device into a handle that can be cached
+     *
+     * Same as \ref getConnection but the returned handle keeps the session alive. Callers cache
+     * the handle and call this function again only if \ref getGeneration changed.
+     *
+     * \param ipPort IP and port of the OPC server
+     * \param deviceName Name of the device
+     * \return ConnectionHandle Handle stamped with the current generation
+     */
+    ConnectionHandle getConnectionHandle(const std::string& ipPort, const std::string& deviceName);
+
+    /**
+     * \brief Get the generation of the connection table
+     *
+     * Incremented whenever existing connections are dropped. Does not lock.
+     *
+     * \return std::uint64_t Generation
+     */
+    [[nodiscard]] std::uint64_t getGeneration() const
+    {
+      return m_generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * \brief Get the generation of the state of the devices
+     *
+     * Incremented whenever the devices may have lost their state: the connections were dropped
+     * by \ref clear or a server restarted. Not incremented by \ref close. Does not lock.
+     *
+     * \return std::uint64_t Generation
+     */
+    [[nodiscard]] std::uint64_t getDeviceGeneration() const
+    {
+      return m_deviceGeneration.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Issue a message if the device of a connection is listed as bad
+     *
+     * Reads the status published by the ping thread without locking.
+     *
+     * @param handle Connection of the device
+     */
+    static void warnBadConnection(const ConnectionHandle& handle);
+
+    /**
+     * \brief Configure the session pools
+     *
+     * Only affects devices that did not lease a session yet.
+     *
+     * \param sessionsPerServer Maximum number of sessions opened to one server
+     * \param selection Strategy to choose the session of a device
+     */
+    void setSessionPoolParameters(std::size_t sessionsPerServer, SessionSelection selection);
+
+    /**
+     * \brief Get the number of open sessions to a server
+     *
+     * \param ipPort IP and port of the OPC server
+     * \return std::size_t Number of sessions
+     */
+    [[nodiscard]] std::size_t getNumSessions(const std::string& ipPort) const;
+
     /**
      * \brief Destroy the OPC Manager object
      *
@@ -61,10 +230,20 @@ namespace nsw {
     OpcManager& operator=(const OpcManager&) = delete;
 
     /**
-     * \brief Close all connections
+     * \brief Close all connections and close the circuit breakers of the retry policy
+     *
+     * Used to recover from failing connections, the state of the devices is considered unknown
+     * afterwards (see \ref getDeviceGeneration)
      */
     void clear();
 
+    /**
+     * \brief Close all connections and close the circuit breakers of the retry policy
+     *
+     * Same as \ref clear, but the devices are assumed to keep their state (e.g. at unconfigure)
+     */
+    void close();
+
     /**
      * \brief Set the command sender to the RC application
      *
@@ -80,22 +259,76 @@ namespace nsw {
      */
     static hw::ScaStatus::ScaStatus testConnection(const std::string& name, const OpcClient* connection);
 
+    /**
+     * \brief Ping many devices of one server with a single read request
+     *
+     * \param names Names of the devices
+     * \param connection OPC client to the server of the devices
+     * \return PingStatusMap Result per device
+     */
+    static PingStatusMap testConnections(const std::vector<std::string>& names, const OpcClient* connection);
+
+    /**
+     * \brief Ping the devices of all servers, one task per server
+     *
+     * Devices sharing a session are pinged with a single call of the ping function. The result of
+     * every device is published in its lease.
+     *
+     * \param targets Devices to be pinged per server
+     * \param ping Function pinging the devices of one session
+     * \return std::map<std::string, PingStatusMap> Result per device per server
+     */
+    static std::map<std::string, PingStatusMap> pingServers(
+      const std::map<std::string, std::vector<PingTarget>>& targets,
+      const PingFunction& ping = &testConnections);
+
+    /**
+     * \brief Update the table of bad devices of one server with the result of a ping
+     *
+     * Adds new devices with issues, removes devices which recovered, and updates the status of
+     * the others.
+     *
+     * \param badConnections Bad devices of the server and their status
+     * \param result Result of the ping of all devices of the server
+     * \return true All devices report that the server is offline
+     */
+    static bool updateBadConnections(PingStatusMap& badConnections, const PingStatusMap& result);
+
   private:
     /**
      * \brief Ping all connections to keep them open
      *
-     * Executes a loop to ping them every \ref PING_INTERVAL seconds
+     * Executes a loop to ping them every \ref PING_INTERVAL seconds. The connection table is only
+     * locked to take a snapshot and to analyze the results, the servers are pinged in parallel
+     * without holding the lock.
      *
      * \param stopToken Token to request to stop background thread
      */
     void pingConnections(std::stop_token stopToken);
 
+    /**
+     * \brief Copy the devices and their sessions of all servers
+     *
+     * \return std::map<std::string, std::vector<PingTarget>> Devices to be pinged per server
+     */
+    std::map<std::string, std::vector<PingTarget>> snapshotConnections() const;
+
+    /**
+     * \brief Ping all devices of one server and publish the result in their leases
+     *
+     * Devices sharing a session are pinged with a single request.
+     *
+     * \param targets Devices of the server
+     * \param ping Function pinging the devices of one session
+     * \return PingStatusMap Result per device
+     */
+    static PingStatusMap pingServer(const std::vector<PingTarget>& targets, const PingFunction& ping);
+
     /**
      * @brief Analyze the result of the pings of all devices of one server
      *
-     * Add new devices with issues to tracker
-     * Remove devices that had issues previously
-     * Send command to SCA service in case of offline OPC server
+     * Update the tracked bad devices (\ref updateBadConnections) and start checking for a restart
+     * in case of offline OPC server
      *
      * @param port OPC server port
      * @param result Result of the connection test
@@ -103,16 +336,21 @@ namespace nsw {
     void analyzePingResults(const std::string& port, const PingStatusMap& result);
 
     /**
-     * @brief Issue a message if a connection is requested for a device that is listed as bad
+     * \brief Lease a session of the pool to a device if it has none yet (mutex must be held)
      *
-     * @param id ID of the device
+     * \param identifier ID of the device
+     * \return ConnectionHandle Connection of the device
      */
-    void warnBadConnection(const Identifier& id) const;
+    ConnectionHandle resolve(const Identifier& identifier);
 
     /**
-     * \brief Create a new connection to the OPC server (one per device)
+     * \brief Lease a session of the pool of the OPC server to a device
+     *
+     * Opens a new session if the pool is not full yet and no session is free. The lease is given
+     * back if the session cannot be opened.
      *
      * \param identifier ID of the device
+     * \throws OpcConnectionIssue new session cannot be opened
      */
     void add(const Identifier& identifier);
 
@@ -151,6 +389,8 @@ namespace nsw {
     /**
      * @brief Check if an OPC server has come back online
      *
+     * Opens one session and reads the status of all devices with a single request.
+     *
      * @param server OPC server
      * @param deviceNames Names of the devices connected to server
      * @return true Server back online
@@ -158,7 +398,20 @@ namespace nsw {
      */
     static bool checkServerStatus(const std::string& server, const std::vector<std::string>& deviceNames);
 
-    ConnectionMap m_connections{};        //<! opened connections
+    /**
+     * \brief Open a session to an OPC server (default \ref SessionFactory)
+     *
+     * \param ipPort IP and port of the OPC server
+     * \return std::shared_ptr<OpcClient> Connected client
+     * \throws OpcConnectionIssue server cannot be reached
+     */
+    static std::shared_ptr<OpcClient> openOpcSession(const std::string& ipPort);
+
+    SessionFactory m_openSession;         //<! Opens new sessions
+
+    ConnectionMap m_connections{};        //<! session pools per server
+    std::size_t m_sessionsPerServer{DEFAULT_SESSIONS_PER_SERVER};  //<! Maximum size of a session pool
+    SessionSelection m_sessionSelection{SessionSelection::LEAST_LOADED};  //<! Strategy to lease sessions
     std::map<std::string, PingStatusMap> m_badConnections{};  //<! opened connections which are not reachable
     constexpr static std::chrono::seconds PING_INTERVAL{10};           //<! Delay between two pings
     std::jthread m_backgroundThread{};     //<! Background thread to ping all connections
@@ -166,6 +419,8 @@ namespace nsw {
       m_reconnectThreads{};                //<! Threads to establish new connection to OPC
                                            // server when it went offline
     nsw::CommandSender m_commandSender{};  //<! Name of the application for recovery callback
+    std::atomic<std::uint64_t> m_generation{0};  //<! Incremented when connections are dropped
+    std::atomic<std::uint64_t> m_deviceGeneration{0};  //<! Incremented when devices may have lost their state
     mutable std::mutex m_mutex{};          //<! Mutex for synchronization
   };
 }  // namespace nsw
@@ -3,14 +3,18 @@
 
 #include <cstdint>
 #include <map>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/core.h>
 #include <ers/Issue.h>
 
+#include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/Utility.h"
 #include "NSWConfiguration/I2cMasterConfig.h"
+#include "NSWConfiguration/hw/I2cReadPlan.h"
 #include "NSWConfiguration/hw/OpcConnectionBase.h"
 #include "NSWConfiguration/hw/OpcManager.h"
 #include "NSWConfiguration/hw/ScaAddressBase.h"
@@ -386,6 +390,24 @@ namespace nsw::hw {
     std::uint32_t readSubRegister(const std::string& rname,
                                   const std::string& subreg) const;
 
+    /**
+     * \brief Read several sub-registers with one request
+     *
+     * Every register is read once, even if several of its sub-registers are requested.
+     *
+     * \param names pairs of register and sub-register names
+     * \return values in the order of names
+     */
+    [[nodiscard]]
+    std::vector<std::uint32_t> readSubRegisters(std::span<const std::pair<std::string, std::string>> names) const;
+
+    /**
+     * \brief Register layout of the FPGA for \ref I2cReadPlan
+     *
+     * One byte register address, no auto-increment of the register address.
+     */
+    constexpr static I2cRegisterLayout FPGA_REGISTER_LAYOUT{1, nsw::padtrigger::SCA_LITTLE_ENDIAN, 1};
+
     /**
      * \brief Get the sub-register of a register from the value of the register
      *
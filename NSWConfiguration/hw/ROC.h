@@ -2,7 +2,11 @@
 #define NSWCONFIGURATION_HW_ROC_H
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <iterator>
+#include <cstdint>
+#include <optional>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -45,6 +49,31 @@ namespace nsw::hw {
      */
     void writeConfiguration() const;
 
+    /**
+     * \brief Write only the registers which changed since the last configuration
+     *
+     * Compares the configuration with the image written by the last successful
+     * \ref writeConfiguration or \ref writeChangedConfiguration. The ROC is not reset, the PLLs
+     * are reset only if analog registers changed (as in \ref writeRegister). Without a previous
+     * image the full configuration is written.
+     *
+     * \return std::size_t Number of written registers
+     */
+    std::size_t writeChangedConfiguration() const;
+
+    /**
+     * \brief Check if the image of a previous configuration is known
+     *
+     * The image is forgotten when the OPC connections were dropped for a recovery or the server
+     * restarted meanwhile (see \ref getOpcGeneration), the device may have been power cycled.
+     *
+     * \return true if \ref writeChangedConfiguration can skip unchanged registers
+     */
+    [[nodiscard]] bool hasWrittenConfiguration() const
+    {
+      return m_written.has_value() and m_writtenGeneration == getOpcGeneration();
+    }
+
     /**
      * \brief Read a ROC register
      *
@@ -53,6 +82,41 @@ namespace nsw::hw {
      */
     [[nodiscard]] std::uint8_t readRegister(std::uint8_t regAddress) const;
 
+    /**
+     * \brief Read several ROC registers
+     *
+     * Registers on the same I2C bus (analog or digital part) are read with one OPC request.
+     *
+     * \param regAddresses are the addresses of the registers
+     * \return std::map<std::uint8_t, std::uint8_t> map of register address to value
+     */
+    [[nodiscard]] std::map<std::uint8_t, std::uint8_t> readRegisters(
+      std::span<const std::uint8_t> regAddresses) const;
+
+    /**
+     * \brief Reads registers on one bit-banged I2C bus
+     *
+     * Arguments are the SCL and SDA lines and the register addresses, returns the values in the
+     * order of the addresses.
+     */
+    using BusReader = std::function<std::vector<std::uint8_t>(std::pair<unsigned int, unsigned int>,
+                                                              std::span<const std::uint8_t>)>;
+
+    /**
+     * \brief Read several ROC registers with a given function reading one I2C bus
+     *
+     * Groups the registers by I2C bus, calls readBus once per bus, and maps the values back to
+     * the addresses.
+     *
+     * \param regAddresses are the addresses of the registers
+     * \param readBus reads the registers of one bus
+     * \return std::map<std::uint8_t, std::uint8_t> map of register address to value
+     * \throws std::logic_error an address is an unused register
+     * \throws std::out_of_range readBus returned too few values
+     */
+    [[nodiscard]] std::map<std::uint8_t, std::uint8_t> readRegisters(
+      std::span<const std::uint8_t> regAddresses, const BusReader& readBus) const;
+
     /**
      * \brief Write a value to a ROC register address
      *
@@ -112,6 +176,22 @@ namespace nsw::hw {
      */
     void enableVmmCaptureInputs() const;
 
+    /**
+     * \brief Queue disabling all VMMs in the VMM enable register on the OPC session
+     *
+     * One thread can disable the VMMs of many FEBs this way (see \ref OpcClient::dispatchAsync)
+     *
+     * \return std::future<void> rethrowing a failed write
+     */
+    [[nodiscard]] std::future<void> disableVmmCaptureInputsAsync() const;
+
+    /**
+     * \brief Queue setting the VMM enable register to the value in the passed config
+     *
+     * \return std::future<void> rethrowing a failed write
+     */
+    [[nodiscard]] std::future<void> enableVmmCaptureInputsAsync() const;
+
     /**
      * \brief Read the VMM capture status registers
      *
@@ -165,6 +245,18 @@ namespace nsw::hw {
     bool readScaOnline() const;
 
   private:
+    /**
+     * \brief Queue a write of a digital register on the OPC session
+     *
+     * Digital registers do not need the PLL reset of \ref writeRegister
+     *
+     * \param regName Name of the digital register
+     * \param value Value to be written
+     * \return std::future<void> rethrowing a failed write
+     */
+    [[nodiscard]] std::future<void> writeDigitalRegisterAsync(const std::string& regName,
+                                                              std::uint8_t value) const;
+
     /**
      * \brief Read a status register
      *
@@ -210,6 +302,25 @@ namespace nsw::hw {
                   const std::string& resetName,
                   bool state) const;
 
+    /**
+     * \brief Queue setting a given reset to a given state
+     *
+     * \param transaction Transaction the GPIO write is added to
+     * \param resetName GPIO name of the reset
+     * \param state true = set reset, false = release reset
+     */
+    void addReset(nsw::OpcTransaction& transaction,
+                  const std::string& resetName,
+                  bool state) const;
+
+    /**
+     * \brief Get the bit-banged I2C lines to which a register is connected
+     *
+     * \param regAddress is the address of the register
+     * \return std::pair<unsigned int, unsigned int> SCL and SDA line
+     */
+    [[nodiscard]] std::pair<unsigned int, unsigned int> getI2cLines(std::uint8_t regAddress) const;
+
     /**
      * \brief Get the address of a named register
      *
@@ -219,8 +330,19 @@ namespace nsw::hw {
      */
     [[nodiscard]] static std::uint8_t getRegAddress(const std::string& regName, bool isAnalog);
 
+    /**
+     * \brief Bitstreams written to the ROC by the last successful configuration
+     */
+    struct WrittenImage {
+      i2c::AddressBitstreamMap m_analog;
+      i2c::AddressBitstreamMap m_digital;
+    };
+
     I2cMasterConfig m_rocAnalog;   //!< associated I2cMasterConfig for the analog part of this ROC
     I2cMasterConfig m_rocDigital;  //!< associated I2cMasterConfig for the digital part of this ROC
+    mutable std::optional<WrittenImage> m_written{};  //!< Empty if the state of the ROC is unknown
+    mutable std::uint64_t m_writtenGeneration{};  //!< OPC generation of the written image
+    constexpr static unsigned int I2C_DELAY{2};  //!< Bit-banging delay (100 kHz)
     constexpr static std::array<std::uint8_t, 22>
       UNUSED_REGISTERS{15, 16, 17, 18, 25, 26, 27, 28, 29, 30, 54, 55, 56, 57, 58, 59, 60, 61, 62, 125, 126, 127};  //!< Unused ROC registers
 
@@ -1,12 +1,15 @@
 #ifndef NSWCONFIGURATION_HW_SCA_H
 #define NSWCONFIGURATION_HW_SCA_H
 
+#include <future>
 #include <vector>
 #include <string>
 #include <memory>
+#include <span>
 
 #include "NSWConfiguration/I2cMasterConfig.h"
 #include "NSWConfiguration/OpcClient.h"
+#include "NSWConfiguration/hw/I2cReadPlan.h"
 
 namespace nsw::hw::SCA {
   /**
@@ -81,6 +84,23 @@ namespace nsw::hw::SCA {
                           std::uint8_t registerAddress,
                           unsigned int i2cDelay);
 
+  /**
+   * \brief Read back several ROC registers with one OPC request
+   * \param opcConnection OPC server connection
+   * \param node name of the OPC node
+   * \param scl scl line to use
+   * \param sda sda line to use
+   * \param registerAddresses ROC register addresses (all on the I2C bus given by scl and sda)
+   * \param i2cDelay I2c delay value, 2 corresponds to 100kHz
+   * \return std::vector<std::uint8_t> values of the registers in the order of registerAddresses
+   */
+  std::vector<std::uint8_t> readRocRawMulti(nsw::OpcClientPtr opcConnection,
+                                            const std::string& node,
+                                            unsigned int scl,
+                                            unsigned int sda,
+                                            std::span<const std::uint8_t> registerAddresses,
+                                            unsigned int i2cDelay);
+
   /**
    * \brief Read back I2c register as vector
    *
@@ -111,6 +131,18 @@ namespace nsw::hw::SCA {
                                              size_t addressSize,
                                              size_t numberOfBytes = 1);
 
+  /**
+   * \brief Read all registers of a read plan with one request
+   *
+   * \param opcConnection OPC server connection
+   * \param node name of the OPC node of the I2c slave
+   * \param plan compiled register reads
+   * \return std::vector<std::uint32_t> Masked values in the order of the registers of the plan
+   */
+  std::vector<std::uint32_t> readRegisters(nsw::OpcClientPtr opcConnection,
+                                           const std::string& node,
+                                           const nsw::hw::I2cReadPlan& plan);
+
   /**
    * \brief Send I2c register for ADDC
    *
@@ -126,6 +158,51 @@ namespace nsw::hw::SCA {
                         const std::vector<std::uint8_t>& address,
                         std::vector<std::uint8_t> data);
 
+  /**
+   * \brief Send all operations of a transaction
+   *
+   * \param opcConnection OPC server connection
+   * \param transaction operations to be executed
+   */
+  void sendTransaction(nsw::OpcClientPtr opcConnection, const nsw::OpcTransaction& transaction);
+
+  /**
+   * \brief Queue all operations of a transaction on the OPC session
+   *
+   * Returns immediately, see \ref OpcClient::dispatchAsync
+   *
+   * \param opcConnection OPC server connection
+   * \param transaction operations to be executed
+   * \return std::future<void> rethrowing a failed operation
+   */
+  [[nodiscard]] std::future<void> sendTransactionAsync(nsw::OpcClientPtr opcConnection,
+                                                       nsw::OpcTransaction transaction);
+
+  /**
+   * \brief Queue writes of the configuration of all addresses under an I2cMaster
+   *
+   * \param transaction transaction the writes are added to
+   * \param topnode Top level name of the OPC node
+   * \param cfg config object holding addresses and data
+   */
+  void addI2cMasterConfig(nsw::OpcTransaction& transaction,
+                          const std::string& topnode,
+                          const nsw::I2cMasterConfig& cfg);
+
+  /**
+   * \brief Queue writes of the addresses under an I2cMaster which differ from a previous image
+   *
+   * \param transaction transaction the writes are added to
+   * \param topnode Top level name of the OPC node
+   * \param cfg config object holding addresses and data
+   * \param previous Bitstreams which were written before, missing addresses are written
+   * \return std::size_t Number of queued writes
+   */
+  std::size_t addChangedI2cMasterConfig(nsw::OpcTransaction& transaction,
+                                        const std::string& topnode,
+                                        const nsw::I2cMasterConfig& cfg,
+                                        const i2c::AddressBitstreamMap& previous);
+
   /**
    * \brief High-level function to send configuration to all addresses under an I2cMaster
    *
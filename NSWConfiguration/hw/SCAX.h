@@ -3,7 +3,9 @@
 
 #include <ers/Issue.h>
 
+#include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/TPConstants.h"
+#include "NSWConfiguration/hw/I2cReadPlan.h"
 #include "NSWConfiguration/hw/SCAInterface.h"
 
 ERS_DECLARE_ISSUE(nsw,
@@ -13,6 +15,14 @@ ERS_DECLARE_ISSUE(nsw,
 
 namespace nsw::hw::SCAX {
 
+  /**
+   * \brief Register layout of the SCAX for \ref I2cReadPlan
+   *
+   * The firmware is not known to auto-increment the register address, so registers are not
+   * read in bursts.
+   */
+  constexpr I2cRegisterLayout REGISTER_LAYOUT{nsw::NUM_BYTES_IN_WORD32, nsw::scax::SCAX_LITTLE_ENDIAN, 1};
+
   /**
    * \brief Write register function
    *
@@ -11,6 +11,7 @@
 
 #include <ers/Issue.h>
 
+#include "NSWConfiguration/hw/I2cReadPlan.h"
 #include "NSWConfiguration/hw/OpcConnectionBase.h"
 #include "NSWConfiguration/hw/OpcManager.h"
 #include "NSWConfiguration/hw/ScaAddressBase.h"
@@ -76,6 +77,17 @@ namespace nsw::hw {
     std::uint32_t readRegister(std::uint32_t regAddress,
                                std::uint32_t mask) const;
 
+    /**
+     * \brief Read several STGCTP registers with one request
+     *
+     * Skipped registers (see \ref SkipRegisters) are not read, they are reported with a dummy value.
+     *
+     * \param plan compiled register reads (see \ref SCAX::REGISTER_LAYOUT)
+     * \return values in the order of the registers of the plan
+     */
+    [[nodiscard]]
+    std::vector<std::uint32_t> readRegisters(const I2cReadPlan& plan) const;
+
     /**
      * \brief Write a value to a STGCTP register address, and read it back
      *
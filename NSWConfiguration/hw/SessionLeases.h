@@ -0,0 +1,67 @@
+#ifndef NSWCONFIGURATION_HW_SESSIONLEASES_H
+#define NSWCONFIGURATION_HW_SESSIONLEASES_H
+
+#include <cstddef>
+#include <vector>
+
+namespace nsw::hw {
+  /**
+   * \brief Strategy to choose the session a device leases
+   */
+  enum class SessionSelection {
+    ROUND_ROBIN,  //!< Cycle through the sessions of the server
+    LEAST_LOADED  //!< Take the session used by the fewest devices
+  };
+
+  /**
+   * \brief Number of devices using each session of a session pool
+   *
+   * Only does the bookkeeping, the sessions themselves are owned by the OpcManager.
+   */
+  class SessionLeases
+  {
+  public:
+    /**
+     * \brief Lease a session to a device
+     *
+     * A session without lease is reused first. Otherwise a new session is requested until the pool
+     * holds maxSessions sessions, afterwards existing sessions are shared according to the
+     * selection strategy.
+     *
+     * \param maxSessions Maximum number of sessions
+     * \param selection Strategy to choose among the existing sessions
+     * \return std::size_t Index of the session (equal to the previous \ref getNumSessions if a new
+     *         session has to be opened)
+     */
+    std::size_t acquire(std::size_t maxSessions, SessionSelection selection);
+
+    /**
+     * \brief Give a lease back
+     *
+     * The session is kept and becomes the preferred one for the next device if it is unused.
+     *
+     * \param session Index of the session
+     * \throws std::out_of_range session does not exist
+     */
+    void release(std::size_t session);
+
+    /**
+     * \brief Get the number of sessions
+     */
+    [[nodiscard]] std::size_t getNumSessions() const { return std::size(m_numLeases); }
+
+    /**
+     * \brief Get the number of devices using a session
+     *
+     * \param session Index of the session
+     * \throws std::out_of_range session does not exist
+     */
+    [[nodiscard]] std::size_t getNumLeases(std::size_t session) const { return m_numLeases.at(session); }
+
+  private:
+    std::vector<std::size_t> m_numLeases{};  //!< Number of devices using each session
+    std::size_t m_nextSession{0};            //!< Next session for round-robin
+  };
+}  // namespace nsw::hw
+
+#endif
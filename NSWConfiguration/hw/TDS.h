@@ -1,6 +1,9 @@
 #ifndef NSWCONFIGURATION_HW_TDS_H
 #define NSWCONFIGURATION_HW_TDS_H
 
+#include <cstdint>
+#include <optional>
+
 #include "NSWConfiguration/ConfigTranslationMap.h"
 #include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/FEBConfig.h"
@@ -50,6 +53,30 @@ namespace nsw::hw {
      */
     void writeConfiguration(bool resetTds = false) const;
 
+    /**
+     * \brief Write only the registers which changed since the last configuration
+     *
+     * Compares the configuration with the image written by the last successful
+     * \ref writeConfiguration or \ref writeChangedConfiguration. The TDS is not reset. Without a
+     * previous image the full configuration is written.
+     *
+     * \return std::size_t Number of written registers
+     */
+    std::size_t writeChangedConfiguration() const;
+
+    /**
+     * \brief Check if the image of a previous configuration is known
+     *
+     * The image is forgotten when the OPC connections were dropped for a recovery or the server
+     * restarted meanwhile (see \ref getOpcGeneration), the device may have been power cycled.
+     *
+     * \return true if \ref writeChangedConfiguration can skip unchanged registers
+     */
+    [[nodiscard]] bool hasWrittenConfiguration() const
+    {
+      return m_written.has_value() and m_writtenGeneration == getOpcGeneration();
+    }
+
     /**
      * \brief Read a TDS register
      *
@@ -115,6 +142,8 @@ namespace nsw::hw {
   private:
     I2cMasterConfig m_config;   //!< I2cMasterConfig object associated with this TDS
     bool m_isPfeb;              //!< is this TDS on a PFEB or SFEB
+    mutable std::optional<i2c::AddressBitstreamMap> m_written{};  //!< Image written by the last configuration, empty if unknown
+    mutable std::uint64_t m_writtenGeneration{};  //!< OPC generation of the written image
 
     /**
      * \brief Get address from register name
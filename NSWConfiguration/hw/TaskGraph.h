@@ -0,0 +1,120 @@
+#ifndef NSWCONFIGURATION_HW_TASKGRAPH_H
+#define NSWCONFIGURATION_HW_TASKGRAPH_H
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ers/Issue.h>
+
+ERS_DECLARE_ISSUE(nsw,
+                  TaskGraphIssue,
+                  message,
+                  ((std::string)message)
+                  )
+
+namespace nsw::hw {
+  /**
+   * \brief Dependency graph of tasks
+   *
+   * Every task is started as soon as all tasks it depends on are finished. Tasks without a path
+   * between them run concurrently. Dependencies have to be added before the tasks depending on
+   * them, which makes cycles impossible.
+   */
+  class TaskGraph
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * \brief Timing of one task
+     */
+    struct TaskTiming {
+      Clock::duration m_start{};  //!< Start time relative to the start of the graph
+      Clock::duration m_end{};    //!< End time relative to the start of the graph
+    };
+
+    /**
+     * \brief Summary of the execution of the graph
+     */
+    struct Report {
+      Clock::duration m_total{};                    //!< Wall time of the whole graph
+      std::map<std::string, TaskTiming> m_timings{};  //!< Timing per task
+      std::vector<std::string> m_criticalPath{};    //!< Chain of tasks that determined the wall time
+      std::vector<std::string> m_failed{};          //!< Tasks which threw an exception
+      std::vector<std::string> m_skipped{};         //!< Tasks not run because a dependency failed
+      std::exception_ptr m_error{};                 //!< First exception (in the order tasks were added)
+
+      /**
+       * \brief Human readable representation of the critical path
+       *
+       * \return std::string e.g. "FEB (10.1 s) -> Pad Trigger (2.0 s)"
+       */
+      [[nodiscard]] std::string criticalPathToString() const;
+
+      /**
+       * \brief Rethrow the first exception thrown by a task, if any
+       */
+      void rethrowIfFailed() const;
+    };
+
+    /**
+     * \brief Add a task to the graph
+     *
+     * \param name Unique name of the task
+     * \param task Function to be executed
+     * \param dependencies Names of the tasks which have to be finished before this one starts
+     * \throws TaskGraphIssue name exists already or dependency is unknown
+     */
+    void add(const std::string& name,
+             std::function<void()> task,
+             const std::vector<std::string>& dependencies = {});
+
+    /**
+     * \brief Execute all tasks
+     *
+     * Tasks depending (directly or indirectly) on a task which threw an exception are skipped.
+     * Exceptions are not propagated: they are stored in the report to be inspected and rethrown
+     * by the caller (\ref Report::rethrowIfFailed) once all tasks are finished.
+     *
+     * \param parallel Run independent tasks concurrently, otherwise run the tasks one after another
+     *                 in the order they were added
+     * \return Report Timing information, critical path, and failed tasks
+     */
+    Report run(bool parallel = true) const;
+
+  private:
+    /**
+     * \brief Outcome of a task
+     */
+    enum class State { SUCCEEDED, FAILED, SKIPPED };
+
+    /**
+     * \brief Node of the graph
+     */
+    struct Node {
+      std::string m_name{};
+      std::function<void()> m_task{};
+      std::vector<std::size_t> m_dependencies{};  //!< Indices of the nodes this node depends on
+    };
+
+    /**
+     * \brief Find the chain of tasks ending last
+     *
+     * Starting from the task which finished last, step back to the dependency which finished last
+     * since this one determined the start of the task.
+     *
+     * \param timings Timing of each node (same order as \ref m_nodes)
+     * \return std::vector<std::string> Names of the tasks on the critical path
+     */
+    [[nodiscard]] std::vector<std::string> findCriticalPath(
+      const std::vector<TaskTiming>& timings) const;
+
+    std::vector<Node> m_nodes{};  //!< Nodes in the order they were added (topological order)
+  };
+}  // namespace nsw::hw
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,30 @@ namespace nsw::hw {
      */
     void writeConfiguration(const VMMConfig& config, bool resetVmm = false) const;
 
+    /**
+     * \brief Write the VMM configuration if it changed since the last configuration
+     *
+     * The SPI image of a VMM can only be written as a whole. It is skipped if it is identical to
+     * the one written by the last successful \ref writeConfiguration. Without a previous image
+     * the configuration is written.
+     *
+     * \return true if the configuration was written
+     */
+    bool writeChangedConfiguration() const;
+
+    /**
+     * \brief Check if the image of a previous configuration is known
+     *
+     * The image is forgotten when the OPC connections were dropped for a recovery or the server
+     * restarted meanwhile (see \ref getOpcGeneration), the device may have been power cycled.
+     *
+     * \return true if \ref writeChangedConfiguration can skip an unchanged configuration
+     */
+    [[nodiscard]] bool hasWrittenConfiguration() const
+    {
+      return m_written.has_value() and m_writtenGeneration == getOpcGeneration();
+    }
+
     /**
      * \brief Sampling the selected monitoring output of the VMM by the PDO channel
      *
@@ -98,6 +123,8 @@ namespace nsw::hw {
     VMMConfig m_config;           //!< VMMConfig object associated with this VMM
     std::string m_rocAnalogName;  //!< Disable data acquisition
     std::size_t m_vmmId{};        //!< Board position of VMM
+    mutable std::optional<BitVector> m_written{};  //!< Image written by the last configuration, empty if unknown
+    mutable std::uint64_t m_writtenGeneration{};  //!< OPC generation of the written image
   };
 }  // namespace nsw::hw
 
@@ -2,6 +2,7 @@
 #define NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_CONFIG_H
 
 #include <chrono>
+#include <cstddef>
 #include <string>
 
 namespace nsw::mon {
@@ -13,7 +14,30 @@ namespace nsw::mon {
    */
   struct Config {
     std::string m_name;
-    std::chrono::seconds m_frequency;
+    std::chrono::milliseconds m_frequency;  //!< Period between two sweeps over all devices
+  };
+
+  /**
+   * \brief Part of the devices of a group monitored in one cycle
+   *
+   * If a sweep over all devices of a group does not fit into its period, the devices are split
+   * into m_count shards which are monitored in consecutive periods. Device i belongs to shard
+   * i % m_count.
+   */
+  struct Shard {
+    std::size_t m_index{0};  //!< Index of the shard
+    std::size_t m_count{1};  //!< Number of shards
+
+    /**
+     * \brief Check if a device belongs to this shard
+     *
+     * \param deviceIndex Index of the device in the group
+     * \return true if the device is monitored in this cycle
+     */
+    [[nodiscard]] constexpr bool contains(const std::size_t deviceIndex) const
+    {
+      return m_count <= 1 or deviceIndex % m_count == m_index;
+    }
   };
 }  // namespace nsw::mon
 
@@ -2,14 +2,75 @@
 #define NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_HELPERS_H
 
 #include <cstddef>
-
-#include <is/infodictionary.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <semaphore>
+#include <string>
+#include <vector>
 
 #include "NSWConfiguration/Concepts.h"
+#include "NSWConfiguration/monitoring/Config.h"
+#include "NSWConfiguration/monitoring/History.h"
 #include "NSWConfiguration/monitoring/IsPublisher.h"
 
 namespace nsw::mon::internal {
+  /**
+   * \brief Default for groups which do not record any metric in the local history
+   */
+  struct NoMetrics {
+    template<typename IsType>
+    [[nodiscard]] std::vector<Metric> operator()(const IsType& /*values*/) const
+    {
+      return {};
+    }
+  };
+
+  /**
+   * \brief Serializes the access to a device across monitoring groups
+   *
+   * Groups of the same device type (e.g. RocStatusRegisters and RocConfigurationRegisters) run
+   * concurrently and read from the same devices. A device is only read by one group at a time.
+   * Devices are identified by their SCA address, so the lock does not depend on where the device
+   * object is stored and devices never share a lock. One mutex is created per device on first use.
+   */
+  class DeviceLocks
+  {
+  public:
+    /**
+     * \brief Get the locks shared by all monitoring groups
+     */
+    [[nodiscard]] static DeviceLocks& getInstance()
+    {
+      static DeviceLocks locks{};
+      return locks;
+    }
+
+    /**
+     * \brief Get the mutex of a device
+     *
+     * \tparam T HW interface type
+     * \param device Device stored in the container of the device manager
+     * \return std::mutex& Mutex to be held while reading from the device
+     */
+    template<nsw::HWI T>
+    [[nodiscard]] std::mutex& get(const T& device)
+    {
+      std::scoped_lock lock(m_mutex);
+      auto& mutex = m_mutexes[std::string{device.getScaAddress()}];
+      if (mutex == nullptr) {
+        mutex = std::make_unique<std::mutex>();
+      }
+      // The mutex lives in its own allocation and stays valid when the map grows
+      return *mutex;
+    }
+
+  private:
+    std::mutex m_mutex{};  //!< Protects m_mutexes
+    std::map<std::string, std::unique_ptr<std::mutex>> m_mutexes{};
+  };
+
   /**
    * @brief Helper do monitor boards and publish the result to IS
    */
@@ -20,31 +81,42 @@ namespace nsw::mon::internal {
      * @brief Constructor
      *
      * @param numConcurrent Number of boards monitored concurrently
+     * @param history Local history to record metrics (optional)
      */
-    explicit MonitorHelper(std::int64_t numConcurrent) : m_semaphore{numConcurrent} {}
+    explicit MonitorHelper(std::int64_t numConcurrent, History* history = nullptr) :
+      m_semaphore{numConcurrent}, m_history{history}
+    {}
 
     /**
      * \brief Loop over all devices and publish result to IS
      *
      * \tparam T HW interface type
      * \param hwis Set of devices to be monitored
-     * \param isDict IS dictionary (from partition)
+     * \param publisher IS publisher
      * \param theadPool Thread pool to execute jobs
      * \param serverName Name of the IS monitoring server
      * \param groupName Name of the monitoring group
      * \param func Function that fills the IS object for each device
+     * \param shard Part of the devices to be monitored (default: all)
+     * \param metrics Function that extracts the metrics recorded in the local history from the IS object
      */
-    template<nsw::HWI T>
+    template<nsw::HWI T, typename Metrics = NoMetrics>
     void monitorAndPublish(const std::vector<T>& hwis,
-                           ISInfoDictionary* isDict,
+                           ISPublisher& publisher,
                            IPCThreadPool& threadPool,
                            const std::string_view serverName,
                            const std::string_view groupName,
-                           const std::regular_invocable<T> auto& func) const
+                           const std::regular_invocable<T> auto& func,
+                           const Shard shard = {},
+                           const Metrics& metrics = {}) const
     {
-      for (const auto& device : hwis) {
-        threadPool.addJob([this, &isDict, &serverName, &groupName, &func, &device]() {
-          doWork(device, isDict, serverName, groupName, func);
+      for (std::size_t index = 0; index < std::size(hwis); ++index) {
+        if (not shard.contains(index)) {
+          continue;
+        }
+        const auto& device = hwis[index];
+        threadPool.addJob([this, &publisher, &serverName, &groupName, &func, &device, &metrics]() {
+          doWork(device, publisher, serverName, groupName, func, metrics);
         });
       }
       threadPool.waitForCompletion();
@@ -56,26 +128,33 @@ namespace nsw::mon::internal {
      *
      * \tparam T HW interface type
      * \param device device to be monitored
-     * \param isDict IS dictionary (from partition)
+     * \param publisher IS publisher
      * \param serverName Name of the IS monitoring server
      * \param groupName Name of the monitoring group
      * \param func Function that fills the IS object for each device
+     * \param metrics Function that extracts the metrics recorded in the local history
      */
-    template<nsw::HWI T>
+    template<nsw::HWI T, typename Metrics>
     void doWork(const T& device,
-                ISInfoDictionary* isDict,
+                ISPublisher& publisher,
                 const std::string_view serverName,
                 const std::string_view groupName,
-                const std::regular_invocable<T> auto& func) const
+                const std::regular_invocable<T> auto& func,
+                const Metrics& metrics) const
     {
       try {
-        const auto values = func(device);
-        ISPublisher::publish(isDict,
-                             serverName,
-                             groupName,
-                             nsw::getElementType(device.getScaAddress()),
-                             device.getScaAddress(),
-                             values);
+        const auto values = [&func, &device]() {
+          std::scoped_lock lock(DeviceLocks::getInstance().get(device));
+          return func(device);
+        }();
+        if (m_history != nullptr and m_history->isEnabled()) {
+          m_history->record(groupName, device.getScaAddress(), metrics(values));
+        }
+        publisher.publish(serverName,
+                          groupName,
+                          nsw::getElementType(device.getScaAddress()),
+                          device.getScaAddress(),
+                          values);
       } catch (const std::exception& ex) {
         ERS_LOG("Monitoring failed due to " << ex.what());
       }
@@ -83,6 +162,7 @@ namespace nsw::mon::internal {
 
     static constexpr std::ptrdiff_t MIN_MAX_THREADS{200};
     mutable std::counting_semaphore<MIN_MAX_THREADS> m_semaphore;
+    History* m_history{nullptr};
   };
 }  // namespace nsw::mon::internal
 
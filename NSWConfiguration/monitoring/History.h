@@ -0,0 +1,194 @@
+#ifndef NSWCONFIGURATION_MONITORING_HISTORY_H
+#define NSWCONFIGURATION_MONITORING_HISTORY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace nsw::mon {
+  /**
+   * \brief Value of one monitored quantity of a device
+   */
+  struct Metric {
+    std::string_view m_name;  //!< Name of the metric (has to refer to static storage)
+    double m_value;
+  };
+
+  /**
+   * \brief Samples of one series in columnar layout
+   */
+  struct Samples {
+    std::vector<std::int64_t> m_timestamps{};  //!< Milliseconds since epoch
+    std::vector<double> m_values{};
+  };
+
+  /**
+   * \brief Fixed size ring buffer of timestamped samples
+   *
+   * Timestamps and values are stored in separate columns. There must be only one writer at a
+   * time, readers can run concurrently to the writer without locking. Samples which are
+   * overwritten while being read are dropped from the result.
+   */
+  class TimeSeries
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param capacity Number of samples kept
+     */
+    explicit TimeSeries(std::size_t capacity);
+
+    /**
+     * \brief Add a sample, overwrites the oldest one when full
+     *
+     * \param timestamp Milliseconds since epoch
+     * \param value Value
+     */
+    void push(std::int64_t timestamp, double value);
+
+    /**
+     * \brief Get the samples not older than a timestamp
+     *
+     * \param since Oldest timestamp to return (milliseconds since epoch)
+     * \return Samples Samples in chronological order
+     */
+    [[nodiscard]] Samples read(std::int64_t since) const;
+
+    /**
+     * \brief Get the maximum number of samples
+     */
+    [[nodiscard]] std::size_t getCapacity() const { return m_capacity; }
+
+  private:
+    std::size_t m_capacity;
+    std::unique_ptr<std::atomic<std::int64_t>[]> m_timestamps;
+    std::unique_ptr<std::atomic<double>[]> m_values;
+    std::atomic<std::uint64_t> m_numStarted{0};   //!< Samples whose write started
+    std::atomic<std::uint64_t> m_numWritten{0};   //!< Samples whose write finished
+  };
+
+  /**
+   * \brief Selection of series and time window
+   */
+  struct HistoryQuery {
+    std::string m_group{};                     //!< Monitoring group (empty: all)
+    std::string m_device{};                    //!< Device name (empty: all)
+    std::chrono::milliseconds m_window{0};     //!< Age of the oldest sample (0: all samples)
+  };
+
+  /**
+   * \brief Samples of one series returned by a query
+   */
+  struct SeriesWindow {
+    std::string m_group;
+    std::string m_device;
+    std::string m_metric;
+    Samples m_samples;
+  };
+
+  /**
+   * \brief Local short-term history of monitored values
+   *
+   * Keeps the last samples of every metric of every monitored device in memory, independently
+   * of IS. Every series has a fixed size. A series must only be recorded by one thread at a
+   * time, which holds since a monitoring group is never monitored concurrently with itself.
+   */
+  class History
+  {
+  public:
+    using Clock = std::chrono::system_clock;
+    constexpr static std::uint32_t FILE_VERSION{1};
+    constexpr static std::string_view FILE_MAGIC{"NSWMONHI"};
+
+    /**
+     * \brief Constructor
+     *
+     * \param capacity Number of samples kept per series (0: disabled)
+     */
+    explicit History(std::size_t capacity = 0) : m_capacity{capacity} {}
+
+    /**
+     * \brief Remove all series and change the number of samples kept per series
+     *
+     * Must not be called while monitoring.
+     *
+     * \param capacity Number of samples kept per series (0: disabled)
+     */
+    void reset(std::size_t capacity);
+
+    /**
+     * \brief Check if samples are recorded
+     */
+    [[nodiscard]] bool isEnabled() const { return m_capacity > 0; }
+
+    /**
+     * \brief Record the metrics of one device
+     *
+     * \param group Monitoring group
+     * \param device Device name
+     * \param metrics Values
+     * \param time Time of the measurement
+     */
+    void record(std::string_view group,
+                std::string_view device,
+                std::span<const Metric> metrics,
+                Clock::time_point time = Clock::now());
+
+    /**
+     * \brief Get the samples of the selected series
+     *
+     * \param query Selection
+     * \param now Reference time of the window
+     * \return std::vector<SeriesWindow> Samples of every selected series with at least one sample
+     */
+    [[nodiscard]] std::vector<SeriesWindow> query(const HistoryQuery& query,
+                                                  Clock::time_point now = Clock::now()) const;
+
+    /**
+     * \brief Write the samples of the selected series to a binary file
+     *
+     * \param fileName Output file
+     * \param query Selection
+     * \return std::size_t Number of series written
+     * \throws std::runtime_error File cannot be written
+     */
+    std::size_t dump(const std::string& fileName, const HistoryQuery& query) const;
+
+    /**
+     * \brief Write series in the binary format
+     *
+     * Format (native byte order): magic (8 chars), version (u32), number of series (u32), then for
+     * every series: group, device, and metric (u16 length followed by the characters), number of
+     * samples n (u32), n timestamps (i64, milliseconds since epoch), n values (f64).
+     *
+     * \param stream Output stream
+     * \param series Series to be written
+     */
+    static void write(std::ostream& stream, std::span<const SeriesWindow> series);
+
+  private:
+    using SeriesId = std::tuple<std::string, std::string, std::string>;
+
+    /**
+     * \brief Find or create a series
+     */
+    TimeSeries& getSeries(std::string_view group, std::string_view device, std::string_view metric);
+
+    std::size_t m_capacity;
+    mutable std::shared_mutex m_mutex;  //!< Protects the set of series, not their samples
+    std::map<SeriesId, std::unique_ptr<TimeSeries>, std::less<>> m_series{};
+  };
+}  // namespace nsw::mon
+
+#endif
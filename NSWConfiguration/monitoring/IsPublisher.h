@@ -1,23 +1,174 @@
 #ifndef NSWCONFIGURATION_MONITORING_ISPUBLISHER_H
 #define NSWCONFIGURATION_MONITORING_ISPUBLISHER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
-#include <string>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
 
+#include <is/info.h>
 #include <is/infodictionary.h>
 
 namespace nsw::mon {
+  /**
+   * \brief Destination of the IS objects of the publisher
+   */
+  class ISDestination
+  {
+  public:
+    ISDestination() = default;
+    virtual ~ISDestination() = default;
+    ISDestination(const ISDestination&) = delete;
+    ISDestination(ISDestination&&) = delete;
+    ISDestination& operator=(const ISDestination&) = delete;
+    ISDestination& operator=(ISDestination&&) = delete;
+
+    /**
+     * \brief Publish an object
+     *
+     * \param key IS key
+     * \param values IS object
+     */
+    virtual void checkin(const std::string& key, const ISInfo& values) const = 0;
+  };
+
+  /**
+   * \brief Publishes the IS objects to an IS dictionary
+   */
+  class ISDictionaryDestination : public ISDestination
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param isDict IS dictionary, has to outlive the destination
+     */
+    explicit ISDictionaryDestination(const ISInfoDictionary* isDict) : m_isDict{isDict} {}
+
+    void checkin(const std::string& key, const ISInfo& values) const override;
+
+  private:
+    const ISInfoDictionary* m_isDict;
+  };
+
+  namespace internal {
+    /**
+     * \brief IS object waiting to be published
+     */
+    class PendingInfo
+    {
+    public:
+      virtual ~PendingInfo() = default;
+
+      /**
+       * \brief Fingerprint of the values to detect unchanged objects
+       *
+       * \return std::optional<std::size_t> Hash of the values, empty if it cannot be computed
+       */
+      [[nodiscard]] virtual std::optional<std::size_t> fingerprint() const = 0;
+
+      /**
+       * \brief Publish the values to IS
+       *
+       * \param destination Destination of the IS object
+       * \param key IS key
+       */
+      virtual void checkin(const ISDestination& destination, const std::string& key) const = 0;
+    };
+
+    /**
+     * \brief Copy of an IS object waiting to be published
+     *
+     * \tparam IsType IS info type
+     */
+    template<typename IsType>
+    class PendingInfoOf : public PendingInfo
+    {
+    public:
+      explicit PendingInfoOf(const IsType& values) : m_values{values} {}
+
+      [[nodiscard]] std::optional<std::size_t> fingerprint() const override
+      {
+        // Generated IS info types print all their attributes
+        if constexpr (requires(std::ostream& stream, const IsType& values) { stream << values; }) {
+          std::ostringstream stream;
+          stream << m_values;
+          return std::hash<std::string>{}(stream.str());
+        } else {
+          return std::nullopt;
+        }
+      }
+
+      void checkin(const ISDestination& destination, const std::string& key) const override
+      {
+        destination.checkin(key, m_values);
+      }
+
+    private:
+      IsType m_values;
+    };
+  }  // namespace internal
+
+  /**
+   * \brief Publishes monitoring data to IS from a dedicated thread
+   *
+   * Monitoring threads only queue the values and never wait for IS. The publishing thread
+   * publishes everything which was queued since its last pass. Only the latest values of a
+   * key are kept, and values which did not change since they were last published are skipped
+   * unless they were not refreshed for longer than the heartbeat period.
+   */
   class ISPublisher
   {
   public:
+    using Clock = std::chrono::steady_clock;
+    constexpr static std::chrono::seconds DEFAULT_HEARTBEAT{0};
+
+    /**
+     * \brief Constructor
+     *
+     * \param isDict IS dictionary, has to outlive the publisher
+     * \param heartbeat Period after which unchanged values are published again (0: publish always)
+     */
+    explicit ISPublisher(const ISInfoDictionary* isDict,
+                         std::chrono::milliseconds heartbeat = DEFAULT_HEARTBEAT);
+
     /**
-     * \brief Publish data to IS
+     * \brief Constructor
+     *
+     * \param destination Destination of the IS objects
+     * \param heartbeat Period after which unchanged values are published again (0: publish always)
+     */
+    explicit ISPublisher(std::unique_ptr<const ISDestination> destination,
+                         std::chrono::milliseconds heartbeat = DEFAULT_HEARTBEAT);
+
+    /**
+     * \brief Publishes the queued values and stops the publishing thread
+     */
+    ~ISPublisher();
+
+    ISPublisher(const ISPublisher&) = delete;
+    ISPublisher(ISPublisher&&) = delete;
+    ISPublisher& operator=(const ISPublisher&) = delete;
+    ISPublisher& operator=(ISPublisher&&) = delete;
+
+    /**
+     * \brief Queue data to be published to IS
      *
      * Publishes a dictionary of values to IS with the key
      * <serverName>.<deviceType>.<groupName>.<deviceName>
      *
-     * \param isDict IS dictionary
      * \param serverName IS server name
      * \param groupName name of the monitoring group
      * \param deviceType device type
@@ -25,17 +176,50 @@ namespace nsw::mon {
      * \param values IS info struct
      */
     template<typename IsType>
-    static void publish(ISInfoDictionary* isDict,
-                        const std::string_view serverName,
-                        const std::string_view groupName,
-                        const std::string_view deviceType,
-                        const std::string_view deviceName,
-                        const IsType& values)
+    void publish(const std::string_view serverName,
+                 const std::string_view groupName,
+                 const std::string_view deviceType,
+                 const std::string_view deviceName,
+                 const IsType& values)
     {
-      isDict->checkin(buildKey(serverName, groupName, deviceType, deviceName), values);
+      enqueue(serverName,
+              groupName,
+              deviceType,
+              deviceName,
+              std::make_unique<internal::PendingInfoOf<IsType>>(values));
     }
 
+    /**
+     * \brief Wait until all queued values are published
+     */
+    void flush();
+
+    /**
+     * \brief Get the number of objects published to IS
+     */
+    [[nodiscard]] std::size_t getNumPublished() const { return m_numPublished; }
+
+    /**
+     * \brief Get the number of objects skipped because they did not change
+     */
+    [[nodiscard]] std::size_t getNumSuppressed() const { return m_numSuppressed; }
+
   private:
+    /**
+     * \brief State of one IS key
+     *
+     * The pending values are protected by the mutex, the publication state is only used by the
+     * publishing thread.
+     */
+    struct Entry {
+      std::string m_key;
+      std::unique_ptr<internal::PendingInfo> m_pending{};
+      std::optional<std::size_t> m_fingerprint{};
+      Clock::time_point m_lastPublished{};
+    };
+
+    using EntryId = std::tuple<std::string, std::string, std::string, std::string>;
+
     /**
      * \brief Builds the kedy for the IS dict
      *
@@ -51,6 +235,42 @@ namespace nsw::mon {
                                 std::string_view groupName,
                                 std::string_view deviceType,
                                 std::string_view deviceName);
+
+    /**
+     * \brief Replace the pending values of a key and wake up the publishing thread
+     */
+    void enqueue(std::string_view serverName,
+                 std::string_view groupName,
+                 std::string_view deviceType,
+                 std::string_view deviceName,
+                 std::unique_ptr<internal::PendingInfo> values);
+
+    /**
+     * \brief Publishing thread
+     *
+     * \param stopToken Stops the thread once the queue is empty
+     */
+    void run(std::stop_token stopToken);
+
+    /**
+     * \brief Publish the values of a key if they changed or the heartbeat expired
+     *
+     * \param entry State of the key
+     * \param values Values to be published
+     * \param now Time of this pass
+     */
+    void publishEntry(Entry& entry, const internal::PendingInfo& values, Clock::time_point now);
+
+    std::unique_ptr<const ISDestination> m_destination;
+    std::chrono::milliseconds m_heartbeat;
+    std::mutex m_mutex;
+    std::condition_variable_any m_condition;
+    std::map<EntryId, Entry, std::less<>> m_entries{};  //!< Keys are built once per device
+    std::vector<Entry*> m_queue{};                      //!< Entries with pending values
+    bool m_publishing{false};
+    std::atomic<std::size_t> m_numPublished{0};
+    std::atomic<std::size_t> m_numSuppressed{0};
+    std::jthread m_thread;
   };
 }  // namespace nsw::mon
 
@@ -21,16 +21,18 @@ namespace nsw::mon {
      * \brief Constructor
      *
      * \param deviceManager device manager containing HWIs
+     * \param history local history to record the metrics of the devices
      */
-    explicit MmtpInRunStatusRegisters(const nsw::hw::DeviceManager& deviceManager);
+    MmtpInRunStatusRegisters(const nsw::hw::DeviceManager& deviceManager, History& history);
 
     /**
      * \brief Monitor and publish information for all devices to IS
      *
-     * \param isDict IS dictionary
+     * \param publisher IS publisher
      * \param serverName name of the monitoring IS server
+     * \param shard Part of the devices to be monitored (default: all)
      */
-    void monitor(ISInfoDictionary* isDict, std::string_view serverName);
+    void monitor(ISPublisher& publisher, std::string_view serverName, Shard shard = {});
     static constexpr std::string_view NAME{"MmtpInRunStatusRegisters"};
 
   private:
@@ -42,6 +44,14 @@ namespace nsw::mon {
      */
     [[nodiscard]] static nsw::mon::is::MmtpInRunStatusRegisters getData(const nsw::hw::MMTP& tp);
 
+    /**
+     * \brief Extract the values of one MMTP which are recorded in the local history
+     *
+     * \param values IS info struct
+     * \return std::vector<Metric> metrics
+     */
+    [[nodiscard]] static std::vector<Metric> getMetrics(const nsw::mon::is::MmtpInRunStatusRegisters& values);
+
     std::reference_wrapper<const std::vector<nsw::hw::MMTP>> m_devices;
     constexpr static std::int64_t NUM_CONCURRENT{5};
     IPCThreadPool m_threadPool{NUM_CONCURRENT};
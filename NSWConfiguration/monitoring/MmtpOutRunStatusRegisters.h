@@ -27,10 +27,11 @@ namespace nsw::mon {
     /**
      * \brief Monitor and publish information for all devices to IS
      *
-     * \param isDict IS dictionary
+     * \param publisher IS publisher
      * \param serverName name of the monitoring IS server
+     * \param shard Part of the devices to be monitored (default: all)
      */
-    void monitor(ISInfoDictionary* isDict, std::string_view serverName);
+    void monitor(ISPublisher& publisher, std::string_view serverName, Shard shard = {});
     static constexpr std::string_view NAME{"MmtpOutRunStatusRegisters"};
 
   private:
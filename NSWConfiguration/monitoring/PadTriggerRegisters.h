@@ -18,16 +18,18 @@ namespace nsw::mon {
      * \brief Constructor
      *
      * \param deviceManager device manager containing HWIs
+     * \param history local history to record the metrics of the devices
      */
-    explicit PadTriggerRegisters(const nsw::hw::DeviceManager& deviceManager);
+    PadTriggerRegisters(const nsw::hw::DeviceManager& deviceManager, History& history);
 
     /**
      * \brief Monitor and publish information for all devices to IS
      *
-     * \param isDict IS dictionary
+     * \param publisher IS publisher
      * \param serverName name of the monitoring IS server
+     * \param shard Part of the devices to be monitored (default: all)
      */
-    void monitor(ISInfoDictionary* isDict, std::string_view serverName);
+    void monitor(ISPublisher& publisher, std::string_view serverName, Shard shard = {});
     static constexpr std::string_view NAME{"PadTriggerRegisters"};
 
     /**
@@ -39,6 +41,14 @@ namespace nsw::mon {
     [[nodiscard]]
     static nsw::mon::is::PadTriggerRegisters getData(const nsw::hw::PadTrigger& dev);
 
+    /**
+     * \brief Extract the values of one pad trigger which are recorded in the local history
+     *
+     * \param values IS info struct
+     * \return std::vector<Metric> metrics
+     */
+    [[nodiscard]] static std::vector<Metric> getMetrics(const nsw::mon::is::PadTriggerRegisters& values);
+
   private:
     const nsw::hw::DeviceManager& m_devices;
     constexpr static std::int64_t NUM_CONCURRENT{1};
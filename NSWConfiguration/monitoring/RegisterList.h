@@ -0,0 +1,137 @@
+#ifndef NSWCONFIGURATION_MONITORING_REGISTERLIST_H
+#define NSWCONFIGURATION_MONITORING_REGISTERLIST_H
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include "NSWConfiguration/hw/I2cReadPlan.h"
+
+namespace nsw::mon::internal {
+  /**
+   * \brief One register of a monitoring group and how it is stored in the IS object
+   *
+   * \tparam IsType IS info type
+   */
+  template<typename IsType>
+  struct RegisterField {
+    std::uint32_t m_address;                 //!< Register address
+    std::uint32_t m_mask;                    //!< Mask applied to the value
+    void (*m_store)(IsType&, std::uint32_t); //!< Fills the IS object from the masked value
+  };
+
+  /**
+   * \brief Class of a pointer to data member
+   */
+  template<typename MemberPointer>
+  struct MemberClass;
+
+  template<typename Class, typename Value>
+  struct MemberClass<Value Class::*> {
+    using type = Class;
+  };
+
+  /**
+   * \brief Create a field which stores a register into a member of the IS object
+   *
+   * Boolean members are set if any bit of the masked value is set.
+   *
+   * \tparam Member Pointer to the member of the IS type
+   * \param address Register address
+   * \param mask Mask applied to the value
+   */
+  template<auto Member>
+  [[nodiscard]] constexpr auto makeField(const std::uint32_t address, const std::uint32_t mask = 0xffffffff)
+  {
+    using IsType = typename MemberClass<decltype(Member)>::type;
+    return RegisterField<IsType>{address, mask, [](IsType& is, const std::uint32_t value) {
+                                   using Value = std::remove_cvref_t<decltype(is.*Member)>;
+                                   if constexpr (std::is_same_v<Value, bool>) {
+                                     is.*Member = (value != 0U);
+                                   } else {
+                                     is.*Member = static_cast<Value>(value);
+                                   }
+                                 }};
+  }
+
+  /**
+   * \brief Declarative list of the registers of a monitoring group
+   *
+   * The list is compiled once into an \ref nsw::hw::I2cReadPlan, so that all registers of a
+   * device are read with one request and registers which are used by several fields are read
+   * once.
+   *
+   * \tparam IsType IS info type
+   */
+  template<typename IsType>
+  class RegisterList
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param fields Registers and how they are stored
+     * \param layout Register layout of the device
+     */
+    RegisterList(std::vector<RegisterField<IsType>> fields, const nsw::hw::I2cRegisterLayout& layout) :
+      m_fields{std::move(fields)}, m_plan{toReads(m_fields), layout}
+    {}
+
+    /**
+     * \brief Get the compiled reads
+     */
+    [[nodiscard]] const nsw::hw::I2cReadPlan& getPlan() const { return m_plan; }
+
+    /**
+     * \brief Store the values read with the plan into the IS object
+     *
+     * \param is IS object
+     * \param values Values in the order of the fields
+     * \throws std::invalid_argument Number of values does not match the number of fields
+     */
+    void decode(IsType& is, const std::span<const std::uint32_t> values) const
+    {
+      if (std::size(values) != std::size(m_fields)) {
+        throw std::invalid_argument(
+          fmt::format("Expected {} register values but got {}", std::size(m_fields), std::size(values)));
+      }
+      for (std::size_t index = 0; index < std::size(m_fields); ++index) {
+        m_fields[index].m_store(is, values[index]);
+      }
+    }
+
+    /**
+     * \brief Read all registers of a device and store them into the IS object
+     *
+     * \tparam Device HW interface providing readRegisters(const I2cReadPlan&)
+     * \param device Device
+     * \param is IS object
+     */
+    template<typename Device>
+    void read(const Device& device, IsType& is) const
+    {
+      decode(is, device.readRegisters(m_plan));
+    }
+
+  private:
+    [[nodiscard]] static std::vector<nsw::hw::RegisterRead> toReads(const std::vector<RegisterField<IsType>>& fields)
+    {
+      std::vector<nsw::hw::RegisterRead> reads{};
+      reads.reserve(std::size(fields));
+      for (const auto& field : fields) {
+        reads.push_back({field.m_address, field.m_mask});
+      }
+      return reads;
+    }
+
+    std::vector<RegisterField<IsType>> m_fields;
+    nsw::hw::I2cReadPlan m_plan;
+  };
+}  // namespace nsw::mon::internal
+
+#endif
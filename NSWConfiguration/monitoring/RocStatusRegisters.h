@@ -21,16 +21,18 @@ namespace nsw::mon {
      * \brief Constructor
      *
      * \param deviceManager device manager containing HWIs
+     * \param history local history to record the metrics of the devices
      */
-    explicit RocStatusRegisters(const nsw::hw::DeviceManager& deviceManager);
+    RocStatusRegisters(const nsw::hw::DeviceManager& deviceManager, History& history);
 
     /**
      * \brief Monitor and publish information for all devices to IS
      *
-     * \param isDict IS dictionary
+     * \param publisher IS publisher
      * \param serverName name of the monitoring IS server
+     * \param shard Part of the devices to be monitored (default: all)
      */
-    void monitor(ISInfoDictionary* isDict, std::string_view serverName);
+    void monitor(ISPublisher& publisher, std::string_view serverName, Shard shard = {});
     static constexpr std::string_view NAME{"RocStatusRegisters"};
 
   private:
@@ -42,6 +44,14 @@ namespace nsw::mon {
      */
     [[nodiscard]] static nsw::mon::is::RocStatus getData(const nsw::hw::FEB& feb);
 
+    /**
+     * \brief Extract the values of one ROC which are recorded in the local history
+     *
+     * \param values IS info struct
+     * \return std::vector<Metric> metrics
+     */
+    [[nodiscard]] static std::vector<Metric> getMetrics(const nsw::mon::is::RocStatus& values);
+
     std::reference_wrapper<const std::vector<nsw::hw::FEB>> m_devices;
     constexpr static std::int64_t NUM_CONCURRENT{20};
     IPCThreadPool m_threadPool{NUM_CONCURRENT};
@@ -0,0 +1,215 @@
+#ifndef NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_SCHEDULER_H
+#define NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NSWConfiguration/monitoring/Config.h"
+
+namespace nsw::mon {
+  /**
+   * \brief Achieved performance of one monitoring group
+   */
+  struct GroupStatistics {
+    std::string m_name{};                         //!< Name of the group
+    std::chrono::milliseconds m_period{};         //!< Requested period of a full sweep
+    std::chrono::milliseconds m_lastDuration{};   //!< Duration of the last cycle
+    std::chrono::milliseconds m_sweepCost{};      //!< Estimated duration of a sweep over all devices
+    double m_achievedRate{0.};                    //!< Full sweeps per second (0 until the first sweep finished)
+    std::size_t m_numShards{1};                   //!< Number of periods a full sweep is spread over
+    std::uint64_t m_numMissedDeadlines{0};        //!< Cycles which finished after the end of their period
+    std::uint64_t m_numCycles{0};                 //!< Executed cycles
+  };
+
+  namespace internal {
+    /**
+     * \brief Compute into how many shards the devices of each group are split
+     *
+     * A group is sharded if a full sweep takes longer than its period. If the load of all groups
+     * still exceeds the capacity of the workers, the group with the highest load is split further
+     * until the load fits or every group reached the maximum number of shards, i.e. all groups
+     * are slowed down instead of overrunning every cycle.
+     *
+     * \param sweepCosts Estimated duration of a full sweep of each group
+     * \param periods Requested period of each group
+     * \param numWorkers Number of worker threads
+     * \param maxUtilization Fraction of the worker time that may be used by monitoring
+     * \param maxShards Maximum number of shards of one group
+     * \return std::vector<std::size_t> Number of shards of each group
+     */
+    [[nodiscard]] std::vector<std::size_t> computeNumShards(
+      std::span<const std::chrono::milliseconds> sweepCosts,
+      std::span<const std::chrono::milliseconds> periods,
+      std::size_t numWorkers,
+      double maxUtilization,
+      std::size_t maxShards);
+  }  // namespace internal
+
+  /**
+   * \brief Source of time of the scheduler
+   *
+   * Uses the steady clock. Tests derive from it to control the time.
+   */
+  class SchedulerClock
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    SchedulerClock() = default;
+    virtual ~SchedulerClock() = default;
+    SchedulerClock(const SchedulerClock&) = delete;
+    SchedulerClock(SchedulerClock&&) = delete;
+    SchedulerClock& operator=(const SchedulerClock&) = delete;
+    SchedulerClock& operator=(SchedulerClock&&) = delete;
+
+    /**
+     * \brief Get the current time
+     */
+    [[nodiscard]] virtual Clock::time_point now() const;
+
+    /**
+     * \brief Block a worker until a time is reached, a cycle finished, or a stop is requested
+     *
+     * \param lock Lock of the scheduler, held when called and when returning
+     * \param condition Condition signalled when a cycle finished
+     * \param stopToken Token to request to stop the worker
+     * \param time Time to wake up (time_point::max(): only when a cycle finished)
+     * \param finished Check if a cycle finished since the worker started to wait
+     */
+    virtual void waitUntil(std::unique_lock<std::mutex>& lock,
+                           std::condition_variable_any& condition,
+                           std::stop_token stopToken,
+                           Clock::time_point time,
+                           const std::function<bool()>& finished);
+  };
+
+  /**
+   * \brief Central scheduler of all monitoring groups
+   *
+   * A fixed number of worker threads is shared by all groups. Every group is released once per
+   * period and must finish before the end of it (its deadline). Idle workers pick the released
+   * group with the earliest deadline, so groups with short periods are not blocked by long ones.
+   *
+   * The duration of each cycle is measured and smoothed into an estimate of the cost of a full
+   * sweep. When a sweep does not fit (see \ref internal::computeNumShards) the devices are split
+   * into shards which are monitored in consecutive periods. The number of shards only changes
+   * after a full sweep, so that every device is monitored once per sweep. A cycle which finishes
+   * late is counted as a missed deadline and the next release is not earlier than now, i.e.
+   * missed cycles are skipped instead of being caught up.
+   */
+  class Scheduler
+  {
+  public:
+    using Clock = SchedulerClock::Clock;
+    using Job = std::function<void(const std::string&, Shard)>;
+    using Reporter = std::function<void(const GroupStatistics&)>;
+
+    constexpr static double MAX_UTILIZATION{0.8};  //!< Fraction of the worker time used by monitoring
+    constexpr static std::size_t MAX_SHARDS{64};   //!< Maximum number of shards of a group
+    constexpr static std::chrono::milliseconds MINIMUM_MONITORING_DELAY{500};  //!< Minimum pause between two cycles of a group
+
+    /**
+     * \brief Constructor
+     *
+     * Starts the worker threads. All groups are released immediately.
+     *
+     * \param configs Groups to monitor
+     * \param numWorkers Number of worker threads (at least one thread is started)
+     * \param job Function monitoring one shard of a group
+     * \param reporter Function called with the statistics of a group after every cycle (optional)
+     * \param minimumDelay Minimum pause between the end of a cycle and the start of the next one
+     * \param clock Source of time (default: steady clock)
+     */
+    Scheduler(std::span<const Config> configs,
+              std::size_t numWorkers,
+              Job job,
+              Reporter reporter = {},
+              std::chrono::milliseconds minimumDelay = MINIMUM_MONITORING_DELAY,
+              std::shared_ptr<SchedulerClock> clock = std::make_shared<SchedulerClock>());
+
+    /**
+     * \brief Destructor
+     *
+     * Waits until the running cycles finished
+     */
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler(Scheduler&&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler& operator=(Scheduler&&) = delete;
+
+    /**
+     * \brief Stop scheduling and wait until the running cycles finished
+     */
+    void stop();
+
+    /**
+     * \brief Get the statistics of all groups
+     *
+     * \return std::vector<GroupStatistics> Statistics in the order of the configs
+     */
+    [[nodiscard]] std::vector<GroupStatistics> getStatistics() const;
+
+  private:
+    /**
+     * \brief Scheduling state of one group
+     */
+    struct Group {
+      Config m_config;
+      Clock::time_point m_release{};                      //!< Start of the current period
+      Clock::time_point m_lastSweepEnd{};                 //!< End of the last full sweep
+      std::chrono::duration<double> m_sweepCost{0.};      //!< Smoothed cost of a full sweep
+      bool m_hasCost{false};                              //!< A cycle was measured
+      bool m_running{false};                              //!< A worker monitors the group
+      std::size_t m_shardIndex{0};                        //!< Next shard to be monitored
+      std::size_t m_plannedShards{1};                     //!< Shards to be used from the next sweep on
+      GroupStatistics m_statistics{};
+    };
+
+    /**
+     * \brief Main loop of a worker thread
+     *
+     * \param stopToken Token to request to stop the worker
+     */
+    void run(std::stop_token stopToken);
+
+    /**
+     * \brief Book keeping after a cycle finished, must hold the lock
+     *
+     * \param group Group
+     * \param start Start of the cycle
+     * \param end End of the cycle
+     */
+    void finishCycle(Group& group, Clock::time_point start, Clock::time_point end);
+
+    /**
+     * \brief Recompute the number of shards of all groups, must hold the lock
+     */
+    void plan();
+
+    constexpr static double COST_SMOOTHING{0.3};  //!< Weight of the newest measurement
+
+    Job m_job;
+    Reporter m_reporter;
+    std::chrono::milliseconds m_minimumDelay;
+    std::shared_ptr<SchedulerClock> m_clock;
+    std::size_t m_numWorkers;
+    mutable std::mutex m_mutex{};
+    std::condition_variable_any m_condition{};  //!< Signals finished cycles to idle workers
+    std::uint64_t m_numFinished{0};             //!< Counts finished cycles to detect notifications
+    std::vector<Group> m_groups{};
+    std::vector<std::jthread> m_workers{};
+  };
+}  // namespace nsw::mon
+
+#endif
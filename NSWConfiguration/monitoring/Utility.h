@@ -1,20 +1,21 @@
 #ifndef NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_UTILITY_H
 #define NSWCONFIGURATION_NSWCONFIGURATION_MONITORING_UTILITY_H
 
+#include <map>
+#include <memory>
 #include <ranges>
 #include <span>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
 
 #include <ers/ers.h>
-#include <is/infodictionary.h>
-
 #include <NSWConfigurationIs/Statistics.h>
 
 #include "NSWConfiguration/monitoring/Config.h"
+#include "NSWConfiguration/monitoring/IsPublisher.h"
+#include "NSWConfiguration/monitoring/Scheduler.h"
 
 using namespace std::chrono_literals;
 
@@ -48,62 +49,59 @@ namespace nsw::mon {
     const std::string& groupSetName);
 
   /**
-   * @brief Start monitoring and return threads
+   * @brief Start monitoring of all groups on shared worker threads
+   *
+   * The statistics of a group (cycle duration, achieved rate of full sweeps, number of shards
+   * and missed deadlines) are published to IS after every cycle. A warning is issued when a
+   * group has to be spread over more periods because its sweep does not fit.
    *
    * @param configs Groups to monitor
-   * @param monFunc Function that does the monitoring
-   * @param isDict IS dictionary
+   * @param numWorkers Number of worker threads shared by all groups
+   * @param monFunc Function that monitors one shard of a group
+   * @param publisher IS publisher, has to outlive the scheduler
    * @param isServerName Name of IS server to publish stats
    * @param appName Name of the app
-   * @return std::map<std::string, std::jthread> Map of group name to thread
+   * @return std::unique_ptr<nsw::mon::Scheduler> Running scheduler, stops when destroyed
    */
-  [[nodiscard]] std::map<std::string, std::jthread> startMonitoring(
+  [[nodiscard]] std::unique_ptr<nsw::mon::Scheduler> startMonitoring(
     std::span<const nsw::mon::Config> configs,
-    const std::regular_invocable<const std::string&> auto& monFunc,
-    const ISInfoDictionary* isDict,
+    std::size_t numWorkers,
+    const std::regular_invocable<const std::string&, nsw::mon::Shard> auto& monFunc,
+    nsw::mon::ISPublisher& publisher,
     const std::string& isServerName,
     const std::string& appName)
   {
     constexpr static std::string_view KEY_STATS{"Statistics"};
-    std::map<std::string, std::jthread> threads{};
+    // One entry per group, the reporter of a group is only called by the worker which finished its cycle
+    std::map<std::string, std::size_t> lastNumShards{};
     for (const auto& config : configs) {
-      threads[config.m_name] = std::jthread{[&config, isDict, &isServerName, &appName, monFunc](
-                                              const std::stop_token stopToken) {
-        while (not stopToken.stop_requested()) {
-          const auto startTime = std::chrono::high_resolution_clock::now();
-          monFunc(config.m_name);
-          const auto timeDiff = std::chrono::high_resolution_clock::now() - startTime;
-          auto stats = nsw::mon::is::Statistics{};
-          stats.time = static_cast<std::uint64_t>(
-            std::chrono::duration_cast<std::chrono::milliseconds>(timeDiff).count());
-          isDict->checkin(
-            fmt::format("{}.{}.{}.{}", isServerName, KEY_STATS, config.m_name, appName), stats);
-          const auto requestedTime = std::max(
-            0ms,
-            std::chrono::duration_cast<std::chrono::milliseconds>(config.m_frequency - timeDiff));
-          if (requestedTime == 0s) {
-            ers::warning(NSWMonitoringFrequency(
-              ERS_HERE,
-              config.m_name,
-              config.m_frequency.count(),
-              std::chrono::duration_cast<std::chrono::seconds>(timeDiff).count()));
-          }
-
-          constexpr static auto MINIMUM_MONITORING_DELAY{500ms};
-
-          const auto sleepTime = std::max(
-            MINIMUM_MONITORING_DELAY,
-            std::chrono::duration_cast<std::chrono::milliseconds>(config.m_frequency - timeDiff));
-          std::mutex mutex;
-          std::unique_lock lock(mutex);
-          std::condition_variable_any().wait_for(lock, stopToken, sleepTime, [] { return false; });
-          if (stopToken.stop_requested()) {
-            return;
-          }
-        }
-      }};
+      lastNumShards.try_emplace(config.m_name, 1);
     }
-    return threads;
+    auto report = [&publisher, isServerName, appName, lastNumShards = std::move(lastNumShards)](
+                    const nsw::mon::GroupStatistics& statistics) mutable {
+      auto stats = nsw::mon::is::Statistics{};
+      stats.time = static_cast<std::uint64_t>(statistics.m_lastDuration.count());
+      stats.sweepTime = static_cast<std::uint64_t>(statistics.m_sweepCost.count());
+      stats.rate = statistics.m_achievedRate;
+      stats.shards = static_cast<std::uint32_t>(statistics.m_numShards);
+      stats.missedDeadlines = statistics.m_numMissedDeadlines;
+      publisher.publish(isServerName, statistics.m_name, KEY_STATS, appName, stats);
+      auto& numShards = lastNumShards.at(statistics.m_name);
+      if (statistics.m_numShards > numShards) {
+        ers::warning(NSWMonitoringFrequency(
+          ERS_HERE,
+          statistics.m_name,
+          std::chrono::duration_cast<std::chrono::seconds>(statistics.m_period).count(),
+          std::chrono::duration_cast<std::chrono::seconds>(statistics.m_sweepCost).count()));
+        ERS_LOG(fmt::format("Monitoring of {} is spread over {} periods", statistics.m_name, statistics.m_numShards));
+      }
+      numShards = statistics.m_numShards;
+    };
+    return std::make_unique<nsw::mon::Scheduler>(
+      configs,
+      numWorkers,
+      [monFunc](const std::string& name, const nsw::mon::Shard shard) { monFunc(name, shard); },
+      std::move(report));
   }
 }  // namespace nsw::mon
 
@@ -0,0 +1,118 @@
+// Compare the JSON configuration loader with the previous regex-cleaning + read_json path
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <fmt/core.h>
+
+#include "NSWConfiguration/JsonParser.h"
+
+namespace po = boost::program_options;
+using boost::property_tree::ptree;
+
+namespace {
+  /// Previous implementation of JsonApi::read
+  ptree readLegacy(const std::string& path)
+  {
+    std::stringstream jsonStringStream;
+    std::ifstream inputJSONFile(path.c_str());
+    std::string line;
+
+    while (std::getline(inputJSONFile, line)) {
+      const auto found = line.find_first_not_of(" \t");
+      if (found != std::string::npos && line[found] == '/') continue;
+      if (found != std::string::npos && line[found] == '#') continue;
+      jsonStringStream << line << "\r\n";
+    }
+
+    std::string jsonString(jsonStringStream.str());
+    jsonString = std::regex_replace(jsonString, std::regex("(\\S)\\s*\\/\\/.*"), "$1");
+    jsonString = std::regex_replace(jsonString, std::regex("(\\S)\\s*#.*"), "$1");
+    jsonString = std::regex_replace(jsonString, std::regex(",(?=\\s*[}\\]])"), "");
+    jsonStringStream.str(jsonString);
+
+    ptree config;
+    boost::property_tree::read_json(jsonStringStream, config);
+    return config;
+  }
+
+  /// Mean time of one call of func in milliseconds
+  template<typename Func>
+  double measure(Func&& func, const int iterations)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+      static_cast<void>(func());
+    }
+    const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    return duration.count() / iterations;
+  }
+}  // namespace
+
+int main(int ac, const char* av[])
+{
+  std::string description = "This program compares the speed of the JSON configuration loaders";
+
+  std::vector<std::string> files;
+  std::string directory;
+  int iterations{};
+  po::options_description desc(description);
+  desc.add_options()
+    ("help,h", "produce help message")
+    ("files,f", po::value<std::vector<std::string>>(&files)->multitoken(),
+     "JSON files to be read")
+    ("directory,d", po::value<std::string>(&directory)->default_value("data"),
+     "Read all JSON files of this directory if no files are given")
+    ("iterations,i", po::value<int>(&iterations)->default_value(10),
+     "Number of times each file is read");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(ac, av, desc), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << desc << "\n";
+    return 1;
+  }
+
+  if (files.empty()) {
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+      if (entry.path().extension() == ".json") {
+        files.push_back(entry.path().string());
+      }
+    }
+  }
+
+  std::cout << fmt::format("{:<50} {:>10} {:>12} {:>12} {:>8}\n", "File", "Size [kB]", "Legacy [ms]", "New [ms]", "Speedup");
+  int result{0};
+  for (const auto& file : files) {
+    try {
+      if (readLegacy(file) != nsw::json::readFile(file)) {
+        std::cout << file << " - ERROR: Trees differ\n";
+        result = 1;
+        continue;
+      }
+      const auto legacy = measure([&file]() { return readLegacy(file); }, iterations);
+      const auto fast = measure([&file]() { return nsw::json::readFile(file); }, iterations);
+      std::cout << fmt::format("{:<50} {:>10.1f} {:>12.3f} {:>12.3f} {:>7.1f}x\n",
+                               file,
+                               static_cast<double>(std::filesystem::file_size(file)) / 1024,
+                               legacy,
+                               fast,
+                               legacy / fast);
+    } catch (const std::exception& ex) {
+      std::cout << file << " - ERROR: " << ex.what() << '\n';
+      result = 1;
+    }
+  }
+  return result;
+}
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <sstream>
 #include <numeric>
 
 #include "NSWConfiguration/ConfigReader.h"
@@ -25,6 +26,7 @@ int main(int ac, const char *av[]) {
 
     std::string config_filename;
     std::string fe_name;
+    std::size_t chunk_size;
     po::options_description desc(description);
     desc.add_options()
         ("help,h", "produce help message")
@@ -34,7 +36,10 @@ int main(int ac, const char *av[]) {
         ("name,n", po::value<std::string>(&fe_name)->
         default_value(""),
         "The name of frontend to read SCA ID.\n"
-        "If this option is left empty, all front end elements in the config file will be scanned.");
+        "If this option is left empty, all front end elements in the config file will be scanned.")
+        ("chunk-size", po::value<std::size_t>(&chunk_size)->
+        default_value(nsw::OpcClient::DEFAULT_READ_CHUNK_SIZE),
+        "Maximum number of boards read with one OPC request");
 
 
     po::variables_map vm;
@@ -82,21 +87,23 @@ int main(int ac, const char *av[]) {
 
     nsw::ConfigSender cs;
 
-    std::string scaAddress;
-    bool scaOnline; 
-    std::cout << "Board" << "\t"<< "ID" <<"\t"<< "Online" <<"\t"<< "Address" <<std::endl;
+    // One read request per OPC server (and chunk of boards) instead of three per board
+    const auto status = cs.readSCAStatus(frontend_configs, chunk_size);
 
-    for (auto & feb : frontend_configs) {
+    const auto print = [](const auto& value) -> std::string {
+      if (not value) {
+        return "-";
+      }
+      std::stringstream ss;
+      ss << *value;
+      return ss.str();
+    };
 
-    const auto scaID=cs.readSCAID(feb);
-	scaAddress=cs.readSCAAddress(feb);
-	scaOnline=cs.readSCAOnline(feb);
-	
-    std::cout << feb.getAddress() << "\t"<< scaID << "\t" << scaOnline << "\t" << scaAddress << std::endl;
+    std::cout << "Board" << "\t"<< "ID" <<"\t"<< "Online" <<"\t"<< "Address" <<std::endl;
 
+    for (std::size_t i = 0; i < frontend_configs.size(); ++i) {
+      std::cout << frontend_configs[i].getAddress() << "\t" << print(status[i].id) << "\t"
+                << print(status[i].online) << "\t" << print(status[i].address) << std::endl;
     }
-
-
-
 }
 
@@ -0,0 +1,158 @@
+#include "NSWConfiguration/BitVector.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include "NSWConfiguration/Constants.h"
+#include "NSWConfiguration/Utility.h"
+
+namespace {
+  constexpr std::size_t numBytesFor(const std::size_t numBits)
+  {
+    return (numBits + nsw::NUM_BITS_IN_BYTE - 1) / nsw::NUM_BITS_IN_BYTE;
+  }
+
+  /**
+   * \brief Mask of the lowest bits of a value
+   */
+  constexpr std::uint64_t lowMask(const std::size_t width)
+  {
+    return width >= nsw::BitVector::MAX_FIELD_WIDTH ? ~std::uint64_t{0}
+                                                    : (std::uint64_t{1} << width) - 1;
+  }
+}  // namespace
+
+nsw::BitVector::BitVector(const std::size_t numBits) : m_bytes(numBytesFor(numBits), 0), m_size(numBits)
+{}
+
+nsw::BitVector nsw::BitVector::fromString(const std::string_view bits)
+{
+  BitVector result(bits.size());
+  for (std::size_t pos = 0; pos < bits.size(); ++pos) {
+    if (bits[pos] != '0' and bits[pos] != '1') {
+      throw std::invalid_argument(
+        fmt::format("Invalid character '{}' at position {} of bit string", bits[pos], pos));
+    }
+    result.set(pos, bits[pos] == '1');
+  }
+  return result;
+}
+
+nsw::BitVector nsw::BitVector::fromBytes(const std::span<const std::uint8_t> bytes)
+{
+  BitVector result{};
+  result.m_bytes.assign(std::cbegin(bytes), std::cend(bytes));
+  result.m_size = bytes.size() * NUM_BITS_IN_BYTE;
+  return result;
+}
+
+std::uint64_t nsw::BitVector::reverseBits(std::uint64_t value, const std::size_t width)
+{
+  std::uint64_t result{0};
+  for (std::size_t bit = 0; bit < width; ++bit) {
+    result = (result << 1U) | (value & 1U);
+    value >>= 1U;
+  }
+  return result;
+}
+
+void nsw::BitVector::reserve(const std::size_t numBits)
+{
+  m_bytes.reserve(numBytesFor(numBits));
+}
+
+bool nsw::BitVector::test(const std::size_t pos) const
+{
+  return extract(pos, 1) != 0;
+}
+
+void nsw::BitVector::set(const std::size_t pos, const bool value)
+{
+  insert(pos, 1, value ? 1 : 0);
+}
+
+std::uint64_t nsw::BitVector::extract(std::size_t pos, std::size_t width) const
+{
+  checkRange(pos, width);
+  std::uint64_t result{0};
+  // Process the field in chunks which do not cross byte boundaries
+  while (width > 0) {
+    const auto offset = pos % NUM_BITS_IN_BYTE;
+    const auto chunk = std::min(NUM_BITS_IN_BYTE - offset, width);
+    const auto shift = NUM_BITS_IN_BYTE - offset - chunk;
+    const auto bits = (m_bytes[pos / NUM_BITS_IN_BYTE] >> shift) & lowMask(chunk);
+    result = (result << chunk) | bits;
+    pos += chunk;
+    width -= chunk;
+  }
+  return result;
+}
+
+void nsw::BitVector::insert(std::size_t pos, std::size_t width, const std::uint64_t value)
+{
+  checkRange(pos, width);
+  while (width > 0) {
+    const auto offset = pos % NUM_BITS_IN_BYTE;
+    const auto chunk = std::min(NUM_BITS_IN_BYTE - offset, width);
+    const auto shift = NUM_BITS_IN_BYTE - offset - chunk;
+    const auto bits = (value >> (width - chunk)) & lowMask(chunk);
+    auto& byte = m_bytes[pos / NUM_BITS_IN_BYTE];
+    byte = static_cast<std::uint8_t>((byte & ~(lowMask(chunk) << shift)) | (bits << shift));
+    pos += chunk;
+    width -= chunk;
+  }
+}
+
+void nsw::BitVector::append(const std::uint64_t value, const std::size_t width)
+{
+  const auto pos = m_size;
+  m_size += width;
+  m_bytes.resize(numBytesFor(m_size), 0);
+  insert(pos, width, value);
+}
+
+void nsw::BitVector::append(const BitVector& other)
+{
+  if (m_size % NUM_BITS_IN_BYTE == 0) {
+    m_bytes.insert(std::end(m_bytes), std::cbegin(other.m_bytes), std::cend(other.m_bytes));
+    m_size += other.m_size;
+    return;
+  }
+  reserve(m_size + other.m_size);
+  std::size_t pos{0};
+  while (pos < other.m_size) {
+    const auto width = std::min(MAX_FIELD_WIDTH, other.m_size - pos);
+    append(other.extract(pos, width), width);
+    pos += width;
+  }
+}
+
+std::string nsw::BitVector::toString() const
+{
+  std::string result(m_size, '0');
+  for (std::size_t pos = 0; pos < m_size; ++pos) {
+    if (test(pos)) {
+      result[pos] = '1';
+    }
+  }
+  return result;
+}
+
+std::string nsw::BitVector::toHexString() const
+{
+  return vectorToHexString(m_bytes);
+}
+
+void nsw::BitVector::checkRange(const std::size_t pos, const std::size_t width) const
+{
+  if (width > MAX_FIELD_WIDTH) {
+    throw std::out_of_range(
+      fmt::format("Bit field width {} exceeds maximum of {}", width, MAX_FIELD_WIDTH));
+  }
+  if (pos > m_size or width > m_size - pos) {
+    throw std::out_of_range(
+      fmt::format("Bit field [{}, {}) out of range of bit vector of size {}", pos, pos + width, m_size));
+  }
+}
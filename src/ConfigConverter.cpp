@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -12,20 +13,233 @@
 
 using boost::property_tree::ptree;
 
+namespace {
+  int countTrailingZeros(const std::uint32_t t_val)
+  {
+    return __builtin_ctz(t_val);
+  }
+
+  int countTrailingZeros(const __uint128_t t_val)
+  {
+    // __builtin_ctzll is undefined for 0, t_val itself must not be 0
+    const auto trailing = static_cast<std::uint64_t>(t_val);
+    if (trailing != 0) {
+      return __builtin_ctzll(trailing);
+    }
+    constexpr auto SIZE_LEADING = 64;
+    const std::uint64_t leading = static_cast<std::uint64_t>(t_val >> static_cast<unsigned int>(SIZE_LEADING));
+    return SIZE_LEADING + __builtin_ctzll(leading);
+  }
+
+  template<nsw::ConfigConversionType DeviceType>
+  const nsw::translationMapType_t<DeviceType>& getTranslationMap()
+  {
+    using nsw::ConfigConversionType;
+    if constexpr (DeviceType == ConfigConversionType::ROC_ANALOG) {
+      return TRANSLATION_MAP_ROC_ANALOG;
+    }
+    if constexpr (DeviceType == ConfigConversionType::ROC_DIGITAL) {
+      return TRANSLATION_MAP_ROC_DIGITAL;
+    }
+    if constexpr (DeviceType == ConfigConversionType::ART) {
+      return TRANSLATION_MAP_ART_CORE;
+    }
+    if constexpr (DeviceType == ConfigConversionType::ART_PS) {
+      return TRANSLATION_MAP_ART_PS;
+    }
+    if constexpr (DeviceType == ConfigConversionType::TDS) {
+      return TRANSLATION_MAP_TDS;
+    }
+    throw std::logic_error("Unknown type. No translation map found.");
+  }
+
+  const i2c::AddressRegisterMap& getRegisterMapping(const nsw::ConfigConversionType t_type)
+  {
+    using nsw::ConfigConversionType;
+    switch (t_type) {
+    case ConfigConversionType::ROC_DIGITAL:
+      return ROC_DIGITAL_REGISTERS;
+    case ConfigConversionType::ROC_ANALOG:
+      return ROC_ANALOG_REGISTERS;
+    case ConfigConversionType::TDS:
+      return TDS_REGISTERS;
+    case ConfigConversionType::ART:
+      return ART_CORE_REGISTERS;
+    case ConfigConversionType::ART_PS:
+      return ART_PS_REGISTERS;
+    default:
+      throw std::logic_error("Unknown type. No register mapping found.");
+    }
+  }
+
+  template<typename IntType>
+  int shiftOf(const IntType t_mask)
+  {
+    return t_mask == 0 ? 0 : countTrailingZeros(t_mask);
+  }
+}  // namespace
+
 namespace nsw {
   template<ConfigConversionType DeviceType>
-  const std::unordered_map<ConfigConversionType, i2c::AddressRegisterMap>
-    ConfigConverter<DeviceType>::REGISTER_MAPPINGS = {
-      {ConfigConversionType::ROC_DIGITAL, ROC_DIGITAL_REGISTERS},
-      {ConfigConversionType::ROC_ANALOG, ROC_ANALOG_REGISTERS},
-      {ConfigConversionType::TDS, TDS_REGISTERS},
-      {ConfigConversionType::ART, ART_CORE_REGISTERS},
-      {ConfigConversionType::ART_PS, ART_PS_REGISTERS},
-  };
+  const ConfigTranslationIndex<DeviceType>& ConfigTranslationIndex<DeviceType>::getInstance()
+  {
+    static const ConfigTranslationIndex index{};
+    return index;
+  }
+
+  template<ConfigConversionType DeviceType>
+  ConfigTranslationIndex<DeviceType>::ConfigTranslationIndex()
+  {
+    const auto& translationMap = getTranslationMap<DeviceType>();
+    const auto& registerMapping = getRegisterMapping(DeviceType);
+
+    m_valueOffsets.reserve(translationMap.size() + 1);
+    for (const auto& [valueName, units] : translationMap) {
+      const auto value = m_valueNames.size();
+      m_valueLookup.emplace(valueName, value);
+      m_valueNames.push_back(valueName);
+      m_valueOffsets.push_back(m_units.size());
+      for (const auto& unit : units) {
+        const auto registerName = unit.m_registerName.substr(0, unit.m_registerName.find('.'));
+        const auto [iter, inserted] = m_registerLookup.try_emplace(registerName, m_registerNames.size());
+        if (inserted) {
+          m_registerNames.push_back(registerName);
+          const auto mapping = registerMapping.find(registerName);
+          m_registerSizes.push_back(
+            mapping == std::cend(registerMapping)
+              ? 0
+              : std::accumulate(std::cbegin(mapping->second),
+                                std::cend(mapping->second),
+                                std::size_t{0},
+                                [](const std::size_t sum, const i2c::RegisterSizePair& p) { return sum + p.second; }));
+        }
+        // A sub-register belongs to the first value which contains it
+        m_subRegisterLookup.try_emplace(unit.m_registerName, m_units.size());
+        m_subRegisterNames.push_back(unit.m_registerName);
+        m_units.push_back(Unit{value,
+                               iter->second,
+                               unit.m_maskRegister,
+                               unit.m_maskValue,
+                               shiftOf(unit.m_maskRegister),
+                               shiftOf(unit.m_maskValue)});
+      }
+    }
+    m_valueOffsets.push_back(m_units.size());
+
+    // Group the units by register (counting sort keeps the order of the translation map)
+    m_registerOffsets.assign(m_registerNames.size() + 1, 0);
+    for (const auto& unit : m_units) {
+      ++m_registerOffsets[unit.m_register + 1];
+    }
+    std::partial_sum(std::cbegin(m_registerOffsets), std::cend(m_registerOffsets), std::begin(m_registerOffsets));
+    m_registerUnits.resize(m_units.size());
+    auto next = m_registerOffsets;
+    for (std::size_t unit = 0; unit < m_units.size(); ++unit) {
+      m_registerUnits[next[m_units[unit].m_register]++] = unit;
+    }
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::optional<std::size_t> ConfigTranslationIndex<DeviceType>::findValue(const std::string& name) const
+  {
+    if (const auto iter = m_valueLookup.find(name); iter != std::cend(m_valueLookup)) {
+      return iter->second;
+    }
+    return std::nullopt;
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::optional<std::size_t> ConfigTranslationIndex<DeviceType>::findRegister(const std::string& name) const
+  {
+    if (const auto iter = m_registerLookup.find(name); iter != std::cend(m_registerLookup)) {
+      return iter->second;
+    }
+    return std::nullopt;
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::optional<std::size_t> ConfigTranslationIndex<DeviceType>::findSubRegister(const std::string& name) const
+  {
+    if (const auto iter = m_subRegisterLookup.find(name); iter != std::cend(m_subRegisterLookup)) {
+      return iter->second;
+    }
+    return std::nullopt;
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::size_t ConfigTranslationIndex<DeviceType>::getValue(const std::string& name) const
+  {
+    if (const auto value = findValue(name)) {
+      return *value;
+    }
+    throw std::out_of_range(fmt::format("Did not find value {} in translation map", name));
+  }
+
+  template<ConfigConversionType DeviceType>
+  auto ConfigTranslationIndex<DeviceType>::getUnitsOfValue(const std::size_t value) const
+    -> std::span<const Unit>
+  {
+    return std::span{m_units}.subspan(m_valueOffsets.at(value),
+                                      m_valueOffsets.at(value + 1) - m_valueOffsets.at(value));
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::span<const std::string> ConfigTranslationIndex<DeviceType>::getSubRegisterNamesOfValue(
+    const std::size_t value) const
+  {
+    return std::span{m_subRegisterNames}.subspan(m_valueOffsets.at(value),
+                                                 m_valueOffsets.at(value + 1) - m_valueOffsets.at(value));
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::span<const std::size_t> ConfigTranslationIndex<DeviceType>::getUnitsOfRegister(const std::size_t reg) const
+  {
+    return std::span{m_registerUnits}.subspan(m_registerOffsets.at(reg),
+                                              m_registerOffsets.at(reg + 1) - m_registerOffsets.at(reg));
+  }
+
+  template<ConfigConversionType DeviceType>
+  std::vector<std::size_t> ConfigTranslationIndex<DeviceType>::getRegistersOfValues(
+    const std::span<const std::size_t> values) const
+  {
+    std::vector<std::size_t> result{};
+    for (const auto value : values) {
+      for (const auto& unit : getUnitsOfValue(value)) {
+        result.push_back(unit.m_register);
+      }
+    }
+    std::ranges::sort(result);
+    const auto [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+    return result;
+  }
+
+  template<ConfigConversionType DeviceType>
+  auto ConfigTranslationIndex<DeviceType>::decodeValue(const std::size_t value,
+                                                       const std::span<const IntType> registers) const
+    -> IntType
+  {
+    IntType result{0};
+    for (const auto& unit : getUnitsOfValue(value)) {
+      result += ((registers[unit.m_register] & unit.m_maskRegister) >> unit.m_shiftRegister) << unit.m_shiftValue;
+    }
+    return result;
+  }
+
+  template<ConfigConversionType DeviceType>
+  void ConfigTranslationIndex<DeviceType>::encodeValue(const std::size_t value,
+                                                       const IntType data,
+                                                       const std::span<IntType> registers,
+                                                       const std::span<IntType> masks) const
+  {
+    for (const auto& unit : getUnitsOfValue(value)) {
+      registers[unit.m_register] += ((data & unit.m_maskValue) >> unit.m_shiftValue) << unit.m_shiftRegister;
+      masks[unit.m_register] |= unit.m_maskRegister;
+    }
+  }
 
   template<ConfigConversionType DeviceType>
   ConfigConverter<DeviceType>::ConfigConverter(const ptree& t_config, const ConfigType t_type) :
-    m_translationMap(getTranslationMap()),
     m_registerTree([this, t_type, &t_config]() {
       if (t_type == ConfigType::REGISTER_BASED) {
         return t_config;
@@ -67,8 +281,9 @@ namespace nsw {
   template<ConfigConversionType DeviceType>
   void ConfigConverter<DeviceType>::checkPaths(const std::vector<std::string>& t_paths) const
   {
-    if (not std::all_of(std::begin(t_paths), std::end(t_paths), [this](const auto& t_element) {
-          return m_translationMap.find(t_element) != m_translationMap.end();
+    const auto& index = Index::getInstance();
+    if (not std::all_of(std::begin(t_paths), std::end(t_paths), [&index](const auto& t_element) {
+          return index.findValue(t_element).has_value();
         })) {
       throw std::runtime_error("Did not find all nodes in translation map");
     }
@@ -80,21 +295,18 @@ namespace nsw {
     const auto allPaths = getAllPaths(t_config);
     checkPaths(allPaths);
 
+    const auto& index = Index::getInstance();
     ptree newTree;
-    std::for_each(
-      std::begin(allPaths), std::end(allPaths), [this, &t_config, &newTree](const auto& t_element) {
-        const auto translationUnits = m_translationMap.at(t_element);
-        std::for_each(std::begin(translationUnits),
-                      std::end(translationUnits),
-                      [&t_config, &newTree, &t_element](const auto& t_unit) {
-                        // rotate to right by first least significant non-zero bit
-                        auto value =
-                          (t_unit.m_maskValue &
-                           t_config.get<translationMapIntType_t<DeviceType>>(t_element)) >>
-                          ctz(t_unit.m_maskValue);
-                        newTree.put(t_unit.m_registerName, value);
-                      });
-      });
+    for (const auto& path : allPaths) {
+      const auto value = index.getValue(path);
+      const auto data = t_config.get<translationMapIntType_t<DeviceType>>(path);
+      const auto units = index.getUnitsOfValue(value);
+      const auto names = index.getSubRegisterNamesOfValue(value);
+      for (std::size_t i = 0; i < units.size(); ++i) {
+        // rotate to right by first least significant non-zero bit
+        newTree.put(names[i], (units[i].m_maskValue & data) >> units[i].m_shiftValue);
+      }
+    }
 
     return newTree;
   }
@@ -106,36 +318,17 @@ namespace nsw {
     const auto allPaths = getAllPaths(t_config);
     checkPaths(allPaths);
 
-    const auto calcValue = [](const auto t_val, const auto t_maskRegister, const auto t_maskValue) {
-      return ((t_val & t_maskValue) >> ctz(t_maskValue)) << ctz(t_maskRegister);
-    };
+    const auto& index = Index::getInstance();
+    TranslatedConfig result{std::vector<translationMapIntType_t<DeviceType>>(index.getNumRegisters()),
+                            std::vector<translationMapIntType_t<DeviceType>>(index.getNumRegisters())};
+    for (const auto& path : allPaths) {
+      index.encodeValue(index.getValue(path),
+                        t_config.get<translationMapIntType_t<DeviceType>>(path),
+                        result.m_registers,
+                        result.m_mask);
+    }
 
-    ptree newTree;
-    std::map<std::string, translationMapIntType_t<DeviceType>> mask;
-    std::for_each(
-      std::begin(allPaths),
-      std::end(allPaths),
-      [this, &mask, &t_config, &newTree, &calcValue](const auto& t_element) {
-        const auto translationUnit = m_translationMap.at(t_element);
-        std::for_each(
-          std::begin(translationUnit),
-          std::end(translationUnit),
-          [this, &mask, &t_config, &newTree, &t_element, &calcValue](const auto& t_unit) {
-            const auto value =
-              calcValue(t_config.get<translationMapIntType_t<DeviceType>>(t_element),
-                        t_unit.m_maskRegister,
-                        t_unit.m_maskValue);
-            const auto name = t_unit.m_registerName.substr(0, t_unit.m_registerName.find('.'));
-            newTree.put(name, newTree.get(name, 0u) + value);
-            if (mask.find(name) != mask.end()) {
-              mask[name] = mask.at(name) | t_unit.m_maskRegister;
-            } else {
-              mask[name] = t_unit.m_maskRegister;
-            }
-          });
-      });
-
-    return {newTree, mask};
+    return result;
   }
 
   template<ConfigConversionType DeviceType>
@@ -143,35 +336,27 @@ namespace nsw {
   {
     const auto allPaths = getAllPaths(t_config);
 
-    const auto findOldRegisterName = [this](const std::string& t_name) {
-      for (const auto& [newName, element] : m_translationMap) {
-        const auto item =
-          std::find_if(std::begin(element), std::end(element), [&t_name](const auto& t_unit) {
-            return t_name == t_unit.m_registerName;
-          });
-        if (item != std::end(element)) {
-          return std::make_pair(newName, *item);
-        }
+    const auto& index = Index::getInstance();
+    std::vector<translationMapIntType_t<DeviceType>> values(index.getNumValues());
+    std::vector<std::size_t> order{};
+    std::vector<bool> seen(index.getNumValues(), false);
+    for (const auto& path : allPaths) {
+      const auto unitIndex = index.findSubRegister(path);
+      if (not unitIndex) {
+        throw std::runtime_error("Did not find node " + path + " in translation map");
       }
-      throw std::runtime_error("Did not find node " + t_name + " in translation map");
-    };
-
-    const auto calcValue = [](const auto t_val, const auto t_maskValue) {
-      return t_val << ctz(t_maskValue);
-    };
+      const auto& unit = index.getUnit(*unitIndex);
+      values[unit.m_value] += t_config.get<translationMapIntType_t<DeviceType>>(path) << unit.m_shiftValue;
+      if (not seen[unit.m_value]) {
+        seen[unit.m_value] = true;
+        order.push_back(unit.m_value);
+      }
+    }
 
     ptree newTree;
-    std::for_each(std::begin(allPaths),
-                  std::end(allPaths),
-                  [&t_config, &newTree, &calcValue, &findOldRegisterName](const auto& t_element) {
-                    const auto tmp = findOldRegisterName(t_element);
-                    const auto newName = tmp.first;
-                    const auto unit = tmp.second;
-                    const auto value =
-                      calcValue(t_config.get<translationMapIntType_t<DeviceType>>(t_element),
-                                unit.m_maskValue);
-                    newTree.put(newName, newTree.get(newName, 0u) + value);
-                  });
+    for (const auto value : order) {
+      newTree.put(index.getValueName(value), values[value]);
+    }
 
     return newTree;
   }
@@ -193,7 +378,7 @@ namespace nsw {
     const i2c::AddressBitstreamMap& t_reference) const
   {
     const auto func = [&t_reference](const std::string& t_registerName) {
-      return binaryStringToInt(t_reference.at(t_registerName));
+      return bitVectorToInt(t_reference.at(t_registerName));
     };
 
     return readMissingRegisterParts(func);
@@ -226,12 +411,11 @@ namespace nsw {
   template<ConfigConversionType DeviceType>
   std::unordered_set<std::string> ConfigConverter<DeviceType>::getRegsForValue(const std::string& name)
   {
+    const auto& index = Index::getInstance();
     std::unordered_set<std::string> result{};
-    const auto& list = getTranslationMap().at(name);
-    std::transform(std::cbegin(list),
-                   std::cend(list),
-                   std::inserter(result, std::begin(result)),
-                   [](const auto& element) { return element.m_registerName.substr(0, element.m_registerName.find('.')); });
+    for (const auto& unit : index.getUnitsOfValue(index.getValue(name))) {
+      result.insert(index.getRegisterName(unit.m_register));
+    }
     return result;
   }
 
@@ -243,39 +427,25 @@ namespace nsw {
   {
     const auto allPaths = getAllPaths(t_config);
 
-    const auto& translationMap = getTranslationMap();
-    std::vector<typename std::decay_t<decltype(translationMap)>::mapped_type::value_type> units{};
-    for (const auto& path : allPaths) {
-      bool found = false;
-      for (const auto& [valueName, element] : translationMap) {
-        const auto item =
-          std::find_if(std::begin(element), std::end(element), [&path](const auto& t_unit) {
-            return path == t_unit.m_registerName.substr(0, t_unit.m_registerName.find('.'));
-          });
-        if (item != std::end(element)) {
-          units.push_back(*item);
-          found = true;
-        }
-      }
-      if (not found) {
-        throw std::runtime_error(fmt::format("Did not find register {} in translation map", path));
-      }
+    const auto& index = Index::getInstance();
+    std::vector<bool> requested(index.getNumValues(), false);
+    for (const auto& valueName : t_values) {
+      requested[index.getValue(valueName)] = true;
     }
 
     std::map<std::string, translationMapIntType_t<DeviceType>> subregisterBasedMap{};
-    for (const auto& unit : units) {
-      if (std::any_of(std::cbegin(t_values), std::cend(t_values), [&unit](const auto& valueName) {
-            const auto& element = getTranslationMap().at(valueName);
-            return std::any_of(
-              std::cbegin(element), std::cend(element), [&unit](const auto& unitRequired) {
-                return unit.m_registerName == unitRequired.m_registerName;
-              });
-          })) {
-        subregisterBasedMap[unit.m_registerName] =
-          (t_config.get<translationMapIntType_t<DeviceType>>(
-             unit.m_registerName.substr(0, unit.m_registerName.find('.'))) &
-           unit.m_maskRegister) >>
-          ctz(unit.m_maskRegister);
+    for (const auto& path : allPaths) {
+      const auto reg = index.findRegister(path);
+      if (not reg) {
+        throw std::runtime_error(fmt::format("Did not find register {} in translation map", path));
+      }
+      const auto contents = t_config.get<translationMapIntType_t<DeviceType>>(path);
+      for (const auto unitIndex : index.getUnitsOfRegister(*reg)) {
+        const auto& unit = index.getUnit(unitIndex);
+        if (requested[unit.m_value]) {
+          subregisterBasedMap[index.getSubRegisterName(unitIndex)] =
+            (contents & unit.m_maskRegister) >> unit.m_shiftRegister;
+        }
       }
     }
 
@@ -285,21 +455,7 @@ namespace nsw {
   template<ConfigConversionType DeviceType>
   int ConfigConverter<DeviceType>::ctz(const translationMapIntType_t<DeviceType> t_val)
   {
-    return __builtin_ctz(t_val);
-  }
-
-  template<>
-  int ConfigConverter<ConfigConversionType::TDS>::ctz(
-    const translationMapIntType_t<ConfigConversionType::TDS> t_val)
-  {
-    const auto trailing = static_cast<std::uint64_t>(t_val);
-    auto result = __builtin_ctzll(trailing);
-    constexpr auto SIZE_LEADING = 64;
-    if (result != SIZE_LEADING) {
-      return result;
-    }
-    const std::uint64_t leading = static_cast<std::uint64_t>(t_val >> static_cast<unsigned int>(SIZE_LEADING));
-    return SIZE_LEADING + __builtin_ctzll(leading);
+    return countTrailingZeros(t_val);
   }
 
   template<ConfigConversionType DeviceType>
@@ -318,48 +474,32 @@ namespace nsw {
   }
 
   template<ConfigConversionType DeviceType>
-  translationMapIntType_t<DeviceType> ConfigConverter<DeviceType>::binaryStringToInt(
-    const std::string& t_string)
+  translationMapIntType_t<DeviceType> ConfigConverter<DeviceType>::bitVectorToInt(
+    const nsw::BitVector& t_bits)
   {
-    return static_cast<translationMapIntType_t<DeviceType>>(std::stoul(t_string, nullptr, 2));
+    return static_cast<translationMapIntType_t<DeviceType>>(t_bits.toInteger());
   }
 
   template<>
   translationMapIntType_t<ConfigConversionType::TDS>
-  ConfigConverter<ConfigConversionType::TDS>::binaryStringToInt(const std::string& t_string)
+  ConfigConverter<ConfigConversionType::TDS>::bitVectorToInt(const nsw::BitVector& t_bits)
   {
-    if (t_string.size() > 128U) {
-      throw std::runtime_error("String longer that 128. Cannot convert into a 128bit integer.");
+    if (t_bits.size() > 128U) {
+      throw std::runtime_error("Bitstream longer that 128. Cannot convert into a 128bit integer.");
     }
-    if (t_string.size() <= 64U) {
-      return static_cast<__uint128_t>(std::stoul(t_string, nullptr, 2));
+    if (t_bits.size() <= 64U) {
+      return static_cast<__uint128_t>(t_bits.toInteger());
     }
-    const std::string leading = t_string.substr(0, 64);
-    const std::string trailing = t_string.substr(64);
-    return (static_cast<__uint128_t>(std::stoul(leading, nullptr, 2)) << 64U) +
-           std::stoul(trailing, nullptr, 2);
+    const auto trailingSize = t_bits.size() - 64U;
+    return (static_cast<__uint128_t>(t_bits.extract(0, 64)) << trailingSize) +
+           t_bits.extract(64, trailingSize);
   }
 
-  template<ConfigConversionType DeviceType>
-  const translationMapType_t<DeviceType>& ConfigConverter<DeviceType>::getTranslationMap()
-  {
-    if constexpr (DeviceType == ConfigConversionType::ROC_ANALOG) {
-      return TRANSLATION_MAP_ROC_ANALOG;
-    }
-    if constexpr (DeviceType == ConfigConversionType::ROC_DIGITAL) {
-      return TRANSLATION_MAP_ROC_DIGITAL;
-    }
-    if constexpr (DeviceType == ConfigConversionType::ART) {
-      return TRANSLATION_MAP_ART_CORE;
-    }
-    if constexpr (DeviceType == ConfigConversionType::ART_PS) {
-      return TRANSLATION_MAP_ART_PS;
-    }
-    if constexpr (DeviceType == ConfigConversionType::TDS) {
-      return TRANSLATION_MAP_TDS;
-    }
-    throw std::logic_error("Unknown type. No translation map found.");
-  }
+  template class ConfigTranslationIndex<ConfigConversionType::ROC_ANALOG>;
+  template class ConfigTranslationIndex<ConfigConversionType::ROC_DIGITAL>;
+  template class ConfigTranslationIndex<ConfigConversionType::TDS>;
+  template class ConfigTranslationIndex<ConfigConversionType::ART>;
+  template class ConfigTranslationIndex<ConfigConversionType::ART_PS>;
 
   template class ConfigConverter<ConfigConversionType::ROC_ANALOG>;
   template class ConfigConverter<ConfigConversionType::ROC_DIGITAL>;
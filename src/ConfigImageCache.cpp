@@ -0,0 +1,217 @@
+#include "NSWConfiguration/ConfigImageCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <fmt/core.h>
+
+#include <ers/ers.h>
+
+namespace {
+  constexpr std::string_view VERSION_KEY{"version"};
+  constexpr std::string_view VMM_KEY{"vmm"};
+  constexpr std::string_view I2C_KEY{"i2c"};
+
+  /**
+   * \brief 128 bit FNV-1a hash, fed like a string so that the canonical form is never stored
+   */
+  class Fnv1a128
+  {
+  public:
+    void push_back(const char character)
+    {
+      m_hash = (m_hash ^ static_cast<std::uint8_t>(character)) * PRIME;
+    }
+
+    void append(const std::string_view text)
+    {
+      for (const auto character : text) {
+        push_back(character);
+      }
+    }
+
+    [[nodiscard]] std::string toString() const
+    {
+      constexpr unsigned BITS_PER_WORD{64};
+      return fmt::format("{:016x}{:016x}",
+                         static_cast<std::uint64_t>(m_hash >> BITS_PER_WORD),
+                         static_cast<std::uint64_t>(m_hash));
+    }
+
+  private:
+    __extension__ using Hash = unsigned __int128;  // GCC and Clang
+    static constexpr Hash PRIME{(Hash{1} << 88U) + 0x13bU};
+    static constexpr Hash OFFSET{(Hash{0x6c62272e07bb0142} << 64U) + 0x62b821756295c58d};
+    Hash m_hash{OFFSET};
+  };
+
+  template<typename Sink>
+  void appendEscaped(Sink& key, const std::string_view text)
+  {
+    for (const auto character : text) {
+      if (character == '\\' or character == '{' or character == '}' or character == '=' or character == ';' or
+          character == '+' or character == '#') {
+        key.push_back('\\');
+      }
+      key.push_back(character);
+    }
+  }
+
+  template<typename Sink>
+  void appendCanonical(Sink& key, const boost::property_tree::ptree& tree)
+  {
+    appendEscaped(key, tree.data());
+    if (tree.empty()) {
+      return;
+    }
+    std::vector<const boost::property_tree::ptree::value_type*> children;
+    children.reserve(tree.size());
+    for (const auto& child : tree) {
+      children.push_back(&child);
+    }
+    std::ranges::stable_sort(children, {}, [](const auto* child) -> const std::string& { return child->first; });
+    key.push_back('{');
+    for (const auto* child : children) {
+      appendEscaped(key, child->first);
+      key.push_back('=');
+      appendCanonical(key, child->second);
+      key.push_back(';');
+    }
+    key.push_back('}');
+  }
+
+  std::string makeKey(const std::string_view domain, const Fnv1a128& hash)
+  {
+    return fmt::format("{}:{}", domain, hash.toString());
+  }
+}  // namespace
+
+std::string nsw::buildConfigImageKey(const std::string_view domain, const boost::property_tree::ptree& config)
+{
+  Fnv1a128 hash{};
+  appendCanonical(hash, config);
+  return makeKey(domain, hash);
+}
+
+std::string nsw::buildConfigImageKey(const std::string_view domain, const ConfigOverlay& config)
+{
+  // Unescaped '+' and '#' never occur in a canonical form, the variants cannot collide
+  Fnv1a128 hash{};
+  const auto& common = config.getCommon();
+  if (common.m_fingerprint.empty()) {
+    appendCanonical(hash, common.m_tree);
+    if (not config.getOverrides().empty()) {
+      hash.push_back('+');
+      appendCanonical(hash, config.getOverrides());
+    }
+    return makeKey(domain, hash);
+  }
+  hash.push_back('#');
+  hash.append(common.m_fingerprint);
+  hash.push_back(':');
+  appendCanonical(hash, config.getOverrides());
+  return makeKey(domain, hash);
+}
+
+std::string nsw::buildConfigFingerprint(const boost::property_tree::ptree& config)
+{
+  Fnv1a128 hash{};
+  appendCanonical(hash, config);
+  return hash.toString();
+}
+
+void nsw::saveConfigImageCaches(const std::string& filename)
+{
+  // ptree paths are split at '.', nodes are added with push_back to keep the keys verbatim
+  const auto makeEntry = [](const std::string& key, boost::property_tree::ptree image) {
+    boost::property_tree::ptree entry;
+    entry.push_back({"key", boost::property_tree::ptree{key}});
+    entry.push_back({"image", std::move(image)});
+    return entry;
+  };
+
+  boost::property_tree::ptree vmms;
+  for (const auto& [key, image] : VmmImageCache::getInstance().getEntries()) {
+    vmms.push_back({"", makeEntry(key, boost::property_tree::ptree{image->toString()})});
+  }
+  boost::property_tree::ptree i2cs;
+  for (const auto& [key, image] : I2cImageCache::getInstance().getEntries()) {
+    boost::property_tree::ptree bitstreams;
+    for (const auto& [address, bitstream] : *image) {
+      bitstreams.push_back({address, boost::property_tree::ptree{bitstream.toString()}});
+    }
+    i2cs.push_back({"", makeEntry(key, std::move(bitstreams))});
+  }
+
+  boost::property_tree::ptree tree;
+  tree.push_back({std::string{VERSION_KEY}, boost::property_tree::ptree{std::to_string(CONFIG_IMAGE_FILE_VERSION)}});
+  tree.push_back({std::string{VMM_KEY}, std::move(vmms)});
+  tree.push_back({std::string{I2C_KEY}, std::move(i2cs)});
+  boost::property_tree::write_json(filename, tree, std::locale(), false);
+}
+
+std::size_t nsw::loadConfigImageCaches(const std::string& filename)
+{
+  boost::property_tree::ptree tree;
+  try {
+    boost::property_tree::read_json(filename, tree);
+  } catch (const boost::property_tree::json_parser_error& ex) {
+    ers::warning(ConfigImageCacheIssue(ERS_HERE, filename, fmt::format("Cannot be read, ignored: {}", ex.what())));
+    return 0;
+  }
+
+  const auto version = tree.get_optional<std::uint32_t>(std::string{VERSION_KEY});
+  if (not version or *version != CONFIG_IMAGE_FILE_VERSION) {
+    ers::warning(ConfigImageCacheIssue(
+      ERS_HERE,
+      filename,
+      fmt::format("Unsupported version {} (expected {}), ignored",
+                  version ? std::to_string(*version) : std::string{"<none>"},
+                  CONFIG_IMAGE_FILE_VERSION)));
+    return 0;
+  }
+
+  // Entries are only parsed here, whether an image matches its layout is checked on first use
+  std::size_t numImages{0};
+  std::size_t numMalformed{0};
+  const auto loadEntries = [&tree, &numImages, &numMalformed](const std::string_view domain, const auto& load) {
+    const auto entries = tree.get_child_optional(std::string{domain});
+    if (not entries) {
+      return;
+    }
+    for (const auto& [unused, entry] : *entries) {
+      try {
+        if (load(entry.get_child("key").data(), entry.get_child("image"))) {
+          ++numImages;
+        }
+      } catch (const boost::property_tree::ptree_error&) {
+        ++numMalformed;
+      } catch (const std::invalid_argument&) {
+        ++numMalformed;
+      }
+    }
+  };
+
+  loadEntries(VMM_KEY, [](const std::string& key, const boost::property_tree::ptree& image) {
+    return VmmImageCache::getInstance().preload(
+      key, std::make_shared<const nsw::BitVector>(nsw::BitVector::fromString(image.data())));
+  });
+  loadEntries(I2C_KEY, [](const std::string& key, const boost::property_tree::ptree& image) {
+    i2c::AddressBitstreamMap bitstreams;
+    for (const auto& [address, bitstream] : image) {
+      bitstreams.emplace(address, nsw::BitVector::fromString(bitstream.data()));
+    }
+    return I2cImageCache::getInstance().preload(
+      key, std::make_shared<const i2c::AddressBitstreamMap>(std::move(bitstreams)));
+  });
+
+  if (numMalformed != 0) {
+    ers::warning(ConfigImageCacheIssue(ERS_HERE, filename, fmt::format("Skipped {} malformed entries", numMalformed)));
+  }
+  return numImages;
+}
@@ -0,0 +1,72 @@
+#include "NSWConfiguration/ConfigOverlay.h"
+
+#include <utility>
+
+#include "NSWConfiguration/ConfigImageCache.h"
+
+namespace {
+  bool isArray(const boost::property_tree::ptree& tree)
+  {
+    return not tree.empty() and tree.front().first.empty();
+  }
+
+  void mergeInto(boost::property_tree::ptree& target, const boost::property_tree::ptree& overrides)
+  {
+    for (const auto& [key, node] : overrides) {
+      const auto existing = target.find(key);
+      if (existing == target.not_found()) {
+        target.push_back({key, node});
+      } else if (node.empty() or isArray(node) or existing->second.empty() or isArray(existing->second)) {
+        target.to_iterator(existing)->second = node;
+      } else {
+        mergeInto(target.to_iterator(existing)->second, node);
+      }
+    }
+  }
+}  // namespace
+
+std::optional<nsw::ConfigLayers> nsw::ConfigLayers::getChildOptional(const std::string& path) const
+{
+  const auto common = m_common->get_child_optional(path);
+  const auto overrides = m_overrides != nullptr ? m_overrides->get_child_optional(path) : boost::none;
+  if (common) {
+    return ConfigLayers{*common, overrides ? &*overrides : nullptr};
+  }
+  if (overrides) {
+    return ConfigLayers{*overrides};
+  }
+  return std::nullopt;
+}
+
+const boost::property_tree::ptree& nsw::ConfigLayers::getNode(const std::string& path) const
+{
+  if (m_overrides != nullptr) {
+    if (const auto node = m_overrides->get_child_optional(path)) {
+      return *node;
+    }
+  }
+  return m_common->get_child(path);
+}
+
+boost::property_tree::ptree nsw::ConfigLayers::materialize() const
+{
+  auto result = *m_common;
+  if (m_overrides != nullptr) {
+    mergeInto(result, *m_overrides);
+  }
+  return result;
+}
+
+std::shared_ptr<const nsw::ConfigLayer> nsw::makeSharedConfigLayer(boost::property_tree::ptree tree)
+{
+  auto fingerprint = nsw::buildConfigFingerprint(tree);
+  return std::make_shared<const ConfigLayer>(ConfigLayer{std::move(tree), std::move(fingerprint)});
+}
+
+nsw::ConfigOverlay::ConfigOverlay(boost::property_tree::ptree config) :
+  m_common{std::make_shared<const ConfigLayer>(ConfigLayer{std::move(config), {}})}
+{}
+
+nsw::ConfigOverlay::ConfigOverlay(std::shared_ptr<const ConfigLayer> common, boost::property_tree::ptree overrides) :
+  m_common{std::move(common)}, m_overrides{std::move(overrides)}
+{}
@@ -48,6 +48,27 @@ ptree ConfigReaderApi::read(const std::string& element) {
     throw std::runtime_error(fmt::format("Do not know devices of type {}", element));
 }
 
+nsw::FEBConfig ConfigReaderApi::readFEBConfig(const std::string& element) const {
+    const std::string type = nsw::getElementType(element);
+    ERS_DEBUG(2, "==> Reading front end board=" << element << " as type=" << type);
+    if (type == "MMFE8") {
+        return readFEBLayered(element, nsw::NUM_VMM_PER_MMFE8, nsw::NUM_TDS_PER_MMFE8, 0, 0);
+    } else if (type == "PFEB") {
+        return readFEBLayered(element, nsw::NUM_VMM_PER_PFEB, nsw::NUM_TDS_PER_PFEB, 0, 0);
+    } else if (type == "SFEB_old") {
+        return readFEBLayered(element, nsw::NUM_VMM_PER_SFEB, 3, 0, 0);
+    } else if (type == "SFEB") {
+        ERS_LOG("WARNING!! You are using deprecated SFEB type. Please switch to use SFEB8_XXX instead of " << element);
+        return readFEBLayered(element, nsw::NUM_VMM_PER_SFEB, 4, 0, 0);
+    } else if (type == "SFEB8") {
+        return readFEBLayered(element, nsw::NUM_VMM_PER_SFEB, 4, 0, 0);
+    } else if (type == "SFEB6") {
+        return readFEBLayered(element, nsw::NUM_VMM_PER_SFEB, nsw::NUM_TDS_PER_SFEB, nsw::SFEB6_FIRST_VMM,
+                              nsw::SFEB6_FIRST_TDS);
+    }
+    throw std::runtime_error(fmt::format("{} is not a front end board", element));
+}
+
 std::set<std::string> ConfigReaderApi::getElementNames(const std::string& regexp) const {
     std::set<std::string> result;
     std::regex re(regexp);
@@ -1,8 +1,8 @@
 #include "NSWConfiguration/ConfigReaderJsonApi.h"
 
 #include <filesystem>
+#include <mutex>
 #include <stdexcept>
-#include <regex>
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/optional/optional.hpp>
@@ -13,6 +13,7 @@
 #include <ers/ers.h>
 
 #include "NSWConfiguration/GitWrapper.h"
+#include "NSWConfiguration/JsonParser.h"
 #include "NSWConfiguration/OKSDeviceHierarchy.h"
 #include "NSWConfiguration/Utility.h"
 
@@ -58,20 +59,14 @@ ptree JsonApi::readTP(const std::string& element) const {
     return tree;
 }
 
-void JsonApi::mergeI2cMasterTree(ptree & specific, ptree & common) const {
+void JsonApi::checkI2cMasterTree(const ptree& specific, const ptree& common) const {
     // Loop over I2c addresses within specific tree
-    for (ptree::iterator iter_addresses = specific.begin();
-        iter_addresses != specific.end(); iter_addresses++) {
-        std::string address = iter_addresses->first;
-        ptree addresstree = iter_addresses->second;
-
+    for (const auto& [address, addresstree] : specific) {
         // Iterate over registers in I2c address
-        for (ptree::iterator iter_registers = addresstree.begin();
-            iter_registers != addresstree.end(); iter_registers++) {
-            std::string registername = iter_registers->first;
-            std::string node = address + "." + registername;
+        for (const auto& [registername, value] : addresstree) {
+            const std::string node = address + "." + registername;
 
-            //  Check if node exists in specific tree, and replace the value from common
+            //  Check if node of the specific tree exists in the common tree
             if (!common.get_optional<std::string>(node).is_initialized()) {
                 nsw::ConfigBadNode issue(ERS_HERE, node, "i2c master. See err file for details");
                 ers::error(issue);
@@ -84,20 +79,25 @@ void JsonApi::mergeI2cMasterTree(ptree & specific, ptree & common) const {
                 std::cerr << ss.str() << std::endl;
 
                 throw issue;
-            } else {
-                common.put(node, iter_registers->second.data());
             }
         }
     }
 }
 
-void JsonApi::mergeVMMTree(ptree & specific, ptree & common) const {
-    // Iterate over registers in I2c address
-    for (ptree::iterator iter_registers = specific.begin();
-        iter_registers != specific.end(); iter_registers++) {
-        std::string registername = iter_registers->first;
+void JsonApi::mergeI2cMasterTree(ptree & specific, ptree & common) const {
+    checkI2cMasterTree(specific, common);
+    // Replace the values of common with the ones of specific
+    for (const auto& [address, addresstree] : specific) {
+        for (const auto& [registername, value] : addresstree) {
+            common.put(address + "." + registername, value.data());
+        }
+    }
+}
 
-        //  Check if node exists in specific tree, and replace the value from common
+void JsonApi::checkVMMTree(const ptree& specific, const ptree& common) const {
+    // Iterate over registers in I2c address
+    for (const auto& [registername, value] : specific) {
+        //  Check if node of the specific tree exists in the common tree
         if (!common.get_optional<std::string>(registername).is_initialized()) {
             nsw::ConfigBadNode issue(ERS_HERE, registername, "vmm");
             ers::error(issue);
@@ -110,21 +110,49 @@ void JsonApi::mergeVMMTree(ptree & specific, ptree & common) const {
             std::cerr << ss.str() << std::endl;
 
             throw issue;
+        }
+    }
+}
+
+void JsonApi::mergeVMMTree(ptree & specific, ptree & common) const {
+    checkVMMTree(specific, common);
+    // Replace the values of common with the ones of specific
+    for (const auto& [registername, value] : specific) {
+        if (registername.find("channel_") == 0) {
+            common.put_child(registername, value);
         } else {
-            if (registername.find("channel_") == 0) {
-              ptree temp = iter_registers->second;
-              common.put_child(registername, temp);
-            } else {
-              common.put(registername, iter_registers->second.data());
-            }
+            common.put(registername, value.data());
         }
     }
 }
 
+const nsw::FEBCommonConfig& JsonApi::getFEBCommonConfig() const {
+    // The configuration does not change after construction, the layers are built once
+    std::call_once(m_febCommonOnce, [this] () {
+        const auto& roc_common = m_config.get_child("roc_common_config");
+        m_febCommon = nsw::FEBCommonConfig{
+            nsw::makeSharedConfigLayer(roc_common.get_child("rocPllCoreAnalog")),
+            nsw::makeSharedConfigLayer(roc_common.get_child("rocCoreDigital")),
+            nsw::makeSharedConfigLayer(m_config.get_child("vmm_common_config")),
+            nsw::makeSharedConfigLayer(m_config.get_child("tds_common_config"))};
+    });
+    return m_febCommon;
+}
+
 ptree JsonApi::readFEB(const std::string& element, size_t nvmm, size_t ntds, size_t vmm_start,
     size_t tds_start) const {
+    return readFEBTree(element, nvmm, ntds, vmm_start, tds_start, true);
+}
+
+nsw::FEBConfig JsonApi::readFEBLayered(const std::string& element, size_t nvmm, size_t ntds, size_t vmm_start,
+    size_t tds_start) const {
+    return nsw::FEBConfig{readFEBTree(element, nvmm, ntds, vmm_start, tds_start, false), getFEBCommonConfig()};
+}
+
+ptree JsonApi::readFEBTree(const std::string& element, size_t nvmm, size_t ntds, size_t vmm_start,
+    size_t tds_start, const bool merge) const {
     ptree feb = m_config.get_child(element);
-    ptree roc_common = m_config.get_child("roc_common_config");
+    const ptree& roc_common = m_config.get_child("roc_common_config");
 
     // ROC
     if (not m_devices.empty() and not findInTree(m_devices.at("FEB").at(element), [](const std::string& deviceName) {
@@ -138,6 +166,11 @@ ptree JsonApi::readFEB(const std::string& element, size_t nvmm, size_t ntds, siz
         if (feb.get_child_optional(name)) {  // If node exists
             specific = feb.get_child(name);
         }
+        if (not merge) {
+            checkI2cMasterTree(specific, roc_common.get_child(name));
+            feb.put_child(name, specific);
+            continue;
+        }
         ptree common = roc_common.get_child(name);
 
         ERS_DEBUG(4, "Merging " << name << " ptree");
@@ -171,11 +204,16 @@ ptree JsonApi::readFEB(const std::string& element, size_t nvmm, size_t ntds, siz
             }
             continue;
         }
-        ptree vmm_common = m_config.get_child("vmm_common_config");
         ptree specific;
         if (feb.get_child_optional(vmmname)) {  // If node exists
             specific = feb.get_child(vmmname);
         }
+        if (not merge) {
+            checkVMMTree(specific, m_config.get_child("vmm_common_config"));
+            feb.put_child(vmmname, specific);
+            continue;
+        }
+        ptree vmm_common = m_config.get_child("vmm_common_config");
         mergeVMMTree(specific, vmm_common);
         feb.put_child(vmmname, vmm_common);
     }
@@ -207,10 +245,15 @@ ptree JsonApi::readFEB(const std::string& element, size_t nvmm, size_t ntds, siz
             continue;
         }
         ptree specific;
-        ptree tds_common = m_config.get_child("tds_common_config");
         if (feb.get_child_optional(name)) {  // If node exists
             specific = feb.get_child(name);
         }
+        if (not merge) {
+            checkI2cMasterTree(specific, m_config.get_child("tds_common_config"));
+            feb.put_child(name, specific);
+            continue;
+        }
+        ptree tds_common = m_config.get_child("tds_common_config");
         mergeI2cMasterTree(specific, tds_common);
         feb.put_child(name, tds_common);
     }
@@ -438,38 +481,9 @@ ptree JsonApi::read() {
       ERS_LOG(fmt::format("{}\n", ex.what()));
     }
 
-    // temporary objects for reading in JSON file for cleaning
-    std::stringstream jsonStringStream;
-    std::ifstream inputJSONFile(m_file_path.c_str() );
-    std::string line;
-
-    // Clean input JSON file
-    while (std::getline(inputJSONFile, line)) {
-        // Skip whitespace starting a line
-        const auto found = line.find_first_not_of(" \t");
-        // Remove lines that start with a "/" or "#"
-        if (found != std::string::npos && line[found] == '/' ) continue;
-        if (found != std::string::npos && line[found] == '#' ) continue;
-        jsonStringStream << line << "\r\n";
-    }
-
-    // Converting to string for trans-line cleaning
-    std::string jsonString(jsonStringStream.str());
-
-    // Removing comments that come after a comma and whitespace
-    jsonString = std::regex_replace(jsonString, std::regex("(\\S)\\s*\\/\\/.*"), "$1");
-    jsonString = std::regex_replace(jsonString, std::regex("(\\S)\\s*#.*"), "$1");
-
-    // Removing any commas that are followed by white space and then either a } or ]
-    jsonString = std::regex_replace(jsonString, std::regex(",(?=\\s*[}\\]])"), "");
-
-    // Converting back to a stringstream to make read_json() happy
-    jsonStringStream.str(jsonString);
-
+    // Comments and trailing commas are handled by the parser
     try {
-        ptree config;
-        boost::property_tree::read_json(jsonStringStream, config);
-        return config;
+        return nsw::json::readFile(m_file_path);
     } catch(std::exception & e) {
         nsw::ConfigIssue issue(ERS_HERE, e.what());
         ers::fatal(issue);
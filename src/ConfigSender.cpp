@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -125,7 +128,7 @@ void nsw::ConfigSender::sendI2cMasterSingle(const std::string& opcserver_ipport,
     auto addr_bitstr = cfg.getBitstreamMap();
     auto address = topnode + "." + cfg.getName() + "." + reg_address;  // Full I2C address
     auto bitstr = addr_bitstr[reg_address];
-    auto data = nsw::stringToByteVector(bitstr);
+    auto data = bitstr.toByteVector();
     for (auto d : data) {
         ERS_DEBUG(5, "data: " << static_cast<unsigned>(d));
     }
@@ -139,7 +142,7 @@ void nsw::ConfigSender::sendI2cMasterConfig(const std::string& opcserver_ipport,
     for (auto ab : addr_bitstr) {
         auto address = topnode + "." + cfg.getName() + "." + ab.first;  // Full I2C address
         auto bitstr = ab.second;
-        auto data = nsw::stringToByteVector(bitstr);
+        auto data = bitstr.toByteVector();
         for (auto d : data) {
             ERS_DEBUG(5, "data: " << static_cast<unsigned>(d));
         }
@@ -182,7 +185,7 @@ void nsw::ConfigSender::sendVmmConfig(const nsw::FEBConfig& feb) {
         ERS_DEBUG(4, "vmm size(bytes) : " << dat.size());
         ERS_LOG("Sending configuration to " << feb.getAddress() << ".spi." << vmm.getName());
         sendSpiRaw(opc_ip, feb.getAddress() + ".spi." + vmm.getName() , data.data(), data.size());
-        ERS_DEBUG(5, "Hexstring:\n" << nsw::bitstringToHexString(vmm.getBitString()));
+        ERS_DEBUG(5, "Hexstring:\n" << vmm.getBitVector().toHexString());
     }
 
     // Set Vmm Acquisition Enable
@@ -203,7 +206,7 @@ void nsw::ConfigSender::sendVmmConfigSingle(const nsw::FEBConfig& feb, const siz
     const auto vmmdata = vmm.getByteVector();
     ERS_DEBUG(1, "Sending I2c configuration to " << feb.getAddress() << ".spi." << vmm.getName());
     sendSpiRaw(opc_ip, feb.getAddress() + ".spi." + vmm.getName() , vmmdata.data(), vmmdata.size());
-    ERS_DEBUG(5, "Hexstring:\n" << nsw::bitstringToHexString(vmm.getBitString()));
+    ERS_DEBUG(5, "Hexstring:\n" << vmm.getBitVector().toHexString());
 
     // Set Vmm Acquisition Enable
     // data = {0x0};
@@ -746,7 +749,7 @@ void nsw::ConfigSender::sendAddcConfig(const nsw::ADDCConfig& addc, int i_art) {
             ERS_DEBUG(1, "ART common config " << name);
             for (auto ab : addr_bitstr) {
                 art_data[0] = static_cast<uint8_t>(std::stoi(ab.first) );
-                art_data[1] = static_cast<uint8_t>(std::stoi(ab.second, nullptr, 2) );
+                art_data[1] = static_cast<uint8_t>(ab.second.toInteger() );
                 sendI2cRaw(opc_ip, name, art_data, art_size);
             }
         }
@@ -829,7 +832,7 @@ void nsw::ConfigSender::sendAddcConfig(const nsw::ADDCConfig& addc, int i_art) {
             for (auto ab : addr_bitstr) {
                 if (reg == static_cast<uint8_t>(std::stoi(ab.first) )) {
                     art_data[0] = static_cast<uint8_t>(std::stoi(ab.first) );
-                    art_data[1] = static_cast<uint8_t>(std::stoi(ab.second, nullptr, 2) );
+                    art_data[1] = static_cast<uint8_t>(ab.second.toInteger() );
                     sendI2cRaw(opc_ip, core, art_data, art_size);
                     break;
                 }
@@ -867,7 +870,7 @@ void nsw::ConfigSender::sendAddcConfig(const nsw::ADDCConfig& addc, int i_art) {
             for (auto ab : addr_bitstr) {
                 if (reg == static_cast<uint8_t>( std::stoi(ab.first) )) {
                     art_data[0] = static_cast<uint8_t>( std::stoi(ab.first) );
-                    art_data[1] = static_cast<uint8_t>( std::stoi(ab.second, nullptr, 2) );
+                    art_data[1] = static_cast<uint8_t>( ab.second.toInteger() );
                     sendI2cRaw(opc_ip, name, art_data, art_size);
                     break;
                 }
@@ -1189,6 +1192,29 @@ bool nsw::ConfigSender::readSCAOnline(FEBConfig& feb) {
     return m_clients[opc_ip]->readScaOnline(feb_address);
 }
 
+std::vector<nsw::ScaStatusInfo> nsw::ConfigSender::readSCAStatus(const std::vector<FEBConfig>& febs,
+                                                                 const std::size_t chunkSize) {
+    // Indices of the front ends per OPC server
+    std::map<std::string, std::vector<std::size_t>> febsPerServer;
+    for (std::size_t i = 0; i < febs.size(); ++i) {
+        febsPerServer[febs[i].getOpcServerIp()].push_back(i);
+    }
+
+    std::vector<nsw::ScaStatusInfo> result(febs.size());
+    for (const auto& [opc_ip, indices] : febsPerServer) {
+        addOpcClientIfNew(opc_ip);
+        std::vector<std::string> nodes;
+        nodes.reserve(indices.size());
+        std::transform(std::cbegin(indices), std::cend(indices), std::back_inserter(nodes),
+                       [&febs](const auto index) { return febs[index].getAddress(); });
+        const auto status = m_clients[opc_ip]->readScaStatus(nodes, chunkSize);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            result[indices[i]] = status[i];
+        }
+    }
+    return result;
+}
+
 void nsw::ConfigSender::sendFPGA(const std::string& opcserver_ipport, const std::string& node,
                                  const std::string& bitfile_path) {
     addOpcClientIfNew(opcserver_ipport);
@@ -1198,7 +1224,7 @@ void nsw::ConfigSender::sendFPGA(const std::string& opcserver_ipport, const std:
 void nsw::ConfigSender::enableVmmCaptureInputs(const nsw::FEBConfig& feb)
 {
     ptree tree;
-    tree.put_child("reg008vmmEnable", feb.getConfig().get_child("rocCoreDigital.reg008vmmEnable"));
+    tree.put_child("reg008vmmEnable", feb.getRocDigital().getConfigLayers().getNode("reg008vmmEnable"));
     const auto configConverter = ConfigConverter<ConfigConversionType::ROC_DIGITAL>(tree, ConfigType::REGISTER_BASED);
     const auto translatedPtree = configConverter.getFlatRegisterBasedConfig(feb.getRocDigital().getBitstreamMap());
     const auto partialConfig = nsw::I2cMasterConfig(translatedPtree, ROC_DIGITAL_NAME, ROC_DIGITAL_REGISTERS, true);
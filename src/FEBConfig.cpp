@@ -8,10 +8,25 @@
 
 using boost::property_tree::ptree;
 
- nsw::FEBConfig::FEBConfig(const ptree& config):
+namespace {
+    nsw::ConfigOverlay makeOverlay(const ptree& config, const std::string& name,
+                                   const std::shared_ptr<const nsw::ConfigLayer>& common) {
+        if (common == nullptr) {
+            return nsw::ConfigOverlay{config.get_child(name)};
+        }
+        const auto overrides = config.get_child_optional(name);
+        return nsw::ConfigOverlay{common, overrides ? *overrides : ptree{}};
+    }
+}  // namespace
+
+nsw::FEBConfig::FEBConfig(const ptree& config): FEBConfig(config, nullptr) {}
+
+nsw::FEBConfig::FEBConfig(const ptree& config, const FEBCommonConfig& common): FEBConfig(config, &common) {}
+
+ nsw::FEBConfig::FEBConfig(const ptree& config, const FEBCommonConfig* common):
          SCAConfig(config),
-         m_roc_analog(config.get_child(ROC_ANALOG_NAME), ROC_ANALOG_NAME, ROC_ANALOG_REGISTERS),
-         m_roc_digital(config.get_child(ROC_DIGITAL_NAME), ROC_DIGITAL_NAME, ROC_DIGITAL_REGISTERS) {
+         m_roc_analog(makeOverlay(config, ROC_ANALOG_NAME, common ? common->m_rocAnalog : nullptr), ROC_ANALOG_NAME, ROC_ANALOG_REGISTERS),
+         m_roc_digital(makeOverlay(config, ROC_DIGITAL_NAME, common ? common->m_rocDigital : nullptr), ROC_DIGITAL_NAME, ROC_DIGITAL_REGISTERS) {
 
 
     // A FE can have up to 8 VMMs, the config ptree should be
@@ -21,7 +36,7 @@ using boost::property_tree::ptree;
         std::string vmmname = "vmm" + std::to_string(i);
         if (config.find(vmmname) != config.not_found()) {
             ERS_DEBUG(3, "VMM id:" << vmmname);
-            m_vmms.emplace_back(config.get_child(vmmname));
+            m_vmms.emplace_back(makeOverlay(config, vmmname, common ? common->m_vmm : nullptr));
             m_vmms.back().setName(vmmname);
             if (i < m_firstVmm) {
               ERS_LOG(fmt::format("Setting m_firstVmm ({}) to {}", m_firstVmm, i));
@@ -37,7 +52,7 @@ using boost::property_tree::ptree;
         std::string tdsname = "tds" + std::to_string(i);
         if (config.find(tdsname) != config.not_found()) {
             ERS_DEBUG(3, "TDS id:" << tdsname);
-            m_tdss.emplace_back(config.get_child(tdsname), tdsname, TDS_REGISTERS);
+            m_tdss.emplace_back(makeOverlay(config, tdsname, common ? common->m_tds : nullptr), tdsname, TDS_REGISTERS);
             if (i < m_firstTds) {
               ERS_LOG(fmt::format("Setting m_firstTds ({}) to {}", m_firstTds, i));
               m_firstTds = i;
@@ -1,14 +1,21 @@
 #include "NSWConfiguration/I2cMasterConfig.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <cmath>
 #include <iostream>
+#include <string_view>
 #include <utility>
-#include <numeric>
+
+#include <fmt/core.h>
 
 #include <ers/ers.h>
 
+#include "NSWConfiguration/ConfigImageCache.h"
 #include "NSWConfiguration/Utility.h"
 #include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/Types.h"
@@ -19,102 +26,128 @@ nsw::I2cMasterCodec::I2cMasterCodec(const i2c::AddressRegisterMap & ar_map): m_a
     calculateSizesAndPositions();
 }
 
-void nsw::I2cMasterCodec::calculateSizesAndPositions() {
-    for (auto e : m_addr_reg) {
-        auto address = e.first;
-        auto register_sizes = e.second;
+const nsw::I2cMasterCodec& nsw::I2cMasterCodec::getInstance(const i2c::AddressRegisterMap& ar_map) {
+    // The register maps are static tables, their address identifies them
+    static std::mutex mutex;
+    static std::map<const i2c::AddressRegisterMap*, std::unique_ptr<const I2cMasterCodec>> codecs;
+    std::scoped_lock lock(mutex);
+    auto& codec = codecs[&ar_map];
+    if (codec == nullptr) {
+        codec = std::make_unique<const I2cMasterCodec>(ar_map);
+    }
+    return *codec;
+}
 
+void nsw::I2cMasterCodec::calculateSizesAndPositions() {
+    // FNV-1a over the layout, stable across processes so that persisted images can be reused
+    constexpr std::uint64_t FNV_OFFSET{0xcbf29ce484222325};
+    constexpr std::uint64_t FNV_PRIME{0x100000001b3};
+    std::uint64_t layout_hash{FNV_OFFSET};
+    const auto hash = [&layout_hash] (const std::string_view text) {
+        for (const auto character : text) {
+            layout_hash = (layout_hash ^ static_cast<std::uint8_t>(character)) * FNV_PRIME;
+        }
+        layout_hash *= FNV_PRIME;  // Terminates the field
+    };
+    for (const auto& [address, register_sizes] : m_addr_reg) {
         i2c::AddressSizeMap register_position;
         i2c::AddressSizeMap register_size;
+        std::vector<FieldLayout> layout;
+        layout.reserve(register_sizes.size());
 
-        // Total size of registers, by summing sizes of individual registers
-        const auto total_size = std::accumulate(register_sizes.begin(), register_sizes.end(), std::size_t{0},
-                                            [](size_t sum, i2c::RegisterSizePair & p) {
-                                            return sum + p.second;  });
-        ERS_DEBUG(3, address << " -> total size: " << total_size);
         size_t pos = 0;
-        std::string register_name;
-        for (auto i : register_sizes) {
+        for (const auto& [register_name, size] : register_sizes) {
             // NOT_USED is a special register name. It means there are some bits not used in
             // the configuration but they affect the position of other configuration bits.
             // By default they will be all set to 0
-            if (i.first == nsw::NOT_USED) {
-                register_name = std::string{nsw::NOT_USED};
-                ERS_DEBUG(3, "Not used bits : " << register_name << ", size: " << i.second << ", pos: " << pos);
+            if (register_name == nsw::NOT_USED) {
+                ERS_DEBUG(3, "Not used bits : " << register_name << ", size: " << size << ", pos: " << pos);
             } else {
-                register_name = i.first;
-                ERS_DEBUG(3, "register: " << register_name << ", size : " << i.second << ", pos: " << pos);
-                register_position[register_name] = pos;
-                register_size[register_name] = i.second;
+                ERS_DEBUG(3, "register: " << register_name << ", size : " << size << ", pos: " << pos);
+                register_position[std::string{register_name}] = pos;
+                register_size[std::string{register_name}] = size;
             }
-            pos = pos + i.second;
+            layout.push_back(FieldLayout{register_name, pos, size});
+            hash(address);
+            hash(register_name);
+            hash(std::to_string(size));
+            pos = pos + size;
         }
+        // Total size of registers, by summing sizes of individual registers
+        ERS_DEBUG(3, address << " -> total size: " << pos);
         ERS_DEBUG(3, "");
-        m_addr_size[address] = total_size;
-        m_addr_reg_pos[address] = register_position;
-        m_addr_reg_size[address] = register_size;
+        m_addr_size[address] = pos;
+        m_addr_reg_pos[address] = std::move(register_position);
+        m_addr_reg_size[address] = std::move(register_size);
+        m_addr_layout[address] = std::move(layout);
     }
+    m_layout_key = fmt::format("i2c{:016x}v{}", layout_hash, ENCODER_VERSION);
 }
 
 i2c::AddressBitstreamMap nsw::I2cMasterCodec::buildConfig(const ptree& config) const {
+    return buildConfig(nsw::ConfigLayers{config});
+}
+
+i2c::AddressBitstreamMap nsw::I2cMasterCodec::buildConfig(const nsw::ConfigLayers& config) const {
     i2c::AddressBitstreamMap bitstreams;
-    for (auto e : m_addr_reg) {
-        auto address = e.first;
+    for (const auto& [address, layout] : m_addr_layout) {
         if (address.find("READONLY") != std::string::npos) {
             continue;  // Ignore readonly registers, as they don't have a value in configuration
         }
-        auto register_sizes = e.second;
-
-        ptree child;
-        try {
-            child = config.get_child(std::string{address});
-        } catch (const boost::property_tree::ptree_bad_path& e) {
-            std::string temp = e.what();
-            nsw::MissingI2cAddress issue(ERS_HERE, temp.c_str());
+
+        const auto child = config.getChildOptional(address);
+        if (not child) {
+            nsw::MissingI2cAddress issue(ERS_HERE, address.c_str());
             ers::error(issue);
             throw issue;
         }
 
-        std::string tempstr;
+        // Not used bits stay 0
+        nsw::BitVector bits(m_addr_size.at(address));
         ERS_DEBUG(4, address);
-        for (auto rs : register_sizes) {
-            auto register_name = rs.first;
-            auto size = rs.second;
-
+        for (const auto& field : layout) {
+            if (field.m_name == nsw::NOT_USED) {
+                continue;
+            }
             unsigned value;
-            // Fill not used bits with 0
-            if (register_name == nsw::NOT_USED) {
-                value = 0;
-            } else {
-                try {
-                    value = child.get<unsigned>(std::string{register_name});
-                } catch (const boost::property_tree::ptree_bad_path& e) {
-                    std::string temp = address + ": " + e.what();
-                    nsw::MissingI2cRegister issue(ERS_HERE, temp.c_str());
-                    ers::error(issue);
-                    throw issue;
-                }
-                nsw::checkOverflow(size, value, register_name);
+            try {
+                value = child->get<unsigned>(std::string{field.m_name});
+            } catch (const boost::property_tree::ptree_bad_path& e) {
+                std::string temp = address + ": " + e.what();
+                nsw::MissingI2cRegister issue(ERS_HERE, temp.c_str());
+                ers::error(issue);
+                throw issue;
             }
-            ERS_DEBUG(5, " -- " << register_name << " -> " << value);
-
-            // TODO(cyildiz): Large enough to take any register
-            std::bitset<MAX_I2C_REGISTER_SIZE> bs(value);
-            auto stringbs = bs.to_string();
-            stringbs = stringbs.substr(stringbs.size()-size, stringbs.size());
-            ERS_DEBUG(6, " --- substr:" << stringbs);
-            tempstr += stringbs;
+            nsw::checkOverflow(field.m_width, value, field.m_name);
+            ERS_DEBUG(5, " -- " << field.m_name << " -> " << value);
+            bits.insert(field.m_offset, field.m_width, value);
         }
-        ERS_DEBUG(4, " - bitstream : " << tempstr);
-        bitstreams[address] = tempstr;
+        ERS_DEBUG(4, " - bitstream : " << bits.toString());
+        bitstreams.emplace(address, std::move(bits));
     }
     return bitstreams;
 }
 
+bool nsw::I2cMasterCodec::isValidImage(const i2c::AddressBitstreamMap& image) const {
+    // Same addresses as written by buildConfig, each with the width of its registers
+    std::size_t numAddresses{0};
+    for (const auto& [address, size] : m_addr_size) {
+        if (address.find("READONLY") != std::string::npos) {
+            continue;
+        }
+        const auto bitstream = image.find(address);
+        if (bitstream == std::end(image) or bitstream->second.size() != size) {
+            return false;
+        }
+        ++numAddresses;
+    }
+    return image.size() == numAddresses;
+}
+
 i2c::AddressBitstreamMap nsw::I2cMasterCodec::buildPartialConfig(const ptree& config) const {
     i2c::AddressBitstreamMap bitstreams;
     // Lambda that defines the transformation
-    std::transform(std::begin(config), std::end(config), std::inserter(bitstreams, std::end(bitstreams)), [this, &config] (const auto& pair) -> std::pair<std::string, std::string> {
+    std::transform(std::begin(config), std::end(config), std::inserter(bitstreams, std::end(bitstreams)), [this, &config] (const auto& pair) -> std::pair<std::string, nsw::BitVector> {
         const std::string address = pair.first;
         if (address.find("READONLY") != std::string::npos) {
             nsw::WriteToReadOnlyRegister issue(ERS_HERE, address);
@@ -122,78 +155,85 @@ i2c::AddressBitstreamMap nsw::I2cMasterCodec::buildPartialConfig(const ptree& co
             throw issue;
         }
         const auto value = config.get<unsigned int>(address);
-        constexpr auto MAX_SIZE = std::size_t{128};
-        const std::bitset<MAX_SIZE> bs(value);
-        const auto registerSize =
-            std::accumulate(std::cbegin(m_addr_reg.at(address)),
-                            std::cend(m_addr_reg.at(address)),
-                            std::size_t{0},
-                            [](const auto result, const auto& pair) { return result + pair.second; });
-        return {address, bs.to_string().substr(MAX_SIZE - registerSize, MAX_SIZE)};
+        const auto registerSize = m_addr_size.at(address);
+        // The value sits right-aligned in the register, leading bits stay 0
+        nsw::BitVector bits(registerSize);
+        const auto width = std::min(registerSize, nsw::BitVector::MAX_FIELD_WIDTH);
+        bits.insert(registerSize - width, width, value);
+        return {address, std::move(bits)};
     });
     return bitstreams;
 }
 
+std::shared_ptr<const i2c::AddressBitstreamMap> nsw::I2cMasterConfig::buildConfig(const bool partialConfig) {
+    if (partialConfig) {
+        return std::make_shared<const i2c::AddressBitstreamMap>(m_codec->buildPartialConfig(m_config.getCommon().m_tree));
+    }
+    return nsw::I2cImageCache::getInstance().getByKey(nsw::buildConfigImageKey(m_codec->getLayoutKey(), m_config), [this] () {
+        return m_codec->buildConfig(m_config.getLayers());
+    }, [this] (const i2c::AddressBitstreamMap& image) {
+        return m_codec->isValidImage(image);
+    });
+}
+
 void nsw::I2cMasterConfig::dump() const {
     ERS_LOG("Dumping Config for: " << m_name);
-    for (auto ab : m_address_bitstream) {
+    for (const auto& ab : *m_address_bitstream) {
         auto address = ab.first;
         auto bitstream = ab.second;
         std::cout << address
-                  << "\n  bits  : " << bitstream
-                  << "\n  bytes : " << bitstringToHexString(bitstream)
+                  << "\n  bits  : " << bitstream.toString()
+                  << "\n  bytes : " << bitstream.toHexString()
                   << std::endl;
     }
 }
 
 uint32_t nsw::I2cMasterConfig::getRegisterValue(const std::string& address, const std::string& register_name) const {
-    if (m_codec.m_addr_reg_pos.find(address) == m_codec.m_addr_reg_pos.end()) {
+    if (m_codec->m_addr_reg_pos.find(address) == m_codec->m_addr_reg_pos.end()) {
         std::string temp = address;
         nsw::NoSuchI2cAddress issue(ERS_HERE, temp.c_str());
         ers::error(issue);
         throw issue;
     }
-    if (m_codec.m_addr_reg_pos.at(address).find(register_name) == m_codec.m_addr_reg_pos.at(address).end()) {
+    if (m_codec->m_addr_reg_pos.at(address).find(register_name) == m_codec->m_addr_reg_pos.at(address).end()) {
         std::string temp = address;
         nsw::NoSuchI2cRegister issue(ERS_HERE, temp.c_str());
         ers::error(issue);
         throw issue;
     }
-    auto reg_pos = m_codec.m_addr_reg_pos.at(address).at(register_name);
-    auto reg_size = m_codec.m_addr_reg_size.at(address).at(register_name);
+    auto reg_pos = m_codec->m_addr_reg_pos.at(address).at(register_name);
+    auto reg_size = m_codec->m_addr_reg_size.at(address).at(register_name);
 
-    // Find corresponding string of bits from the bitstream and convert it to long
-    auto tmp = m_address_bitstream.at(address).substr(reg_pos, reg_size);
-    return static_cast<std::uint32_t>(std::stoul(tmp, nullptr, 2));
+    return static_cast<std::uint32_t>(m_address_bitstream->at(address).extract(reg_pos, reg_size));
 }
 
 void nsw::I2cMasterConfig::setRegisterValue(const std::string& address, const std::string& register_name,
     uint32_t value) {
-    if (m_codec.m_addr_reg_pos.find(address) == m_codec.m_addr_reg_pos.end()) {
+    if (m_codec->m_addr_reg_pos.find(address) == m_codec->m_addr_reg_pos.end()) {
         std::string temp = address;
         nsw::NoSuchI2cAddress issue(ERS_HERE, temp.c_str());
         ers::error(issue);
         throw issue;
     }
-    if (m_codec.m_addr_reg_pos[address].find(register_name) == m_codec.m_addr_reg_pos[address].end()) {
+    if (m_codec->m_addr_reg_pos.at(address).find(register_name) == m_codec->m_addr_reg_pos.at(address).end()) {
         std::string temp = address;
         nsw::NoSuchI2cRegister issue(ERS_HERE, temp.c_str());
         ers::error(issue);
         throw issue;
     }
-    auto reg_pos = m_codec.m_addr_reg_pos[address][register_name];
-    auto reg_size = m_codec.m_addr_reg_size[address][register_name];
+    auto reg_pos = m_codec->m_addr_reg_pos.at(address).at(register_name);
+    auto reg_size = m_codec->m_addr_reg_size.at(address).at(register_name);
 
     nsw::checkOverflow(reg_size, value, register_name);
 
-    auto bitstring = nsw::bitString(value, reg_size);
-
-    // Replace corresponding substring of bitstream with new bitstring
-    m_address_bitstream[address].replace(reg_pos, reg_size, bitstring);
+    // Replace the corresponding bits of a private copy of the bitstream, the map may be shared
+    auto bitstreams = *m_address_bitstream;
+    bitstreams[address].insert(reg_pos, reg_size, value);
+    m_address_bitstream = std::make_shared<const i2c::AddressBitstreamMap>(std::move(bitstreams));
 }
 
 void nsw::I2cMasterConfig::decodeVector(const std::string& address, const std::vector<uint8_t>& vec) const {
-    if (m_codec.m_addr_reg_pos.find(address) == m_codec.m_addr_reg_pos.end()) {
+    if (m_codec->m_addr_reg_pos.find(address) == m_codec->m_addr_reg_pos.end()) {
         nsw::NoSuchI2cAddress issue(ERS_HERE, address.c_str());
         ers::error(issue);
         return;
@@ -208,15 +248,14 @@ void nsw::I2cMasterConfig::decodeVector(const std::string& address, const std::v
     }
 
     std::cout << address << std::endl;
-    auto bitstring = vectorToBitString(vec);
-    for (auto reg : m_codec.m_addr_reg_size.at(address)) {
+    const auto bits = nsw::BitVector::fromBytes(vec);
+    for (auto reg : m_codec->m_addr_reg_size.at(address)) {
         auto register_name = reg.first;
         auto reg_size = reg.second;
-        auto reg_pos = m_codec.m_addr_reg_pos.at(address).at(register_name);
-        auto tmp = bitstring.substr(reg_pos, reg_size);
+        auto reg_pos = m_codec->m_addr_reg_pos.at(address).at(register_name);
         std::stringstream name_stream;
         name_stream << std::setw(30) << std::left << register_name;
-        std::cout << " - " << name_stream.str()  << " : " <<  std::stoul(tmp, nullptr, 2) << std::endl;
+        std::cout << " - " << name_stream.str()  << " : " <<  bits.extract(reg_pos, reg_size) << std::endl;
     }
 }
 
@@ -234,8 +273,9 @@ size_t nsw::I2cMasterCodec::getTotalSize(const std::string& address) const {
 
 std::vector<std::string> nsw::I2cMasterCodec::getAddresses() const {
     std::vector<std::string> addresses;
-    for (auto e : m_addr_reg) {
-        addresses.push_back(e.first);
+    addresses.reserve(m_addr_reg.size());
+    for (const auto& [address, registers] : m_addr_reg) {
+        addresses.push_back(address);
     }
     return addresses;
 }
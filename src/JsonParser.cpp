@@ -0,0 +1,418 @@
+#include "NSWConfiguration/JsonParser.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser/error.hpp>
+
+#include <fmt/core.h>
+
+using boost::property_tree::ptree;
+
+namespace {
+  /**
+   * \brief Recursive descent JSON parser writing into a property tree
+   *
+   * Error messages follow the ones of boost::property_tree::read_json.
+   */
+  class Parser
+  {
+  public:
+    Parser(const std::string_view text, const std::string& source) : m_text(text), m_source(source) {}
+
+    ptree parseDocument()
+    {
+      ptree root;
+      skipWhitespace();
+      parseValue(root);
+      skipWhitespace();
+      if (m_pos != m_text.size()) {
+        fail("garbage after data");
+      }
+      return root;
+    }
+
+  private:
+    [[noreturn]] void fail(const std::string& message) const
+    {
+      // The line is only needed for errors, count it here instead of while parsing
+      const auto end = std::next(std::cbegin(m_text), static_cast<std::ptrdiff_t>(m_pos));
+      const auto line = static_cast<unsigned long>(std::count(std::cbegin(m_text), end, '\n')) + 1;
+      throw boost::property_tree::json_parser::json_parser_error(message, m_source, line);
+    }
+
+    [[nodiscard]] bool atEnd() const { return m_pos >= m_text.size(); }
+
+    [[nodiscard]] char peek() const { return atEnd() ? '\0' : m_text[m_pos]; }
+
+    bool consume(const char character)
+    {
+      if (not atEnd() and m_text[m_pos] == character) {
+        ++m_pos;
+        return true;
+      }
+      return false;
+    }
+
+    void skipWhitespace()
+    {
+      while (not atEnd()) {
+        const auto character = m_text[m_pos];
+        if (character == ' ' or character == '\t' or character == '\n' or character == '\r') {
+          ++m_pos;
+        } else if (character == '#' or
+                   (character == '/' and m_pos + 1 < m_text.size() and m_text[m_pos + 1] == '/')) {
+          // Comment until the end of the line
+          const auto endOfLine = m_text.find('\n', m_pos);
+          m_pos = endOfLine == std::string_view::npos ? m_text.size() : endOfLine;
+        } else {
+          return;
+        }
+      }
+    }
+
+    void parseValue(ptree& node)
+    {
+      switch (peek()) {
+      case '{':
+        parseObject(node);
+        return;
+      case '[':
+        parseArray(node);
+        return;
+      case '"':
+        parseString(node.data());
+        return;
+      case 't':
+        parseLiteral("true", node);
+        return;
+      case 'f':
+        parseLiteral("false", node);
+        return;
+      case 'n':
+        parseLiteral("null", node);
+        return;
+      default:
+        parseNumber(node);
+      }
+    }
+
+    void parseObject(ptree& node)
+    {
+      ++m_pos;  // '{'
+      skipWhitespace();
+      if (consume('}')) {
+        return;
+      }
+      std::string key;
+      while (true) {
+        if (peek() != '"') {
+          fail("expected key string");
+        }
+        key.clear();
+        parseString(key);
+        skipWhitespace();
+        if (not consume(':')) {
+          fail("expected ':'");
+        }
+        skipWhitespace();
+        auto& child = node.push_back(ptree::value_type(key, ptree{}))->second;
+        parseValue(child);
+        skipWhitespace();
+        if (consume('}')) {
+          return;
+        }
+        if (not consume(',')) {
+          fail("expected '}' or ','");
+        }
+        skipWhitespace();
+        // Tolerate trailing comma
+        if (consume('}')) {
+          return;
+        }
+      }
+    }
+
+    void parseArray(ptree& node)
+    {
+      ++m_pos;  // '['
+      skipWhitespace();
+      if (consume(']')) {
+        return;
+      }
+      while (true) {
+        auto& child = node.push_back(ptree::value_type("", ptree{}))->second;
+        parseValue(child);
+        skipWhitespace();
+        if (consume(']')) {
+          return;
+        }
+        if (not consume(',')) {
+          fail("expected ']' or ','");
+        }
+        skipWhitespace();
+        // Tolerate trailing comma
+        if (consume(']')) {
+          return;
+        }
+      }
+    }
+
+    void parseLiteral(const std::string_view literal, ptree& node)
+    {
+      if (m_text.substr(m_pos, literal.size()) != literal) {
+        fail(fmt::format("expected '{}'", literal));
+      }
+      m_pos += literal.size();
+      node.data().assign(literal);
+    }
+
+    void parseNumber(ptree& node)
+    {
+      const auto isDigit = [this]() { return peek() >= '0' and peek() <= '9'; };
+      const auto skipDigits = [this, &isDigit]() {
+        while (isDigit()) {
+          ++m_pos;
+        }
+      };
+
+      const auto start = m_pos;
+      const auto minus = consume('-');
+      if (consume('0')) {
+        // No leading zeros
+      } else if (isDigit()) {
+        skipDigits();
+      } else {
+        fail(minus ? "expected digits after -" : "expected value");
+      }
+      if (consume('.')) {
+        if (not isDigit()) {
+          fail("need at least one digit after '.'");
+        }
+        skipDigits();
+      }
+      if (consume('e') or consume('E')) {
+        if (not consume('+')) {
+          consume('-');
+        }
+        if (not isDigit()) {
+          fail("need at least one digit in exponent");
+        }
+        skipDigits();
+      }
+      node.data().assign(m_text.substr(start, m_pos - start));
+    }
+
+    void parseString(std::string& result)
+    {
+      ++m_pos;  // '"'
+      while (true) {
+        // Copy runs of plain characters at once
+        const auto end = m_text.find_first_of("\"\\", m_pos);
+        if (end == std::string_view::npos) {
+          m_pos = m_text.size();
+          fail("unterminated string");
+        }
+        const auto run = m_text.substr(m_pos, end - m_pos);
+        const auto control = std::find_if(std::cbegin(run), std::cend(run), [](const char character) {
+          return static_cast<unsigned char>(character) < ' ';
+        });
+        if (control != std::cend(run)) {
+          m_pos += static_cast<std::size_t>(std::distance(std::cbegin(run), control));
+          fail("invalid code sequence");
+        }
+        result.append(run);
+        m_pos = end + 1;
+        if (m_text[end] == '"') {
+          return;
+        }
+        parseEscape(result);
+      }
+    }
+
+    void parseEscape(std::string& result)
+    {
+      if (atEnd()) {
+        fail("invalid escape sequence");
+      }
+      const auto character = m_text[m_pos++];
+      switch (character) {
+      case '"':
+      case '\\':
+      case '/':
+        result.push_back(character);
+        return;
+      case 'b':
+        result.push_back('\b');
+        return;
+      case 'f':
+        result.push_back('\f');
+        return;
+      case 'n':
+        result.push_back('\n');
+        return;
+      case 'r':
+        result.push_back('\r');
+        return;
+      case 't':
+        result.push_back('\t');
+        return;
+      case 'u':
+        appendUtf8(parseCodepoint(), result);
+        return;
+      default:
+        --m_pos;
+        fail("invalid escape sequence");
+      }
+    }
+
+    std::uint32_t parseCodepoint()
+    {
+      constexpr std::uint32_t HIGH_SURROGATE_BEGIN{0xd800};
+      constexpr std::uint32_t LOW_SURROGATE_BEGIN{0xdc00};
+      constexpr std::uint32_t LOW_SURROGATE_END{0xe000};
+      constexpr std::uint32_t SURROGATE_BITS{10};
+      constexpr std::uint32_t SUPPLEMENTARY_BEGIN{0x10000};
+
+      const auto first = parseHex4();
+      if (first >= LOW_SURROGATE_BEGIN and first < LOW_SURROGATE_END) {
+        fail("invalid codepoint, stray low surrogate");
+      }
+      if (first < HIGH_SURROGATE_BEGIN or first >= LOW_SURROGATE_BEGIN) {
+        return first;
+      }
+      if (not consume('\\') or not consume('u')) {
+        fail("invalid codepoint, stray high surrogate");
+      }
+      const auto second = parseHex4();
+      if (second < LOW_SURROGATE_BEGIN or second >= LOW_SURROGATE_END) {
+        fail("expected low surrogate after high surrogate");
+      }
+      return SUPPLEMENTARY_BEGIN + ((first - HIGH_SURROGATE_BEGIN) << SURROGATE_BITS) +
+             (second - LOW_SURROGATE_BEGIN);
+    }
+
+    std::uint32_t parseHex4()
+    {
+      constexpr std::size_t NUM_DIGITS{4};
+      constexpr std::uint32_t BITS_PER_DIGIT{4};
+      constexpr std::uint32_t DECIMAL_DIGITS{10};
+      std::uint32_t value{0};
+      for (std::size_t digit = 0; digit < NUM_DIGITS; ++digit) {
+        const auto character = peek();
+        std::uint32_t nibble{0};
+        if (character >= '0' and character <= '9') {
+          nibble = static_cast<std::uint32_t>(character - '0');
+        } else if (character >= 'a' and character <= 'f') {
+          nibble = static_cast<std::uint32_t>(character - 'a') + DECIMAL_DIGITS;
+        } else if (character >= 'A' and character <= 'F') {
+          nibble = static_cast<std::uint32_t>(character - 'A') + DECIMAL_DIGITS;
+        } else {
+          fail("invalid escape sequence");
+        }
+        value = (value << BITS_PER_DIGIT) | nibble;
+        ++m_pos;
+      }
+      return value;
+    }
+
+    static void appendUtf8(const std::uint32_t codepoint, std::string& result)
+    {
+      const auto append = [&result](const std::uint32_t byte) {
+        result.push_back(static_cast<char>(byte));
+      };
+      if (codepoint < 0x80U) {
+        append(codepoint);
+      } else if (codepoint < 0x800U) {
+        append(0xc0U | (codepoint >> 6U));
+        append(0x80U | (codepoint & 0x3fU));
+      } else if (codepoint < 0x10000U) {
+        append(0xe0U | (codepoint >> 12U));
+        append(0x80U | ((codepoint >> 6U) & 0x3fU));
+        append(0x80U | (codepoint & 0x3fU));
+      } else {
+        append(0xf0U | (codepoint >> 18U));
+        append(0x80U | ((codepoint >> 12U) & 0x3fU));
+        append(0x80U | ((codepoint >> 6U) & 0x3fU));
+        append(0x80U | (codepoint & 0x3fU));
+      }
+    }
+
+    std::string_view m_text;
+    const std::string& m_source;
+    std::size_t m_pos{0};
+  };
+
+  /**
+   * \brief Read-only memory mapping of a file, unmapped on destruction
+   */
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string& path)
+    {
+      const auto fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw boost::property_tree::json_parser::json_parser_error("cannot open file", path, 0);
+      }
+      struct stat info {};
+      if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw boost::property_tree::json_parser::json_parser_error("cannot open file", path, 0);
+      }
+      m_size = static_cast<std::size_t>(info.st_size);
+      // Mapping an empty file fails, it is parsed as empty text instead
+      if (m_size > 0) {
+        m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      ::close(fd);
+      if (m_data == MAP_FAILED) {
+        throw boost::property_tree::json_parser::json_parser_error("cannot read file", path, 0);
+      }
+      if (m_size > 0) {
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+      }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    ~MappedFile()
+    {
+      if (m_data != nullptr and m_data != MAP_FAILED) {
+        ::munmap(m_data, m_size);
+      }
+    }
+
+    [[nodiscard]] std::string_view getText() const
+    {
+      if (m_data == nullptr) {
+        return {};
+      }
+      return {static_cast<const char*>(m_data), m_size};
+    }
+
+  private:
+    void* m_data{nullptr};
+    std::size_t m_size{0};
+  };
+}  // namespace
+
+ptree nsw::json::parse(const std::string_view text, const std::string& source)
+{
+  return Parser{text, source}.parseDocument();
+}
+
+ptree nsw::json::readFile(const std::string& path)
+{
+  const MappedFile file{path};
+  return parse(file.getText(), path);
+}
@@ -1,18 +1,23 @@
 #include "NSWConfiguration/NSWConfig.h"
+#include "NSWConfiguration/ConfigImageCache.h"
 #include "NSWConfiguration/OpcClient.h"
 #include "NSWConfiguration/TPConstants.h"
+#include "NSWConfiguration/Utility.h"
 #include "NSWConfiguration/hw/FEB.h"
 #include "NSWConfiguration/hw/PadTrigger.h"
 
+#include <algorithm>
 #include <thread>
 #include <utility>
 #include <string>
 #include <memory>
 #include <chrono>
 #include <variant>
+#include <vector>
 
 // Header to the RC online services
 #include "NSWConfiguration/hw/DeviceManager.h"
+#include "NSWConfiguration/hw/Executor.h"
 #include "NSWConfiguration/monitoring/RocStatusRegisters.h"
 #include "NSWConfiguration/monitoring/RocConfigurationRegisters.h"
 #include "RunControl/Common/OnlineServices.h"
@@ -40,7 +45,19 @@ void nsw::NSWConfig::readConfigurationResource() {
     // we should find the ones that are at the same links with the swROD
     const auto frontend_names = m_reader->getAllElementNames();
 
+    // Images of identical configurations are shared, optionally also with previous processes
+    const auto imageCacheFile = nsw::getenv(std::string{IMAGE_CACHE_ENV});
+    if (not imageCacheFile.empty()) {
+      try {
+        ERS_LOG(fmt::format("Loaded {} configuration images from {}", nsw::loadConfigImageCaches(imageCacheFile), imageCacheFile));
+      } catch (const std::exception& e) {
+        ERS_LOG(fmt::format("Could not load configuration images from {}: {}", imageCacheFile, e.what()));
+      }
+    }
+
     ERS_LOG("The following front ends will be configured now:\n");
+    std::vector<std::string> names;
+    names.reserve(frontend_names.size());
     for (const auto& name : frontend_names) {
       try {
         const auto element = nsw::getElementType(name);
@@ -50,31 +67,64 @@ void nsw::NSWConfig::readConfigurationResource() {
           continue;
         }
         ERS_LOG(name << ", an instance of " << element);
-        auto this_pair = std::make_pair(name, m_reader->readConfig(name));
-        if      (element == "ADDC")          { m_deviceManager.add(this_pair.second); }
-        else if (element == "Router")        { m_deviceManager.add(this_pair.second); }
-        else if (element == "PadTrigger")    { m_deviceManager.add(this_pair.second); }
-        else if (element == "MMTP")          { m_deviceManager.add(this_pair.second); }
-        else if (element == "STGCTP")        { m_deviceManager.add(this_pair.second); }
-        else if (element == "TPCarrier")     { m_deviceManager.add(this_pair.second); }
-        else if (element == "L1DDC")         { m_l1ddcs.emplace(this_pair); }
-        else {
-          m_deviceManager.add(this_pair.second);
-        }
+        names.push_back(name);
       } catch (const std::exception& e) {
         nsw::NSWConfigIssue issue(ERS_HERE, fmt::format("Problem constructing configuration ({}) due to : {}", name, e.what()));
         ers::fatal(issue);
       }
     }
+
+    // Reading and decoding are independent per element and run in parallel. Front end boards
+    // share the common ROC, VMM and TDS configurations instead of merging them. The devices are
+    // added in the order of the names, so that the result and the order of the error reports do
+    // not depend on the scheduling. The pool respects the thread limit of the application (maxThreads).
+    using ParsedConfig = std::variant<nsw::FEBConfig, nsw::ADDCConfig, ptree>;
+    nsw::hw::Executor executor{std::max(m_max_threads, std::size_t{1})};
+    nsw::hw::transformInOrder(
+      executor,
+      names,
+      [this] (const std::string& name) -> ParsedConfig {
+        const auto element = nsw::getElementType(name);
+        if (hw::DeviceManager::isFebType(element)) {
+          return m_reader->readFEBConfig(name);
+        }
+        auto config = m_reader->readConfig(name);
+        if (element == "ADDC") {
+          return nsw::ADDCConfig{config};
+        }
+        return config;
+      },
+      [this] (const std::string&, const ParsedConfig& config) {
+        std::visit([this] (const auto& parsed) { m_deviceManager.add(parsed); }, config);
+      },
+      [] (const std::string& name, const std::exception& e) {
+        nsw::NSWConfigIssue issue(ERS_HERE, fmt::format("Problem constructing configuration ({}) due to : {}", name, e.what()));
+        ers::fatal(issue);
+      });
+    const auto vmmImages = nsw::VmmImageCache::getInstance().getStatistics();
+    const auto i2cImages = nsw::I2cImageCache::getInstance().getStatistics();
+    ERS_LOG(fmt::format("Configuration images: {} cached VMM ({} reused, {} built, {} rejected from file), "
+                        "{} cached I2C ({} reused, {} built, {} rejected from file)",
+                        vmmImages.m_entries, vmmImages.m_hits, vmmImages.m_misses, vmmImages.m_rejected,
+                        i2cImages.m_entries, i2cImages.m_hits, i2cImages.m_misses, i2cImages.m_rejected));
+    if (not imageCacheFile.empty()) {
+      try {
+        nsw::saveConfigImageCaches(imageCacheFile);
+      } catch (const std::exception& e) {
+        ERS_LOG(fmt::format("Could not save configuration images to {}: {}", imageCacheFile, e.what()));
+      }
+    }
     m_monitoringMap.try_emplace(std::string{nsw::mon::RocStatusRegisters::NAME},
                                 std::in_place_type<nsw::mon::RocStatusRegisters>,
-                                m_deviceManager);
+                                m_deviceManager,
+                                m_history);
     m_monitoringMap.try_emplace(std::string{nsw::mon::RocConfigurationRegisters::NAME},
                                 std::in_place_type<nsw::mon::RocConfigurationRegisters>,
                                 m_deviceManager);
     m_monitoringMap.try_emplace(std::string{nsw::mon::MmtpInRunStatusRegisters::NAME},
                                 std::in_place_type<nsw::mon::MmtpInRunStatusRegisters>,
-                                m_deviceManager);
+                                m_deviceManager,
+                                m_history);
     m_monitoringMap.try_emplace(std::string{nsw::mon::MmtpOutRunStatusRegisters::NAME},
                                 std::in_place_type<nsw::mon::MmtpOutRunStatusRegisters>,
                                 m_deviceManager);
@@ -86,7 +136,8 @@ void nsw::NSWConfig::readConfigurationResource() {
                                 m_deviceManager);
     m_monitoringMap.try_emplace(std::string{nsw::mon::PadTriggerRegisters::NAME},
                                 std::in_place_type<nsw::mon::PadTriggerRegisters>,
-                                m_deviceManager);
+                                m_deviceManager,
+                                m_history);
     m_monitoringMap.try_emplace(std::string{nsw::mon::CarriertpInRunStatusRegisters::NAME},
                                 std::in_place_type<nsw::mon::CarriertpInRunStatusRegisters>,
                                 m_deviceManager);
@@ -102,6 +153,9 @@ void nsw::NSWConfig::configureRc() {
         if (m_resettds) {
             result.push_back(hw::DeviceManager::Options::RESET_TDS);
         }
+        if (m_writeChangedOnly) {
+            result.push_back(hw::DeviceManager::Options::WRITE_CHANGED_ONLY);
+        }
         m_deviceManager.configure(result);  // Configure all FEBs, Routers, and TPCarriers
     }
     ERS_LOG("End");
@@ -120,6 +174,9 @@ void nsw::NSWConfig::unconfigureRc() {
     m_tps.clear();
     m_deviceManager.clear();
     m_monitoringMap.clear();
+    // Images are kept (the caches are size bounded), the next configuration only builds the changed ones
+    nsw::VmmImageCache::getInstance().resetStatistics();
+    nsw::I2cImageCache::getInstance().resetStatistics();
     // m_reader.reset();
     ERS_INFO("End");
 }
@@ -297,7 +354,10 @@ bool nsw::NSWConfig::recoverOpc() {
   return pingServer();
 }
 
-void nsw::NSWConfig::monitor(const std::string& name, ISInfoDictionary* isDict, const std::string_view serverName)
+void nsw::NSWConfig::monitor(const std::string& name,
+                             mon::ISPublisher& publisher,
+                             const std::string_view serverName,
+                             const mon::Shard shard)
 {
-  std::visit([&isDict, &serverName] (auto& mon) mutable { mon.monitor(isDict, serverName); }, m_monitoringMap.at(name));
+  std::visit([&publisher, &serverName, &shard] (auto& mon) mutable { mon.monitor(publisher, serverName, shard); }, m_monitoringMap.at(name));
 }
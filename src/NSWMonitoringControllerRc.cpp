@@ -43,9 +43,14 @@ void nsw::NSWMonitoringControllerRc::configure(const daq::rc::TransitionCmd& /*c
   // Retrieving the configuration db
   daq::rc::OnlineServices& rcSvc = daq::rc::OnlineServices::instance();
   m_ipcpartition = rcSvc.getIPCPartition();
-  m_isDictionary = std::make_unique<ISInfoDictionary>(m_ipcpartition);
   const daq::core::RunControlApplicationBase& rcBase = rcSvc.getApplication();
   m_app = rcBase.cast<dal::NSWMonitoringControllerApplication>();
+  // The statistics of running groups are published with the publisher
+  stopMonitoringAll();
+  m_isPublisher.reset();
+  m_isDictionary = std::make_unique<ISInfoDictionary>(m_ipcpartition);
+  m_isPublisher = std::make_unique<mon::ISPublisher>(
+    m_isDictionary.get(), std::chrono::seconds{m_app->get_monitoringHeartbeat()});
 
   m_monitoringIsServerName = m_app->get_monitoringIsServerName();
 
@@ -79,23 +84,19 @@ void nsw::NSWMonitoringControllerRc::user(const daq::rc::UserCmd& usrCmd)
 void nsw::NSWMonitoringControllerRc::startMonitoringAll()
 {
   stopMonitoringAll();
-  m_threads = mon::startMonitoring(
+  m_scheduler = mon::startMonitoring(
     m_configs,
-    [this](const std::string& name) {
-      m_scaServiceSender.send(nsw::commands::MONITOR, {name}, 0);
+    m_app->get_maxMonitoringThreads(),
+    [this](const std::string& name, const mon::Shard shard) {
+      m_scaServiceSender.send(
+        nsw::commands::MONITOR, {name, std::to_string(shard.m_index), std::to_string(shard.m_count)}, 0);
     },
-    m_isDictionary.get(),
+    *m_isPublisher,
     m_monitoringIsServerName,
     m_app->UID());
 }
 
 void nsw::NSWMonitoringControllerRc::stopMonitoringAll()
 {
-  for (auto& thread : m_threads) {
-    thread.second.request_stop();
-  }
-  for (auto& thread : m_threads) {
-    thread.second.join();
-  }
-  m_threads.clear();
+  m_scheduler.reset();
 }
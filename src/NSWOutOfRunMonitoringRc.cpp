@@ -5,6 +5,8 @@
 #include <string>
 #include <memory>
 
+#include <fmt/core.h>
+
 // Header to the RC online services
 #include <RunControl/Common/OnlineServices.h>
 #include <RunControl/Common/RunControlCommands.h>
@@ -25,9 +27,12 @@ void nsw::NSWOutOfRunMonitoringRc::configure(const daq::rc::TransitionCmd& /*cmd
   // Retrieving the configuration db
   daq::rc::OnlineServices& rcSvc = daq::rc::OnlineServices::instance();
   m_ipcpartition = rcSvc.getIPCPartition();
-  m_isDictionary = std::make_unique<ISInfoDictionary>(m_ipcpartition);
   const daq::core::RunControlApplicationBase& rcBase = rcSvc.getApplication();
   m_app = rcBase.cast<dal::NSWOutOfRunMonitoringApplication>();
+  m_isPublisher.reset();
+  m_isDictionary = std::make_unique<ISInfoDictionary>(m_ipcpartition);
+  m_isPublisher = std::make_unique<mon::ISPublisher>(
+    m_isDictionary.get(), std::chrono::seconds{m_app->get_monitoringHeartbeat()});
 
   m_monitoringIsServerName = m_app->get_monitoringIsServerName();
 
@@ -42,21 +47,23 @@ void nsw::NSWOutOfRunMonitoringRc::configure(const daq::rc::TransitionCmd& /*cmd
 
 void nsw::NSWOutOfRunMonitoringRc::prepareForRun(const daq::rc::TransitionCmd& /*cmd*/)
 {
-  m_threads = mon::startMonitoring(
+  m_scheduler = mon::startMonitoring(
     m_configs,
-    [this](const std::string& name) { m_NSWConfig->monitor(name, m_isDictionary.get(), m_monitoringIsServerName); },
-    m_isDictionary.get(),
+    m_app->get_maxMonitoringThreads(),
+    [this](const std::string& name, const mon::Shard shard) {
+      m_NSWConfig->monitor(name, *m_isPublisher, m_monitoringIsServerName, shard);
+    },
+    *m_isPublisher,
     m_monitoringIsServerName,
     m_app->UID());
 }
 
 void nsw::NSWOutOfRunMonitoringRc::stopRecording(const daq::rc::TransitionCmd& /*cmd*/)
 {
-  for (auto& thread : m_threads) {
-    thread.second.request_stop();
-  }
-  for (auto& thread : m_threads) {
-    thread.second.join();
-  }
-  m_threads.clear();
+  m_scheduler.reset();
+  // The data of the last cycles is in IS when the transition finished
+  m_isPublisher->flush();
+  ERS_LOG(fmt::format("Published {} monitoring objects to IS, skipped {} unchanged ones",
+                      m_isPublisher->getNumPublished(),
+                      m_isPublisher->getNumSuppressed()));
 }
@@ -3,6 +3,8 @@
 #include <utility>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
@@ -43,7 +45,7 @@ bool nsw::NSWSCAServiceRc::simulationFromIS()
 
 void nsw::NSWSCAServiceRc::configure(const daq::rc::TransitionCmd& /*cmd*/)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto lock = lockExclusive();
 
   ERS_LOG("Start");
   // Retrieving the configuration db
@@ -57,7 +59,10 @@ void nsw::NSWSCAServiceRc::configure(const daq::rc::TransitionCmd& /*cmd*/)
   m_ipcpartition = rcSvc.getIPCPartition();
 
   // Get the IS dictionary for the current partition
+  m_isPublisher.reset();
   m_isDictionary = std::make_unique<ISInfoDictionary>(m_ipcpartition);
+  m_isPublisher = std::make_unique<mon::ISPublisher>(
+    m_isDictionary.get(), std::chrono::seconds{app->get_monitoringHeartbeat()});
 
   m_errorThresholdContinue = app->get_errorThresholdContinue();
   m_errorThresholdRecover = app->get_errorThresholdRecover();
@@ -71,33 +76,43 @@ void nsw::NSWSCAServiceRc::configure(const daq::rc::TransitionCmd& /*cmd*/)
     CommandSender(findSegmentSiblingApp("NSWSectorControllerApplication"),
                   std::make_unique<daq::rc::CommandSender>(m_ipcpartition, app->UID()));
   m_NSWConfig->readConfigurationResource();
+  // No monitoring cycle is running while the lock is held exclusively
+  m_monitoringExecutor = std::make_unique<hw::Executor>(app->get_maxMonitoringThreads());
   ERS_LOG("End");
 }
 
 void nsw::NSWSCAServiceRc::unconfigure(const daq::rc::TransitionCmd& /*cmd*/)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto lock = lockExclusive();
 
   m_NSWConfig->unconfigureRc();
+  if (m_isPublisher != nullptr) {
+    m_isPublisher->flush();
+    ERS_LOG(fmt::format("Published {} monitoring objects to IS, skipped {} unchanged ones",
+                        m_isPublisher->getNumPublished(),
+                        m_isPublisher->getNumSuppressed()));
+  }
 }
 
 void nsw::NSWSCAServiceRc::user(const daq::rc::UserCmd& usrCmd)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
   const auto commandName = usrCmd.commandName();
+  if (commandName == nsw::commands::MONITOR) {
+    monitor(usrCmd);
+    return;
+  }
+  if (commandName == nsw::commands::DUMP_HISTORY) {
+    dumpHistory(usrCmd);
+    return;
+  }
+
+  const auto lock = lockExclusive();
+
   ERS_LOG(fmt::format("User command '{}' received in state '{}': {}",
                       commandName,
                       usrCmd.currentFSMState(),
                       usrCmd.commandParameters()));
-  const auto notifyScaUnavailable = [this, &commandName]() {
-    ERS_INFO("SCA unavailable");
-    m_isDictionary->checkin(buildScaAvailableKey(m_isDbName, m_sectorId), ISInfoBool(false));
-    if (commandName == nsw::commands::RECOVER_OPC_MESSAGE) {
-      m_sectorControllerSender.send(nsw::commands::SCA_DISCONNECTED);
-    }
-  };
-  const auto checkErrorCounter = [this, &notifyScaUnavailable]() {
+  const auto checkErrorCounter = [this, &commandName]() {
     const auto failedFraction = m_NSWConfig->getFractionFailed();
     if (failedFraction == 0.) {
       ERS_LOG("All devices configured correctly");
@@ -105,7 +120,7 @@ void nsw::NSWSCAServiceRc::user(const daq::rc::UserCmd& usrCmd)
       ers::warning(NSWConfigurationError(ERS_HERE, failedFraction, "Continuing anyways"));
     } else if (failedFraction <= m_errorThresholdRecover) {
       ers::warning(NSWConfigurationError(ERS_HERE, failedFraction, "Trying to recover OPC"));
-      notifyScaUnavailable();
+      notifyScaUnavailable(commandName);
     } else {
       ers::fatal(NSWConfigurationError(ERS_HERE, failedFraction, "Failing"));
     }
@@ -135,34 +150,13 @@ void nsw::NSWSCAServiceRc::user(const daq::rc::UserCmd& usrCmd)
     checkErrorCounter();
   } else if (commandName == nsw::commands::RECOVER_OPC or
              commandName == nsw::commands::RECOVER_OPC_MESSAGE) {
-    notifyScaUnavailable();
+    notifyScaUnavailable(commandName);
   } else if (commandName == nsw::commands::RECONNECT_OPC) {
     if (m_NSWConfig->recoverOpc()) {
       m_isDictionary->checkin(fmt::format("{}.{}.{}", m_isDbName, m_sectorId, "scaAvailable"),
                               ISInfoBool(true));
       m_sectorControllerSender.send(nsw::commands::SCA_RECONNECTED);
     }
-  } else if (commandName == nsw::commands::MONITOR) {
-    try {
-      if (std::size(usrCmd.commandParameters()) != 1) {
-        ers::warning(nsw::NSWInvalidCommand(
-          ERS_HERE,
-          fmt::format("Monitor command must have one argument. Recieved {} commands ({}).",
-                      std::size(usrCmd.commandParameters()),
-                      usrCmd.toString())));
-      }
-      if (m_monitoringIsServerName.empty()) {
-        ers::warning(
-          nsw::NSWConfigIssue(ERS_HERE, "Requested monitoring but did not set IS server before"));
-      } else {
-        m_NSWConfig->monitor(
-          usrCmd.commandParameters().at(0), m_isDictionary.get(), m_monitoringIsServerName);
-      }
-    } catch (const OpcReadWriteIssue&) {
-      notifyScaUnavailable();
-    } catch (const OpcConnectionIssue&) {
-      notifyScaUnavailable();
-    }
   } else if (commandName == nsw::commands::MON_IS_SERVER_NAME) {
     if (std::size(usrCmd.commandParameters()) != 1) {
       ers::warning(nsw::NSWInvalidCommand(
@@ -175,3 +169,132 @@ void nsw::NSWSCAServiceRc::user(const daq::rc::UserCmd& usrCmd)
   }
   ERS_LOG(fmt::format("Finished execution of user command '{}': {}", commandName, usrCmd.commandParameters()));
 }
+
+void nsw::NSWSCAServiceRc::monitor(const daq::rc::UserCmd& usrCmd)
+{
+  ERS_LOG(fmt::format("User command '{}' received in state '{}': {}",
+                      usrCmd.commandName(),
+                      usrCmd.currentFSMState(),
+                      usrCmd.commandParameters()));
+  const auto& parameters = usrCmd.commandParameters();
+  if (std::size(parameters) != 1 and std::size(parameters) != 3) {
+    ers::warning(nsw::NSWInvalidCommand(
+      ERS_HERE,
+      fmt::format("Monitor command must have one (group) or three (group, shard, number of shards) arguments. "
+                  "Recieved {} commands ({}).",
+                  std::size(parameters),
+                  usrCmd.toString())));
+    return;
+  }
+  std::string name{};
+  // Without shard arguments all devices are monitored
+  mon::Shard shard{};
+  try {
+    name = parameters.at(0);
+    if (std::size(parameters) == 3) {
+      shard = mon::Shard{std::stoul(parameters.at(1)), std::stoul(parameters.at(2))};
+    }
+  } catch (const std::exception& ex) {
+    ers::warning(nsw::NSWInvalidCommand(
+      ERS_HERE, fmt::format("Invalid arguments of monitor command ({}): {}", usrCmd.toString(), ex.what())));
+    return;
+  }
+
+  // Admission: one cycle per group at a time
+  {
+    std::scoped_lock lock(m_monitoringMutex);
+    if (not m_monitoringInFlight.insert(name).second) {
+      ERS_LOG(fmt::format("Monitoring of '{}' is still running. Dropped request", name));
+      return;
+    }
+  }
+  const auto finish = [this, &name]() {
+    std::scoped_lock lock(m_monitoringMutex);
+    m_monitoringInFlight.erase(name);
+  };
+
+  try {
+    // Held until the cycle finished, so that exclusive commands never run concurrently
+    const auto lock = lockShared();
+    if (m_monitoringIsServerName.empty()) {
+      ers::warning(
+        nsw::NSWConfigIssue(ERS_HERE, "Requested monitoring but did not set IS server before"));
+    } else if (m_monitoringExecutor == nullptr or m_isPublisher == nullptr) {
+      ers::warning(nsw::NSWConfigIssue(ERS_HERE, "Requested monitoring before configuring"));
+    } else {
+      m_monitoringExecutor
+        ->submit([this, &name, &shard]() {
+          try {
+            m_NSWConfig->monitor(name, *m_isPublisher, m_monitoringIsServerName, shard);
+          } catch (const OpcReadWriteIssue&) {
+            notifyScaUnavailable(nsw::commands::MONITOR);
+          } catch (const OpcConnectionIssue&) {
+            notifyScaUnavailable(nsw::commands::MONITOR);
+          }
+        })
+        .get();
+    }
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+  ERS_LOG(fmt::format("Finished execution of user command '{}': {}", usrCmd.commandName(), usrCmd.commandParameters()));
+}
+
+void nsw::NSWSCAServiceRc::dumpHistory(const daq::rc::UserCmd& usrCmd)
+{
+  ERS_LOG(fmt::format("User command '{}' received in state '{}': {}",
+                      usrCmd.commandName(),
+                      usrCmd.currentFSMState(),
+                      usrCmd.commandParameters()));
+  const auto& parameters = usrCmd.commandParameters();
+  if (std::empty(parameters) or std::size(parameters) > 4) {
+    ers::warning(nsw::NSWInvalidCommand(
+      ERS_HERE,
+      fmt::format("Dump history command must have one to four arguments (file, group, device, window in seconds). "
+                  "Recieved {} commands ({}).",
+                  std::size(parameters),
+                  usrCmd.toString())));
+    return;
+  }
+  const auto parameter = [&parameters](const std::size_t index) {
+    return index < std::size(parameters) ? parameters.at(index) : std::string{};
+  };
+  try {
+    const auto window = parameter(3);
+    const auto query = mon::HistoryQuery{
+      parameter(1), parameter(2), window.empty() ? std::chrono::seconds{0} : std::chrono::seconds{std::stoul(window)}};
+    // Only reads the history, runs concurrently with monitoring
+    const auto lock = lockShared();
+    if (m_NSWConfig == nullptr) {
+      ers::warning(nsw::NSWConfigIssue(ERS_HERE, "Requested history dump before configuring"));
+      return;
+    }
+    const auto numSeries = m_NSWConfig->getHistory().dump(parameter(0), query);
+    ERS_LOG(fmt::format("Wrote {} monitoring series to {}", numSeries, parameter(0)));
+  } catch (const std::exception& ex) {
+    ers::warning(nsw::NSWConfigIssue(ERS_HERE, fmt::format("Failed to dump the monitoring history: {}", ex.what())));
+  }
+}
+
+void nsw::NSWSCAServiceRc::notifyScaUnavailable(const std::string_view commandName)
+{
+  ERS_INFO("SCA unavailable");
+  m_isDictionary->checkin(buildScaAvailableKey(m_isDbName, m_sectorId), ISInfoBool(false));
+  if (commandName == nsw::commands::RECOVER_OPC_MESSAGE) {
+    m_sectorControllerSender.send(nsw::commands::SCA_DISCONNECTED);
+  }
+}
+
+std::unique_lock<std::shared_mutex> nsw::NSWSCAServiceRc::lockExclusive() const
+{
+  std::scoped_lock turnstile(m_turnstile);
+  return std::unique_lock{m_mutex};
+}
+
+std::shared_lock<std::shared_mutex> nsw::NSWSCAServiceRc::lockShared() const
+{
+  std::scoped_lock turnstile(m_turnstile);
+  return std::shared_lock{m_mutex};
+}
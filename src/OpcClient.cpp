@@ -6,9 +6,13 @@
 #include <algorithm>
 #include <utility>
 #include <fstream>
+#include <array>
 #include <bitset>
 #include <chrono>
 #include <thread>
+#include <span>
+#include <future>
+#include <string_view>
 
 #include <fmt/core.h>
 
@@ -27,7 +31,6 @@
 #include <XilinxFpga.h>
 #include <UaoClientForOpcUaScaUaoExceptions.h>
 
-using namespace std::chrono_literals;
 
 nsw::OpcClient::OpcClient(const std::string& server_ip_port): m_server_ipport(server_ip_port) {
     // TODO(cyildiz): Does this need to be moved to a higher level?
@@ -38,6 +41,7 @@ nsw::OpcClient::OpcClient(const std::string& server_ip_port): m_server_ipport(se
     std::string opc_connection = "opc.tcp://" + server_ip_port;
 
     m_session = std::make_unique<UaClientSdk::UaSession>();
+    m_requests = std::make_unique<OpcRequestQueue>(MAX_IN_FLIGHT, MAX_CONCURRENT_SCAS);
     m_sessionConnectInfo.internalServiceCallTimeout = OPC_SERVICE_TIMEOUT;
 
     // TODO(cyildiz): Handle connection exceptions
@@ -55,6 +59,8 @@ nsw::OpcClient::OpcClient(const std::string& server_ip_port): m_server_ipport(se
 }
 
 nsw::OpcClient::~OpcClient() {
+  // Finish pending asynchronous requests while the session is still open
+  m_requests.reset();
   ServiceSettings sessset = ServiceSettings();
   m_session->disconnect(sessset, OpcUa_True);
 }
@@ -73,31 +79,12 @@ void nsw::OpcClient::writeSpiSlaveRaw(const std::string& node, const uint8_t* da
     ERS_DEBUG(4, "Node: " << node << ", Data size: " << number_of_bytes
               << ", data[0]: " << static_cast<unsigned>(data[0]));
 
-    bool success{ false };
-    size_t retry{ 0 };
-    while (!success && retry < MAX_RETRY) {
-        try {
-            ss.writeSlave(bs);
-            success = true;
-        } catch (const std::exception& e) {
-            ERS_LOG("writeSpiSlaveRaw " << retry << " failed. " << e.what()
-                    << " Next attempt. Maximum " << MAX_RETRY << " attempts.");
-            retry++;
-            sleep(1);
-        }
-    }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "writeSpiSlaveRaw failed");
-        ers::warning(issue);
-        throw issue;
-    }
+    retry(node, "writeSpiSlaveRaw", [&ss, &bs]() { ss.writeSlave(bs); });
 }
 
 
-std::uint8_t nsw::OpcClient::readRocRaw(const std::string& node, unsigned int scl, unsigned int sda,
-                                        std::uint8_t registerAddress, unsigned int i2cDelay) const {
-    UaoClientForOpcUaSca::IoBatch ioBatch(m_session.get(), UaNodeId( node.c_str(), 2));
-
+void nsw::OpcClient::addRocRead(UaoClientForOpcUaSca::IoBatch& ioBatch, unsigned int scl, unsigned int sda,
+                                std::uint8_t registerAddress, unsigned int i2cDelay) {
     ioBatch.addSetPins( { { scl, true }, { sda, true } } );
     ioBatch.addSetPinsDirections( { { scl, UaoClientForOpcUaSca::IoBatch::OUTPUT }, { sda, UaoClientForOpcUaSca::IoBatch::OUTPUT } }, GPIO_PIN_DELAY );
 
@@ -165,35 +152,52 @@ std::uint8_t nsw::OpcClient::readRocRaw(const std::string& node, unsigned int sc
     ioBatch.addSetPins( { { sda, false } }, i2cDelay );
     ioBatch.addSetPins( { { scl, true } }, i2cDelay );
     ioBatch.addSetPins( { { sda, true } }, i2cDelay );
+}
 
-    const auto interestingPinSda = [&ioBatch, &sda, &node, this] () {
-        std::string message{};
-        for (std::size_t retry=0; retry < MAX_RETRY; ++retry) {
-            try {
-                return UaoClientForOpcUaSca::repliesToPinBits( ioBatch.dispatch(), sda );
-            } catch (const UaoClientForOpcUaSca::Exceptions::BadStatusCode& ex) {
-                message = ex.what();
-                ERS_LOG(fmt::format("Attempt {} to read failed with {}", retry+1, message));
-                std::this_thread::sleep_for(100ms);
-            }
-        }
-        throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, message);
-    }();
+std::uint8_t nsw::OpcClient::readRocRaw(const std::string& node, unsigned int scl, unsigned int sda,
+                                        std::uint8_t registerAddress, unsigned int i2cDelay) const {
+    return readRocRawMulti(node, scl, sda, std::array{registerAddress}, i2cDelay).front();
+}
 
-    std::bitset<ROC_REGISTER_SIZE> registerValue;
+std::vector<std::uint8_t> nsw::OpcClient::readRocRawMulti(const std::string& node, unsigned int scl, unsigned int sda,
+                                                          std::span<const std::uint8_t> registerAddresses,
+                                                          unsigned int i2cDelay) const {
+    if (registerAddresses.empty()) {
+        return {};
+    }
+    UaoClientForOpcUaSca::IoBatch ioBatch(m_session.get(), UaNodeId( node.c_str(), 2));
 
-    for (std::size_t i = 0; i < ROC_REGISTER_SIZE; ++i) {
-        registerValue.set(ROC_REGISTER_SIZE-1-i, interestingPinSda.at(i+2));
+    for (const auto registerAddress : registerAddresses) {
+        addRocRead(ioBatch, scl, sda, registerAddress, i2cDelay);
     }
 
-    return static_cast<uint8_t>(registerValue.to_ulong());
+    const auto interestingPinSda = retry(node, "readRocRaw", [&ioBatch, sda]() {
+        return UaoClientForOpcUaSca::repliesToPinBits( ioBatch.dispatch(), sda );
+    });
+    return decodeRocReads({std::begin(interestingPinSda), std::end(interestingPinSda)}, registerAddresses.size());
+}
+
+std::vector<std::uint8_t> nsw::OpcClient::decodeRocReads(const std::vector<bool>& sdaBits, const std::size_t numRegisters) {
+    // Each read samples the two acknowledge bits followed by the register bits
+    constexpr std::size_t PIN_READS_PER_REGISTER = ROC_REGISTER_SIZE + 2;
+    std::vector<std::uint8_t> result;
+    result.reserve(numRegisters);
+    for (std::size_t reg = 0; reg < numRegisters; ++reg) {
+        std::bitset<ROC_REGISTER_SIZE> registerValue;
+        const auto offset = reg * PIN_READS_PER_REGISTER;
+        for (std::size_t i = 0; i < ROC_REGISTER_SIZE; ++i) {
+            registerValue.set(ROC_REGISTER_SIZE-1-i, sdaBits.at(offset+i+2));
+        }
+        result.push_back(static_cast<uint8_t>(registerValue.to_ulong()));
+    }
+    return result;
 }
 
 
 std::vector<uint8_t> nsw::OpcClient::readSpiSlave(const std::string& node, size_t number_of_chunks) const {
     UaoClientForOpcUaSca::SpiSlave ss(m_session.get(), UaNodeId(node.c_str(), 2));
 
-    try {
+    return retry(node, "readSpiSlave", [&ss, &node, number_of_chunks]() {
         UaByteString bsread;
         ss.readSlave(static_cast<std::uint32_t>(number_of_chunks), bsread);
         std::vector<uint8_t> result;
@@ -202,11 +206,7 @@ std::vector<uint8_t> nsw::OpcClient::readSpiSlave(const std::string& node, size_
         ERS_DEBUG(4, "node: " << node << ", read bytes: " << length);
         result.assign(array, array + length);
         return result;
-    } catch (const std::exception& e) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, e.what());
-        ers::warning(issue);
-        throw issue;
-    }
+    });
 }
 
 void nsw::OpcClient::writeI2c(const std::string& node, const std::vector<uint8_t>& cdata) const {
@@ -223,166 +223,383 @@ void nsw::OpcClient::writeI2cRaw(const std::string& node, const uint8_t* data, s
     ERS_DEBUG(4, "Node: " << node << ", Data size: " << number_of_bytes
               << ", data[0]: " << static_cast<unsigned>(data[0]));
 
-    bool success{ false };
-    size_t retry{ 0 };
-    while (!success && retry < MAX_RETRY) {
-        try {
-            i2cnode.writeSlave(bs);
-            success = true;
-        } 
-        catch (const std::exception& e) {
-            ERS_LOG("writeI2cRaw " << retry << " failed. " << e.what() 
-                    << " Next attempt. Maximum " << MAX_RETRY << " attempts.");
-            retry++;
-            sleep(1);
-        }
-    }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "writeI2c failed");
-        ers::warning(issue);
-        throw issue;
-    }
+    retry(node, "writeI2cRaw", [&i2cnode, &bs]() { i2cnode.writeSlave(bs); });
 }
 
 void nsw::OpcClient::writeGPIO(const std::string& node, bool data) const {
     UaoClientForOpcUaSca::DigitalIO gpio(m_session.get(), UaNodeId(node.c_str(), 2));
     ERS_DEBUG(4, "Node: " << node << ", Data: " << data);
 
-    bool success{ false };
-    size_t retry{ 0 };
-    while (!success && retry < MAX_RETRY) {
-        try {
-            gpio.writeValue(data);
-            success = true;
-        } catch (const std::exception& e) {
-            ERS_LOG("writeGPIO " << retry << " to " << node << " failed. " << e.what()
-                    << " Next attempt. Maximum " << MAX_RETRY << " attempts.");
-            retry++;
-            sleep(1);
+    retry(node, "writeGPIO", [&gpio, data]() { gpio.writeValue(data); });
+}
+
+void nsw::OpcClient::writeGPIOs(const std::span<const OpcTransaction::Operation> operations) const {
+    // Same request as DigitalIO::writeValue, but with one value per GPIO
+    UaWriteValues nodesToWrite;
+    nodesToWrite.create(static_cast<OpcUa_UInt32>(operations.size()));
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+        ERS_DEBUG(4, "Node: " << operation.node << ", Data: " << operation.value);
+        UaNodeId(fmt::format("{}.value", operation.node).c_str(), 2).copyTo(&nodesToWrite[i].NodeId);
+        nodesToWrite[i].AttributeId = OpcUa_Attributes_Value;
+        UaVariant value;
+        value.setBool(operation.value);
+        value.copyTo(&nodesToWrite[i].Value.Value);
+    }
+
+    // Writing a GPIO twice has no side effect, so the whole request is repeated. The first node
+    // whose write failed is reported.
+    const auto& node = operations.front().node;
+    retry(node, "writeGPIOs", [this, &operations, &nodesToWrite]() {
+        UaClientSdk::ServiceSettings settings;
+        UaStatusCodeArray results;
+        UaDiagnosticInfos diagnosticInfos;
+        const UaStatus status = m_session->write(settings, nodesToWrite, results, diagnosticInfos);
+        if (status.isBad()) {
+            throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, operations.front().node,
+                                         status.toString().toUtf8());
         }
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            if (OpcUa_IsBad(results[static_cast<OpcUa_UInt32>(i)])) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, operations[i].node, "writeGPIOs failed");
+            }
+        }
+    });
+}
+
+void nsw::OpcClient::writeI2cs(const std::span<const OpcTransaction::Operation> operations) const {
+    if (operations.size() == 1) {
+        writeI2cRaw(operations.front().node, operations.front().data.data(), operations.front().data.size());
+        return;
     }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "writeGPIO failed");
-        ers::warning(issue);
-        throw issue;
+    // Same calls as I2cSlave::writeSlave, one per operation
+    UaCallMethodRequests requests;
+    requests.create(static_cast<OpcUa_UInt32>(operations.size()));
+    for (std::size_t i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+        ERS_DEBUG(4, "Node: " << operation.node << ", Data size: " << operation.data.size());
+        auto& request = requests[static_cast<OpcUa_UInt32>(i)];
+        UaNodeId(operation.node.c_str(), 2).copyTo(&request.ObjectId);
+        UaNodeId(fmt::format("{}.writeSlave", operation.node).c_str(), 2).copyTo(&request.MethodId);
+        UaByteString data;
+        // UaByteString::setByteString does not modify its buffer argument.
+        data.setByteString(static_cast<int>(operation.data.size()), const_cast<uint8_t*>(operation.data.data()));
+        UaVariantArray arguments;
+        arguments.create(1);
+        UaVariant(data).copyTo(&arguments[0]);
+        request.NoOfInputArguments = static_cast<OpcUa_Int32>(arguments.length());
+        request.InputArguments = arguments.detach();
     }
-}
 
-bool nsw::OpcClient::readGPIO(const std::string& node) const {
-    UaoClientForOpcUaSca::DigitalIO gpio(m_session.get(), UaNodeId(node.c_str(), 2));
-    bool value = false;
+    // Like a single write, the whole request is repeated. The first node whose write failed is
+    // reported.
+    retry(operations.front().node, "writeI2cs", [this, &operations, &requests]() {
+        UaClientSdk::ServiceSettings settings;
+        UaCallMethodResults results;
+        UaDiagnosticInfos diagnosticInfos;
+        const UaStatus status = m_session->callList(settings, requests, results, diagnosticInfos);
+        if (status.isBad()) {
+            throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, operations.front().node,
+                                         status.toString().toUtf8());
+        }
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            if (OpcUa_IsBad(results[static_cast<OpcUa_UInt32>(i)].StatusCode)) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, operations[i].node, "writeI2cs failed");
+            }
+        }
+    });
+}
 
-    bool success{ false };
-    size_t retry{ 0 };
-    while (!success && retry < MAX_RETRY) {
-        try {
-            value = gpio.readValue();
-            success = true;
-        } catch (const std::exception& e) {
-            ERS_LOG("readGPIO " << retry << " to " << node << " failed. " << e.what()
-                    << " Next attempt. Maximum " << MAX_RETRY << " attempts.");
-            retry++;
-            sleep(1);
+void nsw::OpcClient::dispatch(const OpcTransaction& transaction) const {
+    for (const auto& request : transaction.getRequests()) {
+        switch (request.front().type) {
+        case OpcTransaction::Type::GPIO:
+            writeGPIOs(request);
+            break;
+        case OpcTransaction::Type::I2C:
+            writeI2cs(request);
+            break;
+        case OpcTransaction::Type::SPI:
+            writeSpiSlaveRaw(request.front().node, request.front().data.data(), request.front().data.size());
+            break;
         }
     }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "readGPIO failed");
-        ers::warning(issue);
-        throw issue;
-    }
-    return value;
+}
+
+std::future<void> nsw::OpcClient::dispatchAsync(OpcTransaction transaction) const {
+    // Copied before the transaction is moved into the request
+    const std::string sca{transaction.empty() ? std::string_view{} :
+        OpcRetryPolicy::getScaName(transaction.getOperations().front().node)};
+    return m_requests->submit(sca, [this, transaction = std::move(transaction)]() {
+        dispatch(transaction);
+    });
+}
+
+std::future<void> nsw::OpcClient::writeI2cRawAsync(std::string node, std::vector<uint8_t> data) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), data = std::move(data)]() {
+        writeI2cRaw(node, data.data(), data.size());
+    });
+}
+
+std::future<std::vector<uint8_t>> nsw::OpcClient::readI2cAsync(std::string node, const size_t number_of_bytes) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), number_of_bytes]() {
+        return readI2c(node, number_of_bytes);
+    });
+}
+
+std::future<void> nsw::OpcClient::writeSpiSlaveRawAsync(std::string node, std::vector<uint8_t> data) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), data = std::move(data)]() {
+        writeSpiSlaveRaw(node, data.data(), data.size());
+    });
+}
+
+std::future<std::vector<uint8_t>> nsw::OpcClient::readSpiSlaveAsync(std::string node, const size_t number_of_chunks) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), number_of_chunks]() {
+        return readSpiSlave(node, number_of_chunks);
+    });
+}
+
+std::future<void> nsw::OpcClient::writeGPIOAsync(std::string node, const bool value) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), value]() {
+        writeGPIO(node, value);
+    });
+}
+
+std::future<bool> nsw::OpcClient::readGPIOAsync(std::string node) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node)]() {
+        return readGPIO(node);
+    });
+}
+
+std::future<std::uint8_t> nsw::OpcClient::readRocRawAsync(std::string node, const unsigned int scl, const unsigned int sda,
+                                                          const std::uint8_t registerAddress, const unsigned int i2cDelay) const {
+    const std::string sca{OpcRetryPolicy::getScaName(node)};
+    return m_requests->submit(sca, [this, node = std::move(node), scl, sda, registerAddress, i2cDelay]() {
+        return readRocRaw(node, scl, sda, registerAddress, i2cDelay);
+    });
+}
+
+bool nsw::OpcClient::readGPIO(const std::string& node) const {
+    UaoClientForOpcUaSca::DigitalIO gpio(m_session.get(), UaNodeId(node.c_str(), 2));
+    return retry(node, "readGPIO", [&gpio]() -> bool { return gpio.readValue(); });
 }
 
 std::vector<uint8_t> nsw::OpcClient::readI2c(const std::string& node, size_t number_of_bytes) const {
     UaoClientForOpcUaSca::I2cSlave i2cnode(m_session.get(), UaNodeId(node.c_str(), 2));
 
-    std::vector<uint8_t> result;
-    bool success{false};
-    std::size_t retry{0};
-    while (!success && retry < MAX_RETRY) {
-        try {
-            UaByteString output;
-            i2cnode.readSlave(static_cast<std::uint8_t>(number_of_bytes), output);
-            ERS_DEBUG(4, "node: " << node << ", bytes to read: " << number_of_bytes);
-            // copy array contents in a vector
-            result.assign(output.data(), output.data() + number_of_bytes);
-            success = true;
-        } catch (const std::exception& e) {
-            ERS_LOG(fmt::format("readI2c of {} failed, attempt {}/{}: {}.",
-                                node, retry + 1, MAX_RETRY, e.what()));
-            retry++;
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
+    return retry(node, "readI2c", [&i2cnode, &node, number_of_bytes]() {
+        UaByteString output;
+        i2cnode.readSlave(static_cast<std::uint8_t>(number_of_bytes), output);
+        ERS_DEBUG(4, "node: " << node << ", bytes to read: " << number_of_bytes);
+        // copy array contents in a vector
+        return std::vector<uint8_t>(output.data(), output.data() + number_of_bytes);
+    });
+}
+
+std::vector<std::vector<uint8_t>> nsw::OpcClient::readI2cAtAddresses(
+    const std::string& node, const std::span<const I2cAddressedRead> reads) const {
+    if (reads.empty()) {
+        return {};
     }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "readI2c failed");
-        ers::warning(issue);
-        throw issue;
+    // Same calls as I2cSlave::writeSlave and I2cSlave::readSlave
+    const UaNodeId objectId(node.c_str(), 2);
+    const UaNodeId writeMethodId(fmt::format("{}.writeSlave", node).c_str(), 2);
+    const UaNodeId readMethodId(fmt::format("{}.readSlave", node).c_str(), 2);
+    UaCallMethodRequests requests;
+    requests.create(static_cast<OpcUa_UInt32>(2 * reads.size()));
+    for (std::size_t i = 0; i < reads.size(); ++i) {
+        ERS_DEBUG(4, "Node: " << node << ", address size: " << reads[i].address.size()
+                  << ", bytes to read: " << reads[i].numberOfBytes);
+        auto& write = requests[static_cast<OpcUa_UInt32>(2 * i)];
+        objectId.copyTo(&write.ObjectId);
+        writeMethodId.copyTo(&write.MethodId);
+        UaByteString address;
+        // UaByteString::setByteString does not modify its buffer argument.
+        address.setByteString(static_cast<int>(reads[i].address.size()),
+                              const_cast<uint8_t*>(reads[i].address.data()));
+        UaVariantArray writeArguments;
+        writeArguments.create(1);
+        UaVariant(address).copyTo(&writeArguments[0]);
+        write.NoOfInputArguments = static_cast<OpcUa_Int32>(writeArguments.length());
+        write.InputArguments = writeArguments.detach();
+
+        auto& read = requests[static_cast<OpcUa_UInt32>(2 * i + 1)];
+        objectId.copyTo(&read.ObjectId);
+        readMethodId.copyTo(&read.MethodId);
+        UaVariantArray readArguments;
+        readArguments.create(1);
+        UaVariant numberOfBytes;
+        numberOfBytes.setByte(static_cast<OpcUa_Byte>(reads[i].numberOfBytes));
+        numberOfBytes.copyTo(&readArguments[0]);
+        read.NoOfInputArguments = static_cast<OpcUa_Int32>(readArguments.length());
+        read.InputArguments = readArguments.detach();
     }
-    return result;
+
+    // Writing the address again before each read has no side effect, so the whole request is repeated
+    return retry(node, "readI2cAtAddresses", [this, &node, &reads, &requests]() {
+        UaClientSdk::ServiceSettings settings;
+        UaCallMethodResults results;
+        UaDiagnosticInfos diagnosticInfos;
+        const UaStatus status = m_session->callList(settings, requests, results, diagnosticInfos);
+        if (status.isBad()) {
+            throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, status.toString().toUtf8());
+        }
+        std::vector<std::vector<uint8_t>> data;
+        data.reserve(reads.size());
+        for (std::size_t i = 0; i < reads.size(); ++i) {
+            const auto& write = results[static_cast<OpcUa_UInt32>(2 * i)];
+            const auto& read = results[static_cast<OpcUa_UInt32>(2 * i + 1)];
+            if (OpcUa_IsBad(write.StatusCode) or OpcUa_IsBad(read.StatusCode) or read.NoOfOutputArguments < 1) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, "readI2cAtAddresses failed");
+            }
+            UaByteString output;
+            UaVariant(read.OutputArguments[0]).toByteString(output);
+            if (static_cast<std::size_t>(output.length()) < reads[i].numberOfBytes) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, "readI2cAtAddresses returned too few bytes");
+            }
+            data.emplace_back(output.data(), output.data() + reads[i].numberOfBytes);
+        }
+        return data;
+    });
 }
 
 float nsw::OpcClient::readAnalogInput(const std::string& node) const {
     UaoClientForOpcUaSca::AnalogInput ainode(m_session.get(), UaNodeId(node.c_str(), 2));
-    try {
-        return ainode.readValue();
-    } catch (const UaoClientForOpcUaSca::Exceptions::BadStatusCode& ex) {
-        throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, ex.what());
-    }
+    return retry(node, "readAnalogInput", [&ainode]() -> float { return ainode.readValue(); });
 }
 
 std::vector<std::uint16_t> nsw::OpcClient::readAnalogInputConsecutiveSamples(const std::string& node, size_t n_samples) const {
     UaoClientForOpcUaSca::AnalogInput ainode(m_session.get(), UaNodeId(node.c_str(), 2));
 
-    std::vector<std::uint16_t> values;
-
-    bool success{ false };
-    size_t retry{ 0 };
-    while (!success && retry < MAX_RETRY) {
-        try {
-            ainode.getConsecutiveRawSamples(static_cast<std::uint16_t>(n_samples), values);
-            success = true;
-        }
-        catch (const std::exception& e) {
-            values.clear();
-            ERS_LOG("readAnalogInputConsecutiveSamples " << retry << " failed. " << e.what() 
-                    << " Next attempt. Maximum " << MAX_RETRY << " attempts.");
-            retry++;
-            sleep(1);
-        }
-    }
-    if (!success) {
-        nsw::OpcReadWriteIssue issue(ERS_HERE, m_server_ipport, node, "readAnalogInputConsecutiveSamples failed");
-        ers::warning(issue);
-        throw issue;
-    }
-    return values;
+    return retry(node, "readAnalogInputConsecutiveSamples", [&ainode, n_samples]() {
+        std::vector<std::uint16_t> values;
+        ainode.getConsecutiveRawSamples(static_cast<std::uint16_t>(n_samples), values);
+        return values;
+    });
 }
 
 unsigned int nsw::OpcClient::readScaID(const std::string& node) const {
     UaoClientForOpcUaSca::SCA scanode(m_session.get(), UaNodeId(node.c_str(), std::uint16_t{2}));
-    try {
-        return scanode.readId();
-    } catch (const UaoClientForOpcUaSca::Exceptions::BadStatusCode& ex) {
-        throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, ex.what());
-    }
+    return retry(node, "readScaID", [&scanode]() -> unsigned int { return scanode.readId(); });
 }
 
 std::string nsw::OpcClient::readScaAddress(const std::string& node) const {
     UaoClientForOpcUaSca::SCA scanode(m_session.get(), UaNodeId(node.c_str(), std::uint16_t{2}));
-    try {
-        return scanode.readAddress().toUtf8();
-    } catch (const UaoClientForOpcUaSca::Exceptions::BadStatusCode& ex) {
-        throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, ex.what());
-    }
+    return retry(node, "readScaAddress", [&scanode]() { return scanode.readAddress().toUtf8(); });
 }
 
 bool nsw::OpcClient::readScaOnline(const std::string& node) const {
     UaoClientForOpcUaSca::SCA scanode(m_session.get(), UaNodeId(node.c_str(), std::uint16_t{2}));
-    try {
-        return scanode.readOnline();
-    } catch (const UaoClientForOpcUaSca::Exceptions::BadStatusCode& ex) {
-        throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, node, ex.what());
+    return probe(node, "readScaOnline", [&scanode]() -> bool { return scanode.readOnline(); });
+}
+
+void nsw::OpcClient::readScaVariables(const std::span<const std::string> nodes,
+                                      const std::span<const std::string_view> variables,
+                                      const std::size_t chunkSize,
+                                      const std::function<void(std::size_t, std::size_t, const UaVariant&)>& store) const {
+    for (const auto& [first, size] : getReadChunks(nodes.size(), chunkSize)) {
+        const auto chunk = nodes.subspan(first, size);
+
+        // Same request as SCA::read<Variable>, but with all variables of all SCAs of the chunk
+        UaReadValueIds nodesToRead;
+        nodesToRead.create(static_cast<OpcUa_UInt32>(chunk.size() * variables.size()));
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            for (std::size_t j = 0; j < variables.size(); ++j) {
+                auto& nodeToRead = nodesToRead[static_cast<OpcUa_UInt32>(i * variables.size() + j)];
+                UaNodeId(fmt::format("{}.{}", chunk[i], variables[j]).c_str(), 2).copyTo(&nodeToRead.NodeId);
+                nodeToRead.AttributeId = OpcUa_Attributes_Value;
+            }
+        }
+
+        // Only used to probe the state of the SCAs
+        UaDataValues values;
+        probe(chunk.front(), "readScaVariables", [this, &chunk, &nodesToRead, &values]() {
+            UaClientSdk::ServiceSettings settings;
+            UaDiagnosticInfos diagnosticInfos;
+            const UaStatus status = m_session->read(settings, 0, OpcUa_TimestampsToReturn_Neither,
+                                                    nodesToRead, values, diagnosticInfos);
+            if (status.isBad()) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, chunk.front(),
+                                             status.toString().toUtf8());
+            }
+            if (values.length() != nodesToRead.length()) {
+                throw nsw::OpcReadWriteIssue(ERS_HERE, m_server_ipport, chunk.front(),
+                                             fmt::format("Read returned {} values for {} variables",
+                                                         values.length(), nodesToRead.length()));
+            }
+        });
+
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            for (std::size_t j = 0; j < variables.size(); ++j) {
+                const auto& value = values[static_cast<OpcUa_UInt32>(i * variables.size() + j)];
+                if (OpcUa_IsGood(value.StatusCode)) {
+                    store(first + i, j, UaVariant(value.Value));
+                }
+            }
+        }
+    }
+}
+
+std::vector<std::optional<bool>> nsw::OpcClient::readScaOnlineMulti(const std::span<const std::string> nodes,
+                                                                    const std::size_t chunkSize) const {
+    constexpr std::array<std::string_view, 1> VARIABLES{"online"};
+    std::vector<std::optional<bool>> result(nodes.size());
+    readScaVariables(nodes, VARIABLES, chunkSize, [&result](const std::size_t node, std::size_t, const UaVariant& value) {
+        OpcUa_Boolean online{};
+        if (value.toBool(online).isGood()) {
+            result[node] = online != OpcUa_False;
+        }
+    });
+    return result;
+}
+
+std::vector<nsw::ScaStatusInfo> nsw::OpcClient::readScaStatus(const std::span<const std::string> nodes,
+                                                              const std::size_t chunkSize) const {
+    std::vector<ScaStatusInfo> result(nodes.size());
+    readScaVariables(nodes, SCA_STATUS_VARIABLES, chunkSize, [&result](const std::size_t node, const std::size_t variable, const UaVariant& value) {
+        storeScaStatus(result[node], static_cast<ScaStatusVariable>(variable), value);
+    });
+    return result;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> nsw::OpcClient::getReadChunks(const std::size_t numNodes,
+                                                                                const std::size_t chunkSize) {
+    const auto nodesPerRequest = std::max(chunkSize, std::size_t{1});
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    chunks.reserve((numNodes + nodesPerRequest - 1) / nodesPerRequest);
+    for (std::size_t first = 0; first < numNodes; first += nodesPerRequest) {
+        chunks.emplace_back(first, std::min(nodesPerRequest, numNodes - first));
+    }
+    return chunks;
+}
+
+void nsw::OpcClient::storeScaStatus(ScaStatusInfo& info, const ScaStatusVariable variable, const UaVariant& value) {
+    switch (variable) {
+    case ScaStatusVariable::ONLINE: {
+        OpcUa_Boolean online{};
+        if (value.toBool(online).isGood()) {
+            info.online = online != OpcUa_False;
+        }
+        break;
+    }
+    case ScaStatusVariable::ID: {
+        OpcUa_UInt32 id{};
+        if (value.toUInt32(id).isGood()) {
+            info.id = id;
+        }
+        break;
+    }
+    case ScaStatusVariable::ADDRESS:
+        if (value.type() == OpcUaType_String) {
+            info.address = value.toString().toUtf8();
+        }
+        break;
     }
 }
 
@@ -407,19 +624,9 @@ void nsw::OpcClient::writeXilinxFpga(const std::string& node, const std::string&
         ERS_DEBUG(4, "Node: " << node << ", Data size: " << size
                   << ", data[0]: " << static_cast<unsigned>(bytes.get()[0]));
 
-        bool success{ false };
-        std::size_t retry{ 0 };
-        while (not success and retry < RETRY_TWICE) {
-          try {
-            fpga.program(bs);
-            success = true;
-          } catch (const std::exception& ex) {
-            retry++;
-            ERS_LOG(fmt::format("Attempt {}/{} failed: {}", retry, RETRY_TWICE, ex.what()));
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-          }
-        }
-        if (not success) {
+        try {
+          retry(node, "writeXilinxFpga", [&fpga, &bs]() { fpga.program(bs); }, RETRY_TWICE);
+        } catch (const nsw::OpcReadWriteIssue&) {
           nsw::OpcClientIssue issue(ERS_HERE, fmt::format("FPGA programming failed"));
           ers::error(issue);
         }
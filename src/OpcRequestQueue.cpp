@@ -0,0 +1,73 @@
+#include "NSWConfiguration/OpcRequestQueue.h"
+
+#include <algorithm>
+#include <utility>
+
+nsw::OpcRequestQueue::OpcRequestQueue(const std::size_t maxInFlight, const std::size_t maxWorkers) :
+  m_maxInFlight{std::max(maxInFlight, std::size_t{1})},
+  m_maxWorkers{std::max(maxWorkers, std::size_t{1})}
+{}
+
+nsw::OpcRequestQueue::~OpcRequestQueue()
+{
+  for (auto& worker : m_workers) {
+    worker.request_stop();
+  }
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void nsw::OpcRequestQueue::post(const std::string_view key, Request request)
+{
+  std::unique_lock lock(m_mutex);
+  m_condition.wait(lock, [this]() { return m_numInFlight < m_maxInFlight; });
+  ++m_numInFlight;
+  auto entry = m_requests.find(key);
+  if (entry == std::end(m_requests)) {
+    // A known key is either waiting in m_ready already or being served by a worker
+    entry = m_requests.emplace(std::string{key}, std::deque<Request>{}).first;
+    m_ready.push_back(entry->first);
+  }
+  entry->second.push_back(std::move(request));
+  if (std::size(m_workers) < std::min(m_maxWorkers, std::size(m_requests))) {
+    m_workers.emplace_back([this](const std::stop_token stopToken) { run(stopToken); });
+  }
+  m_condition.notify_all();
+}
+
+void nsw::OpcRequestQueue::run(const std::stop_token stopToken)
+{
+  while (true) {
+    std::string key{};
+    Request request{};
+    {
+      std::unique_lock lock(m_mutex);
+      // Stop only once all submitted requests are executed
+      m_condition.wait(lock, stopToken, [this]() { return not m_ready.empty(); });
+      if (m_ready.empty()) {
+        return;
+      }
+      key = std::move(m_ready.front());
+      m_ready.pop_front();
+      auto& requests = m_requests.find(key)->second;
+      request = std::move(requests.front());
+      requests.pop_front();
+    }
+    request();
+    {
+      std::scoped_lock lock(m_mutex);
+      --m_numInFlight;
+      const auto entry = m_requests.find(key);
+      if (entry->second.empty()) {
+        m_requests.erase(entry);
+      } else {
+        // Round robin: other keys are served before the next request of this key
+        m_ready.push_back(std::move(key));
+      }
+    }
+    m_condition.notify_all();
+  }
+}
@@ -0,0 +1,293 @@
+#include "NSWConfiguration/OpcRetryPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+#include <fmt/core.h>
+
+#include <ers/ers.h>
+
+namespace {
+  std::chrono::microseconds toMicroseconds(const nsw::OpcRetryPolicy::Clock::duration duration)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+  }
+}  // namespace
+
+std::string nsw::OpcRetryStatistics::toString() const
+{
+  const auto toMilliseconds = [](const std::chrono::microseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  const auto meanLatency = m_operations == 0 ? std::chrono::microseconds{0} :
+                                               m_totalLatency / static_cast<std::int64_t>(m_operations);
+  return fmt::format("{} operations, {} retries, {} failures, {} rejections, mean latency {:.1f} ms, max latency {:.1f} ms",
+                     m_operations,
+                     m_retries,
+                     m_failures,
+                     m_rejections,
+                     toMilliseconds(meanLatency),
+                     toMilliseconds(m_maxLatency));
+}
+
+nsw::OpcRetryPolicy::OpcRetryPolicy(OpcRetryParameters parameters)
+{
+  setParameters(std::move(parameters));
+}
+
+void nsw::OpcRetryPolicy::setParameters(OpcRetryParameters parameters)
+{
+  m_parameters = std::move(parameters);
+  m_parameters.m_maxAttempts = std::max(m_parameters.m_maxAttempts, std::size_t{1});
+  m_parameters.m_jitter = std::clamp(m_parameters.m_jitter, 0., 1.);
+  resetBreakers();
+}
+
+nsw::OpcRetryPolicy& nsw::OpcRetryPolicy::getDefault()
+{
+  static OpcRetryPolicy policy{};
+  return policy;
+}
+
+std::string_view nsw::OpcRetryPolicy::getScaName(const std::string_view node)
+{
+  return node.substr(0, node.find('.'));
+}
+
+void nsw::OpcRetryPolicy::setDeadline(const std::optional<Clock::time_point> deadline)
+{
+  m_deadline = deadline.has_value() ? deadline->time_since_epoch().count() : Clock::rep{0};
+}
+
+std::optional<nsw::OpcRetryPolicy::Clock::time_point> nsw::OpcRetryPolicy::getDeadline() const
+{
+  const auto deadline = m_deadline.load();
+  if (deadline == 0) {
+    return std::nullopt;
+  }
+  return Clock::time_point{Clock::duration{deadline}};
+}
+
+nsw::OpcRetryPolicy::Clock::duration nsw::OpcRetryPolicy::getBackoff(const std::size_t attempt) const
+{
+  thread_local std::mt19937 generator{std::random_device{}()};
+  std::uniform_real_distribution<double> distribution{0., 1.};
+
+  const auto exponent = static_cast<double>(std::max(attempt, std::size_t{1}) - 1);
+  const auto backoff = std::min(static_cast<double>(m_parameters.m_initialBackoff.count()) *
+                                  std::pow(m_parameters.m_backoffMultiplier, exponent),
+                                static_cast<double>(m_parameters.m_maxBackoff.count()));
+  // Spread the retries of operations which failed at the same time
+  const auto jittered = backoff * (1. - m_parameters.m_jitter * distribution(generator));
+  return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(jittered));
+}
+
+nsw::OpcRetryStatistics nsw::OpcRetryPolicy::getStatistics() const
+{
+  return {.m_operations = m_operations,
+          .m_retries = m_retries,
+          .m_failures = m_failures,
+          .m_rejections = m_rejections,
+          .m_totalLatency = std::chrono::microseconds{m_totalLatency},
+          .m_maxLatency = std::chrono::microseconds{m_maxLatency}};
+}
+
+void nsw::OpcRetryPolicy::resetStatistics()
+{
+  m_operations = 0;
+  m_retries = 0;
+  m_failures = 0;
+  m_rejections = 0;
+  m_totalLatency = 0;
+  m_maxLatency = 0;
+}
+
+void nsw::OpcRetryPolicy::resetBreakers()
+{
+  std::scoped_lock lock{m_mutex};
+  m_scaBreakers.clear();
+  m_serverBreakers.clear();
+}
+
+void nsw::OpcRetryPolicy::checkBreakers(const std::string& server,
+                                        const std::string_view sca,
+                                        const Clock::time_point start)
+{
+  const auto now = Clock::now();
+  // Returns true if the request may pass, an elapsed open breaker lets one trial request through
+  const auto allow = [this, now](Breaker& breaker) {
+    if (not breaker.m_open) {
+      return true;
+    }
+    if (now < breaker.m_openUntil) {
+      return false;
+    }
+    breaker.m_openUntil = now + m_parameters.m_breakerCooldown;
+    return true;
+  };
+
+  std::unique_lock lock{m_mutex};
+  const auto reject = [this, &lock, start](const std::string_view target, const Breaker& breaker) {
+    const auto failures = breaker.m_consecutiveFailures;
+    lock.unlock();
+    ++m_rejections;
+    ++m_failures;
+    recordLatency(start);
+    throw OpcCircuitOpenIssue(ERS_HERE, std::string{target}, failures);
+  };
+
+  auto& serverBreaker = m_serverBreakers[server];
+  if (not allow(serverBreaker)) {
+    reject(server, serverBreaker);
+  }
+  if (not sca.empty()) {
+    auto& scaBreaker = getScaBreaker(server, sca);
+    if (not allow(scaBreaker)) {
+      reject(fmt::format("{} ({})", sca, server), scaBreaker);
+    }
+  }
+}
+
+nsw::OpcRetryPolicy::Breaker& nsw::OpcRetryPolicy::getScaBreaker(const std::string& server,
+                                                                 const std::string_view sca)
+{
+  auto& breakers = m_scaBreakers[server];
+  auto breaker = breakers.find(sca);
+  if (breaker == std::end(breakers)) {
+    breaker = breakers.emplace(std::string{sca}, Breaker{}).first;
+  }
+  return breaker->second;
+}
+
+void nsw::OpcRetryPolicy::onSuccess(const std::string& server,
+                                    const std::string_view sca,
+                                    const std::size_t attempt,
+                                    const Clock::time_point start)
+{
+  {
+    std::scoped_lock lock{m_mutex};
+    const auto close = [](Breaker& breaker, const std::string_view target) {
+      if (breaker.m_open) {
+        ERS_LOG(fmt::format("Circuit breaker of {} is closed again", target));
+      }
+      breaker = Breaker{};
+    };
+    close(m_serverBreakers[server], server);
+    if (not sca.empty()) {
+      close(getScaBreaker(server, sca), fmt::format("{} ({})", sca, server));
+    }
+  }
+  m_retries += attempt - 1;
+  recordLatency(start);
+}
+
+bool nsw::OpcRetryPolicy::onFailure(const std::string& server,
+                                    const std::string_view sca,
+                                    const std::string_view operation,
+                                    const std::size_t attempt,
+                                    const std::size_t maxAttempts,
+                                    const Clock::time_point start,
+                                    const std::exception& exception)
+{
+  const auto now = Clock::now();
+  const auto target = sca.empty() ? server : fmt::format("{} ({})", sca, server);
+  const auto deadline = getDeadline();
+  const auto giveUp = [&]() {
+    ERS_LOG(fmt::format("{} of {} failed, attempt {}/{}: {}", operation, target, attempt, maxAttempts, exception.what()));
+    recordFailedOperation(server, sca, now);
+    m_retries += attempt - 1;
+    ++m_failures;
+    recordLatency(start);
+    return false;
+  };
+  // The outcome of a trial request decides about the breaker, retrying it would be rejected anyway
+  if (attempt >= maxAttempts or isTrial(server, sca)) {
+    return giveUp();
+  }
+  if (deadline.has_value() and now >= *deadline) {
+    ERS_LOG(fmt::format("Retry budget of the transition is exhausted, not retrying {} of {}", operation, target));
+    return giveUp();
+  }
+
+  auto backoff = getBackoff(attempt);
+  if (deadline.has_value()) {
+    backoff = std::min(backoff, *deadline - now);
+  }
+  ERS_LOG(fmt::format("{} of {} failed, attempt {}/{}: {}. Retrying in {:.1f} ms",
+                      operation,
+                      target,
+                      attempt,
+                      maxAttempts,
+                      exception.what(),
+                      std::chrono::duration<double, std::milli>(backoff).count()));
+  std::this_thread::sleep_for(backoff);
+  return true;
+}
+
+bool nsw::OpcRetryPolicy::isTrial(const std::string& server, const std::string_view sca) const
+{
+  std::scoped_lock lock{m_mutex};
+  const auto isOpen = [](const auto& breakers, const std::string_view target) {
+    const auto breaker = breakers.find(target);
+    return breaker != std::end(breakers) and breaker->second.m_open;
+  };
+  if (isOpen(m_serverBreakers, server)) {
+    return true;
+  }
+  const auto scaBreakers = m_scaBreakers.find(server);
+  return not sca.empty() and scaBreakers != std::end(m_scaBreakers) and isOpen(scaBreakers->second, sca);
+}
+
+void nsw::OpcRetryPolicy::recordFailedOperation(const std::string& server,
+                                                const std::string_view sca,
+                                                const Clock::time_point now)
+{
+  std::scoped_lock lock{m_mutex};
+  recordFailure(m_serverBreakers[server], m_parameters.m_serverFailureThreshold, server, now);
+  if (not sca.empty()) {
+    recordFailure(getScaBreaker(server, sca), m_parameters.m_scaFailureThreshold,
+                  fmt::format("{} ({})", sca, server), now);
+  }
+}
+
+void nsw::OpcRetryPolicy::recordFailure(Breaker& breaker,
+                                        const std::size_t threshold,
+                                        const std::string_view target,
+                                        const Clock::time_point now) const
+{
+  ++breaker.m_consecutiveFailures;
+  if (breaker.m_open) {
+    // Trial request failed
+    breaker.m_openUntil = now + m_parameters.m_breakerCooldown;
+    return;
+  }
+  if (breaker.m_consecutiveFailures >= threshold) {
+    ERS_LOG(fmt::format("Opening circuit breaker of {} after {} consecutive failed operations", target, breaker.m_consecutiveFailures));
+    breaker.m_open = true;
+    breaker.m_openUntil = now + m_parameters.m_breakerCooldown;
+  }
+}
+
+void nsw::OpcRetryPolicy::recordLatency(const Clock::time_point start)
+{
+  const auto latency = toMicroseconds(Clock::now() - start).count();
+  ++m_operations;
+  m_totalLatency += latency;
+  auto maxLatency = m_maxLatency.load();
+  while (latency > maxLatency and not m_maxLatency.compare_exchange_weak(maxLatency, latency)) {
+  }
+}
+
+nsw::OpcRetryPolicy::ScopedDeadline::ScopedDeadline(OpcRetryPolicy& policy, const Clock::duration budget) :
+  m_policy{policy},
+  m_previous{policy.getDeadline()}
+{
+  m_policy.setDeadline(Clock::now() + budget);
+}
+
+nsw::OpcRetryPolicy::ScopedDeadline::~ScopedDeadline()
+{
+  m_policy.setDeadline(m_previous);
+}
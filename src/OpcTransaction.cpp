@@ -0,0 +1,38 @@
+#include "NSWConfiguration/OpcTransaction.h"
+
+#include <algorithm>
+#include <set>
+#include <string_view>
+
+std::vector<std::span<const nsw::OpcTransaction::Operation>> nsw::OpcTransaction::getRequests() const {
+    const std::span<const Operation> operations{m_operations};
+    std::vector<std::span<const Operation>> requests{};
+    auto iter = std::begin(operations);
+    while (iter != std::end(operations)) {
+        const auto type = iter->type;
+        const auto last = [&operations, iter, type]() {
+            switch (type) {
+            case Type::GPIO: {
+                if (not iter->independent) {
+                    break;
+                }
+                std::set<std::string_view> nodes{};
+                return std::find_if(iter, std::end(operations), [&nodes](const auto& operation) {
+                    return operation.type != Type::GPIO or not operation.independent or
+                           not nodes.insert(operation.node).second;
+                });
+            }
+            case Type::I2C:
+                return std::find_if(iter, std::end(operations), [](const auto& operation) {
+                    return operation.type != Type::I2C;
+                });
+            case Type::SPI:
+                break;
+            }
+            return std::next(iter);
+        }();
+        requests.emplace_back(iter, last);
+        iter = last;
+    }
+    return requests;
+}
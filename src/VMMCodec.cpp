@@ -2,121 +2,132 @@
 
 #include <exception>
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 
 #include "NSWConfiguration/Constants.h"
 #include "NSWConfiguration/Utility.h"
 
 #include <ers/ers.h>
 
+#include <fmt/core.h>
+
 #include <boost/property_tree/ptree.hpp>
 
 using boost::property_tree::ptree;
 
-bool nsw::VMMCodec::globalRegisterExists(std::string_view register_name) {
-  const auto func = [&register_name](const auto& el) {
-    return register_name == el.first;
-  };
-  return std::any_of(std::begin(m_global_name_size0),
-                     std::end(m_global_name_size0),
-                     func) or
-         std::any_of(std::begin(m_global_name_size1),
-                     std::end(m_global_name_size1),
-                     func);
+const std::string& nsw::VMMCodec::getLayoutKey() {
+    // FNV-1a over the layouts, stable across processes so that persisted images can be reused
+    static const std::string key = [] () {
+        constexpr std::uint64_t FNV_OFFSET{0xcbf29ce484222325};
+        constexpr std::uint64_t FNV_PRIME{0x100000001b3};
+        std::uint64_t layout_hash{FNV_OFFSET};
+        const auto hash = [&layout_hash] (const std::string_view text) {
+            for (const auto character : text) {
+                layout_hash = (layout_hash ^ static_cast<std::uint8_t>(character)) * FNV_PRIME;
+            }
+            layout_hash *= FNV_PRIME;  // Terminates the field
+        };
+        const auto hashLayout = [&hash] (const auto& layout) {
+            for (const auto& field : layout.getFields()) {
+                hash(field.m_name);
+                hash(std::to_string(field.m_offset));
+                hash(std::to_string(field.m_width));
+                hash(field.m_reversed ? "r" : "");
+            }
+        };
+        hashLayout(m_global_layout0);
+        hashLayout(m_global_layout1);
+        hashLayout(m_channel_layout);
+        hash(std::to_string(NBITS_TOTAL));
+        return fmt::format("vmm{:016x}v{}", layout_hash, ENCODER_VERSION);
+    }();
+    return key;
 }
 
-bool nsw::VMMCodec::channelRegisterExists(std::string_view register_name) {
-  const auto func = [&register_name](const auto& el) {
-    return register_name == el.first;
-  };
-  return std::any_of(std::begin(m_channel_name_size),
-                     std::end(m_channel_name_size),
-                     func);
+bool nsw::VMMCodec::globalRegisterExists(std::string_view register_name) {
+  return m_global_layout0.contains(register_name) or m_global_layout1.contains(register_name);
 }
 
-std::string nsw::VMMCodec::buildGlobalConfig0(const ptree& config) {
-    return buildGlobalConfig(config, nsw::GlobalRegisters::global0);
+bool nsw::VMMCodec::channelRegisterExists(std::string_view register_name) {
+  return m_channel_layout.contains(register_name);
 }
 
-std::string nsw::VMMCodec::buildGlobalConfig1(const ptree& config) {
-    return buildGlobalConfig(config, nsw::GlobalRegisters::global1);
-}
+void nsw::VMMCodec::encodeGlobalConfig(const nsw::ConfigLayers& config, nsw::GlobalRegisters type,
+                                       nsw::BitVector& bits, const std::size_t start) {
 
-std::string nsw::VMMCodec::buildGlobalConfig(const ptree& config, nsw::GlobalRegisters type) {
-
-    const auto buildBitStream = [&config] (const auto registers) {
-        std::ostringstream ss;
-        for (const auto [reg_name, size] : registers) {
-            if (reg_name == nsw::NOT_USED) {
-                const auto value = 0u;
-                ss << bitString(value, size);
-            } else {
-                const auto reg_name_string = std::string{reg_name};
-                try {
-                    const auto value = config.get<unsigned>(reg_name_string);
-                    nsw::checkOverflow(size, value, reg_name_string);
-
-                    auto iter = std::find(m_bitreversed_registers.begin(), m_bitreversed_registers.end(), reg_name);
-                    if (iter != m_bitreversed_registers.end()) {
-                        ss << reversedBitString(value, size);
-                    } else {
-                        ss << bitString(value, size);
-                    }
-                } catch (const boost::property_tree::ptree_bad_path& e) {
-                    nsw::MissingVmmRegister issue(ERS_HERE, reg_name.data());
-                    ers::error(issue);
-                    throw issue;
-                }
+    const auto encode = [&config, &bits, start] (const auto& layout) {
+        for (const auto& field : layout.getFields()) {
+            // Not used bits stay 0
+            if (field.m_name == nsw::NOT_USED) {
+                continue;
+            }
+            const auto reg_name_string = std::string{field.m_name};
+            try {
+                const auto value = config.get<unsigned>(reg_name_string);
+                nsw::checkOverflow(field.m_width, value, reg_name_string);
+                bits.insert(start + field.m_offset, field.m_width,
+                            field.m_reversed ? nsw::BitVector::reverseBits(value, field.m_width) : value);
+            } catch (const boost::property_tree::ptree_bad_path& e) {
+                nsw::MissingVmmRegister issue(ERS_HERE, field.m_name.data());
+                ers::error(issue);
+                throw issue;
             }
         }
-        return ss.str();
     };
 
     if (type == nsw::GlobalRegisters::global0) {
         ERS_DEBUG(4, "Global 0 ");
-        return buildBitStream(m_global_name_size0);
+        encode(m_global_layout0);
+        return;
     }
     if (type == nsw::GlobalRegisters::global1) {
         ERS_DEBUG(4, "Global 1 ");
-        return buildBitStream(m_global_name_size1);
+        encode(m_global_layout1);
+        return;
     }
     throw std::logic_error(fmt::format("Received invalid type {}", static_cast<int>(type)));
 }
 
-std::string nsw::VMMCodec::buildChannelConfig(const ptree& config) {
+void nsw::VMMCodec::encodeChannelConfig(const nsw::ConfigLayers& config, nsw::BitVector& bits, const std::size_t start) {
     const auto ch_reg_map = buildChannelRegisterMap(config);
 
-    const auto getValue = [&ch_reg_map] (const auto reg_name, const std::size_t channel) {
-        if (reg_name == nsw::NOT_USED) {
-            return 0u;
-        }
-        return ch_reg_map.at(reg_name).at(channel);
-    };
-
-    std::string bitstr;
     // TODO(cyildiz): Verify if we should go from 0 to 64 or reversed
-    for (std::size_t channel = nsw::vmm::NUM_CH_PER_VMM-1;; channel--) {
-        std::string tempstr_ch;
-        for (const auto& [reg_name, reg_size] : m_channel_name_size) {
-            tempstr_ch += reversedBitString(getValue(reg_name, channel), reg_size);
-        }
-        // Reverse the bitstream of the channel
-        std::reverse(tempstr_ch.begin(), tempstr_ch.end());
-        bitstr += tempstr_ch;
-        if (channel == 0) {
-            break;
+    // Channels are stored from the last to the first one
+    for (std::size_t channel = 0; channel < nsw::vmm::NUM_CH_PER_VMM; channel++) {
+        const auto channelStart = start + (nsw::vmm::NUM_CH_PER_VMM - 1 - channel) * NBITS_PER_CHANNEL;
+        for (const auto& field : m_channel_layout.getFields()) {
+            if (field.m_name == nsw::NOT_USED) {
+                continue;
+            }
+            // The bitstream of a channel is mirrored: the registers appear in reverse order, each
+            // of them with its bits in normal order
+            const auto offset = NBITS_PER_CHANNEL - field.m_offset - field.m_width;
+            bits.insert(channelStart + offset, field.m_width, ch_reg_map.at(field.m_name).at(channel));
         }
     }
-    ERS_DEBUG(6, "Channel config: " << bitstr);
-    return bitstr;
 }
 
-std::string nsw::VMMCodec::buildConfig(const ptree& config) {
-    return buildGlobalConfig1(config) + buildChannelConfig(config) + buildGlobalConfig0(config);
+nsw::BitVector nsw::VMMCodec::buildConfig(const ptree& config) {
+    return buildConfig(nsw::ConfigLayers{config});
+}
+
+nsw::BitVector nsw::VMMCodec::buildConfig(const nsw::ConfigLayers& config) {
+    nsw::BitVector bits(NBITS_TOTAL);
+    encodeGlobalConfig(config, nsw::GlobalRegisters::global1, bits, 0);
+    encodeChannelConfig(config, bits, NBITS_GLOBAL);
+    encodeGlobalConfig(config, nsw::GlobalRegisters::global0, bits, NBITS_GLOBAL + NBITS_CHANNEL);
+    ERS_DEBUG(6, "VMM config: " << bits.toString());
+    return bits;
+}
+
+std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> nsw::VMMCodec::buildChannelRegisterMap(const ptree& config) {
+    return buildChannelRegisterMap(nsw::ConfigLayers{config});
 }
 
-std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> nsw::VMMCodec::buildChannelRegisterMap(ptree config) {
+std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> nsw::VMMCodec::buildChannelRegisterMap(const nsw::ConfigLayers& config) {
     std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> result;
 
     for (const auto &[reg_name, reg_size] : m_channel_name_size) {
@@ -128,9 +139,9 @@ std::map<std::string_view, std::array<unsigned, nsw::vmm::NUM_CH_PER_VMM>> nsw::
             continue;
         }
 
-        const ptree ptemp = config.get_child(reg_name_string);
+        const ptree& ptemp = config.getNode(reg_name_string);
         if (ptemp.empty()) {  // There is a single value for register, all channels have the same value
-            const auto value =  config.get<unsigned>(reg_name_string);
+            const auto value = ptemp.get_value<unsigned>();
             nsw::checkOverflow(reg_size, value, reg_name_string);
             for (size_t i = 0; i < nsw::vmm::NUM_CH_PER_VMM; i++) {
                 vtemp.at(i) = value;
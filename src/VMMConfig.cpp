@@ -1,5 +1,6 @@
 #include "NSWConfiguration/VMMConfig.h"
 
+#include "NSWConfiguration/ConfigImageCache.h"
 #include "NSWConfiguration/Utility.h"
 
 #include <utility>
@@ -8,14 +9,24 @@
 
 using boost::property_tree::ptree;
 
-nsw::VMMConfig::VMMConfig(const ptree& vmmconfig): m_config(vmmconfig) {
-    m_bitstring = VMMCodec::buildConfig(m_config);
-    ERS_DEBUG(5, "VMM Bitstream: " << m_bitstring);
-    ERS_DEBUG(3, "VMM Bytestream(hex): " << nsw::bitstringToHexString(m_bitstring));
+nsw::VMMConfig::VMMConfig(const ptree& vmmconfig): VMMConfig(nsw::ConfigOverlay{vmmconfig}) {}
+
+nsw::VMMConfig::VMMConfig(nsw::ConfigOverlay vmmconfig): m_config(std::move(vmmconfig)) {
+    m_bitstream = nsw::VmmImageCache::getInstance().getByKey(nsw::buildConfigImageKey(VMMCodec::getLayoutKey(), m_config), [this] () {
+        return VMMCodec::buildConfig(m_config.getLayers());
+    }, [] (const nsw::BitVector& image) {
+        return image.size() == VMMCodec::NBITS_TOTAL;
+    });
+    ERS_DEBUG(5, "VMM Bitstream: " << m_bitstream->toString());
+    ERS_DEBUG(3, "VMM Bytestream(hex): " << m_bitstream->toHexString());
 }
 
 std::vector<uint8_t> nsw::VMMConfig::getByteVector() const {
-    return nsw::stringToByteVector(m_bitstring);
+    return m_bitstream->toByteVector();
+}
+
+void nsw::VMMConfig::rebuildBitstream() {
+    m_bitstream = std::make_shared<const nsw::BitVector>(VMMCodec::buildConfig(m_config.getLayers()));
 }
 
 std::uint32_t nsw::VMMConfig::getGlobalRegister(const std::string& register_name) const {
@@ -29,7 +40,7 @@ std::uint32_t nsw::VMMConfig::getGlobalRegister(const std::string& register_name
 }
 
 std::uint32_t nsw::VMMConfig::getChannelRegisterOneChannel(const std::string& register_name, const std::uint32_t channel) const {
-    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config);
+    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config.getLayers());
     if (!VMMCodec::channelRegisterExists(register_name)) {
         std::string temp = register_name + "(Channel register)";
         nsw::NoSuchVmmRegister issue(ERS_HERE, temp.c_str());
@@ -44,7 +55,7 @@ std::uint32_t nsw::VMMConfig::getChannelRegisterOneChannel(const std::string& re
 }
 
 std::array<std::uint32_t, nsw::vmm::NUM_CH_PER_VMM> nsw::VMMConfig::getChannelRegisterAllChannels(const std::string& register_name) const {
-    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config);
+    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config.getLayers());
     if (!VMMCodec::channelRegisterExists(register_name)) {
         std::string temp = register_name + "(Channel register)";
         nsw::NoSuchVmmRegister issue(ERS_HERE, temp.c_str());
@@ -65,9 +76,9 @@ void nsw::VMMConfig::setGlobalRegister(const std::string& register_name, const s
         ers::error(issue);
         throw issue;
     }
-    m_config.put(register_name, value);
+    m_config.getOverrides().put(register_name, value);
     try {
-        m_bitstring = VMMCodec::buildConfig(m_config);
+        rebuildBitstream();
     } catch(std::exception & e) {
         nsw::VmmConfigIssue issue(ERS_HERE, e.what());
         ers::error(issue);
@@ -76,9 +87,9 @@ void nsw::VMMConfig::setGlobalRegister(const std::string& register_name, const s
 }
 
 void nsw::VMMConfig::setChannelRegisterAllChannels(const std::string& register_name, const std::uint32_t value) {
-    m_config.erase(register_name);
-    m_config.put(register_name, value);
-    m_bitstring = VMMCodec::buildConfig(m_config);
+    m_config.getOverrides().erase(register_name);
+    m_config.getOverrides().put(register_name, value);
+    rebuildBitstream();
 }
 
 void nsw::VMMConfig::setChannelRegisterOneChannel(const std::string& register_name, const std::uint32_t value, const std::uint32_t channel) {
@@ -93,16 +104,16 @@ void nsw::VMMConfig::setChannelRegisterOneChannel(const std::string& register_na
         throw issue;
     }
 
-    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config);
+    auto channelreg = VMMCodec::buildChannelRegisterMap(m_config.getLayers());
     channelreg[register_name][channel] = value;
 
     ptree temp = nsw::buildPtreeFromVector(channelreg[register_name]);
 
     // Delete the old node, and write the new one
-    m_config.erase(register_name);
-    m_config.add_child(register_name, temp);
+    m_config.getOverrides().erase(register_name);
+    m_config.getOverrides().add_child(register_name, temp);
 
-    m_bitstring = VMMCodec::buildConfig(m_config);
+    rebuildBitstream();
 }
 
 void nsw::VMMConfig::setTestPulseDAC(const std::uint32_t param) {
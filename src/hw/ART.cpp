@@ -133,7 +133,7 @@ void nsw::hw::ART::configART() const
     for (const auto& ab : tup.second.getBitstreamMap()) {
       writeARTRegister(tup.first,
           static_cast<uint8_t>(std::stoi(ab.first) ),
-          static_cast<uint8_t>(std::stoi(ab.second, nullptr, nsw::BASE_BIN) ));
+          static_cast<uint8_t>(ab.second.toInteger() ));
     }
   }
   ERS_DEBUG(1, " -> done");
@@ -184,7 +184,7 @@ void nsw::hw::ART::trainGBTx() const
     for (const auto& ab : addr_bitstr) {
       if (reg == static_cast<std::uint8_t>(std::stoi(ab.first) )) {
         writeARTCoreRegister(static_cast<std::uint8_t>(std::stoi(ab.first)),
-            static_cast<std::uint8_t>(std::stoi(ab.second, nullptr, 2))
+            static_cast<std::uint8_t>(ab.second.toInteger())
             );
         break;
       }
@@ -212,7 +212,7 @@ void nsw::hw::ART::unmaskART() const
     for (const auto& ab : addr_bitstr) {
       if (reg == static_cast<uint8_t>( std::stoi(ab.first) )) {
         writeARTCoreRegister(static_cast<uint8_t>(std::stoi(ab.first)),
-            static_cast<uint8_t>(std::stoi(ab.second, nullptr, 2))
+            static_cast<uint8_t>(ab.second.toInteger())
             );
         break;
       }
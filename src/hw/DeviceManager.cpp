@@ -1,8 +1,20 @@
 #include "NSWConfiguration/hw/DeviceManager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <future>
+#include <set>
+#include <string>
 
-nsw::hw::DeviceManager::DeviceManager(const bool multithreaded) : m_multithreaded(multithreaded) {}
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include "NSWConfiguration/OpcRetryPolicy.h"
+#include "NSWConfiguration/hw/TaskGraph.h"
+
+nsw::hw::DeviceManager::DeviceManager(const bool multithreaded) :
+  m_multithreaded(multithreaded)
+{}
 
 void nsw::hw::DeviceManager::add(const std::span<const boost::property_tree::ptree> configs)
 {
@@ -13,10 +25,29 @@ void nsw::hw::DeviceManager::add(const std::span<const boost::property_tree::ptr
 
 void nsw::hw::DeviceManager::addFeb(const nsw::FEBConfig& config)
 {
+  const auto sameAddress = [&config](const auto& feb) { return feb.getScaAddress() == config.getAddress(); };
+  const auto existing = std::ranges::find_if(m_febs, sameAddress);
+  if (existing != std::end(m_febs)) {
+    existing->setConfiguration(config);
+    return;
+  }
+  // Keep the images written to a FEB of the previous configuration so that it is reconfigured differentially
+  const auto kept = std::ranges::find_if(m_keptFebs, sameAddress);
+  if (kept != std::end(m_keptFebs)) {
+    auto feb = std::move(*kept);
+    m_keptFebs.erase(kept);
+    try {
+      feb.setConfiguration(config);
+      m_febs.push_back(std::move(feb));
+      return;
+    } catch (const std::invalid_argument&) {
+      // Moved to another OPC server or another board type, configured from scratch
+    }
+  }
   m_febs.emplace_back(m_opcManager, config);
 }
 
-void nsw::hw::DeviceManager::addAddc(const boost::property_tree::ptree& config)
+void nsw::hw::DeviceManager::addAddc(const nsw::ADDCConfig& config)
 {
   m_addcs.emplace_back(m_opcManager, config);
 }
@@ -61,17 +92,40 @@ void nsw::hw::DeviceManager::configure(const std::span<const Options> options)
   };
 
   resetErrorCounters();
-  conf(
-    m_febs, "FEB",
-    std::find(std::cbegin(options), std::cend(options), Options::RESET_VMM) != std::cend(options),
-    std::find(std::cbegin(options), std::cend(options), Options::RESET_TDS) != std::cend(options),
-    std::find(std::cbegin(options), std::cend(options), Options::DISABLE_VMM_CAPTURE_INPUTS) != std::cend(options));
-  conf(m_addcs, "ADDC");
-  conf(m_mmtps, "MMTP");
-  conf(m_routers, "Router");
-  conf(m_padTriggers, "Pad Trigger");
-  conf(m_stgctps, "STGCTP");
-  conf(m_tpCarriers, "TP Carrier");
+  auto& retryPolicy = nsw::OpcRetryPolicy::getDefault();
+  retryPolicy.resetStatistics();
+  const nsw::OpcRetryPolicy::ScopedDeadline retryDeadline{retryPolicy, CONFIGURE_RETRY_BUDGET};
+  const auto hasOption = [&options](const Options option) {
+    return std::find(std::cbegin(options), std::cend(options), option) != std::cend(options);
+  };
+  const auto resetVmm = hasOption(Options::RESET_VMM);
+  const auto resetTds = hasOption(Options::RESET_TDS);
+  const auto disableVmmCaptureInputs = hasOption(Options::DISABLE_VMM_CAPTURE_INPUTS);
+  const auto writeChangedOnly = hasOption(Options::WRITE_CHANGED_ONLY);
+
+  // Only the orderings required by the hardware are kept:
+  // - Pad triggers deskew the pFEBs
+  // - MMTPs align to the GBTx of the ARTs
+  // - STGCTPs are reset after the MMTPs, Routers, and Pad Triggers are configured
+  TaskGraph graph{};
+  graph.add("FEB", [&]() { conf(m_febs, "FEB", resetVmm, resetTds, disableVmmCaptureInputs, writeChangedOnly); });
+  graph.add("ADDC", [&]() { conf(m_addcs, "ADDC"); });
+  graph.add("Router", [&]() { conf(m_routers, "Router"); });
+  graph.add("TP Carrier", [&]() { conf(m_tpCarriers, "TP Carrier"); });
+  graph.add("Pad Trigger", [&]() { conf(m_padTriggers, "Pad Trigger"); }, {"FEB"});
+  graph.add("MMTP", [&]() { conf(m_mmtps, "MMTP"); }, {"ADDC"});
+  graph.add("STGCTP", [&]() { conf(m_stgctps, "STGCTP"); }, {"MMTP", "Router", "Pad Trigger"});
+  const auto report = graph.run(m_multithreaded);
+  ERS_INFO(fmt::format("Configuration took {:.1f} s. Critical path: {}",
+                       std::chrono::duration<double>(report.m_total).count(),
+                       report.criticalPathToString()));
+  ERS_INFO(fmt::format("OPC operations: {}", retryPolicy.getStatistics().toString()));
+  if (not report.m_failed.empty()) {
+    ERS_LOG(fmt::format("Failed to configure: {}. Skipped: {}",
+                        fmt::join(report.m_failed, ", "),
+                        fmt::join(report.m_skipped, ", ")));
+  }
+  report.rethrowIfFailed();
 }
 
 void nsw::hw::DeviceManager::connect(std::span<const Options> /*options*/)
@@ -101,9 +155,9 @@ void nsw::hw::DeviceManager::enableMmtpChannelRates(const bool enable)
 void nsw::hw::DeviceManager::enableVmmCaptureInputs()
 {
   resetErrorCounters();
-  applyFunc(
+  applyFuncAsync(
     m_febs,
-    [](const auto& device) { device.getRoc().enableVmmCaptureInputs(); },
+    [](const auto& device) { return device.getRoc().enableVmmCaptureInputsAsync(); },
     [](const auto& ex) {
       nsw::NSWHWConfigIssue issue(
         ERS_HERE, fmt::format("Enabling VMM capture inputs failed due to: {}", ex.what()));
@@ -114,9 +168,9 @@ void nsw::hw::DeviceManager::enableVmmCaptureInputs()
 void nsw::hw::DeviceManager::disableVmmCaptureInputs()
 {
   resetErrorCounters();
-  applyFunc(
+  applyFuncAsync(
     m_febs,
-    [](const auto& device) { device.getRoc().disableVmmCaptureInputs(); },
+    [](const auto& device) { return device.getRoc().disableVmmCaptureInputsAsync(); },
     [](const auto& ex) {
       nsw::NSWHWConfigIssue issue(
         ERS_HERE, fmt::format("Disabling VMM capture inputs failed due to: {}", ex.what()));
@@ -167,7 +221,8 @@ void nsw::hw::DeviceManager::resetSTGCTP()
 
 void nsw::hw::DeviceManager::clear()
 {
-  clearOpc();
+  m_opcManager.close();
+  m_keptFebs = std::move(m_febs);
   m_febs.clear();
   m_addcs.clear();
   m_mmtps.clear();
@@ -182,6 +237,61 @@ void nsw::hw::DeviceManager::clearOpc()
   m_opcManager.clear();
 }
 
+void nsw::hw::DeviceManager::setConcurrency(const std::size_t numThreads,
+                                            const std::size_t maxConcurrentPerOpcServer)
+{
+  if (not m_multithreaded) {
+    return;
+  }
+  m_opcServerSlots.setMaxPerKey(maxConcurrentPerOpcServer);
+  {
+    std::scoped_lock lock(m_executorMutex);
+    m_numThreads = numThreads;
+  }
+  if (numThreads == 0) {
+    ERS_LOG(fmt::format("Using one thread per device handled in parallel, at most {} devices per OPC server",
+                        m_opcServerSlots.getMaxPerKey()));
+  } else {
+    ERS_LOG(fmt::format("Using {} threads with at most {} devices per OPC server in parallel",
+                        numThreads,
+                        m_opcServerSlots.getMaxPerKey()));
+  }
+}
+
+std::size_t nsw::hw::DeviceManager::getNumThreads() const
+{
+  {
+    std::scoped_lock lock(m_executorMutex);
+    if (m_numThreads > 0) {
+      return m_numThreads;
+    }
+  }
+  std::set<std::string> servers{};
+  const auto addServers = [&servers](const auto& devices) {
+    for (const auto& device : devices) {
+      servers.insert(device.getOpcServerIp());
+    }
+  };
+  addServers(m_febs);
+  addServers(m_addcs);
+  addServers(m_mmtps);
+  addServers(m_stgctps);
+  addServers(m_routers);
+  addServers(m_padTriggers);
+  addServers(m_tpCarriers);
+  return std::max(std::size(servers), std::size_t{1}) * m_opcServerSlots.getMaxPerKey();
+}
+
+nsw::hw::Executor& nsw::hw::DeviceManager::getExecutor()
+{
+  const auto numThreads = getNumThreads();
+  std::scoped_lock lock(m_executorMutex);
+  if (m_executor == nullptr or m_executor->getNumThreads() != numThreads) {
+    m_executor = std::make_unique<Executor>(numThreads);
+  }
+  return *m_executor;
+}
+
 double nsw::hw::DeviceManager::getFractionFailed() const
 {
   if (m_configurationTotalCounter == 0) {
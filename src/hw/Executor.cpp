@@ -0,0 +1,147 @@
+#include "NSWConfiguration/hw/Executor.h"
+
+#include <algorithm>
+
+namespace {
+  /**
+   * \brief Identifies the pool and queue of the worker running on the current thread
+   */
+  struct WorkerContext {
+    const nsw::hw::Executor* m_executor{nullptr};
+    std::size_t m_index{0};
+  };
+  thread_local WorkerContext currentWorker{};
+}  // namespace
+
+nsw::hw::Executor::Executor(const std::size_t numThreads)
+{
+  const auto nThreads = std::max(numThreads, std::size_t{1});
+  m_queues.reserve(nThreads);
+  for (std::size_t index = 0; index < nThreads; ++index) {
+    m_queues.push_back(std::make_unique<WorkQueue>());
+  }
+  m_workers.reserve(nThreads);
+  for (std::size_t index = 0; index < nThreads; ++index) {
+    m_workers.emplace_back(
+      [this, index](const std::stop_token stopToken) { run(stopToken, index); });
+  }
+}
+
+nsw::hw::Executor::~Executor()
+{
+  for (auto& worker : m_workers) {
+    worker.request_stop();
+  }
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void nsw::hw::Executor::post(Job job)
+{
+  const auto index = [this]() {
+    if (currentWorker.m_executor == this) {
+      return currentWorker.m_index;
+    }
+    return m_nextQueue.fetch_add(1, std::memory_order_relaxed) % std::size(m_queues);
+  }();
+  {
+    std::lock_guard<std::mutex> lock(m_queues[index]->m_mutex);
+    m_queues[index]->m_jobs.push_back(std::move(job));
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_numPending;
+  }
+  m_condition.notify_one();
+}
+
+void nsw::hw::Executor::run(const std::stop_token stopToken, const std::size_t index)
+{
+  currentWorker = WorkerContext{this, index};
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      // Returns false only if a stop was requested and no job is left
+      if (not m_condition.wait(lock, stopToken, [this]() { return m_numPending > 0; })) {
+        return;
+      }
+      --m_numPending;
+    }
+    // A job was reserved above. It was put into a queue before the counter was increased, so
+    // it can always be found.
+    auto job = tryPop(index);
+    while (not job) {
+      std::this_thread::yield();
+      job = tryPop(index);
+    }
+    (*job)();
+  }
+}
+
+std::optional<nsw::hw::Executor::Job> nsw::hw::Executor::tryPop(const std::size_t index)
+{
+  {
+    auto& own = *m_queues[index];
+    std::lock_guard<std::mutex> lock(own.m_mutex);
+    if (not own.m_jobs.empty()) {
+      auto job = std::move(own.m_jobs.back());
+      own.m_jobs.pop_back();
+      return job;
+    }
+  }
+  for (std::size_t offset = 1; offset < std::size(m_queues); ++offset) {
+    auto& victim = *m_queues[(index + offset) % std::size(m_queues)];
+    std::lock_guard<std::mutex> lock(victim.m_mutex);
+    if (not victim.m_jobs.empty()) {
+      auto job = std::move(victim.m_jobs.front());
+      victim.m_jobs.pop_front();
+      return job;
+    }
+  }
+  return std::nullopt;
+}
+
+nsw::hw::KeyedSemaphore::Slot::~Slot()
+{
+  if (m_semaphore != nullptr) {
+    m_semaphore->release(*m_numAcquired);
+  }
+}
+
+nsw::hw::KeyedSemaphore::Slot nsw::hw::KeyedSemaphore::acquire(const std::string_view key)
+{
+  std::unique_lock lock(m_mutex);
+  auto numAcquired = m_numAcquired.find(key);
+  if (numAcquired == std::end(m_numAcquired)) {
+    numAcquired = m_numAcquired.emplace(std::string{key}, std::size_t{0}).first;
+  }
+  auto& counter = numAcquired->second;
+  m_condition.wait(lock, [this, &counter]() { return counter < m_maxPerKey; });
+  ++counter;
+  return Slot{*this, counter};
+}
+
+void nsw::hw::KeyedSemaphore::setMaxPerKey(const std::size_t maxPerKey)
+{
+  {
+    std::scoped_lock lock(m_mutex);
+    m_maxPerKey = std::max(maxPerKey, std::size_t{1});
+  }
+  m_condition.notify_all();
+}
+
+std::size_t nsw::hw::KeyedSemaphore::getMaxPerKey() const
+{
+  std::scoped_lock lock(m_mutex);
+  return m_maxPerKey;
+}
+
+void nsw::hw::KeyedSemaphore::release(std::size_t& numAcquired)
+{
+  {
+    std::scoped_lock lock(m_mutex);
+    --numAcquired;
+  }
+  m_condition.notify_all();
+}
@@ -1,5 +1,12 @@
 #include "NSWConfiguration/hw/FEB.h"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include <ers/ers.h>
+
 nsw::hw::FEB::FEB(OpcManager& manager, const nsw::FEBConfig& config) :
   ScaAddressBase(config.getAddress()),
   m_roc(manager, config),
@@ -23,10 +30,57 @@ nsw::hw::FEB::FEB(OpcManager& manager, const nsw::FEBConfig& config) :
   m_firstTds(config.getFirstTdsIndex())
 {}
 
+void nsw::hw::FEB::setConfiguration(const nsw::FEBConfig& config)
+{
+  if (config.getAddress() != getScaAddress() or config.getOpcServerIp() != m_roc.getOpcServerIp() or
+      config.getVmms().size() != m_vmms.size() or config.getTdss().size() != m_tdss.size()) {
+    throw std::invalid_argument(fmt::format("Configuration of {} ({}) does not match FEB {} ({})",
+                                            config.getAddress(),
+                                            config.getOpcServerIp(),
+                                            getScaAddress(),
+                                            m_roc.getOpcServerIp()));
+  }
+  m_roc.getConfigAnalog() = config.getRocAnalog();
+  m_roc.getConfigDigital() = config.getRocDigital();
+  for (std::size_t iVmm = 0; iVmm < m_vmms.size(); iVmm++) {
+    m_vmms[iVmm].getConfig() = config.getVmms()[iVmm];
+  }
+  for (std::size_t iTds = 0; iTds < m_tdss.size(); iTds++) {
+    m_tdss[iTds].getConfig() = config.getTdss()[iTds];
+  }
+}
+
+bool nsw::hw::FEB::hasWrittenConfiguration() const
+{
+  const auto hasWritten = [](const auto& device) { return device.hasWrittenConfiguration(); };
+  return m_roc.hasWrittenConfiguration() and std::ranges::all_of(m_vmms, hasWritten) and
+         std::ranges::all_of(m_tdss, hasWritten);
+}
+
 void nsw::hw::FEB::writeConfiguration(const bool resetVmm,
                                       const bool resetTds,
-                                      const bool disableVmmCaptureInputs) const
+                                      const bool disableVmmCaptureInputs,
+                                      const bool writeChangedOnly) const
 {
+  // The full configuration resets the ROC, only skip it if all devices are in a known state
+  if (writeChangedOnly and not resetVmm and not resetTds and hasWrittenConfiguration()) {
+    const auto numRocRegisters = m_roc.writeChangedConfiguration();
+    if (disableVmmCaptureInputs) {
+      m_roc.disableVmmCaptureInputs();
+    }
+    const auto numVmms = std::ranges::count_if(m_vmms, [](const auto& vmm) { return vmm.writeChangedConfiguration(); });
+    std::size_t numTdsRegisters{0};
+    for (const auto& tds : m_tdss) {
+      numTdsRegisters += tds.writeChangedConfiguration();
+    }
+    ERS_LOG(fmt::format("{}: wrote {} ROC registers, {} VMMs and {} TDS registers which changed",
+                        getScaAddress(),
+                        numRocRegisters,
+                        numVmms,
+                        numTdsRegisters));
+    return;
+  }
+
   m_roc.writeConfiguration();
   if (disableVmmCaptureInputs) {
     m_roc.disableVmmCaptureInputs();
@@ -0,0 +1,68 @@
+#include "NSWConfiguration/hw/I2cReadPlan.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include "NSWConfiguration/Utility.h"
+
+nsw::hw::I2cReadPlan::I2cReadPlan(const std::span<const RegisterRead> registers,
+                                  const I2cRegisterLayout& layout) :
+  m_registers{std::begin(registers), std::end(registers)}, m_littleEndian{layout.m_littleEndian}
+{
+  const auto maxBurstRegisters =
+    std::clamp(layout.m_maxBurstRegisters, std::size_t{1}, MAX_BURST_BYTES / REGISTER_SIZE);
+
+  // Unique addresses in ascending order, consecutive ones are merged into bursts
+  std::map<std::uint32_t, Location> locations{};
+  for (const auto& reg : m_registers) {
+    locations.try_emplace(reg.m_address);
+  }
+  for (auto& [address, location] : locations) {
+    const auto extends = not m_bursts.empty() and
+                         m_bursts.back().m_numRegisters < maxBurstRegisters and
+                         m_bursts.back().m_firstAddress + m_bursts.back().m_numRegisters == address;
+    if (extends) {
+      location = Location{std::size(m_bursts) - 1, m_bursts.back().m_numRegisters};
+      ++m_bursts.back().m_numRegisters;
+    } else {
+      location = Location{std::size(m_bursts), 0};
+      m_bursts.push_back(
+        Burst{address, 1, nsw::intToByteVector(address, layout.m_addressSize, layout.m_littleEndian)});
+    }
+  }
+
+  m_locations.reserve(std::size(m_registers));
+  std::ranges::transform(m_registers, std::back_inserter(m_locations), [&locations](const auto& reg) {
+    return locations.at(reg.m_address);
+  });
+}
+
+std::vector<std::uint32_t> nsw::hw::I2cReadPlan::decode(
+  const std::span<const std::vector<std::uint8_t>> replies) const
+{
+  if (std::size(replies) != std::size(m_bursts)) {
+    throw std::invalid_argument(
+      fmt::format("Read plan expects {} replies but got {}", std::size(m_bursts), std::size(replies)));
+  }
+  for (std::size_t burst = 0; burst < std::size(m_bursts); ++burst) {
+    if (std::size(replies[burst]) < getNumBytes(m_bursts[burst])) {
+      throw std::invalid_argument(fmt::format("Read of register {:#x} returned {} bytes instead of {}",
+                                              m_bursts[burst].m_firstAddress,
+                                              std::size(replies[burst]),
+                                              getNumBytes(m_bursts[burst])));
+    }
+  }
+
+  std::vector<std::uint32_t> values{};
+  values.reserve(std::size(m_registers));
+  for (std::size_t index = 0; index < std::size(m_registers); ++index) {
+    const auto& [burst, offset] = m_locations[index];
+    const auto first = std::next(std::cbegin(replies[burst]), static_cast<std::ptrdiff_t>(offset * REGISTER_SIZE));
+    const auto word = nsw::byteVectorToWord32({first, std::next(first, REGISTER_SIZE)}, m_littleEndian);
+    values.push_back(word & m_registers[index].m_mask);
+  }
+  return values;
+}
@@ -90,6 +90,11 @@ std::uint32_t nsw::hw::MMTP::readRegister(const std::uint32_t regAddress) const
   return nsw::hw::SCAX::readRegister(getConnection(), m_busAddress, regAddress);
 }
 
+std::vector<std::uint32_t> nsw::hw::MMTP::readRegisters(const I2cReadPlan& plan) const
+{
+  return nsw::hw::SCA::readRegisters(getConnection(), m_busAddress, plan);
+}
+
 void nsw::hw::MMTP::writeAndReadbackRegister(const std::uint32_t regAddress,
                                              const std::uint32_t value) const
 {
@@ -9,11 +9,63 @@ nsw::hw::OpcConnectionBase::OpcConnectionBase(nsw::OpcManager& manager,
   m_scaAddress{std::move(scaAddress)}, m_opcServerIp{std::move(opcServerIp)}, m_opcManager{manager}
 {}
 
+nsw::hw::OpcConnectionBase::OpcConnectionBase(const OpcConnectionBase& other) :
+  m_scaAddress{other.m_scaAddress},
+  m_opcServerIp{other.m_opcServerIp},
+  m_opcManager{other.m_opcManager},
+  m_connection{other.m_connection.load(std::memory_order_acquire)}
+{}
+
+nsw::hw::OpcConnectionBase::OpcConnectionBase(OpcConnectionBase&& other) noexcept :
+  m_scaAddress{std::move(other.m_scaAddress)},
+  m_opcServerIp{std::move(other.m_opcServerIp)},
+  m_opcManager{other.m_opcManager},
+  m_connection{other.m_connection.exchange(nullptr, std::memory_order_acq_rel)}
+{}
+
+nsw::hw::OpcConnectionBase& nsw::hw::OpcConnectionBase::operator=(const OpcConnectionBase& other)
+{
+  if (this != &other) {
+    m_scaAddress = other.m_scaAddress;
+    m_opcServerIp = other.m_opcServerIp;
+    m_opcManager = other.m_opcManager;
+    m_connection.store(other.m_connection.load(std::memory_order_acquire), std::memory_order_release);
+  }
+  return *this;
+}
+
+nsw::hw::OpcConnectionBase& nsw::hw::OpcConnectionBase::operator=(OpcConnectionBase&& other) noexcept
+{
+  if (this != &other) {
+    m_scaAddress = std::move(other.m_scaAddress);
+    m_opcServerIp = std::move(other.m_opcServerIp);
+    m_opcManager = other.m_opcManager;
+    m_connection.store(other.m_connection.exchange(nullptr, std::memory_order_acq_rel),
+                       std::memory_order_release);
+  }
+  return *this;
+}
+
+nsw::OpcClientPtr nsw::hw::OpcConnectionBase::getConnection() const
+{
+  auto& manager = m_opcManager.get();
+  auto handle = m_connection.load(std::memory_order_acquire);
+  if (handle == nullptr or handle->getGeneration() != manager.getGeneration()) {
+    // Only taken on first use and after the manager dropped its connections
+    handle = std::make_shared<const OpcManager::ConnectionHandle>(
+      manager.getConnectionHandle(m_opcServerIp, m_scaAddress));
+    m_connection.store(handle, std::memory_order_release);
+  }
+  OpcManager::warnBadConnection(*handle);
+  // Shares the ownership of the handle, which keeps the session and the lease alive
+  return {handle, handle->get().get()};
+}
+
 nsw::hw::ScaStatus::ScaStatus nsw::hw::OpcConnectionBase::ping() const
 {
+  // Reuse the pooled session instead of connecting a new one for every ping
   try {
-    auto connection = OpcClient(m_opcServerIp);
-    return OpcManager::testConnection(m_scaAddress, &connection);
+    return OpcManager::testConnection(m_scaAddress, getConnection().get());
   } catch (const nsw::OpcConnectionIssue&) {
     return ScaStatus::SERVER_OFFLINE;
   }
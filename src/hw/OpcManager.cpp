@@ -5,6 +5,7 @@
 #include <iterator>
 #include <mutex>
 #include <ranges>
+#include <stdexcept>
 #include <stop_token>
 #include <thread>
 #include <utility>
@@ -18,25 +19,88 @@
 
 #include "NSWConfiguration/CommandNames.h"
 #include "NSWConfiguration/OpcClient.h"
+#include "NSWConfiguration/OpcRetryPolicy.h"
 #include "NSWConfiguration/hw/ScaStatus.h"
 
 using namespace std::chrono_literals;
 
-nsw::OpcManager::OpcManager() :
-  m_backgroundThread{[this](const std::stop_token stopToken) { pingConnections(stopToken); }}
+nsw::OpcManager::OpcManager(SessionFactory openSession) :
+  m_openSession{std::move(openSession)}
+{
+  // Started here and not in the initializer list since the thread uses members declared after it
+  m_backgroundThread =
+    std::jthread{[this](const std::stop_token stopToken) { pingConnections(stopToken); }};
+}
+
+nsw::OpcManager::ConnectionHandle::ConnectionHandle(Identifier identifier,
+                                                    std::shared_ptr<const OpcClient> session,
+                                                    std::shared_ptr<const Lease> lease,
+                                                    const std::uint64_t generation) :
+  m_identifier{std::move(identifier)},
+  m_session{std::move(session)},
+  m_lease{std::move(lease)},
+  m_generation{generation}
 {}
 
 nsw::OpcClientPtr nsw::OpcManager::getConnection(const std::string& ipPort, const std::string& deviceName)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  ERS_DEBUG(2, "Get connection to " << deviceName);
-  const auto identifier = Identifier{ipPort, deviceName};
+  const auto handle = resolve(Identifier{ipPort, deviceName});
+  warnBadConnection(handle);
+  return handle.get();
+}
+
+std::shared_ptr<nsw::OpcClient> nsw::OpcManager::openOpcSession(const std::string& ipPort)
+{
+  return std::make_shared<OpcClient>(ipPort);
+}
+
+nsw::OpcManager::ConnectionHandle nsw::OpcManager::getConnectionHandle(const std::string& ipPort,
+                                                                       const std::string& deviceName)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return resolve(Identifier{ipPort, deviceName});
+}
+
+nsw::OpcManager::ConnectionHandle nsw::OpcManager::resolve(const Identifier& identifier)
+{
+  ERS_DEBUG(2, "Get connection to " << identifier.name);
   if (not exists(identifier)) {
-    ERS_DEBUG(2, "Create new connection to " << deviceName);
+    ERS_DEBUG(2, "Create new connection to " << identifier.name);
     add(identifier);
   }
-  warnBadConnection(identifier);
-  return m_connections.at(identifier.port).at(identifier.name).get();
+  const auto& pool = m_connections.at(identifier.port);
+  const auto& lease = pool.leases.at(identifier.name);
+  // The generation only changes while the mutex is held
+  return {identifier, pool.sessions.at(lease->session), lease, m_generation.load(std::memory_order_relaxed)};
+}
+
+nsw::OpcManager::SessionSelection nsw::OpcManager::parseSessionSelection(const std::string_view name)
+{
+  if (name == "RoundRobin") {
+    return SessionSelection::ROUND_ROBIN;
+  }
+  if (name == "LeastLoaded") {
+    return SessionSelection::LEAST_LOADED;
+  }
+  throw std::invalid_argument(fmt::format("Unknown OPC session selection strategy {}", name));
+}
+
+void nsw::OpcManager::setSessionPoolParameters(const std::size_t sessionsPerServer,
+                                               const SessionSelection selection)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_sessionsPerServer = std::max(sessionsPerServer, std::size_t{1});
+  m_sessionSelection = selection;
+}
+
+std::size_t nsw::OpcManager::getNumSessions(const std::string& ipPort) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (not m_connections.contains(ipPort)) {
+    return 0;
+  }
+  return std::size(m_connections.at(ipPort).sessions);
 }
 
 nsw::OpcManager::~OpcManager()
@@ -48,36 +112,75 @@ nsw::OpcManager::~OpcManager()
 void nsw::OpcManager::clear()
 {
   ERS_DEBUG(2, "Clear");
+  close();
+  m_deviceGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void nsw::OpcManager::close()
+{
   doClear();
+  // Failures of the closed sessions must not reject the requests of the new ones
+  OpcRetryPolicy::getDefault().resetBreakers();
 }
 
 nsw::hw::ScaStatus::ScaStatus nsw::OpcManager::testConnection(const std::string& name, const OpcClient* connection)
 {
+  return testConnections({name}, connection).at(name);
+}
+
+nsw::OpcManager::PingStatusMap nsw::OpcManager::testConnections(const std::vector<std::string>& names,
+                                                                const OpcClient* connection)
+{
+  PingStatusMap result{};
   try {
-    const auto status = connection->readScaOnline(name);
-    if (not status) {
-      return hw::ScaStatus::UNREACHABLE;
+    const auto online = connection->readScaOnlineMulti(names);
+    for (std::size_t index = 0; index < std::size(names); ++index) {
+      // A node that cannot be read is treated like a failing read request
+      const auto status = [&online, index]() {
+        if (not online.at(index).has_value()) {
+          return hw::ScaStatus::SERVER_OFFLINE;
+        }
+        return *online.at(index) ? hw::ScaStatus::REACHABLE : hw::ScaStatus::UNREACHABLE;
+      }();
+      result.try_emplace(names.at(index), status);
     }
-    return hw::ScaStatus::REACHABLE;
   } catch (const nsw::OpcConnectionIssue&) {
-    return hw::ScaStatus::SERVER_OFFLINE;
+    for (const auto& name : names) {
+      result.try_emplace(name, hw::ScaStatus::SERVER_OFFLINE);
+    }
   } catch (const nsw::OpcReadWriteIssue&) {
-    return hw::ScaStatus::SERVER_OFFLINE;
+    for (const auto& name : names) {
+      result.try_emplace(name, hw::ScaStatus::SERVER_OFFLINE);
+    }
   }
+  return result;
 }
 
 void nsw::OpcManager::add(const Identifier& identifier)
 {
-  ERS_DEBUG(2, fmt::format("Create connection for {}:{}", identifier.port, identifier.name));
+  ERS_DEBUG(2, fmt::format("Lease connection for {}:{}", identifier.port, identifier.name));
   if (not existsPort(identifier)) {
     m_connections.try_emplace(identifier.port);
   }
-  m_connections.at(identifier.port).try_emplace(identifier.name, std::make_unique<OpcClient>(identifier.port));
+  auto& pool = m_connections.at(identifier.port);
+  const auto index = pool.sessionLeases.acquire(m_sessionsPerServer, m_sessionSelection);
+  if (index >= std::size(pool.sessions)) {
+    ERS_DEBUG(2, fmt::format("Open session {} to {}", index, identifier.port));
+    try {
+      pool.sessions.push_back(m_openSession(identifier.port));
+    } catch (const nsw::OpcConnectionIssue&) {
+      pool.sessionLeases.release(index);
+      throw;
+    }
+  }
+  auto lease = std::make_shared<Lease>();
+  lease->session = index;
+  pool.leases.try_emplace(identifier.name, std::move(lease));
 }
 
 bool nsw::OpcManager::exists(const Identifier& identifier) const
 {
-  return existsPort(identifier) and m_connections.at(identifier.port).contains(identifier.name);
+  return existsPort(identifier) and m_connections.at(identifier.port).leases.contains(identifier.name);
 }
 
 bool nsw::OpcManager::existsPort(const Identifier& identifier) const
@@ -90,17 +193,13 @@ void nsw::OpcManager::pingConnections(std::stop_token stopToken)
   while (not stopToken.stop_requested()) {
     const auto timeBefore = std::chrono::high_resolution_clock::now();
     ERS_DEBUG(2, "Pinging all connections");
+    const auto results = pingServers(snapshotConnections());
     {
-      std::unique_lock<std::mutex> lock(m_mutex);
-      for (const auto& [port, connectionsPerServer] : m_connections) {
-        std::map<std::string, hw::ScaStatus::ScaStatus> status{};
-        std::transform(std::cbegin(connectionsPerServer),
-                      std::cend(connectionsPerServer),
-                      std::inserter(status, std::end(status)),
-                      [](const auto& pair) -> decltype(status)::value_type {
-                        return {pair.first, testConnection(pair.first, pair.second.get())};
-                      });
-        analyzePingResults(port, status);
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (const auto& [port, status] : results) {
+        if (m_connections.contains(port)) {
+          analyzePingResults(port, status);
+        }
       }
     }
     ERS_DEBUG(2, "Done pinging all connections");
@@ -118,21 +217,85 @@ void nsw::OpcManager::pingConnections(std::stop_token stopToken)
   }
 }
 
-void nsw::OpcManager::analyzePingResults(const std::string& port, const std::map<std::string, hw::ScaStatus::ScaStatus>& result)
+std::map<std::string, std::vector<nsw::OpcManager::PingTarget>> nsw::OpcManager::snapshotConnections() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::map<std::string, std::vector<PingTarget>> snapshot{};
+  for (const auto& [port, pool] : m_connections) {
+    auto& targets = snapshot[port];
+    targets.reserve(std::size(pool.leases));
+    for (const auto& [name, lease] : pool.leases) {
+      targets.push_back({name, pool.sessions.at(lease->session), lease});
+    }
+  }
+  return snapshot;
+}
+
+std::map<std::string, nsw::OpcManager::PingStatusMap> nsw::OpcManager::pingServers(
+  const std::map<std::string, std::vector<PingTarget>>& targets,
+  const PingFunction& ping)
+{
+  std::map<std::string, std::future<PingStatusMap>> futures{};
+  for (const auto& [port, serverTargets] : targets) {
+    futures.try_emplace(
+      port, std::async(std::launch::async, &pingServer, std::cref(serverTargets), std::cref(ping)));
+  }
+  std::map<std::string, PingStatusMap> results{};
+  for (auto& [port, future] : futures) {
+    results.try_emplace(port, future.get());
+  }
+  return results;
+}
+
+nsw::OpcManager::PingStatusMap nsw::OpcManager::pingServer(const std::vector<PingTarget>& targets,
+                                                           const PingFunction& ping)
+{
+  std::map<const OpcClient*, std::vector<const PingTarget*>> targetsPerSession{};
+  for (const auto& target : targets) {
+    targetsPerSession[target.session.get()].push_back(&target);
+  }
+
+  PingStatusMap result{};
+  for (const auto& [session, sessionTargets] : targetsPerSession) {
+    std::vector<std::string> names{};
+    names.reserve(std::size(sessionTargets));
+    std::ranges::transform(sessionTargets, std::back_inserter(names), [](const auto* target) { return target->name; });
+    const auto statuses = ping(names, session);
+    for (const auto* target : sessionTargets) {
+      const auto status = statuses.at(target->name);
+      target->lease->status.store(status, std::memory_order_relaxed);
+      result.try_emplace(target->name, status);
+    }
+  }
+  return result;
+}
+
+void nsw::OpcManager::analyzePingResults(const std::string& port, const PingStatusMap& result)
 {
   // Add port if not yet added
   if (not m_badConnections.contains(port)) {
     m_badConnections.try_emplace(port);
   }
-  auto& badConnections = m_badConnections.at(port);
 
+  // Server offline, start checking for reconnect
+  if (updateBadConnections(m_badConnections.at(port), result) and not m_reconnectThreads.contains(port)) {
+    ERS_INFO("Detected offline OPC server. Testing for restart");
+    std::vector<std::string> deviceNames{};
+    deviceNames.reserve(std::size(m_connections.at(port).leases));
+    std::ranges::copy(m_connections.at(port).leases | std::views::keys, std::back_inserter(deviceNames));
+    m_reconnectThreads.try_emplace(port, [this, port, deviceNames](const std::stop_token stopToken) { testServerRestart(stopToken, port, deviceNames); });
+  }
+}
+
+bool nsw::OpcManager::updateBadConnections(PingStatusMap& badConnections, const PingStatusMap& result)
+{
   // All good: Remove any bad devices
   if (std::ranges::all_of(result, [] (const auto& pair) { return pair.second == hw::ScaStatus::REACHABLE; })) {
     if (not badConnections.empty()) {
       ERS_LOG(fmt::format("Previously bad connections {} are recovered", badConnections | std::views::keys));
       badConnections.clear();
     }
-    return;
+    return false;
   }
 
   // Add bad devices to list if not already there
@@ -154,26 +317,18 @@ void nsw::OpcManager::analyzePingResults(const std::string& port, const std::map
     }
   }
 
-  // Server offline, start checking for reconnect
-  if (std::ranges::all_of(
-        result, [](const auto& pair) { return pair.second == hw::ScaStatus::SERVER_OFFLINE; }) and
-      not m_reconnectThreads.contains(port)) {
-    ERS_INFO("Detected offline OPC server. Testing for restart");
-    std::vector<std::string> deviceNames{};
-    deviceNames.reserve(std::size(m_connections.at(port)));
-    std::ranges::copy(m_connections.at(port) | std::views::keys, std::back_inserter(deviceNames));
-    m_reconnectThreads.try_emplace(port, [this, port, deviceNames](const std::stop_token stopToken) { testServerRestart(stopToken, port, deviceNames); });
-  }
+  return std::ranges::all_of(result, [](const auto& pair) { return pair.second == hw::ScaStatus::SERVER_OFFLINE; });
 }
 
-void nsw::OpcManager::warnBadConnection(const Identifier& id) const
+void nsw::OpcManager::warnBadConnection(const ConnectionHandle& handle)
 {
-  if (m_badConnections.contains(id.port) and m_badConnections.at(id.port).contains(id.name)) {
+  const auto status = handle.m_lease->status.load(std::memory_order_relaxed);
+  if (status != hw::ScaStatus::REACHABLE) {
     ERS_LOG(fmt::format("Received request for a connection to {}.{} that was identified as bad due "
                         "to {}. Operation might fail",
-                        id.port,
-                        id.name,
-                        getRepresentation(m_badConnections.at(id.port).at(id.name))));
+                        handle.m_identifier.port,
+                        handle.m_identifier.name,
+                        getRepresentation(status)));
   }
 }
 
@@ -191,8 +346,10 @@ void nsw::OpcManager::doClear()
       thread.join();
     }
   }
+  std::lock_guard<std::mutex> lock(m_mutex);
   m_connections.clear();
   m_badConnections.clear();
+  m_generation.fetch_add(1, std::memory_order_release);
 }
 
 void nsw::OpcManager::testServerRestart(const std::stop_token stopToken, const std::string& server, const std::vector<std::string>& deviceNames)
@@ -207,8 +364,10 @@ void nsw::OpcManager::testServerRestart(const std::stop_token stopToken, const s
     return;
   }
   std::lock_guard<std::mutex> lock(m_mutex);
-  m_connections.at(server).clear();
+  m_connections.at(server) = SessionPool{};
   m_badConnections.at(server).clear();
+  m_generation.fetch_add(1, std::memory_order_release);
+  m_deviceGeneration.fetch_add(1, std::memory_order_release);
   if (m_commandSender.valid()) {
     ERS_LOG("Detected restart of OPC server. Sending command to application (disabled at the moment)");
     // m_commandSender.send(nsw::commands::RECOVER_OPC_MESSAGE);
@@ -217,13 +376,11 @@ void nsw::OpcManager::testServerRestart(const std::stop_token stopToken, const s
 
 bool nsw::OpcManager::checkServerStatus(const std::string& server, const std::vector<std::string>& deviceNames)
 {
-  const auto tryConnect = [&server](const std::string& deviceName) {
-    try {
-      auto connection = OpcClient(server);
-      return testConnection(deviceName, &connection);
-    } catch (const nsw::OpcConnectionIssue&) {
-      return hw::ScaStatus::SERVER_OFFLINE;
-    }
-  };
-  return std::ranges::none_of(deviceNames | std::views::transform(tryConnect), [] (const auto result) { return result == hw::ScaStatus::SERVER_OFFLINE; });
+  try {
+    const auto connection = OpcClient(server);
+    return std::ranges::none_of(testConnections(deviceNames, &connection) | std::views::values,
+                                [](const auto result) { return result == hw::ScaStatus::SERVER_OFFLINE; });
+  } catch (const nsw::OpcConnectionIssue&) {
+    return false;
+  }
 }
@@ -139,11 +139,11 @@ void nsw::hw::PadTrigger::writeFPGAConfiguration() const
 
   const auto& fpga = getFpga();
 
-  for (const auto& [rname, value_str] : fpga.getBitstreamMap()) {
+  for (const auto& [rname, bits] : fpga.getBitstreamMap()) {
 
     // strings -> numerics
     const auto addr  = addressFromRegisterName(rname);
-    const auto value = std::stoul(value_str, nullptr, nsw::BASE_BIN);
+    const auto value = bits.toInteger();
 
     // write
     ERS_LOG(fmt::format("{}: writing to {} ({:#04x}) with {:#010x}", m_name, rname, addr, value));
@@ -445,6 +445,24 @@ std::uint32_t nsw::hw::PadTrigger::readSubRegister(const std::string& rname,
   return getSubRegisterFromRegister(rname, subreg, readFPGARegister(addressFromRegisterName(rname)));
 }
 
+std::vector<std::uint32_t> nsw::hw::PadTrigger::readSubRegisters(
+  const std::span<const std::pair<std::string, std::string>> names) const
+{
+  std::vector<RegisterRead> registers{};
+  registers.reserve(std::size(names));
+  for (const auto& [rname, subreg] : names) {
+    registers.push_back({addressFromRegisterName(rname)});
+  }
+  const auto values =
+    nsw::hw::SCA::readRegisters(getConnection(), m_scaAddressFPGA, I2cReadPlan{registers, FPGA_REGISTER_LAYOUT});
+  std::vector<std::uint32_t> result{};
+  result.reserve(std::size(names));
+  for (std::size_t index = 0; index < std::size(names); ++index) {
+    result.push_back(getSubRegisterFromRegister(names[index].first, names[index].second, values[index]));
+  }
+  return result;
+}
+
 std::uint32_t nsw::hw::PadTrigger::getSubRegisterFromRegister(const std::string& rname,
                                                               const std::string& subreg,
                                                               const std::uint32_t value) const
@@ -1,9 +1,12 @@
 #include "NSWConfiguration/hw/ROC.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iterator>
+#include <ranges>
 #include <stdexcept>
+#include <utility>
 
 #include <fmt/core.h>
 
@@ -31,35 +34,77 @@ void nsw::hw::ROC::writeConfiguration() const
   constexpr bool INACTIVE = false;
   constexpr bool ACTIVE = true;
 
-  setCoreResetN(getConnection(), ACTIVE);
-  setPllResetN(getConnection(), ACTIVE);
-  setSResetN(getConnection(), ACTIVE);
+  // The state is unknown if the configuration fails
+  m_written.reset();
+  const auto generation = getOpcGeneration();
 
-  setSResetN(getConnection(), INACTIVE);
-
-  nsw::hw::SCA::sendI2cMasterConfig(getConnection(), getScaAddress(), m_rocAnalog);
+  // The reset sequence is order dependent, every GPIO write is sent as a request of its own
+  nsw::OpcTransaction analog;
+  addReset(analog, "rocCoreResetN", ACTIVE);
+  addReset(analog, "rocPllResetN", ACTIVE);
+  addReset(analog, "rocSResetN", ACTIVE);
+  addReset(analog, "rocSResetN", INACTIVE);
+  nsw::hw::SCA::addI2cMasterConfig(analog, getScaAddress(), m_rocAnalog);
+  nsw::hw::SCA::sendTransaction(getConnection(), analog);
 
+  // Waits for the PLLs to lock
   setPllResetN(getConnection(), INACTIVE);
-  setCoreResetN(getConnection(), INACTIVE);
 
-  nsw::hw::SCA::sendI2cMasterConfig(getConnection(), getScaAddress(), m_rocDigital);
+  nsw::OpcTransaction digital;
+  addReset(digital, "rocCoreResetN", INACTIVE);
+  nsw::hw::SCA::addI2cMasterConfig(digital, getScaAddress(), m_rocDigital);
+  nsw::hw::SCA::sendTransaction(getConnection(), digital);
+
+  m_written = WrittenImage{m_rocAnalog.getBitstreamMap(), m_rocDigital.getBitstreamMap()};
+  m_writtenGeneration = generation;
+}
+
+std::size_t nsw::hw::ROC::writeChangedConfiguration() const
+{
+  if (not hasWrittenConfiguration()) {
+    writeConfiguration();
+    return m_rocAnalog.getBitstreamMap().size() + m_rocDigital.getBitstreamMap().size();
+  }
+  const auto previous = std::move(*m_written);
+  m_written.reset();
+  const auto generation = getOpcGeneration();
+
+  nsw::OpcTransaction analog;
+  const auto numAnalog =
+    nsw::hw::SCA::addChangedI2cMasterConfig(analog, getScaAddress(), m_rocAnalog, previous.m_analog);
+  if (numAnalog > 0) {
+    constexpr bool ACTIVE = true;
+    constexpr bool INACTIVE = false;
+    setPllResetN(getConnection(), ACTIVE);
+    nsw::hw::SCA::sendTransaction(getConnection(), analog);
+    setPllResetN(getConnection(), INACTIVE);
+  }
+
+  nsw::OpcTransaction digital;
+  const auto numDigital =
+    nsw::hw::SCA::addChangedI2cMasterConfig(digital, getScaAddress(), m_rocDigital, previous.m_digital);
+  if (numDigital > 0) {
+    nsw::hw::SCA::sendTransaction(getConnection(), digital);
+  }
+
+  m_written = WrittenImage{m_rocAnalog.getBitstreamMap(), m_rocDigital.getBitstreamMap()};
+  m_writtenGeneration = generation;
+  return numAnalog + numDigital;
 }
 
 std::map<std::uint8_t, std::uint8_t> nsw::hw::ROC::readConfiguration() const
 {
-  std::map<std::uint8_t, std::uint8_t> result;
+  std::vector<std::uint8_t> regAddresses{};
   for (std::uint8_t regNumber = 0;
        regNumber <
        static_cast<std::uint8_t>(ROC_ANALOG_REGISTERS.size() + ROC_DIGITAL_REGISTERS.size());
        regNumber++) {
-    try {
-      result[regNumber] = readRegister(regNumber);
-    }
-    catch (const UnusedRegisterException&) {
-      continue;
+    if (std::find(std::begin(UNUSED_REGISTERS), std::end(UNUSED_REGISTERS), regNumber) ==
+        std::end(UNUSED_REGISTERS)) {
+      regAddresses.push_back(regNumber);
     }
   }
-  return result;
+  return readRegisters(regAddresses);
 }
 
 void nsw::hw::ROC::writeRegister(const std::uint8_t regAddress, const std::uint8_t value) const
@@ -106,6 +151,11 @@ void nsw::hw::ROC::writeRegister(const std::string& regName, const std::uint8_t
     return std::string{ROC_DIGITAL_NAME};
   }();
 
+  // The register no longer holds the value of the configuration, rewrite it with the next one
+  if (m_written.has_value()) {
+    (isAnalog ? m_written->m_analog : m_written->m_digital).erase(regName);
+  }
+
   if (isAnalog) {
     constexpr bool ACTIVE = true;
     setPllResetN(getConnection(), ACTIVE);
@@ -121,31 +171,58 @@ void nsw::hw::ROC::writeRegister(const std::string& regName, const std::uint8_t
 
 std::uint8_t nsw::hw::ROC::readRegister(const std::uint8_t regAddress) const
 {
-  if (std::find(std::begin(UNUSED_REGISTERS), std::end(UNUSED_REGISTERS), regAddress) != std::end(UNUSED_REGISTERS)) {
-    throw UnusedRegisterException(fmt::format("Cannot read unused register {}", regAddress));
-  }
-  constexpr unsigned int DELAY = 2;
-  const auto [sclLine, sdaLine] = [address = getScaAddress(),
-                                   regAddress]() -> std::pair<unsigned int, unsigned int> {
-    const auto isMmfe8 = address.find("MM") != std::string::npos;  // FIXME: Use util function
-    const auto isAnalog = regAddress >= ROC_DIGITAL_REGISTERS.size();
-    if (isMmfe8 and isAnalog) {
-      return {nsw::roc::mmfe8::analog::SCL_LINE_PIN, nsw::roc::mmfe8::analog::SDA_LINE_PIN};
-    }
-    if (isMmfe8 and not isAnalog) {
-      return {nsw::roc::mmfe8::digital::SCL_LINE_PIN, nsw::roc::mmfe8::digital::SDA_LINE_PIN};
+  return readRegisters(std::array{regAddress}).at(regAddress);
+}
+
+std::map<std::uint8_t, std::uint8_t> nsw::hw::ROC::readRegisters(
+  const std::span<const std::uint8_t> regAddresses) const
+{
+  return readRegisters(regAddresses, [this](const auto lines, const auto busRegAddresses) {
+    return nsw::hw::SCA::readRocRawMulti(getConnection(),
+                                         fmt::format("{}.gpio.bitBanger", getScaAddress()),
+                                         lines.first,
+                                         lines.second,
+                                         busRegAddresses,
+                                         I2C_DELAY);
+  });
+}
+
+std::map<std::uint8_t, std::uint8_t> nsw::hw::ROC::readRegisters(
+  const std::span<const std::uint8_t> regAddresses, const BusReader& readBus) const
+{
+  // Collect the registers per I2C bus to read each bus with one IoBatch
+  std::map<std::pair<unsigned int, unsigned int>, std::vector<std::uint8_t>> regAddressesPerBus{};
+  for (const auto regAddress : regAddresses) {
+    if (std::find(std::begin(UNUSED_REGISTERS), std::end(UNUSED_REGISTERS), regAddress) != std::end(UNUSED_REGISTERS)) {
+      throw UnusedRegisterException(fmt::format("Cannot read unused register {}", regAddress));
     }
-    if (not isMmfe8 and isAnalog) {
-      return {nsw::roc::sfeb::analog::SCL_LINE_PIN, nsw::roc::sfeb::analog::SDA_LINE_PIN};
+    regAddressesPerBus[getI2cLines(regAddress)].push_back(regAddress);
+  }
+
+  std::map<std::uint8_t, std::uint8_t> result{};
+  for (const auto& [lines, busRegAddresses] : regAddressesPerBus) {
+    const auto values = readBus(lines, busRegAddresses);
+    for (std::size_t i = 0; i < busRegAddresses.size(); ++i) {
+      result[busRegAddresses[i]] = values.at(i);
     }
-    return {nsw::roc::sfeb::digital::SCL_LINE_PIN, nsw::roc::sfeb::digital::SDA_LINE_PIN};
-  }();
-  return nsw::hw::SCA::readRocRaw(getConnection(),
-                                  fmt::format("{}.gpio.bitBanger", getScaAddress()),
-                                  sclLine,
-                                  sdaLine,
-                                  regAddress,
-                                  DELAY);
+  }
+  return result;
+}
+
+std::pair<unsigned int, unsigned int> nsw::hw::ROC::getI2cLines(const std::uint8_t regAddress) const
+{
+  const auto isMmfe8 = getScaAddress().find("MM") != std::string::npos;  // FIXME: Use util function
+  const auto isAnalog = regAddress >= ROC_DIGITAL_REGISTERS.size();
+  if (isMmfe8 and isAnalog) {
+    return {nsw::roc::mmfe8::analog::SCL_LINE_PIN, nsw::roc::mmfe8::analog::SDA_LINE_PIN};
+  }
+  if (isMmfe8 and not isAnalog) {
+    return {nsw::roc::mmfe8::digital::SCL_LINE_PIN, nsw::roc::mmfe8::digital::SDA_LINE_PIN};
+  }
+  if (not isMmfe8 and isAnalog) {
+    return {nsw::roc::sfeb::analog::SCL_LINE_PIN, nsw::roc::sfeb::analog::SDA_LINE_PIN};
+  }
+  return {nsw::roc::sfeb::digital::SCL_LINE_PIN, nsw::roc::sfeb::digital::SDA_LINE_PIN};
 }
 
 void nsw::hw::ROC::writeValues(const std::map<std::string, unsigned int>& values) const
@@ -184,6 +261,14 @@ void nsw::hw::ROC::writeValues(const std::map<std::string, unsigned int>& values
       true);
   }();
 
+  // Rewrite the touched registers with the next configuration
+  if (m_written.has_value()) {
+    auto& written = isAnalog ? m_written->m_analog : m_written->m_digital;
+    for (const auto& address : config.getBitstreamMap() | std::views::keys) {
+      written.erase(address);
+    }
+  }
+
   if (isAnalog) {
     constexpr bool ACTIVE = true;
     setPllResetN(getConnection(), ACTIVE);
@@ -209,64 +294,67 @@ std::map<std::string, unsigned int> nsw::hw::ROC::readValues(
   const std::span<const std::string> names) const
 {
   const auto isAnalog = internal::ROC::namesAnalog(names);
-  // Lambda to const init the register names. Pulls in isAnalog and the names and asks the config
-  // converter for the registers for the given names
-  const auto regNames = [isAnalog, &names] {
-    std::unordered_set<std::string> result{};
-    for (const auto& name : names) {
-      if (isAnalog) {
-        result.merge(ConfigConverter<ConfigConversionType::ROC_ANALOG>::getRegsForValue(name));
-      } else {
-        result.merge(ConfigConverter<ConfigConversionType::ROC_DIGITAL>::getRegsForValue(name));
-      }
-    }
-    return result;
-  }();
+  // Lambda reading the registers needed for the values and translating them with the compiled
+  // translation index of the analog or digital part. Pulls in this, isAnalog and the names
+  const auto readValuesFromIndex = [this, isAnalog, &names](const auto& index) {
+    return index.readValues(names, [this, isAnalog, &index](const std::span<const std::size_t> regs) {
+      std::vector<std::uint8_t> regAddresses{};
+      regAddresses.reserve(regs.size());
+      std::ranges::transform(regs, std::back_inserter(regAddresses), [isAnalog, &index](const auto reg) {
+        return getRegAddress(index.getRegisterName(reg), isAnalog);
+      });
+      const auto readBack = readRegisters(regAddresses);
+      std::vector<std::uint32_t> contents{};
+      contents.reserve(regs.size());
+      std::ranges::transform(regAddresses, std::back_inserter(contents), [&readBack](const auto address) {
+        return readBack.at(address);
+      });
+      return contents;
+    });
+  };
+  if (isAnalog) {
+    return readValuesFromIndex(ConfigTranslationIndex<ConfigConversionType::ROC_ANALOG>::getInstance());
+  }
+  return readValuesFromIndex(ConfigTranslationIndex<ConfigConversionType::ROC_DIGITAL>::getInstance());
+}
 
-  std::map<std::string, unsigned int> registerValues{};
-  std::transform(std::cbegin(regNames),
-                 std::cend(regNames),
-                 std::inserter(registerValues, std::begin(registerValues)),
-                 [&](const auto& regName) -> std::pair<std::string, std::uint8_t> {
-                   return {regName, readRegister(getRegAddress(regName, isAnalog))};
-                 });
-
-  // Lambda to const init the read-back values. Pulls in isAnalog, the read-back register values and
-  // the names. Asks the config converter to do the translation. TODO: Clean up config converter
-  // call (future MR)
-  const auto values = [isAnalog, &registerValues, &names]() {
-    if (isAnalog) {
-      const auto configConverter = ConfigConverter<ConfigConversionType::ROC_ANALOG>(
-        transformMapToPtree(
-          ConfigConverter<ConfigConversionType::ROC_ANALOG>::convertRegisterToSubRegister(
-            transformMapToPtree(registerValues), names)),
-        ConfigType::REGISTER_BASED);
-      return configConverter.getValueBasedConfig();
-    }
-    const auto configConverter = ConfigConverter<ConfigConversionType::ROC_DIGITAL>(
-      transformMapToPtree(
-        ConfigConverter<ConfigConversionType::ROC_DIGITAL>::convertRegisterToSubRegister(
-          transformMapToPtree(registerValues), names)),
-      ConfigType::REGISTER_BASED);
-    return configConverter.getValueBasedConfig();
-  }();
+void nsw::hw::ROC::enableVmmCaptureInputs() const
+{
+  enableVmmCaptureInputsAsync().get();
+}
 
-  return transformPtreetoMap<unsigned int>(values);
+void nsw::hw::ROC::disableVmmCaptureInputs() const
+{
+  disableVmmCaptureInputsAsync().get();
 }
 
-void nsw::hw::ROC::enableVmmCaptureInputs() const
+std::future<void> nsw::hw::ROC::enableVmmCaptureInputsAsync() const
 {
   boost::property_tree::ptree tree;
   tree.put_child("reg008vmmEnable",
-                 m_rocDigital.getConfig().get_child("reg008vmmEnable"));
+                 m_rocDigital.getConfigLayers().getNode("reg008vmmEnable"));
   const auto configConverter = ConfigConverter<ConfigConversionType::ROC_DIGITAL>(tree, ConfigType::REGISTER_BASED);
   const auto translatedPtree = configConverter.getFlatRegisterBasedConfig(m_rocDigital.getBitstreamMap());
-  writeRegister("reg008vmmEnable", translatedPtree.get<std::uint8_t>("reg008vmmEnable"));
+  return writeDigitalRegisterAsync("reg008vmmEnable", translatedPtree.get<std::uint8_t>("reg008vmmEnable"));
 }
 
-void nsw::hw::ROC::disableVmmCaptureInputs() const
+std::future<void> nsw::hw::ROC::disableVmmCaptureInputsAsync() const
 {
-  writeRegister("reg008vmmEnable", 0);
+  return writeDigitalRegisterAsync("reg008vmmEnable", 0);
+}
+
+std::future<void> nsw::hw::ROC::writeDigitalRegisterAsync(const std::string& regName,
+                                                          const std::uint8_t value) const
+{
+  // The register no longer holds the value of the configuration, rewrite it with the next one
+  if (m_written.has_value()) {
+    m_written->m_digital.erase(regName);
+  }
+  const auto node = fmt::format("{}.{}.{}", getScaAddress(), ROC_DIGITAL_NAME, regName);
+  ERS_LOG("Sending I2c configuration to " << node);
+  nsw::OpcTransaction transaction;
+  transaction.addI2cWrite(node, {value});
+  return nsw::hw::SCA::sendTransactionAsync(getConnection(), std::move(transaction));
 }
 
 std::uint8_t nsw::hw::ROC::readVmmCaptureStatus(const std::uint8_t vmmIndex) const
@@ -340,6 +428,14 @@ void nsw::hw::ROC::setReset(const nsw::OpcClientPtr opcConnection,
     opcConnection, fmt::format("{}.gpio.{}", getScaAddress(), resetName), not state);
 }
 
+void nsw::hw::ROC::addReset(nsw::OpcTransaction& transaction,
+                            const std::string& resetName,
+                            const bool state) const
+{
+  // Active = Low
+  transaction.addGpioWrite(fmt::format("{}.gpio.{}", getScaAddress(), resetName), not state);
+}
+
 std::uint8_t nsw::hw::ROC::getRegAddress(const std::string& regName, const bool isAnalog)
 {
   if (isAnalog) {
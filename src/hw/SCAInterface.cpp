@@ -1,5 +1,7 @@
 #include "NSWConfiguration/hw/SCAInterface.h"
 
+#include <utility>
+
 #include "NSWConfiguration/Utility.h"
 
 #include <fmt/core.h>
@@ -49,6 +51,17 @@ std::uint8_t nsw::hw::SCA::readRocRaw(const nsw::OpcClientPtr opcConnection,
   return opcConnection->readRocRaw(node, scl, sda, registerAddress, i2cDelay);
 }
 
+std::vector<std::uint8_t> nsw::hw::SCA::readRocRawMulti(
+  const nsw::OpcClientPtr opcConnection,
+  const std::string& node,
+  unsigned int scl,
+  unsigned int sda,
+  const std::span<const std::uint8_t> registerAddresses,
+  unsigned int i2cDelay)
+{
+  return opcConnection->readRocRawMulti(node, scl, sda, registerAddresses, i2cDelay);
+}
+
 std::vector<std::uint8_t> nsw::hw::SCA::readI2c(const nsw::OpcClientPtr opcConnection,
                                                 const std::string& node,
                                                 const size_t numberOfBytes)
@@ -70,6 +83,18 @@ std::vector<std::uint8_t> nsw::hw::SCA::readI2cAtAddress(const nsw::OpcClientPtr
   return readdata;
 }
 
+std::vector<std::uint32_t> nsw::hw::SCA::readRegisters(const nsw::OpcClientPtr opcConnection,
+                                                       const std::string& node,
+                                                       const nsw::hw::I2cReadPlan& plan)
+{
+  std::vector<nsw::I2cAddressedRead> reads{};
+  reads.reserve(std::size(plan.getBursts()));
+  for (const auto& burst : plan.getBursts()) {
+    reads.push_back({burst.m_address, nsw::hw::I2cReadPlan::getNumBytes(burst)});
+  }
+  return plan.decode(opcConnection->readI2cAtAddresses(node, reads));
+}
+
 void nsw::hw::SCA::sendI2cAtAddress(const nsw::OpcClientPtr opcConnection,
                                     const std::string& node,
                                     const std::vector<std::uint8_t>& address,
@@ -87,9 +112,7 @@ void nsw::hw::SCA::sendI2cMasterSingle(const nsw::OpcClientPtr opcConnection,
                                        const nsw::I2cMasterConfig& cfg,
                                        const std::string& regAddress)
 {
-  const auto addrBitstream = cfg.getBitstreamMap();
-  const auto& bitstr = addrBitstream.at(regAddress);
-  const auto data = nsw::stringToByteVector(bitstr);
+  const auto data = cfg.getBitstreamMap().at(regAddress).toByteVector();
   nsw::hw::SCA::sendI2cMasterSingle(
     opcConnection, fmt::format("{}.{}", topnode, cfg.getName()), data, regAddress);
 }
@@ -107,22 +130,58 @@ void nsw::hw::SCA::sendI2cMasterSingle(const nsw::OpcClientPtr opcConnection,
   sendI2cRaw(opcConnection, address, data.data(), data.size());
 }
 
-void nsw::hw::SCA::sendI2cMasterConfig(const nsw::OpcClientPtr opcConnection,
-                                       const std::string& topnode,
-                                       const nsw::I2cMasterConfig& cfg)
+void nsw::hw::SCA::sendTransaction(const nsw::OpcClientPtr opcConnection,
+                                   const nsw::OpcTransaction& transaction)
 {
-  ERS_LOG("Sending I2c configuration to " << topnode << "." << cfg.getName());
-  const auto addrBitstream = cfg.getBitstreamMap();
-  for (const auto& ab : addrBitstream) {
+  opcConnection->dispatch(transaction);
+}
+
+std::future<void> nsw::hw::SCA::sendTransactionAsync(const nsw::OpcClientPtr opcConnection,
+                                                     nsw::OpcTransaction transaction)
+{
+  return opcConnection->dispatchAsync(std::move(transaction));
+}
+
+void nsw::hw::SCA::addI2cMasterConfig(nsw::OpcTransaction& transaction,
+                                      const std::string& topnode,
+                                      const nsw::I2cMasterConfig& cfg)
+{
+  for (const auto& ab : cfg.getBitstreamMap()) {
     const auto address =
       fmt::format("{}.{}.{}", topnode, cfg.getName(), ab.first);  // Full I2C address
-    const auto bitstr = ab.second;
-    const auto data = nsw::stringToByteVector(bitstr);
+    auto data = ab.second.toByteVector();
     for (const auto d : data) {
       ERS_DEBUG(5, "data: " << static_cast<unsigned>(d));
     }
-    sendI2cRaw(opcConnection, address, data.data(), data.size());
+    transaction.addI2cWrite(address, std::move(data));
+  }
+}
+
+std::size_t nsw::hw::SCA::addChangedI2cMasterConfig(nsw::OpcTransaction& transaction,
+                                                    const std::string& topnode,
+                                                    const nsw::I2cMasterConfig& cfg,
+                                                    const i2c::AddressBitstreamMap& previous)
+{
+  std::size_t numWrites{0};
+  for (const auto& [address, bitstream] : cfg.getBitstreamMap()) {
+    const auto written = previous.find(address);
+    if (written != std::end(previous) and written->second == bitstream) {
+      continue;
+    }
+    transaction.addI2cWrite(fmt::format("{}.{}.{}", topnode, cfg.getName(), address), bitstream.toByteVector());
+    ++numWrites;
   }
+  return numWrites;
+}
+
+void nsw::hw::SCA::sendI2cMasterConfig(const nsw::OpcClientPtr opcConnection,
+                                       const std::string& topnode,
+                                       const nsw::I2cMasterConfig& cfg)
+{
+  ERS_LOG("Sending I2c configuration to " << topnode << "." << cfg.getName());
+  nsw::OpcTransaction transaction;
+  addI2cMasterConfig(transaction, topnode, cfg);
+  sendTransaction(opcConnection, transaction);
 }
 
 void nsw::hw::SCA::sendSpiRaw(const nsw::OpcClientPtr opcConnection,
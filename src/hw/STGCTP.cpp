@@ -3,6 +3,9 @@
 #include "NSWConfiguration/hw/SCAX.h"
 #include "NSWConfiguration/TPConstants.h"
 #include "NSWConfiguration/Utility.h"
+
+#include <algorithm>
+
 using namespace std::chrono_literals;
 
 nsw::hw::STGCTP::STGCTP(OpcManager& manager, const boost::property_tree::ptree& config):
@@ -77,6 +80,22 @@ std::uint32_t nsw::hw::STGCTP::readRegister(const std::uint32_t regAddress,
   return nsw::hw::SCAX::readRegister(getConnection(), m_scaAddressFPGA, regAddress, mask);
 }
 
+std::vector<std::uint32_t> nsw::hw::STGCTP::readRegisters(const I2cReadPlan& plan) const
+{
+  const auto& registers = plan.getRegisters();
+  const auto skipped = [this](const auto& reg) { return m_skippedReg.contains(reg.m_address); };
+  if (std::ranges::none_of(registers, skipped)) {
+    return nsw::hw::SCA::readRegisters(getConnection(), m_scaAddressFPGA, plan);
+  }
+  // Registers of the plan must not be touched, read the others one by one
+  std::vector<std::uint32_t> result{};
+  result.reserve(std::size(registers));
+  for (const auto& reg : registers) {
+    result.push_back(readRegister(reg.m_address, reg.m_mask));
+  }
+  return result;
+}
+
 void nsw::hw::STGCTP::writeAndReadbackRegister(const std::uint32_t regAddress,
                                                const std::uint32_t value,
                                                const std::uint32_t mask) const
@@ -0,0 +1,41 @@
+#include "NSWConfiguration/hw/SessionLeases.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+std::size_t nsw::hw::SessionLeases::acquire(const std::size_t maxSessions, const SessionSelection selection)
+{
+  const auto index = [this, maxSessions, selection]() -> std::size_t {
+    const auto numSessions = getNumSessions();
+    const auto unused = std::ranges::find(m_numLeases, std::size_t{0});
+    if (unused != std::end(m_numLeases)) {
+      return static_cast<std::size_t>(std::distance(std::begin(m_numLeases), unused));
+    }
+    if (numSessions < std::max(maxSessions, std::size_t{1})) {
+      return numSessions;
+    }
+    switch (selection) {
+      case SessionSelection::ROUND_ROBIN:
+        return m_nextSession++ % numSessions;
+      case SessionSelection::LEAST_LOADED:
+        return static_cast<std::size_t>(
+          std::distance(std::begin(m_numLeases), std::ranges::min_element(m_numLeases)));
+    }
+    return 0;
+  }();
+  if (index == getNumSessions()) {
+    m_numLeases.push_back(0);
+  }
+  ++m_numLeases.at(index);
+  return index;
+}
+
+void nsw::hw::SessionLeases::release(const std::size_t session)
+{
+  auto& numLeases = m_numLeases.at(session);
+  if (numLeases == 0) {
+    throw std::out_of_range("Session is not leased");
+  }
+  --numLeases;
+}
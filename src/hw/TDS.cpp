@@ -1,8 +1,11 @@
 #include "NSWConfiguration/hw/TDS.h"
 
+#include <algorithm>
 #include <iterator>
+#include <ranges>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include <fmt/core.h>
 
@@ -22,33 +25,35 @@ nsw::hw::TDS::TDS(OpcManager& manager, const FEBConfig& config, const std::size_
 
 void nsw::hw::TDS::writeConfiguration(const bool resetTds) const
 {
+  // The state is unknown if the configuration fails
+  m_written.reset();
+  const auto generation = getOpcGeneration();
+
   // Assert that TDS is not in reset
   constexpr bool INCATIVE_HIGH = true;
 
+  nsw::OpcTransaction transaction;
   if (m_isPfeb) {
     // old boards, and PFEB
-    nsw::hw::SCA::sendGPIO(
-      getConnection(), fmt::format("{}.gpio.tdsReset", getScaAddress()), INCATIVE_HIGH);
+    transaction.addGpioWrite(fmt::format("{}.gpio.tdsReset", getScaAddress()), INCATIVE_HIGH);
   } else {
     // new boards
     if (m_config.getName() == "tds0") {
-      nsw::hw::SCA::sendGPIO(
-        getConnection(), fmt::format("{}.gpio.tdsaReset", getScaAddress()), INCATIVE_HIGH);
+      transaction.addGpioWrite(fmt::format("{}.gpio.tdsaReset", getScaAddress()), INCATIVE_HIGH);
     } else if (m_config.getName() == "tds1") {
-      nsw::hw::SCA::sendGPIO(
-        getConnection(), fmt::format("{}.gpio.tdsbReset", getScaAddress()), INCATIVE_HIGH);
+      transaction.addGpioWrite(fmt::format("{}.gpio.tdsbReset", getScaAddress()), INCATIVE_HIGH);
     } else if (m_config.getName() == "tds2") {
-      nsw::hw::SCA::sendGPIO(
-        getConnection(), fmt::format("{}.gpio.tdscReset", getScaAddress()), INCATIVE_HIGH);
+      transaction.addGpioWrite(fmt::format("{}.gpio.tdscReset", getScaAddress()), INCATIVE_HIGH);
     } else if (m_config.getName() == "tds3") {
-      nsw::hw::SCA::sendGPIO(
-        getConnection(), fmt::format("{}.gpio.tdsdReset", getScaAddress()), INCATIVE_HIGH);
+      transaction.addGpioWrite(fmt::format("{}.gpio.tdsdReset", getScaAddress()), INCATIVE_HIGH);
     } else {
       throw std::logic_error(fmt::format("Unknown TDS name {}", m_config.getName()));
     }
   }
 
-  nsw::hw::SCA::sendI2cMasterConfig(getConnection(), getScaAddress(), m_config);
+  // Release the reset and configure with one transaction
+  nsw::hw::SCA::addI2cMasterConfig(transaction, getScaAddress(), m_config);
+  nsw::hw::SCA::sendTransaction(getConnection(), transaction);
 
   if (resetTds) {
     // copy out the configuration, etc
@@ -87,6 +92,35 @@ void nsw::hw::TDS::writeConfiguration(const bool resetTds) const
     ERS_LOG("0x" << std::hex
                  << static_cast<uint32_t>(std::stoul(nsw::vectorToBitString(readRegister(14)))));
   }
+
+  m_written = m_config.getBitstreamMap();
+  if (resetTds) {
+    // Ends with the resets released, independent of the configuration
+    m_written->erase("register12");
+  }
+  m_writtenGeneration = generation;
+}
+
+std::size_t nsw::hw::TDS::writeChangedConfiguration() const
+{
+  if (not hasWrittenConfiguration()) {
+    writeConfiguration();
+    return m_config.getBitstreamMap().size();
+  }
+  const auto previous = std::move(*m_written);
+  m_written.reset();
+  const auto generation = getOpcGeneration();
+
+  nsw::OpcTransaction transaction;
+  const auto numWrites =
+    nsw::hw::SCA::addChangedI2cMasterConfig(transaction, getScaAddress(), m_config, previous);
+  if (numWrites > 0) {
+    nsw::hw::SCA::sendTransaction(getConnection(), transaction);
+  }
+
+  m_written = m_config.getBitstreamMap();
+  m_writtenGeneration = generation;
+  return numWrites;
 }
 
 std::map<std::uint8_t, std::vector<std::uint8_t>> nsw::hw::TDS::readConfiguration() const
@@ -106,6 +140,10 @@ void nsw::hw::TDS::writeRegister(const std::uint8_t regAddress, const __uint128_
 
 void nsw::hw::TDS::writeRegister(const std::string& regName, const __uint128_t value) const
 {
+  // The register no longer holds the value of the configuration, rewrite it with the next one
+  if (m_written.has_value()) {
+    m_written->erase(regName);
+  }
   nsw::hw::SCA::sendI2cMasterSingle(getConnection(),
                                     fmt::format("{}.{}", getScaAddress(), m_config.getName()),
                                     nsw::integerToByteVector(value, m_config.getTotalSize(regName) / nsw::NUM_BITS_IN_BYTE),
@@ -142,6 +180,12 @@ void nsw::hw::TDS::writeValues(const std::map<std::string, unsigned int>& values
                          TDS_REGISTERS,
                          true);
 
+  // Rewrite the touched registers with the next configuration
+  if (m_written.has_value()) {
+    for (const auto& address : config.getBitstreamMap() | std::views::keys) {
+      m_written->erase(address);
+    }
+  }
   nsw::hw::SCA::sendI2cMasterConfig(getConnection(), getScaAddress(), config);
 }
 
@@ -158,38 +202,22 @@ unsigned int nsw::hw::TDS::readValue(const std::string& name) const
 std::map<std::string, unsigned int> nsw::hw::TDS::readValues(
   const std::span<const std::string> names) const
 {
-  // Lambda to const init the register names. Pulls in the names and asks the config
-  // converter for the registers for the given names
-  const auto regNames = [&names] {
-    std::unordered_set<std::string> result{};
-    for (const auto& name : names) {
-      result.merge(ConfigConverter<ConfigConversionType::TDS>::getRegsForValue(name));
-    }
-    return result;
-  }();
-
-  std::map<std::string, __uint128_t> registerValues{};
-  std::transform(std::cbegin(regNames),
-                 std::cend(regNames),
-                 std::inserter(registerValues, std::begin(registerValues)),
-                 [&](const auto& regName) -> std::pair<std::string, __uint128_t> {
-                   const auto byteVector = readRegister(addressFromRegisterName(regName));
-                   // byte vector to 128 bit integer conversion
-                   __uint128_t result{0};
-                   auto counter = byteVector.size();
-                   for (const auto byte : byteVector) {
-                     result |= static_cast<__uint128_t>(byte) << (NUM_BITS_IN_BYTE * --counter);
-                   }
-                   return {regName, result};
-                 });
-
-  const auto configConverter = ConfigConverter<ConfigConversionType::TDS>(
-    transformMapToPtree(ConfigConverter<ConfigConversionType::TDS>::convertRegisterToSubRegister(
-      transformMapToPtree(registerValues), names)),
-    ConfigType::REGISTER_BASED);
-  const auto values = configConverter.getValueBasedConfig();
-
-  return transformPtreetoMap<unsigned int>(values);
+  const auto& index = ConfigTranslationIndex<ConfigConversionType::TDS>::getInstance();
+  return index.readValues(names, [this, &index](const std::span<const std::size_t> regs) {
+    std::vector<__uint128_t> contents{};
+    contents.reserve(regs.size());
+    std::ranges::transform(regs, std::back_inserter(contents), [this, &index](const auto reg) {
+      const auto byteVector = readRegister(addressFromRegisterName(index.getRegisterName(reg)));
+      // byte vector to 128 bit integer conversion
+      __uint128_t result{0};
+      auto counter = byteVector.size();
+      for (const auto byte : byteVector) {
+        result |= static_cast<__uint128_t>(byte) << (NUM_BITS_IN_BYTE * --counter);
+      }
+      return result;
+    });
+    return contents;
+  });
 }
 
 std::uint8_t nsw::hw::TDS::addressFromRegisterName(const std::string& name) const
@@ -0,0 +1,141 @@
+#include "NSWConfiguration/hw/TaskGraph.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <iterator>
+
+#include <fmt/core.h>
+
+std::string nsw::hw::TaskGraph::Report::criticalPathToString() const
+{
+  std::string result{};
+  for (const auto& name : m_criticalPath) {
+    const auto& timing = m_timings.at(name);
+    const auto duration = std::chrono::duration<double>(timing.m_end - timing.m_start);
+    result += fmt::format("{}{} ({:.1f} s)", result.empty() ? "" : " -> ", name, duration.count());
+  }
+  return result;
+}
+
+void nsw::hw::TaskGraph::Report::rethrowIfFailed() const
+{
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+}
+
+void nsw::hw::TaskGraph::add(const std::string& name,
+                             std::function<void()> task,
+                             const std::vector<std::string>& dependencies)
+{
+  const auto findNode = [this](const std::string& nodeName) {
+    return std::find_if(std::cbegin(m_nodes), std::cend(m_nodes), [&nodeName](const auto& node) {
+      return node.m_name == nodeName;
+    });
+  };
+  if (findNode(name) != std::cend(m_nodes)) {
+    throw TaskGraphIssue(ERS_HERE, fmt::format("Task {} exists already", name));
+  }
+  Node node{name, std::move(task), {}};
+  for (const auto& dependency : dependencies) {
+    const auto iter = findNode(dependency);
+    if (iter == std::cend(m_nodes)) {
+      throw TaskGraphIssue(
+        ERS_HERE, fmt::format("Task {} depends on unknown task {}", name, dependency));
+    }
+    node.m_dependencies.push_back(
+      static_cast<std::size_t>(std::distance(std::cbegin(m_nodes), iter)));
+  }
+  m_nodes.push_back(std::move(node));
+}
+
+nsw::hw::TaskGraph::Report nsw::hw::TaskGraph::run(const bool parallel) const
+{
+  const auto start = Clock::now();
+  std::vector<TaskTiming> timings(std::size(m_nodes));
+  std::vector<std::exception_ptr> errors(std::size(m_nodes));
+  // Only written by the node itself, read by the nodes depending on it once it finished
+  std::vector<State> states(std::size(m_nodes), State::SUCCEEDED);
+  const auto execute = [this, &start, &timings, &errors, &states](const std::size_t index) {
+    timings[index].m_start = Clock::now() - start;
+    const auto& dependencies = m_nodes[index].m_dependencies;
+    const auto dependencyFailed = [&states](const std::size_t dependency) {
+      return states[dependency] != State::SUCCEEDED;
+    };
+    if (std::any_of(std::cbegin(dependencies), std::cend(dependencies), dependencyFailed)) {
+      states[index] = State::SKIPPED;
+    } else {
+      try {
+        m_nodes[index].m_task();
+      } catch (...) {
+        errors[index] = std::current_exception();
+        states[index] = State::FAILED;
+      }
+    }
+    timings[index].m_end = Clock::now() - start;
+  };
+
+  if (parallel) {
+    // Nodes only depend on nodes with a lower index whose futures exist when the node is launched
+    std::vector<std::shared_future<void>> futures(std::size(m_nodes));
+    for (std::size_t index = 0; index < std::size(m_nodes); ++index) {
+      auto future = std::async(std::launch::async, [this, &futures, &execute, index]() {
+        for (const auto dependency : m_nodes[index].m_dependencies) {
+          futures[dependency].wait();
+        }
+        execute(index);
+      });
+      futures[index] = future.share();
+    }
+    for (const auto& future : futures) {
+      future.wait();
+    }
+  } else {
+    for (std::size_t index = 0; index < std::size(m_nodes); ++index) {
+      execute(index);
+    }
+  }
+
+  Report report{};
+  report.m_total = Clock::now() - start;
+  for (std::size_t index = 0; index < std::size(m_nodes); ++index) {
+    const auto& name = m_nodes[index].m_name;
+    report.m_timings.emplace(name, timings[index]);
+    if (states[index] == State::FAILED) {
+      report.m_failed.push_back(name);
+      if (not report.m_error) {
+        report.m_error = errors[index];
+      }
+    } else if (states[index] == State::SKIPPED) {
+      report.m_skipped.push_back(name);
+    }
+  }
+  report.m_criticalPath = findCriticalPath(timings);
+  return report;
+}
+
+std::vector<std::string> nsw::hw::TaskGraph::findCriticalPath(
+  const std::vector<TaskTiming>& timings) const
+{
+  if (m_nodes.empty()) {
+    return {};
+  }
+  const auto endsEarlier = [&timings](const std::size_t lhs, const std::size_t rhs) {
+    return timings[lhs].m_end < timings[rhs].m_end;
+  };
+  std::size_t current{0};
+  for (std::size_t index = 1; index < std::size(m_nodes); ++index) {
+    if (endsEarlier(current, index)) {
+      current = index;
+    }
+  }
+  std::vector<std::string> path{m_nodes[current].m_name};
+  while (not m_nodes[current].m_dependencies.empty()) {
+    const auto& dependencies = m_nodes[current].m_dependencies;
+    current = *std::max_element(std::cbegin(dependencies), std::cend(dependencies), endsEarlier);
+    path.push_back(m_nodes[current].m_name);
+  }
+  std::reverse(std::begin(path), std::end(path));
+  return path;
+}
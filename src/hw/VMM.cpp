@@ -26,6 +26,10 @@ void nsw::hw::VMM::writeConfiguration(const bool resetVmm) const
 
 void nsw::hw::VMM::writeConfiguration(const VMMConfig& config, bool resetVmm) const
 {
+  // The state is unknown if the configuration fails
+  m_written.reset();
+  const auto generation = getOpcGeneration();
+
   // Set Vmm Configuration Enable
   constexpr std::uint8_t VMM_ACC_DISABLE = 0xff;
   constexpr std::uint8_t VMM_ACC_ENABLE = 0x00;
@@ -56,10 +60,22 @@ void nsw::hw::VMM::writeConfiguration(const VMMConfig& config, bool resetVmm) co
 
   writeVmmConfig(config);
 
-  ERS_DEBUG(5, "Hexstring:\n" << nsw::bitstringToHexString(config.getBitString()));
+  ERS_DEBUG(5, "Hexstring:\n" << config.getBitVector().toHexString());
 
   // Set Vmm Acquisition Enable
   nsw::hw::SCA::sendI2c(getConnection(), scaRocVmmReadoutAddress, {VMM_ACC_ENABLE});
+
+  m_written = config.getBitVector();
+  m_writtenGeneration = generation;
+}
+
+bool nsw::hw::VMM::writeChangedConfiguration() const
+{
+  if (hasWrittenConfiguration() and *m_written == m_config.getBitVector()) {
+    return false;
+  }
+  writeConfiguration(m_config);
+  return true;
 }
 
 std::map<std::uint8_t, std::vector<std::uint8_t>> nsw::hw::VMM::readConfiguration() const
@@ -5,15 +5,17 @@ nsw::mon::CarriertpInRunStatusRegisters::CarriertpInRunStatusRegisters(
   m_devices{deviceManager.getTpCarriers()}, m_helper{NUM_CONCURRENT}
 { }
 
-void nsw::mon::CarriertpInRunStatusRegisters::monitor(ISInfoDictionary* isDict,
-                                                 const std::string_view serverName)
+void nsw::mon::CarriertpInRunStatusRegisters::monitor(ISPublisher& publisher,
+                                                 const std::string_view serverName,
+                                                 const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.get(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::CarriertpInRunStatusRegisters::getData);
+                             nsw::mon::CarriertpInRunStatusRegisters::getData,
+                             shard);
 }
 
 nsw::mon::is::CarriertpInRunStatusRegisters nsw::mon::CarriertpInRunStatusRegisters::getData(
@@ -0,0 +1,161 @@
+#include "NSWConfiguration/monitoring/History.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+nsw::mon::TimeSeries::TimeSeries(const std::size_t capacity) :
+  m_capacity{std::max(capacity, std::size_t{1})},
+  m_timestamps{std::make_unique<std::atomic<std::int64_t>[]>(m_capacity)},
+  m_values{std::make_unique<std::atomic<double>[]>(m_capacity)}
+{}
+
+void nsw::mon::TimeSeries::push(const std::int64_t timestamp, const double value)
+{
+  // Single writer: announce the slot, write it, then publish it (sequence lock)
+  const auto index = m_numWritten.load(std::memory_order_relaxed);
+  m_numStarted.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  const auto slot = index % m_capacity;
+  m_timestamps[slot].store(timestamp, std::memory_order_relaxed);
+  m_values[slot].store(value, std::memory_order_relaxed);
+  m_numWritten.store(index + 1, std::memory_order_release);
+}
+
+nsw::mon::Samples nsw::mon::TimeSeries::read(const std::int64_t since) const
+{
+  const auto end = m_numWritten.load(std::memory_order_acquire);
+  const auto begin = end > m_capacity ? end - m_capacity : 0;
+  std::vector<std::int64_t> timestamps{};
+  std::vector<double> values{};
+  timestamps.reserve(end - begin);
+  values.reserve(end - begin);
+  for (auto index = begin; index < end; ++index) {
+    const auto slot = index % m_capacity;
+    timestamps.push_back(m_timestamps[slot].load(std::memory_order_relaxed));
+    values.push_back(m_values[slot].load(std::memory_order_relaxed));
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  // Samples whose slot was reused by the writer meanwhile are invalid
+  const auto started = m_numStarted.load(std::memory_order_relaxed);
+  const auto firstValid = std::max(begin, started > m_capacity ? started - m_capacity : 0);
+  Samples samples{};
+  for (auto index = firstValid; index < end; ++index) {
+    const auto position = index - begin;
+    if (timestamps[position] >= since) {
+      samples.m_timestamps.push_back(timestamps[position]);
+      samples.m_values.push_back(values[position]);
+    }
+  }
+  return samples;
+}
+
+void nsw::mon::History::reset(const std::size_t capacity)
+{
+  std::unique_lock lock(m_mutex);
+  m_series.clear();
+  m_capacity = capacity;
+}
+
+void nsw::mon::History::record(const std::string_view group,
+                               const std::string_view device,
+                               const std::span<const Metric> metrics,
+                               const Clock::time_point time)
+{
+  if (not isEnabled()) {
+    return;
+  }
+  const auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+  for (const auto& metric : metrics) {
+    getSeries(group, device, metric.m_name).push(timestamp, metric.m_value);
+  }
+}
+
+nsw::mon::TimeSeries& nsw::mon::History::getSeries(const std::string_view group,
+                                                   const std::string_view device,
+                                                   const std::string_view metric)
+{
+  const auto id = std::tuple{group, device, metric};
+  {
+    std::shared_lock lock(m_mutex);
+    if (const auto series = m_series.find(id); series != std::end(m_series)) {
+      return *series->second;
+    }
+  }
+  std::unique_lock lock(m_mutex);
+  auto& series = m_series[SeriesId{group, device, metric}];
+  if (series == nullptr) {
+    series = std::make_unique<TimeSeries>(m_capacity);
+  }
+  return *series;
+}
+
+std::vector<nsw::mon::SeriesWindow> nsw::mon::History::query(const HistoryQuery& query,
+                                                             const Clock::time_point now) const
+{
+  const auto since =
+    query.m_window.count() > 0
+      ? std::chrono::duration_cast<std::chrono::milliseconds>((now - query.m_window).time_since_epoch()).count()
+      : std::numeric_limits<std::int64_t>::min();
+  std::vector<SeriesWindow> result{};
+  std::shared_lock lock(m_mutex);
+  for (const auto& [id, series] : m_series) {
+    const auto& [group, device, metric] = id;
+    if ((not query.m_group.empty() and group != query.m_group) or
+        (not query.m_device.empty() and device != query.m_device)) {
+      continue;
+    }
+    auto samples = series->read(since);
+    if (not samples.m_timestamps.empty()) {
+      result.push_back(SeriesWindow{group, device, metric, std::move(samples)});
+    }
+  }
+  return result;
+}
+
+std::size_t nsw::mon::History::dump(const std::string& fileName, const HistoryQuery& query) const
+{
+  const auto series = this->query(query);
+  std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+  if (not file) {
+    throw std::runtime_error(fmt::format("Cannot open {} to write the monitoring history", fileName));
+  }
+  write(file, series);
+  if (not file) {
+    throw std::runtime_error(fmt::format("Failed to write the monitoring history to {}", fileName));
+  }
+  return std::size(series);
+}
+
+void nsw::mon::History::write(std::ostream& stream, const std::span<const SeriesWindow> series)
+{
+  const auto writeValue = [&stream](const auto value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  const auto writeString = [&stream, &writeValue](const std::string_view string) {
+    const auto length = std::min(std::size(string), std::size_t{std::numeric_limits<std::uint16_t>::max()});
+    writeValue(static_cast<std::uint16_t>(length));
+    stream.write(std::data(string), static_cast<std::streamsize>(length));
+  };
+  const auto writeColumn = [&stream](const auto& column) {
+    stream.write(reinterpret_cast<const char*>(std::data(column)),
+                 static_cast<std::streamsize>(std::size(column) * sizeof(column.front())));
+  };
+
+  stream.write(std::data(FILE_MAGIC), std::size(FILE_MAGIC));
+  writeValue(FILE_VERSION);
+  writeValue(static_cast<std::uint32_t>(std::size(series)));
+  for (const auto& entry : series) {
+    writeString(entry.m_group);
+    writeString(entry.m_device);
+    writeString(entry.m_metric);
+    writeValue(static_cast<std::uint32_t>(std::size(entry.m_samples.m_timestamps)));
+    writeColumn(entry.m_samples.m_timestamps);
+    writeColumn(entry.m_samples.m_values);
+  }
+}
@@ -1,7 +1,41 @@
 #include "NSWConfiguration/monitoring/IsPublisher.h"
 
+#include <exception>
+#include <utility>
+
 #include <fmt/core.h>
 
+#include <ers/ers.h>
+
+void nsw::mon::ISDictionaryDestination::checkin(const std::string& key, const ISInfo& values) const
+{
+  m_isDict->checkin(key, values);
+}
+
+nsw::mon::ISPublisher::ISPublisher(const ISInfoDictionary* isDict,
+                                   const std::chrono::milliseconds heartbeat) :
+  ISPublisher(std::make_unique<ISDictionaryDestination>(isDict), heartbeat)
+{}
+
+nsw::mon::ISPublisher::ISPublisher(std::unique_ptr<const ISDestination> destination,
+                                   const std::chrono::milliseconds heartbeat) :
+  m_destination{std::move(destination)},
+  m_heartbeat{heartbeat},
+  m_thread{[this](const std::stop_token stopToken) { run(stopToken); }}
+{}
+
+nsw::mon::ISPublisher::~ISPublisher()
+{
+  m_thread.request_stop();
+  m_thread.join();
+}
+
+void nsw::mon::ISPublisher::flush()
+{
+  std::unique_lock lock(m_mutex);
+  m_condition.wait(lock, [this]() { return m_queue.empty() and not m_publishing; });
+}
+
 std::string nsw::mon::ISPublisher::buildKey(const std::string_view serverName,
                                             const std::string_view groupName,
                                             const std::string_view deviceType,
@@ -9,3 +43,80 @@ std::string nsw::mon::ISPublisher::buildKey(const std::string_view serverName,
 {
   return fmt::format("{}.{}.{}.{}", serverName, deviceType, groupName, deviceName);
 }
+
+void nsw::mon::ISPublisher::enqueue(const std::string_view serverName,
+                                    const std::string_view groupName,
+                                    const std::string_view deviceType,
+                                    const std::string_view deviceName,
+                                    std::unique_ptr<internal::PendingInfo> values)
+{
+  {
+    std::scoped_lock lock(m_mutex);
+    auto entry = m_entries.find(std::tuple{serverName, groupName, deviceType, deviceName});
+    if (entry == std::end(m_entries)) {
+      entry = m_entries
+                .try_emplace(EntryId{serverName, groupName, deviceType, deviceName},
+                             Entry{buildKey(serverName, groupName, deviceType, deviceName)})
+                .first;
+    }
+    // Values which were not published yet are outdated
+    if (entry->second.m_pending == nullptr) {
+      m_queue.push_back(&entry->second);
+    }
+    entry->second.m_pending = std::move(values);
+  }
+  m_condition.notify_all();
+}
+
+void nsw::mon::ISPublisher::run(const std::stop_token stopToken)
+{
+  std::unique_lock lock(m_mutex);
+  while (true) {
+    m_condition.wait(lock, stopToken, [this]() { return not m_queue.empty(); });
+    if (m_queue.empty()) {
+      // Stop requested and everything is published
+      return;
+    }
+
+    // Take all pending values at once, monitoring threads can queue new ones meanwhile
+    std::vector<std::pair<Entry*, std::unique_ptr<internal::PendingInfo>>> batch{};
+    batch.reserve(std::size(m_queue));
+    for (auto* entry : m_queue) {
+      batch.emplace_back(entry, std::move(entry->m_pending));
+    }
+    m_queue.clear();
+    m_publishing = true;
+    lock.unlock();
+
+    const auto now = Clock::now();
+    for (const auto& [entry, values] : batch) {
+      publishEntry(*entry, *values, now);
+    }
+
+    lock.lock();
+    m_publishing = false;
+    m_condition.notify_all();
+  }
+}
+
+void nsw::mon::ISPublisher::publishEntry(Entry& entry,
+                                         const internal::PendingInfo& values,
+                                         const Clock::time_point now)
+{
+  const auto fingerprint = values.fingerprint();
+  const auto unchanged = fingerprint.has_value() and fingerprint == entry.m_fingerprint;
+  if (unchanged and now - entry.m_lastPublished < m_heartbeat) {
+    ++m_numSuppressed;
+    return;
+  }
+  try {
+    values.checkin(*m_destination, entry.m_key);
+    entry.m_fingerprint = fingerprint;
+    entry.m_lastPublished = now;
+    ++m_numPublished;
+  } catch (const std::exception& ex) {
+    // Published again with the next values
+    entry.m_fingerprint.reset();
+    ERS_LOG("Publishing " << entry.m_key << " failed due to " << ex.what());
+  }
+}
@@ -1,19 +1,24 @@
 #include "NSWConfiguration/monitoring/MmtpInRunStatusRegisters.h"
 
+#include "NSWConfiguration/hw/SCAX.h"
+
 nsw::mon::MmtpInRunStatusRegisters::MmtpInRunStatusRegisters(
-  const nsw::hw::DeviceManager& deviceManager) :
-  m_devices{deviceManager.getMMTps()}, m_helper{NUM_CONCURRENT}
+  const nsw::hw::DeviceManager& deviceManager, History& history) :
+  m_devices{deviceManager.getMMTps()}, m_helper{NUM_CONCURRENT, &history}
 {}
 
-void nsw::mon::MmtpInRunStatusRegisters::monitor(ISInfoDictionary* isDict,
-                                                 const std::string_view serverName)
+void nsw::mon::MmtpInRunStatusRegisters::monitor(ISPublisher& publisher,
+                                                 const std::string_view serverName,
+                                                 const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.get(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::MmtpInRunStatusRegisters::getData);
+                             nsw::mon::MmtpInRunStatusRegisters::getData,
+                             shard,
+                             nsw::mon::MmtpInRunStatusRegisters::getMetrics);
 }
 
 nsw::mon::is::MmtpInRunStatusRegisters nsw::mon::MmtpInRunStatusRegisters::getData(
@@ -30,23 +35,38 @@ nsw::mon::is::MmtpInRunStatusRegisters nsw::mon::MmtpInRunStatusRegisters::getDa
 
   is.nArtFibersAligned = std::accumulate(is.artFibersAlignment.begin(), is.artFibersAlignment.end(), 0U);
 
+  // Compiled once, the status registers of a device are read with one request
+  constexpr static std::size_t NUM_STATUS_REGISTERS{5};
+  const static auto plan = [] {
+    std::vector<nsw::hw::RegisterRead> registers{{nsw::mmtp::REG_GBT_BCID_OK},
+                                                 {nsw::mmtp::REG_GLO_SYNC_IDLE_STATE},
+                                                 {nsw::mmtp::REG_GLO_SYNC_BCID_OFFSET},
+                                                 {nsw::mmtp::REG_OFFSET_MODE_BCID},
+                                                 {nsw::mmtp::REG_OFFSET_MODE_CNT}};
+    for (const auto reg : nsw::mmtp::REG_FIBER_BCIDS) {
+      registers.push_back({reg});
+    }
+    return nsw::hw::I2cReadPlan{registers, nsw::hw::SCAX::REGISTER_LAYOUT};
+  }();
+  const auto values = tp.readRegisters(plan);
+
   is.artFibersBcidGood.clear();
-  const auto word = tp.readRegister(nsw::mmtp::REG_GBT_BCID_OK);
+  const auto word = values.at(0);
   for (std::size_t fiber = 0; fiber < nsw::mmtp::NUM_FIBERS; fiber++) {
     is.artFibersBcidGood.push_back((word >> fiber) & 1);
   }
 
   is.nArtFibersBcidGood = std::accumulate(is.artFibersBcidGood.begin(), is.artFibersBcidGood.end(), 0U);
 
-  is.idleState = (tp.readRegister(nsw::mmtp::REG_GLO_SYNC_IDLE_STATE) != 0U);
-  is.bcidOffset = tp.readRegister(nsw::mmtp::REG_GLO_SYNC_BCID_OFFSET);
-  is.suggestedBcidOffset = tp.readRegister(nsw::mmtp::REG_OFFSET_MODE_BCID);
-  is.nGoodOffset = tp.readRegister(nsw::mmtp::REG_OFFSET_MODE_CNT);
+  is.idleState = (values.at(1) != 0U);
+  is.bcidOffset = values.at(2);
+  is.suggestedBcidOffset = values.at(3);
+  is.nGoodOffset = values.at(4);
 
   is.fiberBCIDs.clear();
   const auto numFibersPerReg = nsw::mmtp::NUM_FIBERS / nsw::mmtp::REG_FIBER_BCIDS.size();
-  for (auto reg : nsw::mmtp::REG_FIBER_BCIDS) {
-    const auto val = tp.readRegister(reg);
+  for (std::size_t reg = 0; reg < nsw::mmtp::REG_FIBER_BCIDS.size(); ++reg) {
+    const auto val = values.at(NUM_STATUS_REGISTERS + reg);
     for (std::size_t  i = 0; i < numFibersPerReg; ++i) {
       // FIXME: Proper name for magic number please
       constexpr static auto BYTE_MASK = unsigned{0xf};
@@ -55,4 +75,24 @@ nsw::mon::is::MmtpInRunStatusRegisters nsw::mon::MmtpInRunStatusRegisters::getDa
   }
 
   return is;
-}  
+}
+
+std::vector<nsw::mon::Metric> nsw::mon::MmtpInRunStatusRegisters::getMetrics(
+  const nsw::mon::is::MmtpInRunStatusRegisters& values)
+{
+  // One bit per fiber to follow flapping fibers
+  const auto toMask = [](const auto& flags) {
+    std::uint64_t mask{0};
+    for (std::size_t fiber = 0; fiber < std::size(flags); ++fiber) {
+      if (flags[fiber]) {
+        mask |= (std::uint64_t{1} << fiber);
+      }
+    }
+    return static_cast<double>(mask);
+  };
+  return {{"nArtFibersAligned", static_cast<double>(values.nArtFibersAligned)},
+          {"artFibersAlignment", toMask(values.artFibersAlignment)},
+          {"nArtFibersBcidGood", static_cast<double>(values.nArtFibersBcidGood)},
+          {"artFibersBcidGood", toMask(values.artFibersBcidGood)},
+          {"idleState", static_cast<double>(values.idleState)}};
+}
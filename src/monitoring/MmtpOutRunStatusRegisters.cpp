@@ -7,15 +7,17 @@ nsw::mon::MmtpOutRunStatusRegisters::MmtpOutRunStatusRegisters(
   m_devices{deviceManager.getMMTps()}, m_helper{NUM_CONCURRENT}
 {}
 
-void nsw::mon::MmtpOutRunStatusRegisters::monitor(ISInfoDictionary* isDict,
-                                                  const std::string_view serverName)
+void nsw::mon::MmtpOutRunStatusRegisters::monitor(ISPublisher& publisher,
+                                                  const std::string_view serverName,
+                                                  const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.get(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::MmtpOutRunStatusRegisters::getData);
+                             nsw::mon::MmtpOutRunStatusRegisters::getData,
+                             shard);
 }
 
 nsw::mon::is::MmtpOutRunStatusRegisters nsw::mon::MmtpOutRunStatusRegisters::getData(
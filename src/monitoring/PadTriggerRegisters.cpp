@@ -1,22 +1,29 @@
 #include "NSWConfiguration/monitoring/PadTriggerRegisters.h"
 #include <ers/ers.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 nsw::mon::PadTriggerRegisters::PadTriggerRegisters(
-  const nsw::hw::DeviceManager& deviceManager) :
+  const nsw::hw::DeviceManager& deviceManager, History& history) :
   m_devices{deviceManager},
-  m_helper{NUM_CONCURRENT}
+  m_helper{NUM_CONCURRENT, &history}
 {
 }
 
-void nsw::mon::PadTriggerRegisters::monitor(ISInfoDictionary* isDict,
-                                            const std::string_view serverName)
+void nsw::mon::PadTriggerRegisters::monitor(ISPublisher& publisher,
+                                            const std::string_view serverName,
+                                            const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.getPadTriggers(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::PadTriggerRegisters::getData);
+                             nsw::mon::PadTriggerRegisters::getData,
+                             shard,
+                             nsw::mon::PadTriggerRegisters::getMetrics);
 }
 
 nsw::mon::is::PadTriggerRegisters
@@ -37,20 +44,34 @@ nsw::mon::PadTriggerRegisters::getData(const nsw::hw::PadTrigger& dev)
     }
     return vec;
   };
-  is.conf_bcid_offset   = dev.readSubRegister("000_control_reg", "conf_bcid_offset");
-  is.conf_ro_bc_offset  = dev.readSubRegister("000_control_reg", "conf_ro_bc_offset");
-  is.trigger_rate       = dev.readSubRegister("00B_trigger_rate_READONLY", "trigger_rate");
+  // All sub-registers are read with one request, registers with several sub-registers once
+  const static auto subRegisters = std::vector<std::pair<std::string, std::string>>{
+    {"000_control_reg", "conf_bcid_offset"},
+    {"000_control_reg", "conf_ro_bc_offset"},
+    {"00B_trigger_rate_READONLY", "trigger_rate"},
+    {"012_pad_bcid_error_READONLY", "pad_bcid_error"},
+    {"012_pad_bcid_error_READONLY", "pad_bcid_error_dif"},
+    {"013_pt_2_tp_lat_READONLY", "pt_2_tp_lat"},
+    {"014_tp_bcid_error_READONLY", "tp_bcid_error"},
+    {"014_tp_bcid_error_READONLY", "tp_bcid_error_dif"},
+    {"015_ttc_mon_0_READONLY", "ttc_bcr_ocr_rate"},
+    {"019_ttc_mon_1_READONLY", "ttc_l1a_rate"},
+  };
+  const auto values = dev.readSubRegisters(subRegisters);
+  is.conf_bcid_offset   = values.at(0);
+  is.conf_ro_bc_offset  = values.at(1);
+  is.trigger_rate       = values.at(2);
   is.xadc_temp          = dev.readFPGATemperature();
   is.pfeb_delays        = dev.readPFEBDelays();
   is.pfeb_bcids         = dev.readPFEBBCIDs();
   is.pfeb_status        = dev.readPFEBBcidErrorReadout();
   is.pfeb_statuses      = statusToVector(is.pfeb_status);
   is.pfeb_bcid_error    = dev.readPFEBBcidErrorTrigger();
-  is.pad_bcid_error     = dev.readSubRegister("012_pad_bcid_error_READONLY", "pad_bcid_error");
-  is.pad_bcid_error_dif = dev.readSubRegister("012_pad_bcid_error_READONLY", "pad_bcid_error_dif");
-  is.pt_2_tp_lat        = dev.readSubRegister("013_pt_2_tp_lat_READONLY", "pt_2_tp_lat");
-  is.tp_bcid_error      = dev.readSubRegister("014_tp_bcid_error_READONLY", "tp_bcid_error");
-  is.tp_bcid_error_dif  = dev.readSubRegister("014_tp_bcid_error_READONLY", "tp_bcid_error_dif");
+  is.pad_bcid_error     = values.at(3);
+  is.pad_bcid_error_dif = values.at(4);
+  is.pt_2_tp_lat        = values.at(5);
+  is.tp_bcid_error      = values.at(6);
+  is.tp_bcid_error_dif  = values.at(7);
   is.trig_bcid_select   = dev.TrigBcidSelect();
   is.trig_bcid_rate_m3  = dev.readBcidTriggerRate(is.trig_bcid_select - 3);
   is.trig_bcid_rate_m2  = dev.readBcidTriggerRate(is.trig_bcid_select - 2);
@@ -59,8 +80,25 @@ nsw::mon::PadTriggerRegisters::getData(const nsw::hw::PadTrigger& dev)
   is.trig_bcid_rate_p1  = dev.readBcidTriggerRate(is.trig_bcid_select + 1);
   is.trig_bcid_rate_p2  = dev.readBcidTriggerRate(is.trig_bcid_select + 2);
   is.trig_bcid_rate_p3  = dev.readBcidTriggerRate(is.trig_bcid_select + 3);
-  is.ttc_bcr_ocr_rate   = dev.readSubRegister("015_ttc_mon_0_READONLY", "ttc_bcr_ocr_rate");
-  is.ttc_l1a_rate       = dev.readSubRegister("019_ttc_mon_1_READONLY", "ttc_l1a_rate");
+  is.ttc_bcr_ocr_rate   = values.at(8);
+  is.ttc_l1a_rate       = values.at(9);
   is.gt_rx_lol          = dev.readGtRxLol();
   return is;
 }
+
+std::vector<nsw::mon::Metric> nsw::mon::PadTriggerRegisters::getMetrics(
+  const nsw::mon::is::PadTriggerRegisters& values)
+{
+  std::vector<Metric> metrics{{"reachable_fpga", static_cast<double>(values.reachable_fpga)}};
+  if (not values.reachable_fpga) {
+    return metrics;
+  }
+  metrics.insert(std::end(metrics),
+                 {{"pad_bcid_error", static_cast<double>(values.pad_bcid_error)},
+                  {"pad_bcid_error_dif", static_cast<double>(values.pad_bcid_error_dif)},
+                  {"tp_bcid_error", static_cast<double>(values.tp_bcid_error)},
+                  {"tp_bcid_error_dif", static_cast<double>(values.tp_bcid_error_dif)},
+                  {"pfeb_bcid_error", static_cast<double>(values.pfeb_bcid_error)},
+                  {"trigger_rate", static_cast<double>(values.trigger_rate)}});
+  return metrics;
+}
@@ -7,15 +7,17 @@ nsw::mon::RocConfigurationRegisters::RocConfigurationRegisters(
   m_devices{deviceManager.getFebs()}, m_helper{NUM_CONCURRENT}
 {}
 
-void nsw::mon::RocConfigurationRegisters::monitor(ISInfoDictionary* isDict,
-                                                  const std::string_view serverName)
+void nsw::mon::RocConfigurationRegisters::monitor(ISPublisher& publisher,
+                                                  const std::string_view serverName,
+                                                  const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.get(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::RocConfigurationRegisters::getData);
+                             nsw::mon::RocConfigurationRegisters::getData,
+                             shard);
 }
 
 nsw::mon::is::RocConfiguration nsw::mon::RocConfigurationRegisters::getData(const nsw::hw::FEB& feb)
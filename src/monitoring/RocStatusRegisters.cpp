@@ -1,46 +1,80 @@
 #include "NSWConfiguration/monitoring/RocStatusRegisters.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include "NSWConfiguration/monitoring/Helper.h"
 
-nsw::mon::RocStatusRegisters::RocStatusRegisters(const nsw::hw::DeviceManager& deviceManager) :
-  m_devices{deviceManager.getFebs()}, m_helper{NUM_CONCURRENT}
+nsw::mon::RocStatusRegisters::RocStatusRegisters(const nsw::hw::DeviceManager& deviceManager,
+                                                 History& history) :
+  m_devices{deviceManager.getFebs()}, m_helper{NUM_CONCURRENT, &history}
 {}
 
-void nsw::mon::RocStatusRegisters::monitor(ISInfoDictionary* isDict,
-                                           const std::string_view serverName)
+void nsw::mon::RocStatusRegisters::monitor(ISPublisher& publisher,
+                                           const std::string_view serverName,
+                                           const Shard shard)
 {
-  m_helper.monitorAndPublish(
-    m_devices.get(), isDict, m_threadPool, serverName, NAME, nsw::mon::RocStatusRegisters::getData);
+  m_helper.monitorAndPublish(m_devices.get(),
+                             publisher,
+                             m_threadPool,
+                             serverName,
+                             NAME,
+                             nsw::mon::RocStatusRegisters::getData,
+                             shard,
+                             nsw::mon::RocStatusRegisters::getMetrics);
 }
 
 nsw::mon::is::RocStatus nsw::mon::RocStatusRegisters::getData(const nsw::hw::FEB& feb)
 {
+  // Status registers 32 to 53 are read with one request
+  constexpr std::uint8_t FIRST_REGISTER{32};
+  constexpr std::uint8_t LAST_REGISTER{53};
+  std::array<std::uint8_t, LAST_REGISTER - FIRST_REGISTER + 1> regAddresses{};
+  std::iota(std::begin(regAddresses), std::end(regAddresses), FIRST_REGISTER);
+  const auto registers = feb.getRoc().readRegisters(regAddresses);
+  const auto readRange = [&registers](const std::uint8_t first, const std::uint8_t last) {
+    std::vector<std::uint8_t> result{};
+    for (auto regAddress = first; regAddress <= last; ++regAddress) {
+      result.push_back(registers.at(regAddress));
+    }
+    return result;
+  };
+  const auto ePllLocks = feb.getRoc().readValues(std::array<std::string, 4>{
+    "ePllVmm0.ePllInstantLock",
+    "ePllVmm1.ePllInstantLock",
+    "ePllTdc.ePllInstantLock",
+    "ePllCore.ePllInstantLock"});
+
   auto isObject = nsw::mon::is::RocStatus{};
-  isObject.captureStatusVmm = std::vector{feb.getRoc().readRegister(32),
-                                          feb.getRoc().readRegister(33),
-                                          feb.getRoc().readRegister(34),
-                                          feb.getRoc().readRegister(35),
-                                          feb.getRoc().readRegister(36),
-                                          feb.getRoc().readRegister(37),
-                                          feb.getRoc().readRegister(38),
-                                          feb.getRoc().readRegister(39)};
-  isObject.parityCounterVmm = std::vector{feb.getRoc().readRegister(45),
-                                          feb.getRoc().readRegister(46),
-                                          feb.getRoc().readRegister(47),
-                                          feb.getRoc().readRegister(48),
-                                          feb.getRoc().readRegister(49),
-                                          feb.getRoc().readRegister(50),
-                                          feb.getRoc().readRegister(51),
-                                          feb.getRoc().readRegister(52)};
-  isObject.statusSroc = std::vector{feb.getRoc().readRegister(40),
-                                    feb.getRoc().readRegister(41),
-                                    feb.getRoc().readRegister(42),
-                                    feb.getRoc().readRegister(43)};
-  isObject.seu = feb.getRoc().readRegister(44);
-  isObject.seuCounter = feb.getRoc().readRegister(53);
-  isObject.ePllVmm0_ePllInstantLock = static_cast<bool>(feb.getRoc().readValue("ePllVmm0.ePllInstantLock"));
-  isObject.ePllVmm1_ePllInstantLock = static_cast<bool>(feb.getRoc().readValue("ePllVmm1.ePllInstantLock"));
-  isObject.ePllTdc_ePllInstantLock = static_cast<bool>(feb.getRoc().readValue("ePllTdc.ePllInstantLock"));
-  isObject.ePllCore_ePllInstantLock = static_cast<bool>(feb.getRoc().readValue("ePllCore.ePllInstantLock"));
+  isObject.captureStatusVmm = readRange(32, 39);
+  isObject.parityCounterVmm = readRange(45, 52);
+  isObject.statusSroc = readRange(40, 43);
+  isObject.seu = registers.at(44);
+  isObject.seuCounter = registers.at(53);
+  isObject.ePllVmm0_ePllInstantLock = static_cast<bool>(ePllLocks.at("ePllVmm0.ePllInstantLock"));
+  isObject.ePllVmm1_ePllInstantLock = static_cast<bool>(ePllLocks.at("ePllVmm1.ePllInstantLock"));
+  isObject.ePllTdc_ePllInstantLock = static_cast<bool>(ePllLocks.at("ePllTdc.ePllInstantLock"));
+  isObject.ePllCore_ePllInstantLock = static_cast<bool>(ePllLocks.at("ePllCore.ePllInstantLock"));
   return isObject;
 }
+
+std::vector<nsw::mon::Metric> nsw::mon::RocStatusRegisters::getMetrics(const nsw::mon::is::RocStatus& values)
+{
+  constexpr static std::array<std::string_view, 8> PARITY_COUNTERS{"parityCounterVmm0",
+                                                                   "parityCounterVmm1",
+                                                                   "parityCounterVmm2",
+                                                                   "parityCounterVmm3",
+                                                                   "parityCounterVmm4",
+                                                                   "parityCounterVmm5",
+                                                                   "parityCounterVmm6",
+                                                                   "parityCounterVmm7"};
+  std::vector<Metric> metrics{{"seu", static_cast<double>(values.seu)},
+                              {"seuCounter", static_cast<double>(values.seuCounter)}};
+  for (std::size_t vmm = 0; vmm < std::min(std::size(values.parityCounterVmm), std::size(PARITY_COUNTERS)); ++vmm) {
+    metrics.push_back({PARITY_COUNTERS.at(vmm), static_cast<double>(values.parityCounterVmm.at(vmm))});
+  }
+  return metrics;
+}
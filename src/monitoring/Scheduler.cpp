@@ -0,0 +1,236 @@
+#include "NSWConfiguration/monitoring/Scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <utility>
+
+#include <ers/ers.h>
+
+std::vector<std::size_t> nsw::mon::internal::computeNumShards(
+  const std::span<const std::chrono::milliseconds> sweepCosts,
+  const std::span<const std::chrono::milliseconds> periods,
+  const std::size_t numWorkers,
+  const double maxUtilization,
+  const std::size_t maxShards)
+{
+  const auto numGroups = std::min(std::size(sweepCosts), std::size(periods));
+  const auto limit = std::max(maxShards, std::size_t{1});
+  // Fraction of one worker used by a full sweep of a group every period
+  std::vector<double> utilizations(numGroups);
+  std::ranges::transform(sweepCosts.first(numGroups),
+                         periods.first(numGroups),
+                         std::begin(utilizations),
+                         [](const auto cost, const auto period) {
+                           return static_cast<double>(cost.count()) /
+                                  static_cast<double>(std::max(period.count(), std::int64_t{1}));
+                         });
+
+  // One cycle has to fit into one period
+  std::vector<std::size_t> numShards(numGroups);
+  std::ranges::transform(utilizations, std::begin(numShards), [limit, maxUtilization](const auto utilization) {
+    const auto minShards = std::ceil(utilization / maxUtilization);
+    return std::clamp(static_cast<std::size_t>(std::max(minShards, 1.)), std::size_t{1}, limit);
+  });
+
+  // All cycles have to fit into the time of the workers
+  const auto load = [&utilizations, &numShards](const std::size_t group) {
+    return utilizations[group] / static_cast<double>(numShards[group]);
+  };
+  const auto capacity = maxUtilization * static_cast<double>(std::max(numWorkers, std::size_t{1}));
+  auto totalLoad = 0.;
+  for (std::size_t group = 0; group < numGroups; ++group) {
+    totalLoad += load(group);
+  }
+  while (totalLoad > capacity) {
+    std::optional<std::size_t> heaviest{};
+    for (std::size_t group = 0; group < numGroups; ++group) {
+      if (numShards[group] < limit and (not heaviest or load(group) > load(*heaviest))) {
+        heaviest = group;
+      }
+    }
+    if (not heaviest) {
+      break;
+    }
+    totalLoad -= load(*heaviest);
+    ++numShards[*heaviest];
+    totalLoad += load(*heaviest);
+  }
+  return numShards;
+}
+
+nsw::mon::SchedulerClock::Clock::time_point nsw::mon::SchedulerClock::now() const
+{
+  return Clock::now();
+}
+
+void nsw::mon::SchedulerClock::waitUntil(std::unique_lock<std::mutex>& lock,
+                                         std::condition_variable_any& condition,
+                                         const std::stop_token stopToken,
+                                         const Clock::time_point time,
+                                         const std::function<bool()>& finished)
+{
+  if (time == Clock::time_point::max()) {
+    condition.wait(lock, stopToken, finished);
+  } else {
+    condition.wait_until(lock, stopToken, time, finished);
+  }
+}
+
+nsw::mon::Scheduler::Scheduler(const std::span<const Config> configs,
+                               const std::size_t numWorkers,
+                               Job job,
+                               Reporter reporter,
+                               const std::chrono::milliseconds minimumDelay,
+                               std::shared_ptr<SchedulerClock> clock) :
+  m_job{std::move(job)},
+  m_reporter{std::move(reporter)},
+  m_minimumDelay{minimumDelay},
+  m_clock{clock != nullptr ? std::move(clock) : std::make_shared<SchedulerClock>()},
+  m_numWorkers{std::max(numWorkers, std::size_t{1})}
+{
+  const auto now = m_clock->now();
+  m_groups.reserve(std::size(configs));
+  for (const auto& config : configs) {
+    auto& group = m_groups.emplace_back(Group{.m_config = config, .m_release = now});
+    group.m_statistics.m_name = config.m_name;
+    group.m_statistics.m_period = config.m_frequency;
+  }
+  m_workers.reserve(m_numWorkers);
+  for (std::size_t index = 0; index < m_numWorkers; ++index) {
+    m_workers.emplace_back([this](const std::stop_token stopToken) { run(stopToken); });
+  }
+}
+
+nsw::mon::Scheduler::~Scheduler()
+{
+  stop();
+}
+
+void nsw::mon::Scheduler::stop()
+{
+  for (auto& worker : m_workers) {
+    worker.request_stop();
+  }
+  for (auto& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+std::vector<nsw::mon::GroupStatistics> nsw::mon::Scheduler::getStatistics() const
+{
+  std::scoped_lock lock(m_mutex);
+  std::vector<GroupStatistics> statistics{};
+  statistics.reserve(std::size(m_groups));
+  std::ranges::transform(
+    m_groups, std::back_inserter(statistics), [](const auto& group) { return group.m_statistics; });
+  return statistics;
+}
+
+void nsw::mon::Scheduler::run(const std::stop_token stopToken)
+{
+  std::unique_lock lock(m_mutex);
+  while (not stopToken.stop_requested()) {
+    // Earliest deadline first among the released groups which are not running
+    const auto now = m_clock->now();
+    Group* next{nullptr};
+    auto wakeUp = Clock::time_point::max();
+    for (auto& group : m_groups) {
+      if (group.m_running) {
+        continue;
+      }
+      if (group.m_release <= now) {
+        if (next == nullptr or group.m_release + group.m_config.m_frequency <
+                                 next->m_release + next->m_config.m_frequency) {
+          next = &group;
+        }
+      } else {
+        wakeUp = std::min(wakeUp, group.m_release);
+      }
+    }
+
+    if (next == nullptr) {
+      const auto numFinished = m_numFinished;
+      m_clock->waitUntil(
+        lock, m_condition, stopToken, wakeUp, [this, numFinished]() { return m_numFinished != numFinished; });
+      continue;
+    }
+
+    next->m_running = true;
+    const auto shard = Shard{next->m_shardIndex, next->m_statistics.m_numShards};
+    // Groups are never added or removed, the reference stays valid
+    const auto& name = next->m_config.m_name;
+    lock.unlock();
+    const auto start = m_clock->now();
+    try {
+      m_job(name, shard);
+    } catch (const std::exception& ex) {
+      ERS_LOG("Monitoring of " << name << " failed due to " << ex.what());
+    }
+    const auto end = m_clock->now();
+    lock.lock();
+    finishCycle(*next, start, end);
+    const auto statistics = next->m_statistics;
+    ++m_numFinished;
+    m_condition.notify_all();
+    if (m_reporter) {
+      lock.unlock();
+      m_reporter(statistics);
+      lock.lock();
+    }
+  }
+}
+
+void nsw::mon::Scheduler::finishCycle(Group& group, const Clock::time_point start, const Clock::time_point end)
+{
+  auto& statistics = group.m_statistics;
+  const auto duration = std::chrono::duration<double>{end - start};
+  const auto sweepCost = duration * static_cast<double>(statistics.m_numShards);
+  group.m_sweepCost =
+    group.m_hasCost ? COST_SMOOTHING * sweepCost + (1. - COST_SMOOTHING) * group.m_sweepCost : sweepCost;
+  group.m_hasCost = true;
+
+  const auto deadline = group.m_release + group.m_config.m_frequency;
+  if (end > deadline) {
+    ++statistics.m_numMissedDeadlines;
+  }
+  ++statistics.m_numCycles;
+  statistics.m_lastDuration = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+  statistics.m_sweepCost = std::chrono::duration_cast<std::chrono::milliseconds>(group.m_sweepCost);
+
+  plan();
+  group.m_shardIndex = (group.m_shardIndex + 1) % statistics.m_numShards;
+  if (group.m_shardIndex == 0) {
+    if (group.m_lastSweepEnd != Clock::time_point{}) {
+      statistics.m_achievedRate = 1. / std::chrono::duration<double>{end - group.m_lastSweepEnd}.count();
+    }
+    group.m_lastSweepEnd = end;
+    // Only change the sharding between two sweeps so that every device is monitored once per sweep
+    statistics.m_numShards = group.m_plannedShards;
+  }
+
+  // Late groups skip the missed periods instead of catching up
+  group.m_release = std::max(deadline, end + m_minimumDelay);
+  group.m_running = false;
+}
+
+void nsw::mon::Scheduler::plan()
+{
+  std::vector<std::chrono::milliseconds> sweepCosts{};
+  std::vector<std::chrono::milliseconds> periods{};
+  sweepCosts.reserve(std::size(m_groups));
+  periods.reserve(std::size(m_groups));
+  for (const auto& group : m_groups) {
+    sweepCosts.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(group.m_sweepCost));
+    periods.push_back(group.m_config.m_frequency);
+  }
+  const auto numShards = internal::computeNumShards(sweepCosts, periods, m_numWorkers, MAX_UTILIZATION, MAX_SHARDS);
+  for (std::size_t index = 0; index < std::size(m_groups); ++index) {
+    m_groups[index].m_plannedShards = numShards[index];
+  }
+}
@@ -7,15 +7,17 @@ nsw::mon::StgctpOutRunStatusRegisters::StgctpOutRunStatusRegisters(
   m_devices{deviceManager.getSTGCTps()}, m_helper{NUM_CONCURRENT}
 {}
 
-void nsw::mon::StgctpOutRunStatusRegisters::monitor(ISInfoDictionary* isDict,
-                                                  const std::string_view serverName)
+void nsw::mon::StgctpOutRunStatusRegisters::monitor(ISPublisher& publisher,
+                                                  const std::string_view serverName,
+                                                  const Shard shard)
 {
   m_helper.monitorAndPublish(m_devices.get(),
-                             isDict,
+                             publisher,
                              m_threadPool,
                              serverName,
                              NAME,
-                             nsw::mon::StgctpOutRunStatusRegisters::getData);
+                             nsw::mon::StgctpOutRunStatusRegisters::getData,
+                             shard);
 }
 
 nsw::mon::is::StgctpOutRunStatusRegisters nsw::mon::StgctpOutRunStatusRegisters::getData(
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE BitVector_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "NSWConfiguration/BitVector.h"
+#include "NSWConfiguration/Utility.h"
+
+BOOST_AUTO_TEST_CASE(FromString_ValidString_RoundTrips)
+{
+  const auto bits = nsw::BitVector::fromString("1100100111");
+  BOOST_TEST(bits.size() == 10);
+  BOOST_TEST(bits.toString() == "1100100111");
+  BOOST_TEST(bits.test(0));
+  BOOST_TEST(not bits.test(2));
+}
+
+BOOST_AUTO_TEST_CASE(FromString_InvalidCharacter_Throws)
+{
+  BOOST_CHECK_THROW(static_cast<void>(nsw::BitVector::fromString("0102")), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Bytes_BytePaddedBitstream_MatchesStringToByteVector)
+{
+  const std::string bitstring{"0100000101000010010000110100010011000011"};
+  const auto bits = nsw::BitVector::fromString(bitstring);
+  const auto bytes = bits.bytes();
+  BOOST_TEST(std::vector(std::begin(bytes), std::end(bytes)) == nsw::stringToByteVector(bitstring));
+  BOOST_TEST(bits.toHexString() == "41424344c3");
+}
+
+BOOST_AUTO_TEST_CASE(Append_Fields_PacksMsbFirst)
+{
+  nsw::BitVector bits;
+  bits.append(0b101, 3);
+  bits.append(0x1ff, 9);
+  bits.append(0, 4);
+  BOOST_TEST(bits.toString() == "1011111111110000");
+  BOOST_TEST(bits.extract(1, 5) == 0b01111);
+}
+
+BOOST_AUTO_TEST_CASE(Append_BitVectorAtUnalignedPosition_KeepsAllBits)
+{
+  auto bits = nsw::BitVector::fromString("101");
+  bits.append(nsw::BitVector::fromString("0011010111001"));
+  BOOST_TEST(bits.toString() == "1010011010111001");
+}
+
+BOOST_AUTO_TEST_CASE(Insert_FieldAcrossBytes_OnlyChangesField)
+{
+  nsw::BitVector bits(24);
+  bits.insert(0, 24, 0xffffff);
+  bits.insert(6, 10, 0);
+  BOOST_TEST(bits.toString() == "111111000000000011111111");
+  bits.insert(6, 10, 0b1000000001);
+  BOOST_TEST(bits.extract(6, 10) == 0b1000000001);
+  BOOST_TEST(bits.extract(0, 6) == 0b111111);
+  BOOST_TEST(bits.extract(16, 8) == 0xff);
+}
+
+BOOST_AUTO_TEST_CASE(Insert_ValueWiderThanField_IgnoresHighBits)
+{
+  nsw::BitVector bits(8);
+  bits.insert(2, 4, 0xff);
+  BOOST_TEST(bits.toString() == "00111100");
+}
+
+BOOST_AUTO_TEST_CASE(Extract_64BitField_ReturnsValue)
+{
+  nsw::BitVector bits;
+  bits.append(0b1, 1);
+  bits.append(0xdeadbeefcafed00d, 64);
+  BOOST_TEST(bits.extract(1, 64) == 0xdeadbeefcafed00d);
+}
+
+BOOST_AUTO_TEST_CASE(Extract_OutOfRange_Throws)
+{
+  const nsw::BitVector bits(16);
+  BOOST_CHECK_THROW(static_cast<void>(bits.extract(10, 7)), std::out_of_range);
+  BOOST_CHECK_THROW(static_cast<void>(bits.test(16)), std::out_of_range);
+  BOOST_CHECK_THROW(static_cast<void>(nsw::BitVector(100).toInteger()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(ReverseBits_Value_MatchesReversedBitString)
+{
+  BOOST_TEST(nsw::BitVector::reverseBits(3, 10) == 0b1100000000);
+  BOOST_TEST(nsw::BitVector::reverseBits(0b10101011, 8) == 0b11010101);
+  nsw::BitVector bits;
+  bits.append(nsw::BitVector::reverseBits(0x41414141, 32), 32);
+  BOOST_TEST(bits.toString() == nsw::reversedBitString(0x41414141, 32));
+}
+
+BOOST_AUTO_TEST_CASE(Equality_SameBits_AreEqual)
+{
+  auto bits = nsw::BitVector::fromString("0110");
+  BOOST_TEST((bits == nsw::BitVector::fromString("0110")));
+  bits.set(0, true);
+  BOOST_TEST((bits == nsw::BitVector::fromString("1110")));
+  BOOST_TEST(not(bits == nsw::BitVector::fromString("11100")));
+}
@@ -0,0 +1,205 @@
+#define BOOST_TEST_MODULE ConfigImageCache_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "NSWConfiguration/ConfigImageCache.h"
+#include "NSWConfiguration/I2cMasterConfig.h"
+
+using boost::property_tree::ptree;
+
+namespace {
+  const i2c::AddressRegisterMap REGISTERS = {
+    {"address0", {{"reg0", 4}, {"reg1", 4}}},
+    {"address1", {{"reg0", 8}}},
+  };
+
+  ptree makeConfig(const unsigned int value)
+  {
+    ptree config;
+    config.put("address0.reg0", 1);
+    config.put("address0.reg1", 2);
+    config.put("address1.reg0", value);
+    return config;
+  }
+
+  std::string getFilename()
+  {
+    return (std::filesystem::temp_directory_path() / "test_configimagecache.json").string();
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(BuildConfigImageKey_ReorderedChildren_SameKey)
+{
+  ptree first;
+  first.put("a", 1);
+  first.put("b", 2);
+  ptree second;
+  second.put("b", 2);
+  second.put("a", 1);
+  BOOST_TEST(nsw::buildConfigImageKey("domain", first) == nsw::buildConfigImageKey("domain", second));
+  BOOST_TEST(nsw::buildConfigImageKey("domain", first) != nsw::buildConfigImageKey("other", first));
+}
+
+BOOST_AUTO_TEST_CASE(BuildConfigImageKey_ReorderedArray_DifferentKey)
+{
+  const auto makeArray = [](const int firstValue, const int secondValue) {
+    ptree first;
+    first.put("", firstValue);
+    ptree second;
+    second.put("", secondValue);
+    ptree array;
+    array.push_back({"", first});
+    array.push_back({"", second});
+    ptree config;
+    config.add_child("channel", array);
+    return config;
+  };
+  BOOST_TEST(nsw::buildConfigImageKey("domain", makeArray(1, 2)) !=
+             nsw::buildConfigImageKey("domain", makeArray(2, 1)));
+}
+
+BOOST_AUTO_TEST_CASE(BuildConfigImageKey_LargeConfig_FixedSizeKey)
+{
+  ptree config;
+  for (int index = 0; index < 1000; ++index) {
+    config.put("register" + std::to_string(index), index);
+  }
+  const auto key = nsw::buildConfigImageKey("domain", config);
+  BOOST_TEST(key.starts_with("domain:"));
+  BOOST_TEST(std::size(key) == std::size("domain:") - 1 + 32);
+  BOOST_TEST(key == nsw::buildConfigImageKey("domain", nsw::ConfigOverlay{config}));
+
+  config.put("register999", 0);
+  BOOST_TEST(key != nsw::buildConfigImageKey("domain", config));
+}
+
+BOOST_AUTO_TEST_CASE(I2cMasterConfig_IdenticalConfigs_ShareImage)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  const nsw::I2cMasterConfig first(makeConfig(3), "first", REGISTERS);
+  const nsw::I2cMasterConfig second(makeConfig(3), "second", REGISTERS);
+  const nsw::I2cMasterConfig third(makeConfig(4), "third", REGISTERS);
+  BOOST_TEST(&first.getBitstreamMap() == &second.getBitstreamMap());
+  BOOST_TEST(&first.getBitstreamMap() != &third.getBitstreamMap());
+
+  const auto statistics = nsw::I2cImageCache::getInstance().getStatistics();
+  BOOST_TEST(statistics.m_entries == 2);
+  BOOST_TEST(statistics.m_hits == 1);
+  BOOST_TEST(statistics.m_misses == 2);
+}
+
+BOOST_AUTO_TEST_CASE(I2cMasterConfig_SetRegisterValue_DoesNotChangeSharedImage)
+{
+  const nsw::I2cMasterConfig unchanged(makeConfig(3), "unchanged", REGISTERS);
+  nsw::I2cMasterConfig changed(makeConfig(3), "changed", REGISTERS);
+  changed.setRegisterValue("address1", "reg0", 5);
+  BOOST_TEST(changed.getRegisterValue("address1", "reg0") == 5);
+  BOOST_TEST(unchanged.getRegisterValue("address1", "reg0") == 3);
+  BOOST_TEST(nsw::I2cMasterConfig(makeConfig(3), "new", REGISTERS).getRegisterValue("address1", "reg0") == 3);
+}
+
+BOOST_AUTO_TEST_CASE(SaveConfigImageCaches_Load_RestoresImages)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  const nsw::I2cMasterConfig config(makeConfig(7), "config", REGISTERS);
+  const auto filename = getFilename();
+  nsw::saveConfigImageCaches(filename);
+
+  nsw::I2cImageCache::getInstance().clear();
+  BOOST_TEST(nsw::loadConfigImageCaches(filename) == 1);
+  std::remove(filename.c_str());
+
+  const nsw::I2cMasterConfig loaded(makeConfig(7), "loaded", REGISTERS);
+  BOOST_TEST(nsw::I2cImageCache::getInstance().getStatistics().m_hits == 1);
+  BOOST_TEST(loaded.getBitstreamMap() == config.getBitstreamMap());
+}
+
+BOOST_AUTO_TEST_CASE(LoadConfigImageCaches_CorruptFile_IgnoredWithoutThrowing)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  const auto filename = getFilename();
+  std::ofstream(filename) << "{\"version\": 1, \"i2c\": [";
+  std::size_t numImages{1};
+  BOOST_CHECK_NO_THROW(numImages = nsw::loadConfigImageCaches(filename));
+  std::remove(filename.c_str());
+  BOOST_TEST(numImages == 0);
+}
+
+BOOST_AUTO_TEST_CASE(LoadConfigImageCaches_OtherVersion_Ignored)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  static_cast<void>(nsw::I2cMasterConfig(makeConfig(7), "config", REGISTERS));
+  const auto filename = getFilename();
+  nsw::saveConfigImageCaches(filename);
+
+  ptree tree;
+  boost::property_tree::read_json(filename, tree);
+  tree.put("version", nsw::CONFIG_IMAGE_FILE_VERSION + 1);
+  boost::property_tree::write_json(filename, tree);
+
+  nsw::I2cImageCache::getInstance().clear();
+  BOOST_TEST(nsw::loadConfigImageCaches(filename) == 0);
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(LoadConfigImageCaches_WidthMismatch_RejectedAndRebuilt)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  const nsw::I2cMasterConfig config(makeConfig(7), "config", REGISTERS);
+  const auto key = nsw::I2cImageCache::getInstance().getEntries().at(0).first;
+
+  // address1 holds 8 bits
+  ptree image;
+  image.push_back({"address0", ptree{"00010010"}});
+  image.push_back({"address1", ptree{"0111"}});
+  ptree entry;
+  entry.push_back({"key", ptree{key}});
+  entry.push_back({"image", image});
+  ptree entries;
+  entries.push_back({"", entry});
+  ptree tree;
+  tree.put("version", nsw::CONFIG_IMAGE_FILE_VERSION);
+  tree.push_back({"i2c", entries});
+  const auto filename = getFilename();
+  boost::property_tree::write_json(filename, tree);
+
+  nsw::I2cImageCache::getInstance().clear();
+  BOOST_TEST(nsw::loadConfigImageCaches(filename) == 1);
+  std::remove(filename.c_str());
+
+  const nsw::I2cMasterConfig loaded(makeConfig(7), "loaded", REGISTERS);
+  const auto statistics = nsw::I2cImageCache::getInstance().getStatistics();
+  BOOST_TEST(statistics.m_rejected == 1);
+  BOOST_TEST(statistics.m_misses == 1);
+  BOOST_TEST(loaded.getBitstreamMap() == config.getBitstreamMap());
+}
+
+BOOST_AUTO_TEST_CASE(ConfigImageCache_MaxEntriesReached_LeastRecentlyUsedEvicted)
+{
+  auto& cache = nsw::VmmImageCache::getInstance();
+  cache.clear();
+  const auto maxEntries = cache.getMaxEntries();
+  cache.setMaxEntries(2);
+  const auto build = []() { return nsw::BitVector(1); };
+  static_cast<void>(cache.getByKey("first", build));
+  static_cast<void>(cache.getByKey("second", build));
+  static_cast<void>(cache.getByKey("first", build));
+  static_cast<void>(cache.getByKey("third", build));
+
+  const auto entries = cache.getEntries();
+  BOOST_REQUIRE_EQUAL(std::size(entries), 2);
+  BOOST_TEST(entries.at(0).first == "third");
+  BOOST_TEST(entries.at(1).first == "first");
+  BOOST_TEST(cache.getStatistics().m_evictions == 1);
+  cache.setMaxEntries(maxEntries);
+  cache.clear();
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE ConfigOverlay_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "NSWConfiguration/ConfigImageCache.h"
+#include "NSWConfiguration/ConfigOverlay.h"
+#include "NSWConfiguration/I2cMasterConfig.h"
+
+using boost::property_tree::ptree;
+
+namespace {
+  const i2c::AddressRegisterMap REGISTERS = {
+    {"address0", {{"reg0", 4}, {"reg1", 4}}},
+    {"address1", {{"reg0", 8}}},
+  };
+
+  ptree makeCommon()
+  {
+    ptree config;
+    config.put("address0.reg0", 1);
+    config.put("address0.reg1", 2);
+    config.put("address1.reg0", 3);
+    return config;
+  }
+
+  ptree makeArray(const int first, const int second)
+  {
+    ptree firstValue;
+    firstValue.put("", first);
+    ptree secondValue;
+    secondValue.put("", second);
+    ptree array;
+    array.push_back({"", firstValue});
+    array.push_back({"", secondValue});
+    return array;
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ConfigLayers_Get_PrefersOverrides)
+{
+  const auto common = makeCommon();
+  ptree overrides;
+  overrides.put("address1.reg0", 7);
+  const nsw::ConfigLayers layers{common, &overrides};
+  BOOST_TEST(layers.get<int>("address0.reg0") == 1);
+  BOOST_TEST(layers.get<int>("address1.reg0") == 7);
+  BOOST_CHECK_THROW(static_cast<void>(layers.get<int>("address2.reg0")), boost::property_tree::ptree_bad_path);
+
+  const auto child = layers.getChildOptional("address1");
+  BOOST_REQUIRE(child.has_value());
+  BOOST_TEST(child->get<int>("reg0") == 7);
+  BOOST_TEST(not layers.getChildOptional("address2").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(ConfigLayers_GetNode_ReplacesArray)
+{
+  ptree common;
+  common.add_child("channel", makeArray(1, 2));
+  ptree overrides;
+  overrides.put("channel", 5);
+  const nsw::ConfigLayers layers{common, &overrides};
+  BOOST_TEST(layers.getNode("channel").empty());
+  BOOST_TEST(layers.getNode("channel").get_value<int>() == 5);
+  BOOST_TEST(layers.materialize().get<int>("channel") == 5);
+}
+
+BOOST_AUTO_TEST_CASE(ConfigLayers_Materialize_MatchesMerge)
+{
+  const auto common = makeCommon();
+  ptree overrides;
+  overrides.put("address0.reg1", 9);
+  const auto merged = nsw::ConfigLayers{common, &overrides}.materialize();
+  BOOST_TEST(merged.get<int>("address0.reg0") == 1);
+  BOOST_TEST(merged.get<int>("address0.reg1") == 9);
+  BOOST_TEST(merged.get<int>("address1.reg0") == 3);
+  BOOST_TEST(merged.get_child("address0").size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(I2cMasterConfig_SharedLayer_SameImageAsMergedConfig)
+{
+  nsw::I2cImageCache::getInstance().clear();
+  const auto common = nsw::makeSharedConfigLayer(makeCommon());
+  ptree overrides;
+  overrides.put("address1.reg0", 7);
+  const nsw::I2cMasterConfig layered(nsw::ConfigOverlay{common, overrides}, "layered", REGISTERS);
+  const nsw::I2cMasterConfig sameLayered(nsw::ConfigOverlay{common, overrides}, "same", REGISTERS);
+  auto merged = makeCommon();
+  merged.put("address1.reg0", 7);
+  const nsw::I2cMasterConfig full(merged, "full", REGISTERS);
+
+  BOOST_TEST(&layered.getBitstreamMap() == &sameLayered.getBitstreamMap());
+  BOOST_TEST(layered.getBitstreamMap() == full.getBitstreamMap());
+  BOOST_TEST(layered.getRegisterValue("address1", "reg0") == 7);
+  BOOST_TEST(layered.getRegisterValue("address0", "reg1") == 2);
+  BOOST_TEST(layered.getConfigLayers().get<int>("address1.reg0") == 7);
+  BOOST_TEST(layered.getConfigLayers().get<int>("address0.reg1") == 2);
+  BOOST_TEST(layered.getConfig().get<int>("address1.reg0") == 7);
+}
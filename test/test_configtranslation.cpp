@@ -181,3 +181,80 @@ BOOST_AUTO_TEST_CASE(translationFailuresDigital_ConfigConverterDigital_ThrowsErr
     BOOST_CHECK_EXCEPTION(nsw::ConfigConverter<nsw::ConfigConversionType::ROC_ANALOG>(registerTree, nsw::ConfigType::VALUE_BASED), std::runtime_error, [&checkFunc] (const auto& t_ex) {return checkFunc(t_ex, "Did not find all nodes in translation map");});
     BOOST_CHECK_EXCEPTION(nsw::ConfigConverter<nsw::ConfigConversionType::ROC_ANALOG>(registerTree, nsw::ConfigType::REGISTER_BASED), std::runtime_error, [&checkFunc] (const auto& t_ex) {return checkFunc(t_ex, "Did not find node reg000rocId.l1_first in translation map");});
 }
+
+
+BOOST_AUTO_TEST_CASE(translationIndexReadValues_ROCAnalogRegisters_MatchesConfigConverter) {
+    const auto valueTree = createDummyAnalog();
+    const auto converter = nsw::ConfigConverter<nsw::ConfigConversionType::ROC_ANALOG>(valueTree, nsw::ConfigType::VALUE_BASED);
+    const auto& index = nsw::ConfigTranslationIndex<nsw::ConfigConversionType::ROC_ANALOG>::getInstance();
+
+    // Encode all values into registers without a ptree
+    std::vector<std::uint32_t> registers(index.getNumRegisters());
+    std::vector<std::uint32_t> masks(index.getNumRegisters());
+    for (const auto& [name, value] : valueTree.get_child("ePllVmm0")) {
+        index.encodeValue(index.getValue("ePllVmm0." + name), value.get_value<std::uint32_t>(), registers, masks);
+    }
+    const auto flatTree = converter.getFlatRegisterBasedConfig(getReferenceConfig().getRocAnalog().getBitstreamMap());
+    for (const auto& [registerName, value] : flatTree) {
+        const auto reg = index.findRegister(registerName);
+        BOOST_REQUIRE(reg.has_value());
+        BOOST_CHECK_EQUAL(registers.at(*reg), value.get_value<std::uint32_t>() & masks.at(*reg));
+    }
+
+    // Read the values back from the registers
+    const std::vector<std::string> names{"ePllVmm0.ePllPhase160MHz_0", "ePllVmm0.ePllCap"};
+    std::size_t numRead{0};
+    const auto values = index.readValues(names, [&registers, &numRead] (const std::span<const std::size_t> regs) {
+        numRead += regs.size();
+        std::vector<std::uint32_t> contents{};
+        for (const auto reg : regs) {
+            contents.push_back(registers.at(reg));
+        }
+        return contents;
+    });
+    BOOST_CHECK_EQUAL(numRead, 3);
+    BOOST_CHECK_EQUAL(values.at("ePllVmm0.ePllPhase160MHz_0"), valueTree.get<unsigned int>("ePllVmm0.ePllPhase160MHz_0"));
+    BOOST_CHECK_EQUAL(values.at("ePllVmm0.ePllCap"), valueTree.get<unsigned int>("ePllVmm0.ePllCap"));
+    BOOST_CHECK_THROW(static_cast<void>(index.getValue("ePllVmm0.unknown")), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(translationIndexReadValues_TDSRegisters_DecodesUpperBits) {
+    ptree valueTree;
+    valueTree.put("BCID_Offset", 0x123);
+    valueTree.put("Chan003_Disable", 1);
+    valueTree.put("Chan100_Disable", 1);
+    valueTree.put("trig_lut7", 0x4321);
+    valueTree.put("Pad_Chan4f_Delay", 0x15);
+    const auto converter = nsw::ConfigConverter<nsw::ConfigConversionType::TDS>(valueTree, nsw::ConfigType::VALUE_BASED);
+    const auto registerTree = converter.getSubRegisterBasedConfig();
+    const auto& index = nsw::ConfigTranslationIndex<nsw::ConfigConversionType::TDS>::getInstance();
+
+    std::vector<__uint128_t> registers(index.getNumRegisters());
+    std::vector<__uint128_t> masks(index.getNumRegisters());
+    for (const auto& [name, value] : valueTree) {
+        index.encodeValue(index.getValue(name), value.get_value<unsigned int>(), registers, masks);
+    }
+    // Only the upper 64 bits of these registers are set
+    const auto register2 = registers.at(*index.findRegister("register2"));
+    BOOST_CHECK(static_cast<std::uint64_t>(register2 >> 64U) == (std::uint64_t{1} << 36U));
+    BOOST_CHECK(static_cast<std::uint64_t>(register2) == (std::uint64_t{1} << 3U));
+    BOOST_CHECK(static_cast<std::uint64_t>(registers.at(*index.findRegister("register3"))) == 0);
+    BOOST_CHECK(static_cast<std::uint64_t>(registers.at(*index.findRegister("register9"))) == 0);
+
+    std::vector<std::string> names{};
+    for (const auto& [name, value] : valueTree) {
+        names.push_back(name);
+    }
+    const auto values = index.readValues(names, [&registers] (const std::span<const std::size_t> regs) {
+        std::vector<__uint128_t> contents{};
+        for (const auto reg : regs) {
+            contents.push_back(registers.at(reg));
+        }
+        return contents;
+    });
+    for (const auto& name : names) {
+        BOOST_CHECK_EQUAL(values.at(name), valueTree.get<unsigned int>(name));
+    }
+    BOOST_CHECK_EQUAL(registerTree.get<unsigned int>("register2.Chan100"), 1);
+    BOOST_CHECK_EQUAL(registerTree.get<unsigned int>("register3.trig_lut7"), valueTree.get<unsigned int>("trig_lut7"));
+}
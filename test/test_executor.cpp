@@ -0,0 +1,237 @@
+#define BOOST_TEST_MODULE Executor_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NSWConfiguration/hw/Executor.h"
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(Submit_ValidJob_ReturnsResult)
+{
+  nsw::hw::Executor executor{2};
+  auto future = executor.submit([]() { return 42; });
+  BOOST_TEST(future.get() == 42);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_ThrowingJob_PropagatesException)
+{
+  nsw::hw::Executor executor{2};
+  auto future = executor.submit([]() -> int { throw std::runtime_error("failed"); });
+  BOOST_CHECK_THROW(future.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_ManyJobs_RunsAllJobs)
+{
+  constexpr std::size_t numJobs{1000};
+  nsw::hw::Executor executor{4};
+  std::atomic<std::size_t> counter{0};
+  std::vector<std::future<void>> futures{};
+  for (std::size_t job = 0; job < numJobs; ++job) {
+    futures.push_back(executor.submit([&counter]() { ++counter; }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  BOOST_TEST(counter == numJobs);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_MoreJobsThanThreads_RespectsThreadCount)
+{
+  constexpr std::size_t numThreads{3};
+  nsw::hw::Executor executor{numThreads};
+  std::atomic<std::size_t> running{0};
+  std::atomic<std::size_t> maxRunning{0};
+  std::vector<std::future<void>> futures{};
+  for (std::size_t job = 0; job < 4 * numThreads; ++job) {
+    futures.push_back(executor.submit([&running, &maxRunning]() {
+      const auto current = ++running;
+      auto previous = maxRunning.load();
+      while (previous < current and not maxRunning.compare_exchange_weak(previous, current)) {
+      }
+      std::this_thread::sleep_for(5ms);
+      --running;
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  BOOST_TEST(maxRunning <= numThreads);
+  BOOST_TEST(executor.getNumThreads() == numThreads);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_JobsFromWorker_AreStolenByIdleWorkers)
+{
+  constexpr std::size_t numThreads{4};
+  nsw::hw::Executor executor{numThreads};
+  std::mutex mutex{};
+  std::vector<std::thread::id> threadIds{};
+  auto outer = executor.submit([&executor, &mutex, &threadIds]() {
+    // All jobs are submitted to the queue of this worker
+    std::vector<std::future<void>> inner{};
+    for (std::size_t job = 0; job < 4 * numThreads; ++job) {
+      inner.push_back(executor.submit([&mutex, &threadIds]() {
+        std::this_thread::sleep_for(5ms);
+        std::lock_guard<std::mutex> lock(mutex);
+        threadIds.push_back(std::this_thread::get_id());
+      }));
+    }
+    return inner;
+  });
+  for (auto& future : outer.get()) {
+    future.get();
+  }
+  std::sort(std::begin(threadIds), std::end(threadIds));
+  const auto numUsedThreads =
+    std::distance(std::begin(threadIds), std::unique(std::begin(threadIds), std::end(threadIds)));
+  BOOST_TEST(numUsedThreads > 1);
+}
+
+BOOST_AUTO_TEST_CASE(Destructor_PendingJobs_FinishesAllJobs)
+{
+  std::atomic<std::size_t> counter{0};
+  {
+    nsw::hw::Executor executor{1};
+    for (std::size_t job = 0; job < 10; ++job) {
+      [[maybe_unused]] auto future = executor.submit([&counter]() {
+        std::this_thread::sleep_for(1ms);
+        ++counter;
+      });
+    }
+  }
+  BOOST_TEST(counter == 10);
+}
+
+BOOST_AUTO_TEST_CASE(TransformInOrder_JobsFinishInReverse_ConsumesInInputOrder)
+{
+  nsw::hw::Executor executor{4};
+  const std::vector<std::string> names{"a", "b", "c", "d", "e", "f"};
+  std::mutex mutex{};
+  std::vector<std::string> finished{};
+  std::vector<std::string> added{};
+  std::vector<std::string> errors{};
+  nsw::hw::transformInOrder(
+    executor,
+    names,
+    [&mutex, &finished, &names](const std::string& name) {
+      // Later inputs are ready first
+      std::this_thread::sleep_for(std::chrono::milliseconds{2 * (std::ssize(names) - (name.front() - 'a'))});
+      if (name == "b" or name == "e") {
+        throw std::runtime_error(name);
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.push_back(name);
+      return name + name;
+    },
+    [&added](const std::string& name, const std::string& result) { added.push_back(name + ":" + result); },
+    [&errors](const std::string& name, const std::exception& ex) { errors.push_back(name + ":" + ex.what()); });
+  BOOST_TEST(std::size(finished) == 4);
+  BOOST_TEST(added == (std::vector<std::string>{"a:aa", "c:cc", "d:dd", "f:ff"}), boost::test_tools::per_element());
+  BOOST_TEST(errors == (std::vector<std::string>{"b:b", "e:e"}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TransformInOrder_ConsumeThrows_ReportsErrorAndContinues)
+{
+  nsw::hw::Executor executor{2};
+  const std::vector<int> inputs{1, 2, 3};
+  std::vector<int> added{};
+  std::vector<int> errors{};
+  nsw::hw::transformInOrder(
+    executor,
+    inputs,
+    [](const int input) { return 10 * input; },
+    [&added](const int, const int result) {
+      if (result == 20) {
+        throw std::runtime_error("duplicate");
+      }
+      added.push_back(result);
+    },
+    [&errors](const int input, const std::exception&) { errors.push_back(input); });
+  BOOST_TEST(added == (std::vector<int>{10, 30}), boost::test_tools::per_element());
+  BOOST_TEST(errors == (std::vector<int>{2}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TransformInOrder_OnErrorThrows_WaitsForJobsAndRethrows)
+{
+  nsw::hw::Executor executor{2};
+  const std::vector<int> inputs{1, 2, 3, 4};
+  std::atomic<std::size_t> numRun{0};
+  BOOST_CHECK_THROW(nsw::hw::transformInOrder(
+                      executor,
+                      inputs,
+                      [&numRun](const int input) -> int {
+                        std::this_thread::sleep_for(1ms);
+                        ++numRun;
+                        if (input == 1) {
+                          throw std::runtime_error("failed");
+                        }
+                        return input;
+                      },
+                      [](const int, const int) {},
+                      [](const int, const std::exception& ex) { throw std::logic_error(ex.what()); }),
+                    std::logic_error);
+  BOOST_TEST(numRun == std::size(inputs));
+}
+
+BOOST_AUTO_TEST_CASE(KeyedSemaphore_IndependentCallers_LimitHoldsPerKey)
+{
+  constexpr std::size_t maxPerKey{2};
+  nsw::hw::Executor executor{8};
+  nsw::hw::KeyedSemaphore semaphore{maxPerKey};
+  std::mutex mutex{};
+  std::map<std::string, std::size_t> running{};
+  std::map<std::string, std::size_t> maxRunning{};
+  const auto job = [&](const std::string& key) {
+    const auto slot = semaphore.acquire(key);
+    {
+      std::scoped_lock lock(mutex);
+      maxRunning[key] = std::max(maxRunning[key], ++running[key]);
+    }
+    std::this_thread::sleep_for(1ms);
+    std::scoped_lock lock(mutex);
+    --running[key];
+  };
+  // Two groups of jobs submitted independently, as done by the device types
+  std::vector<std::future<void>> futures{};
+  for (std::size_t group = 0; group < 2; ++group) {
+    for (std::size_t counter = 0; counter < 2 * maxPerKey; ++counter) {
+      futures.push_back(executor.submit([&job]() { job("server0"); }));
+      futures.push_back(executor.submit([&job]() { job("server1"); }));
+    }
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  BOOST_TEST(maxRunning.at("server0") <= maxPerKey);
+  BOOST_TEST(maxRunning.at("server1") <= maxPerKey);
+}
+
+BOOST_AUTO_TEST_CASE(KeyedSemaphore_SlotReleased_NextCallerProceeds)
+{
+  nsw::hw::KeyedSemaphore semaphore{1};
+  auto slot = std::optional<nsw::hw::KeyedSemaphore::Slot>{semaphore.acquire("server")};
+  std::atomic<bool> acquired{false};
+  std::thread waiter{[&semaphore, &acquired]() {
+    const auto other = semaphore.acquire("server");
+    acquired = true;
+  }};
+  // Other keys are not blocked
+  { const auto other = semaphore.acquire("other"); }
+  std::this_thread::sleep_for(20ms);
+  BOOST_TEST(not acquired);
+  slot.reset();
+  waiter.join();
+  BOOST_TEST(acquired);
+}
@@ -2,8 +2,21 @@
 #define BOOST_TEST_DYN_LINK
 #include "boost/test/unit_test.hpp"
 
+#include <array>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+
 #include "NSWConfiguration/ConfigReader.h"
 #include "NSWConfiguration/hw/DeviceManager.h"
+#include "NSWConfiguration/Constants.h"
+#include "NSWConfiguration/OpcClient.h"
+#include "NSWConfiguration/hw/SCAInterface.h"
 
 BOOST_AUTO_TEST_CASE(VmmGetVmmId_ReturnsCorrectValue) {
   const auto mmfeName  = "MMFE8-0001";
@@ -30,3 +43,145 @@ BOOST_AUTO_TEST_CASE(VmmGetVmmId_ReturnsCorrectValue) {
   }
 }
 
+
+namespace {
+  nsw::FEBConfig readFebConfig(const std::string& name)
+  {
+    nsw::ConfigReader reader("json://test_jsonapi.json");
+    return nsw::FEBConfig{reader.readConfig(name)};
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(AddChangedI2cMasterConfig_OneRegisterChanged_AddsOneWrite) {
+  const auto config = readFebConfig("MMFE8-0001");
+  const auto& rocDigital = config.getRocDigital();
+  nsw::OpcTransaction unchanged;
+  BOOST_TEST(nsw::hw::SCA::addChangedI2cMasterConfig(unchanged, "MMFE8-0001", rocDigital, rocDigital.getBitstreamMap()) == 0);
+  BOOST_TEST(unchanged.empty());
+
+  auto previous = rocDigital.getBitstreamMap();
+  const auto changedAddress = std::cbegin(previous)->first;
+  previous.erase(changedAddress);
+  nsw::OpcTransaction changed;
+  BOOST_TEST(nsw::hw::SCA::addChangedI2cMasterConfig(changed, "MMFE8-0001", rocDigital, previous) == 1);
+  BOOST_REQUIRE(changed.size() == 1);
+  BOOST_TEST(changed.getOperations().front().node ==
+             fmt::format("MMFE8-0001.{}.{}", rocDigital.getName(), changedAddress));
+}
+
+BOOST_AUTO_TEST_CASE(DeviceManagerClear_FebAddedAgain_ReusesKeptFeb) {
+  nsw::hw::DeviceManager deviceManager{false};
+  deviceManager.add(readFebConfig("MMFE8-0001"));
+  deviceManager.add(readFebConfig("PFEB-0001"));
+  deviceManager.clear();
+  BOOST_TEST(deviceManager.getFebs().empty());
+  BOOST_TEST(deviceManager.getNumKeptFebs() == 2);
+
+  // Only the FEB which is part of the next configuration is taken over
+  const auto config = readFebConfig("MMFE8-0001");
+  deviceManager.add(config);
+  BOOST_TEST(deviceManager.getNumKeptFebs() == 1);
+  BOOST_REQUIRE(deviceManager.getFebs().size() == 1);
+  BOOST_TEST(deviceManager.getFebs().front().getScaAddress() == config.getAddress());
+
+  deviceManager.clear();
+  BOOST_TEST(deviceManager.getNumKeptFebs() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(FebSetConfiguration_OtherFeb_Throws) {
+  nsw::OpcManager manager;
+  nsw::hw::FEB feb{manager, readFebConfig("MMFE8-0001")};
+  BOOST_TEST(not feb.hasWrittenConfiguration());
+  BOOST_CHECK_NO_THROW(feb.setConfiguration(readFebConfig("MMFE8-0001")));
+  BOOST_CHECK_THROW(feb.setConfiguration(readFebConfig("PFEB-0001")), std::invalid_argument);
+
+  // Same SCA address behind another OPC server
+  nsw::ConfigReader reader("json://test_jsonapi.json");
+  auto otherServer = reader.readConfig("MMFE8-0001");
+  otherServer.put("OpcServerIp", "otherserver:48020");
+  BOOST_CHECK_THROW(feb.setConfiguration(nsw::FEBConfig{otherServer}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(RocReadRegisters_FakeBus_MapsValuesToAddresses) {
+  nsw::OpcManager manager;
+  const nsw::hw::FEB feb{manager, readFebConfig("MMFE8-0001")};
+  std::map<std::pair<unsigned int, unsigned int>, std::vector<std::uint8_t>> calls{};
+  const auto readBus = [&calls](const auto lines, const auto regAddresses) {
+    calls.emplace(lines, std::vector<std::uint8_t>(std::begin(regAddresses), std::end(regAddresses)));
+    std::vector<std::uint8_t> values{};
+    for (const auto regAddress : regAddresses) {
+      values.push_back(static_cast<std::uint8_t>(regAddress ^ 0xa5));
+    }
+    return values;
+  };
+
+  const auto regAddresses = std::array<std::uint8_t, 5>{64, 0, 65, 2, 1};
+  const auto result = feb.getRoc().readRegisters(regAddresses, readBus);
+  BOOST_REQUIRE(result.size() == regAddresses.size());
+  for (const auto regAddress : regAddresses) {
+    BOOST_TEST(result.at(regAddress) == (regAddress ^ 0xa5));
+  }
+
+  // One read per bus with the addresses in the requested order
+  using namespace nsw::roc::mmfe8;
+  BOOST_REQUIRE(calls.size() == 2);
+  BOOST_TEST(calls.at({digital::SCL_LINE_PIN, digital::SDA_LINE_PIN}) == (std::vector<std::uint8_t>{0, 2, 1}),
+             boost::test_tools::per_element());
+  BOOST_TEST(calls.at({analog::SCL_LINE_PIN, analog::SDA_LINE_PIN}) == (std::vector<std::uint8_t>{64, 65}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(RocReadRegisters_FakeBusReturnsTooFewValues_Throws) {
+  nsw::OpcManager manager;
+  const nsw::hw::FEB feb{manager, readFebConfig("MMFE8-0001")};
+  const auto readBus = [](const auto /*lines*/, const auto /*regAddresses*/) { return std::vector<std::uint8_t>{1}; };
+  BOOST_CHECK_THROW(static_cast<void>(feb.getRoc().readRegisters(std::array<std::uint8_t, 2>{0, 1}, readBus)),
+                    std::out_of_range);
+  BOOST_CHECK_THROW(static_cast<void>(feb.getRoc().readRegisters(std::array<std::uint8_t, 1>{15}, readBus)),
+                    std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeRocReads_TwoRegisters_SkipsAcknowledgeBits) {
+  // Two acknowledge bits followed by the register bits, MSB first
+  const std::vector<bool> sdaBits{true, true, 1, 0, 1, 0, 0, 1, 0, 1,
+                                  false, false, 0, 0, 0, 0, 1, 1, 1, 1};
+  BOOST_TEST(nsw::OpcClient::decodeRocReads(sdaBits, 2) == (std::vector<std::uint8_t>{0xa5, 0x0f}),
+             boost::test_tools::per_element());
+  BOOST_CHECK_THROW(static_cast<void>(nsw::OpcClient::decodeRocReads(sdaBits, 3)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GetReadChunks_SplitsNodesIntoChunks) {
+  using Chunks = std::vector<std::pair<std::size_t, std::size_t>>;
+  BOOST_TEST((nsw::OpcClient::getReadChunks(5, 2) == Chunks{{0, 2}, {2, 2}, {4, 1}}));
+  BOOST_TEST((nsw::OpcClient::getReadChunks(4, 2) == Chunks{{0, 2}, {2, 2}}));
+  BOOST_TEST((nsw::OpcClient::getReadChunks(2, 0) == Chunks{{0, 1}, {1, 1}}));
+  BOOST_TEST(nsw::OpcClient::getReadChunks(0, 2).empty());
+}
+
+BOOST_AUTO_TEST_CASE(StoreScaStatus_MapsVariablesToFields) {
+  using Variable = nsw::OpcClient::ScaStatusVariable;
+  nsw::ScaStatusInfo info{};
+  UaVariant online{};
+  online.setBool(OpcUa_True);
+  UaVariant id{};
+  id.setUInt32(0xabcd);
+  UaVariant address{};
+  address.setString(UaString{"simple-tcp://127.0.0.1:1234"});
+
+  nsw::OpcClient::storeScaStatus(info, Variable::ONLINE, online);
+  nsw::OpcClient::storeScaStatus(info, Variable::ID, id);
+  BOOST_TEST(not info.address.has_value());
+  nsw::OpcClient::storeScaStatus(info, Variable::ADDRESS, address);
+  BOOST_TEST(info.online.value_or(false));
+  BOOST_TEST(info.id.value_or(0) == 0xabcdU);
+  BOOST_TEST(info.address.value_or("") == "simple-tcp://127.0.0.1:1234");
+  BOOST_TEST(nsw::OpcClient::SCA_STATUS_VARIABLES.at(static_cast<std::size_t>(Variable::ADDRESS)) == "address");
+}
+
+BOOST_AUTO_TEST_CASE(StoreScaStatus_WrongType_KeepsFieldEmpty) {
+  nsw::ScaStatusInfo info{};
+  UaVariant number{};
+  number.setUInt32(1);
+  nsw::OpcClient::storeScaStatus(info, nsw::OpcClient::ScaStatusVariable::ADDRESS, number);
+  BOOST_TEST(not info.address.has_value());
+}
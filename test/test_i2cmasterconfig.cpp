@@ -54,10 +54,10 @@ BOOST_AUTO_TEST_CASE(Constructor_AllZeroRegisters_CreatesCorrectBitstreamMap) {
 
     nsw::I2cMasterConfig master(config, "master_address", CUSTOM_REGISTER_SIZE_1);
     auto bs_map = master.getBitstreamMap();
-    BOOST_TEST(bs_map["i2caddress0"] == "0000000000000000");
-    BOOST_TEST(bs_map["i2caddress1"] == "000000000000000000000000000000000000000000000000");
-    BOOST_TEST(bs_map["i2caddress2"] == "00000000000000000000000000000000");
-    BOOST_TEST(bs_map["i2caddress3"] == "00000000");
+    BOOST_TEST(bs_map["i2caddress0"].toString() == "0000000000000000");
+    BOOST_TEST(bs_map["i2caddress1"].toString() == "000000000000000000000000000000000000000000000000");
+    BOOST_TEST(bs_map["i2caddress2"].toString() == "00000000000000000000000000000000");
+    BOOST_TEST(bs_map["i2caddress3"].toString() == "00000000");
 }
 
 BOOST_AUTO_TEST_CASE(Constructor_NoneZeroRegisters_CreatesCorrectBitstreamMap) {
@@ -72,10 +72,10 @@ BOOST_AUTO_TEST_CASE(Constructor_NoneZeroRegisters_CreatesCorrectBitstreamMap) {
 
     nsw::I2cMasterConfig master(config, "master_address", CUSTOM_REGISTER_SIZE_1);
     auto bs_map = master.getBitstreamMap();
-    BOOST_TEST(bs_map["i2caddress0"] == "0000010000001111");
-    BOOST_TEST(bs_map["i2caddress1"] == "000000000001111000000000010000000000000000000000");
-    BOOST_TEST(bs_map["i2caddress2"] == "00000000000000000000000000000000");
-    BOOST_TEST(bs_map["i2caddress3"] == "00000111");
+    BOOST_TEST(bs_map["i2caddress0"].toString() == "0000010000001111");
+    BOOST_TEST(bs_map["i2caddress1"].toString() == "000000000001111000000000010000000000000000000000");
+    BOOST_TEST(bs_map["i2caddress2"].toString() == "00000000000000000000000000000000");
+    BOOST_TEST(bs_map["i2caddress3"].toString() == "00000111");
 }
 
 BOOST_AUTO_TEST_CASE(Constructor_OverflowInConfigTree_ThrowsRegisterOverflow) {
@@ -236,7 +236,7 @@ BOOST_AUTO_TEST_CASE(Constructor_NotUsedInRegisterMap_InsertsZerosToBitstream) {
 
     nsw::I2cMasterConfig master(config, "master_address", CUSTOM_REGISTER_SIZE_2);
     auto bs_map = master.getBitstreamMap();
-    BOOST_TEST(bs_map["i2caddress1"] == "000000000001111000000000000000000001110001000001");
+    BOOST_TEST(bs_map["i2caddress1"].toString() == "000000000001111000000000000000000001110001000001");
 }
 
 BOOST_AUTO_TEST_CASE(Constructor_ReadonlyInRegisterMap_ReadonlyAddressNotInBitstreamMap) {
@@ -250,11 +250,18 @@ BOOST_AUTO_TEST_CASE(Constructor_ReadonlyInRegisterMap_ReadonlyAddressNotInBitst
 
     nsw::I2cMasterConfig master(config, "master_address", CUSTOM_REGISTER_SIZE_3);
     auto bs_map = master.getBitstreamMap();
-    BOOST_TEST(bs_map["i2caddress0"] == "0000010000001111");
-    BOOST_TEST(bs_map["i2caddress1"] == "000000000001111000000000010000000000000000000000");
-    BOOST_TEST(bs_map["i2caddress3"] == "00000111");
+    BOOST_TEST(bs_map["i2caddress0"].toString() == "0000010000001111");
+    BOOST_TEST(bs_map["i2caddress1"].toString() == "000000000001111000000000010000000000000000000000");
+    BOOST_TEST(bs_map["i2caddress3"].toString() == "00000111");
 
     // Make sure the READONLY address is not added to bs_map
     BOOST_TEST((bs_map.find("i2caddress2_READONLY") == bs_map.end()));
     BOOST_TEST((bs_map.find("i2caddress2") == bs_map.end()));
 }
+
+BOOST_AUTO_TEST_CASE(GetInstance_SameRegisterMap_ReturnsSharedCodec) {
+    const auto& codec = nsw::I2cMasterCodec::getInstance(CUSTOM_REGISTER_SIZE_1);
+    BOOST_TEST(&codec == &nsw::I2cMasterCodec::getInstance(CUSTOM_REGISTER_SIZE_1));
+    BOOST_TEST(&codec != &nsw::I2cMasterCodec::getInstance(CUSTOM_REGISTER_SIZE_2));
+    BOOST_TEST(codec.getTotalSize("i2caddress1") == 48);
+}
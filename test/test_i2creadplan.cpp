@@ -0,0 +1,110 @@
+#define BOOST_TEST_MODULE I2cReadPlan_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "NSWConfiguration/hw/I2cReadPlan.h"
+#include "NSWConfiguration/monitoring/RegisterList.h"
+
+namespace {
+  constexpr nsw::hw::I2cRegisterLayout NO_BURST{4, true, 1};
+  constexpr nsw::hw::I2cRegisterLayout BURST{4, true, 8};
+
+  std::vector<std::uint8_t> toBytes(const std::vector<std::uint32_t>& words)
+  {
+    std::vector<std::uint8_t> bytes{};
+    for (const auto word : words) {
+      for (std::size_t byte = 0; byte < 4; ++byte) {
+        bytes.push_back(static_cast<std::uint8_t>(word >> (byte * 8)));
+      }
+    }
+    return bytes;
+  }
+
+  struct TestIs {
+    bool m_flag{false};
+    std::uint32_t m_value{0};
+  };
+
+  struct TestDevice {
+    [[nodiscard]] std::vector<std::uint32_t> readRegisters(const nsw::hw::I2cReadPlan& plan) const
+    {
+      std::vector<std::vector<std::uint8_t>> replies{};
+      for (const auto& burst : plan.getBursts()) {
+        std::vector<std::uint32_t> words{};
+        for (std::size_t reg = 0; reg < burst.m_numRegisters; ++reg) {
+          words.push_back(burst.m_firstAddress + reg + 0x100);
+        }
+        replies.push_back(toBytes(words));
+      }
+      return plan.decode(replies);
+    }
+  };
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Constructor_NoBurst_OneReadPerUniqueRegister)
+{
+  const auto registers = std::array<nsw::hw::RegisterRead, 4>{{{0x2}, {0x1}, {0x2, 0xf}, {0x3}}};
+  const auto plan = nsw::hw::I2cReadPlan{registers, NO_BURST};
+  const auto& bursts = plan.getBursts();
+  BOOST_REQUIRE_EQUAL(std::size(bursts), 3);
+  BOOST_TEST(bursts.at(0).m_firstAddress == 0x1);
+  BOOST_TEST(bursts.at(0).m_numRegisters == 1);
+  BOOST_TEST(bursts.at(0).m_address == (std::vector<std::uint8_t>{0x1, 0x0, 0x0, 0x0}),
+             boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(Constructor_Burst_MergesConsecutiveRegistersUpToMaximum)
+{
+  const auto registers = std::array<nsw::hw::RegisterRead, 7>{{{0x1}, {0x2}, {0x3}, {0x4}, {0x5}, {0x7}, {0x8}}};
+  const auto plan = nsw::hw::I2cReadPlan{registers, BURST};
+  const auto& bursts = plan.getBursts();
+  BOOST_REQUIRE_EQUAL(std::size(bursts), 3);
+  BOOST_TEST(bursts.at(0).m_numRegisters == nsw::hw::I2cReadPlan::MAX_BURST_BYTES / nsw::hw::I2cReadPlan::REGISTER_SIZE);
+  BOOST_TEST(bursts.at(1).m_firstAddress == 0x5);
+  BOOST_TEST(bursts.at(1).m_numRegisters == 1);
+  BOOST_TEST(bursts.at(2).m_firstAddress == 0x7);
+  BOOST_TEST(nsw::hw::I2cReadPlan::getNumBytes(bursts.at(2)) == 8);
+}
+
+BOOST_AUTO_TEST_CASE(Decode_Burst_ReturnsMaskedValuesInRequestOrder)
+{
+  const auto registers = std::array<nsw::hw::RegisterRead, 3>{{{0x2}, {0x1, 0xff}, {0x2, 0x1}}};
+  const auto plan = nsw::hw::I2cReadPlan{registers, BURST};
+  const auto replies = std::array{toBytes({0x1234, 0x5677})};
+  const auto values = plan.decode(replies);
+  BOOST_TEST(values == (std::vector<std::uint32_t>{0x5677, 0x34, 0x1}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(Decode_WrongNumberOfReplies_Throws)
+{
+  const auto registers = std::array<nsw::hw::RegisterRead, 2>{{{0x1}, {0x3}}};
+  const auto plan = nsw::hw::I2cReadPlan{registers, NO_BURST};
+  const auto replies = std::array{toBytes({0x1})};
+  BOOST_CHECK_THROW(static_cast<void>(plan.decode(replies)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Decode_ShortReply_Throws)
+{
+  const auto registers = std::array<nsw::hw::RegisterRead, 2>{{{0x1}, {0x2}}};
+  const auto plan = nsw::hw::I2cReadPlan{registers, BURST};
+  const auto replies = std::array{toBytes({0x1})};
+  BOOST_CHECK_THROW(static_cast<void>(plan.decode(replies)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(RegisterList_Read_FillsFields)
+{
+  using nsw::mon::internal::makeField;
+  const auto registers = nsw::mon::internal::RegisterList<TestIs>{
+    {makeField<&TestIs::m_flag>(0x1, 0x100), makeField<&TestIs::m_value>(0x2, 0xff)}, NO_BURST};
+  BOOST_TEST(std::size(registers.getPlan().getBursts()) == 2);
+  auto is = TestIs{};
+  registers.read(TestDevice{}, is);
+  BOOST_TEST(is.m_flag);
+  BOOST_TEST(is.m_value == 0x02);
+}
@@ -0,0 +1,167 @@
+#define BOOST_TEST_MODULE ISPublisher_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <is/infoT.h>
+
+#include "NSWConfiguration/monitoring/IsPublisher.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+  /**
+   * \brief State shared between the test and the destination owned by the publisher
+   */
+  struct Published {
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    std::vector<std::pair<std::string, int>> m_objects{};
+    bool m_blocked{false};  //!< Destination waits in checkin until unblocked
+    bool m_waiting{false};  //!< Publishing thread waits in checkin
+    bool m_fail{false};     //!< Destination throws
+  };
+
+  /**
+   * \brief Records the published objects
+   */
+  class RecordingDestination : public nsw::mon::ISDestination
+  {
+  public:
+    explicit RecordingDestination(std::shared_ptr<Published> published) : m_published{std::move(published)} {}
+
+    void checkin(const std::string& key, const ISInfo& values) const override
+    {
+      std::unique_lock lock(m_published->m_mutex);
+      m_published->m_waiting = true;
+      m_published->m_condition.notify_all();
+      m_published->m_condition.wait(lock, [this]() { return not m_published->m_blocked; });
+      m_published->m_waiting = false;
+      if (m_published->m_fail) {
+        throw std::runtime_error("IS not available");
+      }
+      m_published->m_objects.emplace_back(key, dynamic_cast<const ISInfoInt&>(values).getValue());
+    }
+
+  private:
+    std::shared_ptr<Published> m_published;
+  };
+
+  std::unique_ptr<const nsw::mon::ISDestination> makeDestination(const std::shared_ptr<Published>& published)
+  {
+    return std::make_unique<RecordingDestination>(published);
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Publish_Value_PublishedWithKey)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published)};
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  publisher.flush();
+
+  BOOST_REQUIRE_EQUAL(std::size(published->m_objects), 1);
+  BOOST_TEST(published->m_objects.at(0).first == "server.MMFE8.group.MMFE8-0");
+  BOOST_TEST(published->m_objects.at(0).second == 1);
+  BOOST_TEST(publisher.getNumPublished() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Publish_WhilePublishing_OnlyLatestValuesPublished)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published)};
+  {
+    std::unique_lock lock(published->m_mutex);
+    published->m_blocked = true;
+  }
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  {
+    // The first value is being published, the following ones are queued
+    std::unique_lock lock(published->m_mutex);
+    published->m_condition.wait(lock, [&published]() { return published->m_waiting; });
+  }
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{2});
+  publisher.publish("server", "group", "MMFE8", "MMFE8-1", ISInfoInt{5});
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{3});
+  {
+    std::scoped_lock lock(published->m_mutex);
+    published->m_blocked = false;
+  }
+  published->m_condition.notify_all();
+  publisher.flush();
+
+  const auto expected = std::vector<std::pair<std::string, int>>{
+    {"server.MMFE8.group.MMFE8-0", 1}, {"server.MMFE8.group.MMFE8-0", 3}, {"server.MMFE8.group.MMFE8-1", 5}};
+  BOOST_REQUIRE_EQUAL(std::size(published->m_objects), std::size(expected));
+  for (std::size_t index = 0; index < std::size(expected); ++index) {
+    BOOST_TEST(published->m_objects.at(index).first == expected.at(index).first);
+    BOOST_TEST(published->m_objects.at(index).second == expected.at(index).second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Publish_DefaultHeartbeat_UnchangedValuesPublished)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published)};
+  for (std::size_t cycle = 0; cycle < 3; ++cycle) {
+    publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+    publisher.flush();
+  }
+  BOOST_TEST(std::size(published->m_objects) == 3);
+  BOOST_TEST(publisher.getNumPublished() == 3);
+  BOOST_TEST(publisher.getNumSuppressed() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Publish_HeartbeatNotExpired_UnchangedValuesSuppressed)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published), 1h};
+  for (const auto value : {1, 1, 2, 2, 1}) {
+    publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{value});
+    publisher.flush();
+  }
+  BOOST_REQUIRE_EQUAL(std::size(published->m_objects), 3);
+  BOOST_TEST(published->m_objects.at(0).second == 1);
+  BOOST_TEST(published->m_objects.at(1).second == 2);
+  BOOST_TEST(published->m_objects.at(2).second == 1);
+  BOOST_TEST(publisher.getNumPublished() == 3);
+  BOOST_TEST(publisher.getNumSuppressed() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(Publish_HeartbeatExpired_UnchangedValuesPublished)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published), 1ms};
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  publisher.flush();
+  std::this_thread::sleep_for(5ms);
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  publisher.flush();
+  BOOST_TEST(std::size(published->m_objects) == 2);
+  BOOST_TEST(publisher.getNumSuppressed() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Publish_CheckinFailed_UnchangedValuesPublishedAgain)
+{
+  const auto published = std::make_shared<Published>();
+  nsw::mon::ISPublisher publisher{makeDestination(published), 1h};
+  published->m_fail = true;
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  publisher.flush();
+  published->m_fail = false;
+  publisher.publish("server", "group", "MMFE8", "MMFE8-0", ISInfoInt{1});
+  publisher.flush();
+  BOOST_TEST(std::size(published->m_objects) == 1);
+  BOOST_TEST(publisher.getNumPublished() == 1);
+  BOOST_TEST(publisher.getNumSuppressed() == 0);
+}
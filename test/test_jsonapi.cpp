@@ -50,3 +50,24 @@ BOOST_AUTO_TEST_CASE(GetElementNames_FullConfigTree_MatchesRegex) {
       BOOST_TEST(elements_read == a02_layer1_elements);
     }
 }
+
+BOOST_AUTO_TEST_CASE(ReadFEBConfig_FullConfigTree_MatchesMergedConfig) {
+    const std::string file_path = "test_jsonapi.json";
+    JsonApi cfg(file_path);
+    ConfigReaderApi& api = cfg;
+
+    for (const auto& name : {"MMFE8-0001", "PFEB-0001", "SFEB6-0001"}) {
+      const nsw::FEBConfig merged{api.read(name)};
+      const auto layered = api.readFEBConfig(name);
+      BOOST_TEST(layered.getVmms().size() == merged.getVmms().size());
+      for (std::size_t i = 0; i < merged.getVmms().size(); ++i) {
+        BOOST_TEST(layered.getVmms().at(i).getBitString() == merged.getVmms().at(i).getBitString());
+      }
+      BOOST_TEST(layered.getTdss().size() == merged.getTdss().size());
+      for (std::size_t i = 0; i < merged.getTdss().size(); ++i) {
+        BOOST_TEST(layered.getTdss().at(i).getBitstreamMap() == merged.getTdss().at(i).getBitstreamMap());
+      }
+      BOOST_TEST(layered.getRocAnalog().getBitstreamMap() == merged.getRocAnalog().getBitstreamMap());
+      BOOST_TEST(layered.getRocDigital().getBitstreamMap() == merged.getRocDigital().getBitstreamMap());
+    }
+}
@@ -0,0 +1,66 @@
+#define BOOST_TEST_MODULE JsonParser_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include "NSWConfiguration/JsonParser.h"
+
+using boost::property_tree::ptree;
+using boost::property_tree::json_parser::json_parser_error;
+
+namespace {
+  ptree readWithBoost(const std::string& text)
+  {
+    std::stringstream stream(text);
+    ptree tree;
+    boost::property_tree::read_json(stream, tree);
+    return tree;
+  }
+
+  std::string errorMessage(const std::string& text)
+  {
+    try {
+      static_cast<void>(nsw::json::parse(text));
+    } catch (const json_parser_error& ex) {
+      return ex.what();
+    }
+    return "";
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Parse_ValidJson_MatchesReadJson)
+{
+  const std::string text{R"({"a": 1, "b": [1, -2.5e+3, {"c": "xé\n"}], "d": true, "e": null,
+                              "a": "duplicate", "f": {}, "g": []})"};
+  BOOST_TEST((nsw::json::parse(text) == readWithBoost(text)));
+}
+
+BOOST_AUTO_TEST_CASE(Parse_CommentsAndTrailingCommas_AreIgnored)
+{
+  const auto tree = nsw::json::parse("// comment\n{\n  # comment\n  \"a\": 1, // comment\n  \"b\": [1, 2,],\n}\n");
+  BOOST_TEST((tree == readWithBoost(R"({"a": 1, "b": [1, 2]})")));
+}
+
+BOOST_AUTO_TEST_CASE(Parse_CommentMarkersInString_AreKept)
+{
+  const auto tree = nsw::json::parse(R"({"url": "http://host/#1"})");
+  BOOST_TEST(tree.get<std::string>("url") == "http://host/#1");
+}
+
+BOOST_AUTO_TEST_CASE(Parse_MalformedJson_ThrowsReadJsonMessage)
+{
+  BOOST_TEST(errorMessage("{\n\"a\": 1\n\"b\": 2}") == "<unspecified file>(3): expected '}' or ','");
+  BOOST_TEST(errorMessage("[1, 2") == "<unspecified file>(1): expected ']' or ','");
+  BOOST_TEST(errorMessage(R"({"a": "b)") == "<unspecified file>(1): unterminated string");
+  BOOST_TEST(errorMessage("{} x") == "<unspecified file>(1): garbage after data");
+}
+
+BOOST_AUTO_TEST_CASE(ReadFile_MissingFile_Throws)
+{
+  BOOST_CHECK_THROW(static_cast<void>(nsw::json::readFile("does_not_exist.json")), json_parser_error);
+}
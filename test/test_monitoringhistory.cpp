@@ -0,0 +1,118 @@
+#define BOOST_TEST_MODULE MonitoringHistory_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NSWConfiguration/monitoring/History.h"
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(TimeSeries_NotFull_ReturnsAllSamples)
+{
+  auto series = nsw::mon::TimeSeries{4};
+  series.push(1, 10.);
+  series.push(2, 20.);
+  const auto samples = series.read(0);
+  BOOST_TEST(samples.m_timestamps == (std::vector<std::int64_t>{1, 2}), boost::test_tools::per_element());
+  BOOST_TEST(samples.m_values == (std::vector<double>{10., 20.}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TimeSeries_Full_KeepsNewestSamplesInOrder)
+{
+  auto series = nsw::mon::TimeSeries{3};
+  for (std::int64_t time = 1; time <= 5; ++time) {
+    series.push(time, static_cast<double>(time));
+  }
+  const auto samples = series.read(0);
+  BOOST_TEST(samples.m_timestamps == (std::vector<std::int64_t>{3, 4, 5}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TimeSeries_Since_ReturnsOnlyNewerSamples)
+{
+  auto series = nsw::mon::TimeSeries{8};
+  for (std::int64_t time = 1; time <= 5; ++time) {
+    series.push(time, static_cast<double>(time));
+  }
+  BOOST_TEST(series.read(4).m_timestamps == (std::vector<std::int64_t>{4, 5}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(TimeSeries_ConcurrentReader_OnlyConsistentSamples)
+{
+  auto series = nsw::mon::TimeSeries{16};
+  std::atomic<bool> done{false};
+  std::thread writer([&series, &done]() {
+    for (std::int64_t time = 0; time < 100000; ++time) {
+      series.push(time, static_cast<double>(time));
+    }
+    done = true;
+  });
+  while (not done) {
+    const auto samples = series.read(0);
+    BOOST_REQUIRE(std::size(samples.m_timestamps) <= 16);
+    for (std::size_t index = 0; index < std::size(samples.m_timestamps); ++index) {
+      BOOST_REQUIRE(static_cast<double>(samples.m_timestamps[index]) == samples.m_values[index]);
+      if (index > 0) {
+        BOOST_REQUIRE(samples.m_timestamps[index] == samples.m_timestamps[index - 1] + 1);
+      }
+    }
+  }
+  writer.join();
+}
+
+BOOST_AUTO_TEST_CASE(History_Disabled_RecordsNothing)
+{
+  auto history = nsw::mon::History{};
+  const auto metrics = std::array{nsw::mon::Metric{"seu", 1.}};
+  history.record("group", "device", metrics);
+  BOOST_TEST(history.query({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(History_Query_FiltersByDeviceAndWindow)
+{
+  auto history = nsw::mon::History{10};
+  const auto now = nsw::mon::History::Clock::now();
+  const auto metrics = std::array{nsw::mon::Metric{"seu", 1.}, nsw::mon::Metric{"seuCounter", 2.}};
+  history.record("group", "MMFE8-0", metrics, now - 10s);
+  history.record("group", "MMFE8-0", metrics, now);
+  history.record("group", "MMFE8-1", metrics, now);
+
+  BOOST_TEST(std::size(history.query({})) == 4);
+  const auto recent = history.query({"group", "MMFE8-0", 5s}, now);
+  BOOST_REQUIRE_EQUAL(std::size(recent), 2);
+  BOOST_TEST(recent.at(0).m_device == "MMFE8-0");
+  BOOST_TEST(recent.at(0).m_metric == "seu");
+  BOOST_TEST(std::size(recent.at(0).m_samples.m_values) == 1);
+  BOOST_TEST(history.query({"other"}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(History_Write_ColumnarBinaryFormat)
+{
+  auto history = nsw::mon::History{10};
+  const auto metrics = std::array{nsw::mon::Metric{"seu", 3.}};
+  const auto time = nsw::mon::History::Clock::time_point{1234ms};
+  history.record("grp", "dev", metrics, time);
+  history.record("grp", "dev", metrics, time + 1ms);
+
+  std::ostringstream stream;
+  nsw::mon::History::write(stream, history.query({}));
+  const auto data = stream.str();
+
+  const auto headerSize = std::size(nsw::mon::History::FILE_MAGIC) + 2 * sizeof(std::uint32_t);
+  const auto namesSize = 3 * (sizeof(std::uint16_t) + 3);
+  const auto samplesSize = sizeof(std::uint32_t) + 2 * (sizeof(std::int64_t) + sizeof(double));
+  BOOST_REQUIRE_EQUAL(std::size(data), headerSize + namesSize + samplesSize);
+  BOOST_TEST(data.substr(0, 8) == nsw::mon::History::FILE_MAGIC);
+
+  std::int64_t firstTimestamp{};
+  data.copy(reinterpret_cast<char*>(&firstTimestamp), sizeof(firstTimestamp), headerSize + namesSize + sizeof(std::uint32_t));
+  BOOST_TEST(firstTimestamp == 1234);
+}
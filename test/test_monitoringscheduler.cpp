@@ -0,0 +1,228 @@
+#define BOOST_TEST_MODULE MonitoringScheduler_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include "NSWConfiguration/monitoring/Scheduler.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+  /**
+   * \brief Simulated time which jumps to the next wake up of an idle worker
+   *
+   * Jobs advance the time to simulate their duration. Once a worker would wait beyond the
+   * simulated duration the test can stop the scheduler.
+   */
+  class ManualClock : public nsw::mon::SchedulerClock
+  {
+  public:
+    explicit ManualClock(const Clock::duration duration) : m_end{START + duration} {}
+
+    [[nodiscard]] Clock::time_point now() const override { return Clock::time_point{Clock::duration{m_now.load()}}; }
+
+    void advance(const Clock::duration duration) { m_now += duration.count(); }
+
+    void waitUntil(std::unique_lock<std::mutex>& lock,
+                   std::condition_variable_any& condition,
+                   const std::stop_token stopToken,
+                   const Clock::time_point time,
+                   const std::function<bool()>& finished) override
+    {
+      if (finished()) {
+        return;
+      }
+      if (time <= m_end) {
+        auto current = m_now.load();
+        while (current < time.time_since_epoch().count() and
+               not m_now.compare_exchange_weak(current, time.time_since_epoch().count())) {
+        }
+        return;
+      }
+      {
+        std::scoped_lock endLock(m_mutex);
+        m_reachedEnd = true;
+      }
+      m_condition.notify_all();
+      condition.wait(lock, stopToken, finished);
+    }
+
+    /**
+     * \brief Wait until a worker has nothing to do before the end of the simulated duration
+     */
+    void waitForEnd()
+    {
+      std::unique_lock lock(m_mutex);
+      m_condition.wait(lock, [this]() { return m_reachedEnd; });
+    }
+
+  private:
+    constexpr static Clock::time_point START{std::chrono::hours{1}};
+    std::atomic<Clock::rep> m_now{START.time_since_epoch().count()};
+    Clock::time_point m_end;
+    std::mutex m_mutex{};
+    std::condition_variable m_condition{};
+    bool m_reachedEnd{false};
+  };
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ComputeNumShards_SweepFitsPeriod_NotSharded)
+{
+  const auto costs = std::array{100ms, 200ms};
+  const auto periods = std::array{std::chrono::milliseconds{1s}, std::chrono::milliseconds{2s}};
+  const auto numShards = nsw::mon::internal::computeNumShards(costs, periods, 1, 0.8, 64);
+  BOOST_TEST(numShards == (std::vector<std::size_t>{1, 1}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(ComputeNumShards_SweepLongerThanPeriod_Sharded)
+{
+  const auto costs = std::array{std::chrono::milliseconds{3s}};
+  const auto periods = std::array{std::chrono::milliseconds{1s}};
+  const auto numShards = nsw::mon::internal::computeNumShards(costs, periods, 4, 0.8, 64);
+  BOOST_TEST(numShards.at(0) == 4);
+}
+
+BOOST_AUTO_TEST_CASE(ComputeNumShards_Overloaded_ShardsHeaviestGroup)
+{
+  // Both groups fit into their period alone, but not together on one worker
+  const auto costs = std::array{750ms, 100ms};
+  const auto periods = std::array{std::chrono::milliseconds{1s}, std::chrono::milliseconds{1s}};
+  const auto numShards = nsw::mon::internal::computeNumShards(costs, periods, 1, 0.8, 64);
+  BOOST_TEST(numShards.at(0) == 2);
+  BOOST_TEST(numShards.at(1) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ComputeNumShards_MaxShardsReached_Clamped)
+{
+  const auto costs = std::array{std::chrono::milliseconds{100s}};
+  const auto periods = std::array{std::chrono::milliseconds{1s}};
+  const auto numShards = nsw::mon::internal::computeNumShards(costs, periods, 1, 0.8, 8);
+  BOOST_TEST(numShards.at(0) == 8);
+}
+
+BOOST_AUTO_TEST_CASE(Scheduler_TwoGroups_MonitorsBothOnSharedWorker)
+{
+  const auto configs = std::array{nsw::mon::Config{"fast", 20ms}, nsw::mon::Config{"slow", 60ms}};
+  const auto clock = std::make_shared<ManualClock>(300ms);
+  std::mutex mutex;
+  std::map<std::string, std::size_t> counts{};
+  std::set<std::size_t> shardCounts{};
+  nsw::mon::Scheduler scheduler{configs,
+                                1,
+                                [&mutex, &counts, &shardCounts](const std::string& name, const nsw::mon::Shard shard) {
+                                  std::scoped_lock lock(mutex);
+                                  ++counts[name];
+                                  shardCounts.insert(shard.m_count);
+                                },
+                                {},
+                                0ms,
+                                clock};
+  clock->waitForEnd();
+  scheduler.stop();
+
+  BOOST_TEST(shardCounts == (std::set<std::size_t>{1}), boost::test_tools::per_element());
+  BOOST_TEST(counts["fast"] > counts["slow"]);
+  BOOST_TEST(counts["slow"] >= 2);
+}
+
+BOOST_AUTO_TEST_CASE(Scheduler_SweepLongerThanPeriod_ShardsAndCoversAllDevices)
+{
+  constexpr std::size_t numDevices{12};
+  const auto configs = std::array{nsw::mon::Config{"group", 20ms}};
+  const auto clock = std::make_shared<ManualClock>(600ms);
+  std::mutex mutex;
+  std::set<std::size_t> shardCounts{};
+  std::vector<std::size_t> monitored(numDevices);
+  nsw::mon::Scheduler scheduler{configs,
+                                1,
+                                [&](const std::string& /*name*/, const nsw::mon::Shard shard) {
+                                  std::size_t numInShard{0};
+                                  {
+                                    std::scoped_lock lock(mutex);
+                                    shardCounts.insert(shard.m_count);
+                                    for (std::size_t device = 0; device < numDevices; ++device) {
+                                      if (shard.contains(device)) {
+                                        ++monitored[device];
+                                        ++numInShard;
+                                      }
+                                    }
+                                  }
+                                  // 5ms per device, a full sweep takes three periods
+                                  clock->advance(numInShard * 5ms);
+                                },
+                                {},
+                                0ms,
+                                clock};
+  clock->waitForEnd();
+  scheduler.stop();
+
+  const auto statistics = scheduler.getStatistics();
+  BOOST_TEST(statistics.at(0).m_numShards > 1);
+  BOOST_TEST(statistics.at(0).m_achievedRate > 0.);
+  BOOST_TEST(std::size(shardCounts) > 1);
+  for (const auto count : monitored) {
+    BOOST_TEST(count >= 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Scheduler_Reporter_CalledAfterEveryCycle)
+{
+  const auto configs = std::array{nsw::mon::Config{"group", 10ms}};
+  const auto clock = std::make_shared<ManualClock>(100ms);
+  std::mutex mutex;
+  std::size_t numCycles{0};
+  std::vector<std::string> reported{};
+  nsw::mon::Scheduler scheduler{
+    configs,
+    2,
+    [&mutex, &numCycles](const std::string& /*name*/, const nsw::mon::Shard /*shard*/) {
+      std::scoped_lock lock(mutex);
+      ++numCycles;
+    },
+    [&mutex, &reported](const nsw::mon::GroupStatistics& statistics) {
+      std::scoped_lock lock(mutex);
+      reported.push_back(statistics.m_name);
+    },
+    0ms,
+    clock};
+  clock->waitForEnd();
+  scheduler.stop();
+
+  BOOST_TEST(numCycles > 0);
+  BOOST_TEST(std::size(reported) == numCycles);
+  BOOST_TEST(reported == (std::vector<std::string>(numCycles, "group")), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(Scheduler_ThrowingJob_KeepsScheduling)
+{
+  const auto configs = std::array{nsw::mon::Config{"group", 10ms}};
+  const auto clock = std::make_shared<ManualClock>(100ms);
+  std::atomic<std::size_t> numCycles{0};
+  nsw::mon::Scheduler scheduler{configs,
+                                1,
+                                [&numCycles](const std::string& /*name*/, const nsw::mon::Shard /*shard*/) {
+                                  ++numCycles;
+                                  throw std::runtime_error("failed");
+                                },
+                                {},
+                                0ms,
+                                clock};
+  clock->waitForEnd();
+  scheduler.stop();
+
+  BOOST_TEST(numCycles.load() > 1);
+}
@@ -0,0 +1,246 @@
+#define BOOST_TEST_MODULE OpcManager_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "NSWConfiguration/hw/OpcConnectionBase.h"
+#include "NSWConfiguration/hw/OpcManager.h"
+#include "NSWConfiguration/hw/SessionLeases.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+  using Status = nsw::hw::ScaStatus::ScaStatus;
+
+  nsw::OpcManager::PingTarget makeTarget(const std::string& name)
+  {
+    return {name, nullptr, std::make_shared<nsw::OpcManager::Lease>()};
+  }
+
+  /**
+   * \brief Device using the connection cache of \ref nsw::hw::OpcConnectionBase
+   */
+  class FakeDevice : public nsw::hw::OpcConnectionBase
+  {
+  public:
+    using OpcConnectionBase::OpcConnectionBase;
+    using OpcConnectionBase::getConnection;
+  };
+
+  bool sameOwner(const nsw::OpcClientPtr& lhs, const nsw::OpcClientPtr& rhs)
+  {
+    return not lhs.owner_before(rhs) and not rhs.owner_before(lhs);
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(ParseSessionSelection_ValidName_ReturnsStrategy)
+{
+  BOOST_TEST((nsw::OpcManager::parseSessionSelection("RoundRobin") ==
+              nsw::OpcManager::SessionSelection::ROUND_ROBIN));
+  BOOST_TEST((nsw::OpcManager::parseSessionSelection("LeastLoaded") ==
+              nsw::OpcManager::SessionSelection::LEAST_LOADED));
+}
+
+BOOST_AUTO_TEST_CASE(ParseSessionSelection_InvalidName_Throws)
+{
+  BOOST_CHECK_THROW(nsw::OpcManager::parseSessionSelection("Random"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(GetNumSessions_UnknownServer_ReturnsZero)
+{
+  nsw::OpcManager manager{};
+  manager.setSessionPoolParameters(4, nsw::OpcManager::SessionSelection::ROUND_ROBIN);
+  BOOST_TEST(manager.getNumSessions("localhost:48020") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(GetGeneration_Clear_IncrementsGeneration)
+{
+  nsw::OpcManager manager{};
+  const auto generation = manager.getGeneration();
+  manager.clear();
+  BOOST_TEST(manager.getGeneration() == generation + 1);
+}
+
+BOOST_AUTO_TEST_CASE(GetDeviceGeneration_CloseAndClear_OnlyClearIncrements)
+{
+  nsw::OpcManager manager{};
+  const auto generation = manager.getGeneration();
+  const auto deviceGeneration = manager.getDeviceGeneration();
+  manager.close();
+  BOOST_TEST(manager.getGeneration() == generation + 1);
+  BOOST_TEST(manager.getDeviceGeneration() == deviceGeneration);
+  manager.clear();
+  BOOST_TEST(manager.getDeviceGeneration() == deviceGeneration + 1);
+}
+
+BOOST_AUTO_TEST_CASE(GetConnection_SameGeneration_ReusesCachedHandle)
+{
+  std::size_t numOpened{0};
+  nsw::OpcManager manager{[&numOpened](const std::string& /*ipPort*/) {
+    ++numOpened;
+    return std::shared_ptr<nsw::OpcClient>{};
+  }};
+  // Stops the ping thread, which would ping the fake sessions
+  manager.clear();
+
+  const FakeDevice device{manager, "localhost:48020", "MMFE8-0"};
+  const auto first = device.getConnection();
+  const auto second = device.getConnection();
+  BOOST_TEST(sameOwner(first, second));
+  BOOST_TEST(numOpened == 1);
+  BOOST_TEST(manager.getNumSessions("localhost:48020") == 1);
+}
+
+BOOST_AUTO_TEST_CASE(GetConnection_AfterClear_ResolvesNewHandle)
+{
+  std::size_t numOpened{0};
+  nsw::OpcManager manager{[&numOpened](const std::string& /*ipPort*/) {
+    ++numOpened;
+    return std::shared_ptr<nsw::OpcClient>{};
+  }};
+  manager.clear();
+
+  const FakeDevice device{manager, "localhost:48020", "MMFE8-0"};
+  const auto before = device.getConnection();
+  manager.clear();
+  BOOST_TEST(manager.getNumSessions("localhost:48020") == 0);
+  const auto after = device.getConnection();
+  BOOST_TEST(not sameOwner(before, after));
+  BOOST_TEST(numOpened == 2);
+  // The old pointer still owns its handle
+  BOOST_TEST(before.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_PoolNotFull_OpensNewSessions)
+{
+  nsw::hw::SessionLeases leases{};
+  BOOST_TEST(leases.acquire(2, nsw::hw::SessionSelection::ROUND_ROBIN) == 0);
+  BOOST_TEST(leases.acquire(2, nsw::hw::SessionSelection::ROUND_ROBIN) == 1);
+  BOOST_TEST(leases.getNumSessions() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_RoundRobin_CyclesThroughSessions)
+{
+  nsw::hw::SessionLeases leases{};
+  std::vector<std::size_t> sessions{};
+  for (std::size_t device = 0; device < 7; ++device) {
+    sessions.push_back(leases.acquire(3, nsw::hw::SessionSelection::ROUND_ROBIN));
+  }
+  BOOST_TEST(sessions == (std::vector<std::size_t>{0, 1, 2, 0, 1, 2, 0}), boost::test_tools::per_element());
+  BOOST_TEST(leases.getNumSessions() == 3);
+  BOOST_TEST(leases.getNumLeases(0) == 3);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_LeastLoaded_TakesSessionWithFewestDevices)
+{
+  nsw::hw::SessionLeases leases{};
+  for (std::size_t device = 0; device < 6; ++device) {
+    leases.acquire(3, nsw::hw::SessionSelection::LEAST_LOADED);
+  }
+  leases.release(1);
+  // Session 1 has one device, sessions 0 and 2 have two
+  BOOST_TEST(leases.acquire(3, nsw::hw::SessionSelection::LEAST_LOADED) == 1);
+  BOOST_TEST(leases.getNumLeases(1) == 2);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_Release_ReusesUnusedSessionFirst)
+{
+  nsw::hw::SessionLeases leases{};
+  leases.acquire(4, nsw::hw::SessionSelection::ROUND_ROBIN);
+  leases.acquire(4, nsw::hw::SessionSelection::ROUND_ROBIN);
+  leases.release(0);
+  BOOST_TEST(leases.getNumLeases(0) == 0);
+  BOOST_TEST(leases.acquire(4, nsw::hw::SessionSelection::ROUND_ROBIN) == 0);
+  BOOST_TEST(leases.getNumSessions() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_ReleaseFailedOpen_NextDeviceRetriesSameSlot)
+{
+  nsw::hw::SessionLeases leases{};
+  const auto session = leases.acquire(4, nsw::hw::SessionSelection::LEAST_LOADED);
+  leases.release(session);
+  BOOST_TEST(leases.acquire(4, nsw::hw::SessionSelection::LEAST_LOADED) == session);
+  BOOST_TEST(leases.getNumSessions() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(SessionLeases_ReleaseUnleased_Throws)
+{
+  nsw::hw::SessionLeases leases{};
+  BOOST_CHECK_THROW(leases.release(0), std::out_of_range);
+  leases.acquire(1, nsw::hw::SessionSelection::ROUND_ROBIN);
+  leases.release(0);
+  BOOST_CHECK_THROW(leases.release(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(PingServers_OneServerOffline_PingsInParallelAndPublishesStatus)
+{
+  const std::map<std::string, std::vector<nsw::OpcManager::PingTarget>> targets{
+    {"online:48020", {makeTarget("MMFE8-0"), makeTarget("MMFE8-1")}},
+    {"offline:48020", {makeTarget("MMFE8-2")}}};
+
+  // Each call waits for the other server to be pinged as well
+  std::mutex mutex{};
+  std::condition_variable condition{};
+  std::size_t numStarted{0};
+  bool overlapped{true};
+  const auto ping = [&](const std::vector<std::string>& names, const nsw::OpcClient* /*connection*/) {
+    {
+      std::unique_lock lock(mutex);
+      ++numStarted;
+      condition.notify_all();
+      if (not condition.wait_for(lock, 10s, [&numStarted]() { return numStarted == 2; })) {
+        overlapped = false;
+      }
+    }
+    const auto status = names.front() == "MMFE8-2" ? Status::SERVER_OFFLINE : Status::REACHABLE;
+    nsw::OpcManager::PingStatusMap result{};
+    for (const auto& name : names) {
+      result.try_emplace(name, status);
+    }
+    return result;
+  };
+
+  const auto results = nsw::OpcManager::pingServers(targets, ping);
+  BOOST_TEST(overlapped);
+  BOOST_REQUIRE_EQUAL(std::size(results), 2);
+  BOOST_TEST((results.at("online:48020") ==
+              nsw::OpcManager::PingStatusMap{{"MMFE8-0", Status::REACHABLE}, {"MMFE8-1", Status::REACHABLE}}));
+  BOOST_TEST((results.at("offline:48020") == nsw::OpcManager::PingStatusMap{{"MMFE8-2", Status::SERVER_OFFLINE}}));
+  BOOST_TEST((targets.at("online:48020").at(1).lease->status == Status::REACHABLE));
+  BOOST_TEST((targets.at("offline:48020").at(0).lease->status == Status::SERVER_OFFLINE));
+}
+
+BOOST_AUTO_TEST_CASE(UpdateBadConnections_ReachableAndOfflineServers_TracksBadDevices)
+{
+  nsw::OpcManager::PingStatusMap online{};
+  BOOST_TEST(not nsw::OpcManager::updateBadConnections(online, {{"MMFE8-0", Status::REACHABLE}}));
+  BOOST_TEST(online.empty());
+
+  nsw::OpcManager::PingStatusMap offline{};
+  const nsw::OpcManager::PingStatusMap result{{"MMFE8-1", Status::SERVER_OFFLINE},
+                                              {"MMFE8-2", Status::SERVER_OFFLINE}};
+  BOOST_TEST(nsw::OpcManager::updateBadConnections(offline, result));
+  BOOST_TEST((offline == result));
+}
+
+BOOST_AUTO_TEST_CASE(UpdateBadConnections_DeviceRecovers_RemovedAndStatusUpdated)
+{
+  nsw::OpcManager::PingStatusMap badConnections{{"MMFE8-0", Status::SERVER_OFFLINE},
+                                                {"MMFE8-1", Status::SERVER_OFFLINE}};
+  BOOST_TEST(not nsw::OpcManager::updateBadConnections(
+    badConnections, {{"MMFE8-0", Status::REACHABLE}, {"MMFE8-1", Status::UNREACHABLE}}));
+  BOOST_TEST((badConnections == nsw::OpcManager::PingStatusMap{{"MMFE8-1", Status::UNREACHABLE}}));
+
+  BOOST_TEST(not nsw::OpcManager::updateBadConnections(
+    badConnections, {{"MMFE8-0", Status::REACHABLE}, {"MMFE8-1", Status::REACHABLE}}));
+  BOOST_TEST(badConnections.empty());
+}
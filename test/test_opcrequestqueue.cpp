@@ -0,0 +1,134 @@
+#define BOOST_TEST_MODULE OpcRequestQueue_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NSWConfiguration/OpcRequestQueue.h"
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(Submit_ValidRequest_ReturnsResult)
+{
+  nsw::OpcRequestQueue queue{4, 2};
+  auto future = queue.submit("sca", []() { return 42; });
+  BOOST_TEST(future.get() == 42);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_ThrowingRequest_PropagatesException)
+{
+  nsw::OpcRequestQueue queue{4, 2};
+  auto future = queue.submit("sca", []() -> int { throw std::runtime_error("failed"); });
+  BOOST_CHECK_THROW(future.get(), std::runtime_error);
+  // The worker survives the exception
+  BOOST_TEST(queue.submit("sca", []() { return 1; }).get() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_ManyRequestsPerKey_ExecutesInOrderPerKey)
+{
+  constexpr int numRequests{1000};
+  const std::vector<std::string> keys{"sca0", "sca1", "sca2"};
+  nsw::OpcRequestQueue queue{8, 4};
+  std::mutex mutex{};
+  std::map<std::string, std::vector<int>> order{};
+  std::vector<std::future<void>> futures{};
+  for (int request = 0; request < numRequests; ++request) {
+    for (const auto& key : keys) {
+      futures.push_back(queue.submit(key, [&mutex, &order, &key, request]() {
+        std::scoped_lock lock(mutex);
+        order[key].push_back(request);
+      }));
+    }
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  for (const auto& key : keys) {
+    BOOST_REQUIRE(order[key].size() == numRequests);
+    for (int request = 0; request < numRequests; ++request) {
+      BOOST_TEST(order[key][static_cast<std::size_t>(request)] == request);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Submit_SameKey_NeverConcurrent)
+{
+  nsw::OpcRequestQueue queue{16, 4};
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  std::vector<std::future<void>> futures{};
+  for (int request = 0; request < 16; ++request) {
+    futures.push_back(queue.submit("sca", [&running, &maxRunning]() {
+      const auto current = ++running;
+      maxRunning = std::max(maxRunning.load(), current);
+      std::this_thread::sleep_for(1ms);
+      --running;
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  BOOST_TEST(maxRunning == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Submit_DifferentKeys_ExecutedConcurrently)
+{
+  nsw::OpcRequestQueue queue{4, 2};
+  std::promise<void> release{};
+  auto blocker = release.get_future().share();
+  // The first SCA hangs, the second one is still served
+  auto first = queue.submit("sca0", [blocker]() { blocker.wait(); });
+  auto second = queue.submit("sca1", []() { return 1; });
+  BOOST_TEST((second.wait_for(5s) == std::future_status::ready));
+  release.set_value();
+  first.get();
+}
+
+BOOST_AUTO_TEST_CASE(Submit_MaxInFlightReached_Blocks)
+{
+  nsw::OpcRequestQueue queue{2, 2};
+  std::promise<void> release{};
+  auto blocker = release.get_future().share();
+  auto first = queue.submit("sca", [blocker]() { blocker.wait(); });
+  auto second = queue.submit("sca", []() {});
+
+  std::atomic<bool> submitted{false};
+  std::thread producer{[&queue, &submitted]() {
+    queue.submit("other", []() {}).get();
+    submitted = true;
+  }};
+  std::this_thread::sleep_for(50ms);
+  BOOST_TEST(not submitted);
+
+  release.set_value();
+  producer.join();
+  BOOST_TEST(submitted);
+  first.get();
+  second.get();
+}
+
+BOOST_AUTO_TEST_CASE(Destructor_PendingRequests_ExecutesAll)
+{
+  constexpr int numRequests{100};
+  std::atomic<int> counter{0};
+  {
+    nsw::OpcRequestQueue queue{numRequests, 2};
+    for (int request = 0; request < numRequests; ++request) {
+      static_cast<void>(queue.submit(request % 2 == 0 ? "sca0" : "sca1", [&counter]() {
+        std::this_thread::sleep_for(100us);
+        ++counter;
+      }));
+    }
+  }
+  BOOST_TEST(counter == numRequests);
+}
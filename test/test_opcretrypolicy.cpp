@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE OpcRetryPolicy_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "NSWConfiguration/OpcRetryPolicy.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+  nsw::OpcRetryParameters fastParameters()
+  {
+    return {.m_maxAttempts = 3,
+            .m_initialBackoff = 1ms,
+            .m_maxBackoff = 4ms,
+            .m_backoffMultiplier = 2.,
+            .m_jitter = 0.5,
+            .m_scaFailureThreshold = 4,
+            .m_serverFailureThreshold = 100,
+            .m_breakerCooldown = 50ms};
+  }
+
+  const std::string SERVER{"server:48020"};
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(GetScaName_Node_ReturnsFirstComponent)
+{
+  BOOST_TEST(nsw::OpcRetryPolicy::getScaName("MMFE8_L1P1_HOL.gpio.bitBanger") == "MMFE8_L1P1_HOL");
+  BOOST_TEST(nsw::OpcRetryPolicy::getScaName("MMFE8_L1P1_HOL") == "MMFE8_L1P1_HOL");
+}
+
+BOOST_AUTO_TEST_CASE(GetBackoff_Attempts_GrowsExponentiallyWithinJitter)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    const auto first = policy.getBackoff(1);
+    BOOST_TEST((first > 0.49ms and first <= 1ms));
+    const auto second = policy.getBackoff(2);
+    BOOST_TEST((second > 0.99ms and second <= 2ms));
+    const auto capped = policy.getBackoff(10);
+    BOOST_TEST((capped > 1.99ms and capped <= 4ms));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Execute_TransientFailure_RetriesAndSucceeds)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  int calls{0};
+  const auto result = policy.execute(SERVER, "SCA", "read", [&calls]() {
+    if (++calls < 3) {
+      throw std::runtime_error("transient");
+    }
+    return 42;
+  });
+  BOOST_TEST(result == 42);
+  BOOST_TEST(calls == 3);
+  const auto statistics = policy.getStatistics();
+  BOOST_TEST(statistics.m_operations == 1);
+  BOOST_TEST(statistics.m_retries == 2);
+  BOOST_TEST(statistics.m_failures == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_PersistentFailure_ThrowsLastException)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  int calls{0};
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", [&calls]() {
+    ++calls;
+    throw std::runtime_error("broken");
+  }),
+                    std::runtime_error);
+  BOOST_TEST(calls == 3);
+  BOOST_TEST(policy.getStatistics().m_failures == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_MaxAttempts_OverridesDefault)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  int calls{0};
+  BOOST_CHECK_THROW(policy.execute(
+                      SERVER, "SCA", "write", [&calls]() { ++calls; throw std::runtime_error("broken"); }, 1),
+                    std::runtime_error);
+  BOOST_TEST(calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_ScaBreakerOpen_RejectsOnlyThisSca)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  // 4 failed operations open the breaker
+  for (std::size_t operation = 0; operation < fastParameters().m_scaFailureThreshold; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+
+  int calls{0};
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", [&calls]() { ++calls; }), nsw::OpcCircuitOpenIssue);
+  BOOST_TEST(calls == 0);
+  BOOST_TEST(policy.getStatistics().m_rejections == 1);
+
+  // Other SCAs of the server are not affected
+  BOOST_CHECK_NO_THROW(policy.execute(SERVER, "OTHER", "write", [&calls]() { ++calls; }));
+  BOOST_TEST(calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_ScaBreakerOpen_SameScaNameOnOtherServerNotAffected)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  for (std::size_t operation = 0; operation < fastParameters().m_scaFailureThreshold; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", []() {}), nsw::OpcCircuitOpenIssue);
+
+  // SCA names are only unique per server
+  int calls{0};
+  BOOST_CHECK_NO_THROW(policy.execute("other:48020", "SCA", "write", [&calls]() { ++calls; }));
+  BOOST_TEST(calls == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_CooldownOver_TrialClosesBreaker)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  for (std::size_t operation = 0; operation < fastParameters().m_scaFailureThreshold; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", []() {}), nsw::OpcCircuitOpenIssue);
+
+  std::this_thread::sleep_for(fastParameters().m_breakerCooldown + 10ms);
+  BOOST_CHECK_NO_THROW(policy.execute(SERVER, "SCA", "write", []() {}));
+  BOOST_CHECK_NO_THROW(policy.execute(SERVER, "SCA", "write", []() {}));
+}
+
+BOOST_AUTO_TEST_CASE(Execute_RetriedAttempts_CountOnceInBreaker)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  // 9 failed attempts, but only 3 failed operations (threshold 4)
+  for (int operation = 0; operation < 3; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+  int calls{0};
+  BOOST_CHECK_NO_THROW(policy.execute(SERVER, "SCA", "write", [&calls]() { ++calls; }));
+  BOOST_TEST(calls == 1);
+  BOOST_TEST(policy.getStatistics().m_rejections == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Execute_TrialFails_NotRetriedAndReopensBreaker)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  for (std::size_t operation = 0; operation < fastParameters().m_scaFailureThreshold; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+
+  std::this_thread::sleep_for(fastParameters().m_breakerCooldown + 10ms);
+  int calls{0};
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", [&calls]() {
+    ++calls;
+    throw std::runtime_error("broken");
+  }),
+                    std::runtime_error);
+  BOOST_TEST(calls == 1);
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", []() {}), nsw::OpcCircuitOpenIssue);
+}
+
+BOOST_AUTO_TEST_CASE(SetParameters_OpenBreaker_ClosesBreakers)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  const auto fail = []() { throw std::runtime_error("broken"); };
+  for (std::size_t operation = 0; operation < fastParameters().m_scaFailureThreshold; ++operation) {
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", fail), std::runtime_error);
+  }
+  BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", []() {}), nsw::OpcCircuitOpenIssue);
+
+  auto parameters = fastParameters();
+  parameters.m_maxAttempts = 0;
+  policy.setParameters(parameters);
+  BOOST_TEST(policy.getParameters().m_maxAttempts == 1);
+  BOOST_CHECK_NO_THROW(policy.execute(SERVER, "SCA", "write", []() {}));
+}
+
+BOOST_AUTO_TEST_CASE(Execute_DeadlinePassed_DoesNotRetry)
+{
+  nsw::OpcRetryPolicy policy{fastParameters()};
+  int calls{0};
+  {
+    const nsw::OpcRetryPolicy::ScopedDeadline deadline{policy, 0s};
+    BOOST_TEST(policy.getDeadline().has_value());
+    BOOST_CHECK_THROW(policy.execute(SERVER, "SCA", "write", [&calls]() {
+      ++calls;
+      throw std::runtime_error("broken");
+    }),
+                      std::runtime_error);
+  }
+  BOOST_TEST(calls == 1);
+  BOOST_TEST(not policy.getDeadline().has_value());
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE OpcTransaction_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "NSWConfiguration/OpcTransaction.h"
+
+namespace {
+  std::vector<std::size_t> getRequestSizes(const nsw::OpcTransaction& transaction)
+  {
+    std::vector<std::size_t> sizes{};
+    for (const auto& request : transaction.getRequests()) {
+      sizes.push_back(request.size());
+    }
+    return sizes;
+  }
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(GetRequests_Empty_NoRequest)
+{
+  BOOST_TEST(nsw::OpcTransaction{}.getRequests().empty());
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_OrderedGpios_OneRequestEach)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addGpioWrite("sca.gpio.rocCoreResetN", false)
+    .addGpioWrite("sca.gpio.rocPllResetN", false)
+    .addGpioWrite("sca.gpio.rocSResetN", false)
+    .addGpioWrite("sca.gpio.rocSResetN", true);
+  const auto requests = transaction.getRequests();
+  BOOST_TEST(getRequestSizes(transaction) == (std::vector<std::size_t>{1, 1, 1, 1}), boost::test_tools::per_element());
+  BOOST_TEST(requests.at(1).front().node == "sca.gpio.rocPllResetN");
+  BOOST_TEST(requests.at(3).front().value);
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_IndependentGpios_MergedIntoOneRequest)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addIndependentGpioWrite("sca.gpio.gpio0", false)
+    .addIndependentGpioWrite("sca.gpio.gpio1", false)
+    .addIndependentGpioWrite("sca.gpio.gpio2", false);
+  BOOST_TEST(getRequestSizes(transaction) == (std::vector<std::size_t>{3}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_IndependentGpioWrittenTwice_SplitToKeepOrder)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addIndependentGpioWrite("sca.gpio.gpio0", false)
+    .addIndependentGpioWrite("sca.gpio.gpio1", false)
+    .addIndependentGpioWrite("sca.gpio.gpio0", true)
+    .addIndependentGpioWrite("sca.gpio.gpio1", true);
+  const auto requests = transaction.getRequests();
+  BOOST_REQUIRE_EQUAL(std::size(requests), 2);
+  BOOST_TEST(requests.at(0).size() == 2);
+  BOOST_TEST(not requests.at(0).front().value);
+  BOOST_TEST(requests.at(1).front().node == "sca.gpio.gpio0");
+  BOOST_TEST(requests.at(1).front().value);
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_OrderedGpioBetweenIndependentGpios_SplitAtOrderedGpio)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addIndependentGpioWrite("sca.gpio.gpio0", false)
+    .addGpioWrite("sca.gpio.rocCoreResetN", false)
+    .addIndependentGpioWrite("sca.gpio.gpio1", false)
+    .addIndependentGpioWrite("sca.gpio.gpio2", false);
+  BOOST_TEST(getRequestSizes(transaction) == (std::vector<std::size_t>{1, 1, 2}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_ConsecutiveI2cWrites_MergedIntoOneRequest)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addI2cWrite("sca.analog.reg000", {0x00, 0x01})
+    .addI2cWrite("sca.analog.reg001", {0x01, 0x02})
+    .addI2cWrite("sca.analog.reg000", {0x00, 0x03});
+  const auto requests = transaction.getRequests();
+  BOOST_REQUIRE_EQUAL(std::size(requests), 1);
+  BOOST_TEST(requests.at(0).back().data == (std::vector<std::uint8_t>{0x00, 0x03}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(GetRequests_MixedTypes_SplitAtTypeChangesInOrder)
+{
+  nsw::OpcTransaction transaction;
+  transaction.addIndependentGpioWrite("sca.gpio.gpio0", false)
+    .addIndependentGpioWrite("sca.gpio.gpio1", false)
+    .addI2cWrite("sca.analog.reg000", {0x00})
+    .addI2cWrite("sca.analog.reg001", {0x01})
+    .addSpiWrite("sca.spi.vmm0", {0x00})
+    .addSpiWrite("sca.spi.vmm1", {0x00})
+    .addGpioWrite("sca.gpio.rocCoreResetN", true)
+    .addI2cWrite("sca.analog.reg002", {0x02});
+  BOOST_TEST(getRequestSizes(transaction) == (std::vector<std::size_t>{2, 2, 1, 1, 1, 1}),
+             boost::test_tools::per_element());
+  const auto requests = transaction.getRequests();
+  BOOST_TEST((requests.at(1).front().type == nsw::OpcTransaction::Type::I2C));
+  BOOST_TEST(requests.at(3).front().node == "sca.spi.vmm1");
+  BOOST_TEST((requests.at(4).front().type == nsw::OpcTransaction::Type::GPIO));
+}
@@ -0,0 +1,49 @@
+#define BOOST_TEST_MODULE RegisterLayout_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <string_view>
+
+#include "NSWConfiguration/Constants.h"
+#include "NSWConfiguration/RegisterLayout.h"
+
+namespace {
+  using namespace std::string_view_literals;
+
+  constexpr std::array REVERSED{"reg2"sv};
+  constexpr nsw::RegisterLayout<4> LAYOUT{
+    std::array<nsw::RegisterLayout<4>::NameSize, 4>{{{"reg1", 3}, {nsw::NOT_USED, 5}, {"reg2", 10}, {"reg3", 1}}},
+    REVERSED};
+
+  static_assert(LAYOUT.getTotalWidth() == 19);
+  static_assert(LAYOUT.contains("reg3"));
+  static_assert(LAYOUT.find("reg2")->m_offset == 8);
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(Find_ExistingRegister_ReturnsLayout)
+{
+  const auto* field = LAYOUT.find("reg2");
+  BOOST_REQUIRE(field != nullptr);
+  BOOST_TEST(field->m_name == "reg2");
+  BOOST_TEST(field->m_offset == 8);
+  BOOST_TEST(field->m_width == 10);
+  BOOST_TEST(field->m_reversed);
+  BOOST_TEST(not LAYOUT.find("reg1")->m_reversed);
+}
+
+BOOST_AUTO_TEST_CASE(Find_UnknownOrNotUsedRegister_ReturnsNullptr)
+{
+  BOOST_TEST(LAYOUT.find("reg4") == nullptr);
+  BOOST_TEST(LAYOUT.find("") == nullptr);
+  BOOST_TEST(not LAYOUT.contains(nsw::NOT_USED));
+}
+
+BOOST_AUTO_TEST_CASE(GetFields_AllFields_InBitstreamOrder)
+{
+  const auto& fields = LAYOUT.getFields();
+  BOOST_TEST(fields.at(1).m_name == nsw::NOT_USED);
+  BOOST_TEST(fields.at(1).m_offset == 3);
+  BOOST_TEST(fields.at(3).m_offset == 18);
+}
@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE TaskGraph_tests
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "NSWConfiguration/hw/TaskGraph.h"
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(Add_UnknownDependency_Throws)
+{
+  nsw::hw::TaskGraph graph{};
+  BOOST_CHECK_THROW(graph.add("B", []() {}, {"A"}), nsw::TaskGraphIssue);
+}
+
+BOOST_AUTO_TEST_CASE(Add_DuplicateName_Throws)
+{
+  nsw::hw::TaskGraph graph{};
+  graph.add("A", []() {});
+  BOOST_CHECK_THROW(graph.add("A", []() {}), nsw::TaskGraphIssue);
+}
+
+BOOST_AUTO_TEST_CASE(Run_Dependencies_RespectsOrder)
+{
+  nsw::hw::TaskGraph graph{};
+  std::mutex mutex{};
+  std::vector<std::string> order{};
+  const auto record = [&mutex, &order](std::string name) {
+    return [&mutex, &order, name = std::move(name)]() {
+      std::this_thread::sleep_for(5ms);
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(name);
+    };
+  };
+  graph.add("A", record("A"));
+  graph.add("B", record("B"), {"A"});
+  graph.add("C", record("C"), {"B"});
+  graph.run();
+  BOOST_TEST(order == (std::vector<std::string>{"A", "B", "C"}));
+}
+
+BOOST_AUTO_TEST_CASE(Run_IndependentTasks_RunConcurrently)
+{
+  nsw::hw::TaskGraph graph{};
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  const auto task = [&running, &maxRunning]() {
+    const auto current = ++running;
+    auto previous = maxRunning.load();
+    while (previous < current and not maxRunning.compare_exchange_weak(previous, current)) {
+    }
+    std::this_thread::sleep_for(50ms);
+    --running;
+  };
+  graph.add("A", task);
+  graph.add("B", task);
+  graph.run();
+  BOOST_TEST(maxRunning == 2);
+}
+
+BOOST_AUTO_TEST_CASE(Run_Chain_ReportsCriticalPath)
+{
+  nsw::hw::TaskGraph graph{};
+  graph.add("Fast", []() { std::this_thread::sleep_for(1ms); });
+  graph.add("Slow", []() { std::this_thread::sleep_for(50ms); });
+  graph.add("Last", []() { std::this_thread::sleep_for(1ms); }, {"Fast", "Slow"});
+  const auto report = graph.run();
+  BOOST_TEST(report.m_criticalPath == (std::vector<std::string>{"Slow", "Last"}));
+  BOOST_TEST(report.m_timings.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(Run_ThrowingTask_SkipsDependentsAndReportsFailure)
+{
+  for (const auto parallel : {true, false}) {
+    nsw::hw::TaskGraph graph{};
+    std::atomic<bool> dependentRan{false};
+    std::atomic<bool> independentRan{false};
+    graph.add("A", []() { throw std::runtime_error("failed"); });
+    graph.add("B", [&dependentRan]() { dependentRan = true; }, {"A"});
+    graph.add("C", [&dependentRan]() { dependentRan = true; }, {"B"});
+    graph.add("D", [&independentRan]() { independentRan = true; });
+    const auto report = graph.run(parallel);
+    BOOST_TEST(not dependentRan);
+    BOOST_TEST(independentRan);
+    BOOST_TEST(report.m_failed == (std::vector<std::string>{"A"}));
+    BOOST_TEST(report.m_skipped == (std::vector<std::string>{"B", "C"}));
+    BOOST_TEST(report.m_timings.size() == 4);
+    BOOST_CHECK_THROW(report.rethrowIfFailed(), std::runtime_error);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Run_NoFailure_RethrowDoesNothing)
+{
+  nsw::hw::TaskGraph graph{};
+  graph.add("A", []() {});
+  const auto report = graph.run();
+  BOOST_TEST(report.m_failed.empty());
+  BOOST_TEST(report.m_skipped.empty());
+  BOOST_CHECK_NO_THROW(report.rethrowIfFailed());
+}